@@ -8,8 +8,13 @@
  * @{
  * @details
  * This file declares the BootClock class which provides system time in a
- * human-readable format. It uses the RTOS tick count to calculate hours,
- * minutes, seconds, and milliseconds since system start.
+ * human-readable format. It extends the 32-bit RTOS tick count to a 64-bit
+ * millisecond time base that never wraps, and derives a wall clock from it
+ * (offset and rate correction), so timestamps carry a calendar date once
+ * the clock is set and can follow a host clock without steps. With a cycle
+ * counter attached, time since start is also available in nanoseconds.
+ * Timestamps are rendered into caller buffers, so any number of threads can
+ * stamp records at the same time.
  */
 
 #ifndef BOOT_CLOCK_H
@@ -17,33 +22,81 @@
 
 #include <array>
 #include <atomic>
+#include <calendar.h>
+#include <cstddef>
+#include <cstdint>
 #include <cstring>
+#include <cycle_clock.h>
 #include <string_view>
 
 #ifdef __cplusplus
 
+class CycleCounter;
+class RtcPort;
+
 /**
  * @class BootClock
  * @brief Singleton class for system timekeeping
- * This class provides methods to get the current system time formatted
- * as a string. It uses the RTOS tick count to compute hours, minutes,
- * seconds, and milliseconds since system start.
- * It also provides a method to set the RTC time based on a provided string.
+ * This class provides a monotonic 64-bit time since start (milliseconds and
+ * microseconds) and the wall-clock time derived from it, formatted as a
+ * string or as a calendar date. The wall clock is set with setRTC() and can
+ * be backed by a hardware RTC that keeps it across resets.
  */
 class BootClock {
 public:
+  static constexpr std::size_t TIME_STRING_LENGTH =
+      12U; ///< Characters in "HH:MM:SS.mmm"
+  static constexpr std::size_t TIME_STRING_SIZE =
+      TIME_STRING_LENGTH + 1U; ///< Buffer size including the terminator
+  static constexpr std::size_t FINE_STRING_LENGTH =
+      16U; ///< Characters in "HH:MM:SS.fffffff" (100 ns digits)
+  static constexpr std::size_t FINE_STRING_SIZE =
+      FINE_STRING_LENGTH + 1U; ///< Buffer size including the terminator
+
   enum class SetRTCStatus : std::int8_t {
     SUCCESS = 0,
     INVALID_RX_FORMAT = -1,
     INVALID_VALUE = -2,
   };
 
+  /// Set the wall clock from "hh:mm:ss" or "YYYY-MM-DD[T ]hh:mm:ss"
   SetRTCStatus setRTC(std::string_view buf);
 
   static BootClock &getInstance(); ///< Get singleton instance
 
-  std::string_view
-  getCurrentTimeString(void); ///< Get current time as formatted string
+  std::uint64_t nowMs(); ///< Milliseconds since start (64-bit, monotonic)
+  std::uint64_t nowUs(); ///< Microseconds since start (64-bit, monotonic)
+  std::uint64_t nowNs(); ///< Nanoseconds since start, cycle resolution
+  std::uint64_t wallMs(); ///< Milliseconds since 1970-01-01 (UTC)
+  std::uint64_t wallUs(); ///< Microseconds since 1970-01-01 (UTC)
+  bool isSet() const { return clock_set.load(); } ///< setRTC() or RTC done
+
+  /// Back the wall clock with an RTC; adopts its time if it has one
+  bool attachRtc(RtcPort *port);
+
+  /// Take fine time from a cycle counter clocked like the kernel tick
+  bool attachCycleCounter(CycleCounter *counter);
+  /// True if nowNs() reads the cycle counter
+  bool hasCycleCounter() const { return cycles_on.load(); }
+
+  /// Correct the wall clock by errorUs and run it at 1 + skewPpb * 1e-9
+  /// of the kernel tick; slews small errors, steps large ones (returns true)
+  bool steer(std::int64_t errorUs, std::int32_t skewPpb);
+
+  /// Current time as "HH:MM:SS.mmm" into buf (TIME_STRING_SIZE bytes);
+  /// day (optional) receives the days since 1970-01-01 of the stamp
+  std::size_t formatTime(char *buf, std::uint32_t *day = nullptr);
+
+  /// Current time as "HH:MM:SS.fffffff" (fractional seconds to 100 ns)
+  /// into buf (FINE_STRING_SIZE bytes); day as for formatTime()
+  std::size_t formatTimeFine(char *buf, std::uint32_t *day = nullptr);
+
+  /// Current date and time as "YYYY-MM-DDTHH:MM:SS.mmm" into buf
+  /// (Calendar::ISO_STRING_SIZE bytes)
+  std::size_t formatIso(char *buf);
+
+  /// Render a millisecond time of day into buf (TIME_STRING_SIZE bytes)
+  static std::size_t formatTime(std::uint32_t milliseconds, char *buf);
 
 private:
   BootClock() {}; ///< Private constructor for singleton pattern
@@ -51,9 +104,33 @@ private:
   BootClock &
   operator=(const BootClock &) = delete; ///< Delete copy assignment operator
 
-  std::array<char, 16> timeString; ///< Buffer to hold formatted time string
+  /// Wall clock as a function of nowMs(), replaced as a whole
+  struct Discipline {
+    std::uint64_t anchorMs = 0U;   ///< nowMs() the model starts at
+    std::int64_t anchorWallUs = 0; ///< Unix microseconds at anchorMs
+    std::int32_t skew = 0;         ///< Rate correction (2^-32 per ms)
+    std::int32_t slew = 0;         ///< Extra rate while slewing (2^-32 per ms)
+    std::uint32_t slewMs = 0U;     ///< Slew length after anchorMs
+  };
+
+  Discipline discipline(); ///< Consistent copy of the current model
+  void publish(const Discipline &next); ///< Replace the model
+  /// Unix microseconds of the model at local time ms
+  static std::int64_t wallAt(const Discipline &d, std::uint64_t ms);
+  void stepTo(std::int64_t unixMs); ///< Jump to a time, keep the rate
+  std::uint64_t sysCycles(); ///< Kernel timer cycles since start (64-bit)
+  /// formatTime() for a given wall time
+  std::size_t formatWall(std::uint64_t now, char *buf, std::uint32_t *day);
 
-  std::atomic_uint32_t clock_offset = 0; ///< Offset to adjust clock time
+  /// Tick epoch (wraps of the 32-bit tick) << 1 | top bit of the last tick
+  std::atomic_uint32_t tick_state = 0U;
+  Discipline model;                     ///< Wall clock model
+  std::atomic_uint32_t model_seq = 0U;  ///< Bumped on every model change
+  std::atomic_bool clock_set = false;   ///< Wall clock was set
+  RtcPort *rtc = nullptr;               ///< Optional hardware RTC
+  CycleClock cycle_clock;               ///< 64-bit cycle count
+  std::uint64_t cycle_offset = 0U;      ///< Cycle count at kernel start
+  std::atomic_bool cycles_on = false;   ///< cycle_offset is valid
 }; // End of BootClock class
 
 extern "C" {
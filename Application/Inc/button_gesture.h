@@ -0,0 +1,92 @@
+/**
+ * @file button_gesture.h
+ * @brief Button debounce and press gesture detection
+ * @author Mitul Goti
+ * @version 1.0
+ * @date 2025-10-14
+ * @ingroup input
+ * @{
+ * @details
+ * This file declares ButtonGesture: a state machine that turns the raw,
+ * timestamped edges of one push button into debounced presses and the
+ * short, long and double press gestures. Time is passed in by the caller
+ * (ms ticks), so there is no RTOS or hardware dependency.
+ */
+
+#ifndef BUTTON_GESTURE_H
+#define BUTTON_GESTURE_H
+
+#include <cstdint>
+
+#ifdef __cplusplus
+
+/**
+ * @class ButtonGesture
+ * @brief Leading-edge debounce and gesture timing of one button
+ * @details The first edge after a quiet period is taken at once, so a press
+ *          is reported without delay; edges inside the debounce window
+ *          after it are bounce and only update the raw level, which is
+ *          checked again when the window closes. Not thread-safe: one
+ *          thread owns the state machine.
+ */
+class ButtonGesture {
+public:
+  /// What a subscriber can wait for
+  enum class Gesture : std::uint8_t {
+    PRESS = 0,   ///< Debounced press, reported on its first edge
+    RELEASE = 1, ///< Debounced release
+    SHORT = 2,   ///< Press and release, no second press within DOUBLE_MS
+    LONG = 3,    ///< Held for LONG_MS (reported while still held)
+    DOUBLE = 4,  ///< Second press within DOUBLE_MS, released before LONG_MS
+  };
+  static constexpr std::uint32_t GESTURES = 5U; ///< Entries of Gesture
+
+  static constexpr std::uint32_t DEBOUNCE_MS = 20U; ///< Bounce window
+  static constexpr std::uint32_t LONG_MS = 800U;    ///< Long press hold
+  static constexpr std::uint32_t DOUBLE_MS = 300U;  ///< Gap of a double
+
+  /// Called for each gesture, with the tick it happened at
+  using EmitHandler = void (*)(void *context, Gesture g, std::uint32_t tick);
+
+  /// Forget all state; the button is taken as released
+  void reset();
+
+  /// Raw edge: level (true = pressed) seen at tick; ticks must not go back
+  void edge(bool level, std::uint32_t tick, EmitHandler emit, void *context);
+
+  /// Handle every deadline up to and including now
+  void expire(std::uint32_t now, EmitHandler emit, void *context);
+
+  /// Ticks from now to the next deadline; false if there is none
+  bool untilNext(std::uint32_t now, std::uint32_t &ticks) const;
+
+  bool isPressed() const { return pressed; } ///< Debounced level
+
+private:
+  /// One pending deadline
+  struct Deadline {
+    std::uint32_t at = 0U; ///< Tick it falls due
+    bool armed = false;    ///< Waiting
+  };
+
+  void accept(bool level, std::uint32_t tick, EmitHandler emit,
+              void *context); ///< Debounced level change
+
+  Deadline settle;            ///< End of the debounce window
+  Deadline hold;              ///< Press turns into a long press
+  Deadline gap;               ///< Single click turns into a short press
+  bool raw = false;           ///< Level of the latest edge
+  bool pressed = false;       ///< Debounced level
+  bool longSent = false;      ///< LONG reported for the current press
+  bool clickPending = false;  ///< One click waiting for a second press
+};
+
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif    // BUTTON_GESTURE_H
+/** @} */ // end of input
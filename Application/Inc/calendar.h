@@ -0,0 +1,91 @@
+/**
+ * @file calendar.h
+ * @brief Civil date/time conversions for the boot clock
+ * @author Mitul Goti
+ * @version 1.0
+ * @date 2025-10-06
+ * @ingroup boot_clock
+ * @{
+ * @details
+ * This file declares the DateTime record and the Calendar helpers that
+ * convert between it and milliseconds since 1970-01-01 (UTC, no leap
+ * seconds), parse "set clock" input and render ISO 8601 text. There is no
+ * RTOS dependency, so the same code builds on a host (Tools/rtc_sim).
+ */
+
+#ifndef CALENDAR_H
+#define CALENDAR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#ifdef __cplusplus
+
+/**
+ * @struct DateTime
+ * @brief Broken-down calendar date and time of day
+ */
+struct DateTime {
+  std::uint16_t year = 1970U;  ///< 1970..9999
+  std::uint8_t month = 1U;     ///< 1..12
+  std::uint8_t day = 1U;       ///< 1..31
+  std::uint8_t hour = 0U;      ///< 0..23
+  std::uint8_t minute = 0U;    ///< 0..59
+  std::uint8_t second = 0U;    ///< 0..59
+  std::uint16_t millis = 0U;   ///< 0..999
+};
+
+/**
+ * @class Calendar
+ * @brief Proleptic Gregorian calendar arithmetic on Unix milliseconds
+ */
+class Calendar {
+public:
+  static constexpr std::uint64_t MS_PER_DAY = 86400000ULL; ///< 24 h
+  static constexpr std::size_t DATE_STRING_LENGTH =
+      10U; ///< Characters in "YYYY-MM-DD"
+  static constexpr std::size_t ISO_STRING_LENGTH =
+      23U; ///< Characters in "YYYY-MM-DDTHH:MM:SS.mmm"
+  static constexpr std::size_t ISO_STRING_SIZE =
+      ISO_STRING_LENGTH + 1U; ///< Buffer size including the terminator
+
+  /// Fields found by parse()
+  enum class Parsed : std::uint8_t {
+    NONE = 0,      ///< Not a time
+    TIME = 1,      ///< "hh:mm:ss": date fields untouched
+    DATE_TIME = 2, ///< "YYYY-MM-DD[T ]hh:mm:ss"
+  };
+
+  /// True if every field is in range (day checked against the month)
+  static bool valid(const DateTime &dt);
+
+  /// Days since 1970-01-01 of a valid date
+  static std::uint32_t daysFromCivil(std::uint32_t year, std::uint32_t month,
+                                     std::uint32_t day);
+
+  /// Milliseconds since 1970-01-01T00:00:00.000 of a valid DateTime
+  static std::uint64_t toUnixMs(const DateTime &dt);
+
+  /// Broken-down time of milliseconds since 1970-01-01
+  static DateTime fromUnixMs(std::uint64_t unixMs);
+
+  /// Parse "hh:mm:ss" or "YYYY-MM-DD[T ]hh:mm:ss[.mmm][Z]" into dt
+  static Parsed parse(std::string_view text, DateTime &dt);
+
+  /// "YYYY-MM-DD" of a day number into buf (DATE_STRING_LENGTH + 1 bytes)
+  static std::size_t formatDate(std::uint32_t days, char *buf);
+
+  /// "YYYY-MM-DDTHH:MM:SS.mmm" into buf (ISO_STRING_SIZE bytes)
+  static std::size_t formatIso(std::uint64_t unixMs, char *buf);
+};
+
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif    // CALENDAR_H
+/** @} */ // end of boot_clock
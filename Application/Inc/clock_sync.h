@@ -0,0 +1,89 @@
+/**
+ * @file clock_sync.h
+ * @brief Host time synchronization over the CDC link
+ * @author Mitul Goti
+ * @version 1.0
+ * @date 2025-10-07
+ * @ingroup boot_clock
+ * @{
+ * @details
+ * This file declares ClockSync, which turns NTP-style exchanges with the
+ * host (four timestamps each) into an offset and a rate estimate, and
+ * steers BootClock's wall clock with them.
+ */
+
+#ifndef CLOCK_SYNC_H
+#define CLOCK_SYNC_H
+
+#include <array>
+#include <cstdint>
+
+#ifdef __cplusplus
+
+/**
+ * @class ClockSync
+ * @brief Singleton offset/skew estimator fed by `sync` commands
+ * @details
+ *   Exchange n: the host sends `sync <t1> [<t4 of exchange n-1>]` with its
+ *   Unix time in microseconds. The device takes t2 when the command is
+ *   handled and t3 just before the reply goes out (local monotonic
+ *   microseconds). The t4 of the next command closes the exchange.
+ *   Only the USB command thread calls into this class.
+ */
+class ClockSync {
+public:
+  static constexpr std::uint32_t SAMPLES = 8U; ///< Exchanges kept
+  static constexpr std::uint32_t MAX_DELAY_US =
+      50000U; ///< Slower round trips are dropped
+
+  /// Summary for status replies
+  struct Stats {
+    std::int64_t errorUs = 0;  ///< Last correction handed to BootClock
+    std::uint32_t delayUs = 0; ///< Round trip of the last sample
+    std::int32_t skewPpb = 0;  ///< Host rate over local rate, minus 1
+    std::uint32_t samples = 0; ///< Samples accepted so far
+    std::uint32_t rejected = 0; ///< Exchanges dropped (delay, order)
+    std::uint32_t steps = 0;   ///< Corrections applied as a step
+  };
+
+  static ClockSync &getInstance(); ///< Get singleton instance
+
+  /// Start an exchange: host send time t1, local receive/send times t2, t3
+  void begin(std::uint64_t t1, std::uint64_t t2, std::uint64_t t3);
+
+  /// Close the open exchange with the host receive time t4 and steer
+  bool complete(std::uint64_t t4);
+
+  const Stats &getStats() const { return stats; } ///< Current summary
+
+private:
+  ClockSync() {}; ///< Private constructor for singleton pattern
+  ClockSync(const ClockSync &) = delete;            ///< Prevent copy
+  ClockSync &operator=(const ClockSync &) = delete; ///< Prevent assignment
+
+  /// One finished exchange
+  struct Sample {
+    std::uint64_t localUs; ///< Middle of t2..t3 (local monotonic)
+    std::int64_t offsetUs; ///< Host time minus local time at localUs
+    std::uint32_t delayUs; ///< Round trip without the device's time
+  };
+
+  void estimate(); ///< Fit offset and skew, steer the wall clock
+
+  std::array<Sample, SAMPLES> samples{}; ///< Ring of recent samples
+  std::uint32_t count = 0U;              ///< Samples in the ring
+  std::uint32_t next = 0U;               ///< Ring write index
+  std::uint64_t open[3] = {0U, 0U, 0U};  ///< t1, t2, t3 of the open exchange
+  bool pending = false;                  ///< open[] is valid
+  Stats stats;                           ///< Summary
+};
+
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif    // CLOCK_SYNC_H
+/** @} */ // end of boot_clock
@@ -0,0 +1,56 @@
+/**
+ * @file    crash_dump.h
+ * @brief   Fault-time capture of pending log records, reported on next boot.
+ * @author  Mitul Goti
+ * @version 1.0
+ * @date    2025-09-26
+ * @ingroup Logger
+ * @{
+ * @details
+ *   This header declares the CrashDump singleton. At fault time (from the
+ *   CMSIS-View ARM_FaultExit() hook) it copies the log records still waiting
+ *   in the logger queues into a CRC-protected ring in no-init RAM. On the
+ *   next boot it decodes the CMSIS-View fault record and that ring and logs
+ *   them as the first records.
+ */
+
+#ifndef CRASH_DUMP_H
+#define CRASH_DUMP_H
+
+#include <cstdint>
+#include <string_view>
+
+#ifdef __cplusplus
+
+/**
+ * @class   CrashDump
+ * @brief   Singleton holding the post-mortem log tail.
+ */
+class CrashDump {
+public:
+  static constexpr std::uint32_t CRASH_TAIL_SIZE =
+      512U; /*!< Pending log bytes kept (newest win) */
+
+  static CrashDump &getInstance(); /*!< Get singleton instance */
+
+  void capturePending();              /*!< Fault context: drain loggers */
+  void capture(std::string_view data); /*!< Fault context: append bytes */
+
+  bool emit(); /*!< Boot: log fault record and tail, then clear them */
+
+private:
+  CrashDump();                                      /*!< Singleton */
+  CrashDump(const CrashDump &) = delete;            /*!< Prevent copy */
+  CrashDump &operator=(const CrashDump &) = delete; /*!< Prevent assignment */
+};
+
+extern "C" {
+#endif
+
+void ARM_FaultExit(void); /*!< CMSIS-View hook, called after ARM_FaultSave */
+
+#ifdef __cplusplus
+}
+#endif
+#endif    // CRASH_DUMP_H
+/** @} */ // end of Logger
@@ -0,0 +1,57 @@
+/**
+ * @file cycle_clock.h
+ * @brief 64-bit extension of a 32-bit cycle counter
+ * @author Mitul Goti
+ * @version 1.0
+ * @date 2025-10-08
+ * @ingroup boot_clock
+ * @{
+ * @details
+ * This file declares CycleClock, which counts the wraps of a CycleCounter
+ * so cycle timestamps never wrap. It has no RTOS or hardware dependency.
+ */
+
+#ifndef CYCLE_CLOCK_H
+#define CYCLE_CLOCK_H
+
+#include <atomic>
+#include <cstdint>
+#include <cycle_counter.h>
+
+#ifdef __cplusplus
+
+/**
+ * @class CycleClock
+ * @brief Lock-free 64-bit cycle count on top of a CycleCounter
+ * @details cycles() must be called at least once per half wrap of the
+ *          counter (12.7 s at 168 MHz), or a wrap is missed.
+ */
+class CycleClock {
+public:
+  /// Use counter from now on (nullptr detaches)
+  void attach(CycleCounter *counter);
+
+  /// True while a counter is attached
+  bool attached() const { return source.load() != nullptr; }
+
+  /// Cycles counted since the counter started (0 without a counter)
+  std::uint64_t cycles();
+
+  /// Counts per second of the attached counter (0 without a counter)
+  std::uint32_t frequency() const;
+
+private:
+  std::atomic<CycleCounter *> source = nullptr; ///< Attached counter
+  /// Wraps seen so far << 1 | top bit of the last count read
+  std::atomic_uint32_t state = 0U;
+};
+
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif    // CYCLE_CLOCK_H
+/** @} */ // end of boot_clock
@@ -0,0 +1,60 @@
+/**
+ * @file cycle_counter.h
+ * @brief Free-running core cycle counter used for fine timestamps
+ * @author Mitul Goti
+ * @version 1.0
+ * @date 2025-10-08
+ * @ingroup boot_clock
+ * @{
+ * @details
+ * This file declares the CycleCounter interface (a 32-bit count and its
+ * frequency) and the Cortex-M4 implementation on DWT CYCCNT. BootClock
+ * only talks to CycleCounter, so host builds use the stub in
+ * Tools/cycle_sim instead.
+ */
+
+#ifndef CYCLE_COUNTER_H
+#define CYCLE_COUNTER_H
+
+#include <cstdint>
+
+#ifdef __cplusplus
+
+/**
+ * @class CycleCounter
+ * @brief Abstract free-running 32-bit counter
+ */
+class CycleCounter {
+public:
+  virtual ~CycleCounter() = default; ///< Virtual destructor
+
+  /// Current count; wraps to 0 after 0xFFFFFFFF
+  virtual std::uint32_t read() = 0;
+  /// Counts per second
+  virtual std::uint32_t frequency() const = 0;
+};
+
+/**
+ * @class DwtCycleCounter
+ * @brief CycleCounter on the DWT cycle counter (CYCCNT) of the Cortex-M4
+ * @details CYCCNT counts core clock cycles (168 MHz, so 5.95 ns per count
+ *          and a wrap every 25.6 s). It is shared with the Event Recorder
+ *          and debuggers, so it is enabled but never reset here.
+ */
+class DwtCycleCounter : public CycleCounter {
+public:
+  bool init(); ///< Enable trace and CYCCNT; false if the core has none
+
+  std::uint32_t read() override;
+  std::uint32_t frequency() const override;
+};
+
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif    // CYCLE_COUNTER_H
+/** @} */ // end of boot_clock
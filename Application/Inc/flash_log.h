@@ -0,0 +1,83 @@
+/**
+ * @file    flash_log.h
+ * @brief   Persistent log in internal flash.
+ * @author  Mitul Goti
+ * @version 1.0
+ * @date    2025-09-24
+ * @ingroup Logger
+ * @{
+ * @details
+ *   This header declares the FlashLog singleton, a Logger that keeps every
+ *   routed message in the FlashStore partition so logs survive resets and
+ *   power cycles. log() only copies into a RAM page; a low-priority thread
+ *   programs full pages and erases the next sector ahead of time.
+ */
+
+#ifndef FLASH_LOG_H
+#define FLASH_LOG_H
+
+#include <atomic>
+#include <cmsis_os2.h>
+#include <cstdint>
+#include <logger.h>
+#include <string_view>
+
+#ifdef __cplusplus
+
+/**
+ * @class   FlashLog
+ * @brief   Singleton page-buffered logger on the internal flash store.
+ */
+class FlashLog : public Logger {
+public:
+  static constexpr std::uint32_t FLASH_PAGE_SIZE =
+      256U; /*!< RAM page = one flash record */
+
+  /** @brief Status codes for the flash logger */
+  enum FlashLogStatus : std::int8_t {
+    FLASH_LOG_OK = 0,               /*!< Success */
+    FLASH_LOG_NOT_INITIALIZED = -1, /*!< init() not called or failed */
+    FLASH_LOG_MOUNT_ERROR = -2,     /*!< Store could not be mounted */
+    FLASH_LOG_RTOS_ERROR = -3,      /*!< Mutex/thread creation failed */
+  };
+
+  /** @brief Snapshot of the store for status replies */
+  struct Stats {
+    std::uint32_t used = 0U;     /*!< Bytes written in the ring */
+    std::uint32_t capacity = 0U; /*!< Bytes the ring can hold */
+    std::uint32_t minErase = 0U; /*!< Lowest sector erase count */
+    std::uint32_t maxErase = 0U; /*!< Highest sector erase count */
+    std::uint32_t dropped = 0U;  /*!< Messages dropped (writer behind) */
+  };
+
+  static FlashLog &getInstance(); /*!< Get singleton instance */
+
+  FlashLogStatus init(); /*!< Mount store, start writer thread */
+
+  void log(std::string_view msg) override; /*!< Queue a message for flash */
+
+  FlashLogStatus replayToUsb(); /*!< Send all stored records to USB */
+  void getStats(Stats &stats);  /*!< Fill a status snapshot */
+  void crashDrain(); /*!< Fault context: move unwritten pages to CrashDump */
+
+  osThreadId_t getThreadId() const { return threadId; } /*!< Get thread ID */
+
+private:
+  FlashLog();                                     /*!< Singleton */
+  FlashLog(const FlashLog &) = delete;            /*!< Prevent copy */
+  FlashLog &operator=(const FlashLog &) = delete; /*!< Prevent assignment */
+  static void writerThreadWrapper(void *argument); /*!< Thread wrapper */
+  void writerThread();                             /*!< Page writer loop */
+
+  osThreadId_t threadId = nullptr; /*!< RTOS thread ID for page writer */
+  std::atomic_bool ready = false;  /*!< Store mounted, thread running */
+};
+
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+#endif    // FLASH_LOG_H
+/** @} */ // end of Logger
@@ -0,0 +1,77 @@
+/**
+ * @file    flash_port.h
+ * @brief   Raw NOR flash access used by the flash log store.
+ * @author  Mitul Goti
+ * @version 1.0
+ * @date    2025-09-24
+ * @ingroup Logger
+ * @{
+ * @details
+ *   This header declares the FlashPort interface (sector geometry, read,
+ *   program, erase) and the STM32F4 implementation on the upper internal
+ *   flash sectors. The store only talks to FlashPort, so the same code runs
+ *   against the file-backed simulator in Tools/flash_sim on a host.
+ */
+
+#ifndef FLASH_PORT_H
+#define FLASH_PORT_H
+
+#include <cstdint>
+
+#ifdef __cplusplus
+
+/**
+ * @class   FlashPort
+ * @brief   Abstract NOR flash partition made of equally sized sectors.
+ * @details Programming may only clear bits (1 -> 0); erase sets a whole
+ *          sector to 0xFF. Offsets and lengths passed to program() are
+ *          multiples of 4 bytes.
+ */
+class FlashPort {
+public:
+  virtual ~FlashPort() = default; /*!< Virtual destructor */
+
+  virtual std::uint32_t sectorCount() const = 0; /*!< Sectors in partition */
+  virtual std::uint32_t sectorSize() const = 0;  /*!< Bytes per sector */
+
+  /** @brief Read len bytes at offset of sector into buf */
+  virtual bool read(std::uint32_t sector, std::uint32_t offset, void *buf,
+                    std::uint32_t len) = 0;
+  /** @brief Program len bytes (word multiple) at offset of sector */
+  virtual bool program(std::uint32_t sector, std::uint32_t offset,
+                       const void *data, std::uint32_t len) = 0;
+  /** @brief Erase one sector to 0xFF */
+  virtual bool erase(std::uint32_t sector) = 0;
+};
+
+/**
+ * @class   Stm32FlashPort
+ * @brief   FlashPort on internal flash sectors 9..11 (0x080A0000, 384 KB).
+ * @details The scatter file limits code to the first 640 KB so these sectors
+ *          stay free. Reads are plain memory accesses, program/erase go
+ *          through the HAL flash driver.
+ */
+class Stm32FlashPort : public FlashPort {
+public:
+  static constexpr std::uint32_t BASE_ADDRESS = 0x080A0000U; /*!< Sector 9 */
+  static constexpr std::uint32_t FIRST_SECTOR = 9U;   /*!< HAL sector number */
+  static constexpr std::uint32_t SECTOR_COUNT = 3U;   /*!< Sectors 9..11 */
+  static constexpr std::uint32_t SECTOR_SIZE = 0x20000U; /*!< 128 KB each */
+
+  std::uint32_t sectorCount() const override { return SECTOR_COUNT; }
+  std::uint32_t sectorSize() const override { return SECTOR_SIZE; }
+  bool read(std::uint32_t sector, std::uint32_t offset, void *buf,
+            std::uint32_t len) override;
+  bool program(std::uint32_t sector, std::uint32_t offset, const void *data,
+               std::uint32_t len) override;
+  bool erase(std::uint32_t sector) override;
+};
+
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+#endif    // FLASH_PORT_H
+/** @} */ // end of Logger
@@ -0,0 +1,124 @@
+/**
+ * @file    flash_store.h
+ * @brief   Log-structured record store on a NOR flash partition.
+ * @author  Mitul Goti
+ * @version 1.0
+ * @date    2025-09-24
+ * @ingroup Logger
+ * @{
+ * @details
+ *   This header declares FlashStore, an append-only store of CRC-checked
+ *   records spread over the sectors of a FlashPort. Sectors are used as a
+ *   ring ordered by a sequence number; the next sector is picked by erase
+ *   count. The class has no RTOS dependency (callers serialize access), so it
+ *   also builds on a host against the flash simulator.
+ */
+
+#ifndef FLASH_STORE_H
+#define FLASH_STORE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <flash_port.h>
+
+#ifdef __cplusplus
+
+/**
+ * @class   FlashStore
+ * @brief   Append-only record store with sector-level wear leveling.
+ * @details
+ *   Sector layout: 16-byte header (magic, erase count, check word, sequence
+ *   number) followed by records. A record is an 8-byte header (length,
+ *   marker, CRC-32 of the payload) and the payload padded to 4 bytes.
+ *   Erased flash (0xFF) marks the end of the written area.
+ */
+class FlashStore {
+public:
+  static constexpr std::uint32_t MAX_SECTORS = 8U;         /*!< Ring limit */
+  static constexpr std::uint32_t SECTOR_HEADER_SIZE = 16U; /*!< Bytes */
+  static constexpr std::uint32_t RECORD_HEADER_SIZE = 8U;  /*!< Bytes */
+
+  /** @brief Status codes for store operations */
+  enum FlashStatus : std::int8_t {
+    FLASH_FORMATTED = 1,       /*!< Mounted an empty (new) store */
+    FLASH_OK = 0,              /*!< Success */
+    FLASH_NOT_MOUNTED = -1,    /*!< mount() not called or failed */
+    FLASH_PORT_ERROR = -2,     /*!< Read/program/erase failed */
+    FLASH_TOO_LARGE = -3,      /*!< Record does not fit in a sector */
+    FLASH_GEOMETRY_ERROR = -4, /*!< Unsupported partition geometry */
+  };
+
+  /** @brief Read result of read() besides a payload length */
+  enum ReadStatus : std::int32_t {
+    READ_END = 0,        /*!< No more records */
+    READ_CRC_ERROR = -1, /*!< Record skipped: payload CRC mismatch */
+  };
+
+  /** @brief Read position: sector sequence number and offset in it */
+  struct Cursor {
+    std::uint32_t seq;    /*!< Sequence number of the sector */
+    std::uint32_t offset; /*!< Offset of the next record header */
+  };
+
+  explicit FlashStore(FlashPort &port); /*!< Bind to a partition */
+
+  FlashStatus mount(); /*!< Scan sector and record headers only */
+  FlashStatus append(const void *data, std::uint32_t len); /*!< Add record */
+
+  bool needsPrepare() const; /*!< True if no erased spare sector is left */
+  FlashStatus prepare();     /*!< Erase the next sector ahead of time */
+
+  Cursor oldest() const; /*!< Cursor at the oldest record */
+  /** @brief Read the record at cursor into buf and advance the cursor */
+  std::int32_t read(Cursor &cursor, void *buf, std::uint32_t size);
+
+  std::uint32_t capacity() const;  /*!< Payload bytes the ring can hold */
+  std::uint32_t usedBytes() const; /*!< Bytes written in used sectors */
+  void eraseCounts(std::uint32_t &min,
+                   std::uint32_t &max) const; /*!< Wear spread */
+
+  /** @brief CRC-32 (IEEE 802.3, reflected), chainable via crc */
+  static std::uint32_t crc32(const void *data, std::size_t len,
+                             std::uint32_t crc = 0U);
+
+private:
+  /** @brief State of a sector derived from its header */
+  enum class SectorState : std::uint8_t {
+    BLANK,    /*!< Header erased, sector never formatted */
+    INVALID,  /*!< Header damaged, must be erased before use */
+    PREPARED, /*!< Erased and stamped, waiting to be activated */
+    USED,     /*!< Holds records, ordered by seq */
+  };
+
+  /** @brief RAM copy of one sector header */
+  struct SectorInfo {
+    SectorState state = SectorState::BLANK; /*!< Derived state */
+    std::uint32_t eraseCount = 0U;          /*!< Erase cycles so far */
+    std::uint32_t seq = 0U;                 /*!< Sequence when USED */
+    std::uint32_t end = 0U;                 /*!< Written bytes when USED */
+  };
+
+  FlashStatus format(std::uint32_t sector);  /*!< Erase and stamp header */
+  FlashStatus activate();                    /*!< Switch to next sector */
+  std::int32_t pickSpare(bool preparedOnly) const; /*!< Wear leveling */
+  std::int32_t findSeq(std::uint32_t seq) const;   /*!< Sector of seq */
+  std::uint32_t scanEnd(std::uint32_t sector); /*!< Walk record headers */
+  std::uint32_t maxEraseCount() const;         /*!< Highest known count */
+
+  FlashPort &port;                              /*!< Partition */
+  std::uint32_t sectorCount = 0U;               /*!< Sectors in use */
+  std::array<SectorInfo, MAX_SECTORS> sectors;  /*!< Header cache */
+  std::int32_t active = -1;                     /*!< Sector being written */
+  std::uint32_t nextSeq = 1U;                   /*!< Seq for next sector */
+  bool mounted = false;                         /*!< mount() succeeded */
+};
+
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+#endif    // FLASH_STORE_H
+/** @} */ // end of Logger
@@ -0,0 +1,42 @@
+/**
+ * @file    fs_bench.h
+ * @brief   Format and write-amplification benchmark for the RAM log drive.
+ * @author  Mitul Goti
+ * @version 1.0
+ * @date    2025-10-02
+ * @ingroup Logger
+ * @{
+ * @details
+ *   This header declares FsBench, which formats R0: with each candidate
+ *   fformat() option string, fills it with synthetic log appends and reports
+ *   the geometry, the bytes touched per logged byte, the append latency and
+ *   the log bytes the drive holds. The winner goes into FS_LOG_FORMAT.
+ *   Built with FS_BENCH only: a run erases the log drive.
+ */
+
+#ifndef FS_BENCH_H
+#define FS_BENCH_H
+
+#include <cstdint>
+#include <fs_log.h>
+
+#ifdef __cplusplus
+
+/**
+ * @class   FsBench
+ * @brief   On-target benchmark of the FlashFS formats for the log drive.
+ */
+class FsBench {
+public:
+  static FsLog::FsLogStatus
+  run(FsReplayControl *ctrl = nullptr); /*!< Measure all candidates */
+};
+
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+#endif    // FS_BENCH_H
+/** @} */ // end of Logger
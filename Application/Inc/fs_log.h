@@ -15,11 +15,38 @@
 #ifndef FS_LOG_H
 #define FS_LOG_H
 
+#include <atomic>
 #include <cstdint>
+#include <log_filter.h>
 #include <logger.h>
 #include <string_view>
+
+#ifndef FS_LOG_FORMAT
+#define FS_LOG_FORMAT "FAT32" ///< fformat() options for R0: (see fs_bench.h)
+#endif
+
 #ifdef __cplusplus
 
+struct FsReader; /*!< Opaque reader handle (cursor + buffer), see fs_log.cpp */
+
+/**
+ * @struct FsReplayControl
+ * @brief  Progress and control block for a replay of the log file to USB.
+ * @details Owned by the caller of FsLog::replayLogsToUsb(); the counters are
+ *          read and written concurrently, hence atomic. The scanner is set by
+ *          the owner before the replay starts and left untouched during it.
+ */
+struct FsReplayControl {
+  std::atomic_bool cancel = false;       /*!< Request to abort the replay */
+  std::atomic_uint32_t throttleMs = 0U;  /*!< Delay between chunks in ms */
+  std::atomic_uint32_t sent = 0U;        /*!< Bytes transferred so far */
+  std::atomic_uint32_t total = 0U;       /*!< Bytes to transfer */
+  std::atomic_uint32_t matched = 0U;     /*!< Bytes that passed the filter */
+  std::atomic_uint32_t acked = 0U;       /*!< Windowed replay: chunks below
+                                            this sequence number arrived */
+  const LogScanner *scanner = nullptr;   /*!< Optional line filter */
+};
+
 /**
  * @class FsLog
  * @brief Singleton class for file system logging.
@@ -29,8 +56,48 @@
  */
 class FsLog : public Logger {
 public:
+  static constexpr std::uint32_t FS_DATA_PACKET_SIZE =
+      256U; /*!< Reader buffer and USB chunk size */
+  static constexpr std::uint32_t FS_DUMP_BLOCK_SIZE =
+      1024U; /*!< Volume image bytes per dump block */
+  static constexpr std::uint32_t FS_DUMP_MAGIC =
+      0x42445346U; /*!< "FSDB": start of a dump block header */
+  static constexpr std::uint32_t FS_WINDOW_CHUNKS =
+      8U; /*!< Windowed replay: unacknowledged chunks in flight */
+  static constexpr std::uint32_t FS_CHUNK_MAGIC =
+      0x43525346U; /*!< "FSRC": start of a windowed replay chunk header */
+
+  /**
+   * @struct DumpBlockHeader
+   * @brief  Header in front of every binary block of `fs dump`.
+   * @details Little-endian; followed by `length` image bytes.
+   */
+  struct DumpBlockHeader {
+    std::uint32_t magic;  /*!< FS_DUMP_MAGIC */
+    std::uint32_t offset; /*!< Offset of the block in the image */
+    std::uint32_t length; /*!< Image bytes that follow */
+    std::uint32_t crc;    /*!< CRC-32 of those bytes */
+  };
+
+  /**
+   * @struct ReplayChunkHeader
+   * @brief  Header in front of every chunk of a windowed replay.
+   * @details Little-endian; followed by `length` bytes of log text. `next`
+   *          is the reader position after the chunk: once the host has
+   *          acknowledged the chunk, `fsLog get <next>` continues behind it.
+   */
+  struct ReplayChunkHeader {
+    std::uint32_t magic;  /*!< FS_CHUNK_MAGIC */
+    std::uint32_t seq;    /*!< Sequence number, acknowledged by the host */
+    std::uint32_t next;   /*!< Reader position after this chunk */
+    std::uint32_t length; /*!< Text bytes that follow */
+    std::uint32_t crc;    /*!< CRC-32 of those bytes */
+  };
+
   /** @brief Status codes for file system logger initialization */
   enum FsLogStatus : std::int8_t {
+    FS_TO_USB_PAUSED = 4,        /*!< Host stopped acknowledging */
+    FS_TO_USB_CANCELLED = 3,     /*!< Replay to USB cancelled */
     FS_NOT_INITIALIZED = 2,      /*!< Not initialized */
     FS_TO_USB_OK = 1,            /*!< Successfully replayed logs to USB */
     FS_INITIALIZED = 0,          /*!< Initialized */
@@ -53,17 +120,59 @@ public:
 
   void log(std::string_view msg) override; /*!< Log a message */
 
-  FsLog::FsLogStatus replayLogsToUsb(); /*!< Replay logs to USB */
+  FsLog::FsLogStatus
+  replayLogsToUsb(FsReplayControl *ctrl = nullptr); /*!< Replay logs to USB */
+  FsLog::FsLogStatus
+  replayLogsToUsb(FsReader *reader,
+                  FsReplayControl *ctrl = nullptr); /*!< Replay via reader */
+
+  FsLog::FsLogStatus
+  replayWindowToUsb(FsReader *reader,
+                    FsReplayControl *ctrl); /*!< Acknowledged replay */
+
+  FsLog::FsLogStatus
+  dumpToUsb(std::uint32_t offset,
+            FsReplayControl *ctrl = nullptr); /*!< Stream volume image */
+
+  FsReader *openReader(std::uint32_t offset = 0U); /*!< Get reader handle */
+  void closeReader(FsReader *reader);              /*!< Release handle */
+  std::uint32_t tellReader(const FsReader *reader) const; /*!< Position */
+  void seekReader(FsReader *reader,
+                  std::uint32_t position); /*!< Restore a position */
+
+  void follow(bool enable); /*!< Enable/disable follow mode */
+  bool isFollowing() const; /*!< Follow mode enabled */
+  std::uint32_t followRead(char *buf, std::uint32_t size,
+                           std::uint32_t timeout); /*!< Take new records */
+  std::uint32_t followDropped() const; /*!< Records lost while following */
+
+  std::uint32_t fsFreeBytes() const; /*!< Cached free space on the drive */
+
+  void crashDrain(); /*!< Fault context: move staged messages to CrashDump */
+
+  FsLog::FsLogStatus suspend(); /*!< Lend the drive out (messages staged) */
+  FsLog::FsLogStatus resume();  /*!< Reformat, take the drive back */
 
 private:
   FsLog();                                  /*!< Singleton */
   FsLog(const FsLog &) = delete;            /*!< Prevent copy construction */
   FsLog &operator=(const FsLog &) = delete; /*!< Prevent assignment */
   ~FsLog() = default;                       /*!< Default destructor */
-  FsLog::FsLogStatus fsLogsToUsb();         /*!< Logger thread function */
+  FsLog::FsLogStatus
+  fsLogsToUsb(FsReader *reader,
+              FsReplayControl *ctrl); /*!< Stream log file to USB */
+  void logsToFs(std::string_view msg); /*!< Append a message to the file */
+  void appendRecord(std::string_view msg); /*!< logsToFs(), mutex held */
+  std::int32_t fileAppend(std::string_view data); /*!< Write to the file */
+#ifdef FS_LOG_COMPRESS
+  void flushBlock(); /*!< Write the open block as a compressed frame */
+#endif
+  static void mountThreadWrapper(void *argument); /*!< Thread wrapper */
+  void mount(); /*!< Mount drive, flush staged messages */
+  void flushStaging(bool toFile); /*!< Staged messages to file or USB */
 
-  FsLogStatus fsInit = FsLogStatus::FS_NOT_INITIALIZED; /*!< Initialization
-                                          status of the file system logger */
+  std::atomic<FsLogStatus> fsInit = FsLogStatus::FS_NOT_INITIALIZED; /*!<
+                    Initialization status of the file system logger */
 };
 
 extern "C" {
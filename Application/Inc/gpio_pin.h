@@ -0,0 +1,171 @@
+/**
+ * @file gpio_pin.h
+ * @brief GPIO pins bound at compile time, written through BSRR
+ * @author Mitul Goti
+ * @version 1.0
+ * @date 2025-10-12
+ * @ingroup led
+ * @{
+ * @details
+ * This file declares GpioPin and GpioGroup, which resolve the port and bit
+ * of a pin number (port * 16 + pin, the Driver_GPIO0 numbering) at compile
+ * time, and GpioBatch, which collects changes of pins known only at run
+ * time. Every write is one store to the port's bit set/reset register
+ * (BSRR), so the pins of a group or batch on one port change together and
+ * no read-modify-write of ODR can lose an update made by another thread.
+ * Tools/gpio_pin builds this against a mock register file.
+ */
+
+#ifndef GPIO_PIN_H
+#define GPIO_PIN_H
+
+#include "stm32f4xx.h" // IWYU pragma: keep
+#include <array>
+#include <cstdint>
+
+#ifdef __cplusplus
+
+constexpr std::uint32_t GPIO_PORTS = 9U;         ///< GPIOA..GPIOI
+constexpr std::uint32_t GPIO_PORT_PINS = 16U;    ///< Pins per port
+constexpr std::uint32_t GPIO_BSRR_RESET = 16U;   ///< BRy = BSy << 16
+
+/// Port registers for a port index known at compile time (0 = GPIOA)
+template <std::uint32_t Port> inline GPIO_TypeDef *gpioPort() {
+  static_assert(Port < GPIO_PORTS, "No such GPIO port");
+  if constexpr (Port == 0U) {
+    return GPIOA;
+  } else if constexpr (Port == 1U) {
+    return GPIOB;
+  } else if constexpr (Port == 2U) {
+    return GPIOC;
+  } else if constexpr (Port == 3U) {
+    return GPIOD;
+  } else if constexpr (Port == 4U) {
+    return GPIOE;
+  } else if constexpr (Port == 5U) {
+    return GPIOF;
+  } else if constexpr (Port == 6U) {
+    return GPIOG;
+  } else if constexpr (Port == 7U) {
+    return GPIOH;
+  } else {
+    return GPIOI;
+  }
+}
+
+/// Port registers for a port index known at run time; nullptr if none
+GPIO_TypeDef *gpioPort(std::uint32_t port);
+
+/// Bit of a pin number within its port
+constexpr std::uint32_t gpioMask(std::uint32_t pin) {
+  return 1U << (pin % GPIO_PORT_PINS);
+}
+
+/// BSRR value that drives the pins of mask high or low
+constexpr std::uint32_t gpioBsrr(std::uint32_t mask, bool high) {
+  return high ? mask : (mask << GPIO_BSRR_RESET);
+}
+
+/// Drive a pin known at run time (one BSRR store); false if no such port
+bool gpioWrite(std::uint32_t pin, bool high);
+
+/// Output latch of a pin known at run time; false if no such port
+bool gpioIsSet(std::uint32_t pin);
+
+/**
+ * @class GpioPin
+ * @brief One output pin, port and bit fixed at compile time
+ * @tparam Number Pin number, port * 16 + pin (60 = PD12)
+ */
+template <std::uint32_t Number> class GpioPin {
+public:
+  static constexpr std::uint32_t PORT = Number / GPIO_PORT_PINS; ///< Port
+  static constexpr std::uint32_t MASK = gpioMask(Number); ///< Port bit
+  static_assert(PORT < GPIO_PORTS, "No such GPIO port");
+
+  static GPIO_TypeDef *port() { return gpioPort<PORT>(); }
+  static void set() { port()->BSRR = MASK; }                     ///< High
+  static void clear() { port()->BSRR = MASK << GPIO_BSRR_RESET; } ///< Low
+  static void write(bool high) { port()->BSRR = gpioBsrr(MASK, high); }
+  /// Invert the output latch (one load of ODR, one store to BSRR)
+  static void toggle() { write((port()->ODR & MASK) == 0U); }
+  static bool isSet() { return (port()->ODR & MASK) != 0U; } ///< Latch
+  static bool read() { return (port()->IDR & MASK) != 0U; }  ///< Input
+};
+
+/**
+ * @class GpioGroup
+ * @brief Pins of one port written together in a single BSRR store
+ * @tparam Pins GpioPin types; bit i of write()/read() values is Pins[i]
+ */
+template <typename... Pins> class GpioGroup {
+public:
+  static_assert(sizeof...(Pins) > 0U, "Empty GPIO group");
+  static constexpr std::uint32_t PORT =
+      std::array<std::uint32_t, sizeof...(Pins)>{Pins::PORT...}[0];
+  static_assert(((Pins::PORT == PORT) && ...), "A group is on one port");
+  static constexpr std::uint32_t MASK = (Pins::MASK | ...); ///< Port bits
+  static_assert((Pins::MASK + ...) == MASK, "Pin listed twice");
+
+  static GPIO_TypeDef *port() { return gpioPort<PORT>(); }
+  static void set() { port()->BSRR = MASK; }                     ///< All high
+  static void clear() { port()->BSRR = MASK << GPIO_BSRR_RESET; } ///< All low
+
+  /// Set every pin: bit i of values drives the i-th pin of the group
+  static void write(std::uint32_t values) { writePort(toPort(values)); }
+
+  /// Set every pin from a value in port bit positions
+  static void writePort(std::uint32_t high) {
+    port()->BSRR =
+        (high & MASK) | ((~high & MASK) << GPIO_BSRR_RESET);
+  }
+
+  /// Invert all pins of the group at once
+  static void toggle() { writePort(~port()->ODR); }
+
+  /// Output latches, bit i for the i-th pin
+  static std::uint32_t isSet() { return fromPort(port()->ODR); }
+
+  /// Pin inputs, bit i for the i-th pin
+  static std::uint32_t read() { return fromPort(port()->IDR); }
+
+private:
+  static std::uint32_t toPort(std::uint32_t values) {
+    std::uint32_t high = 0U;
+    std::uint32_t bit = 1U;
+    ((high |= ((values & bit) != 0U) ? Pins::MASK : 0U, bit <<= 1U), ...);
+    return high;
+  }
+  static std::uint32_t fromPort(std::uint32_t reg) {
+    std::uint32_t values = 0U;
+    std::uint32_t bit = 1U;
+    ((values |= ((reg & Pins::MASK) != 0U) ? bit : 0U, bit <<= 1U), ...);
+    return values;
+  }
+};
+
+/**
+ * @class GpioBatch
+ * @brief Pin changes collected at run time, one BSRR store per port
+ * @details Not thread-safe: one batch belongs to one thread.
+ */
+class GpioBatch {
+public:
+  bool write(std::uint32_t pin, bool high); ///< Stage; false: no such pin
+  void commit();                            ///< Store and clear the batch
+  bool empty() const { return touched == 0U; }
+
+private:
+  std::array<std::uint32_t, GPIO_PORTS> bsrr{}; ///< Staged BSRR per port
+  std::uint32_t touched = 0U;                   ///< Ports with changes
+};
+
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif    // GPIO_PIN_H
+/** @} */ // end of led
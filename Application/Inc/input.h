@@ -0,0 +1,103 @@
+/**
+ * @file input.h
+ * @brief Input dispatcher: button edges to gesture subscribers
+ * @author Mitul Goti
+ * @version 1.0
+ * @date 2025-10-14
+ * @ingroup input
+ * @{
+ * @details
+ * This file declares InputDispatcher, the singleton that owns the user
+ * button. The EXTI callback posts timestamped edges into a queue; a
+ * dedicated thread debounces them with ButtonGesture and calls the
+ * handlers subscribed to each gesture. No LED thread waits on the button.
+ */
+
+#ifndef INPUT_H
+#define INPUT_H
+
+#include "button_gesture.h"
+#include <array>
+#include <atomic>
+#include <cmsis_os2.h>
+#include <cstddef>
+#include <cstdint>
+
+#ifdef __cplusplus
+
+/**
+ * @class InputDispatcher
+ * @brief Singleton thread turning button edges into gesture callbacks
+ * @details Edges are posted from the GPIO interrupt with a zero timeout.
+ *          The thread runs above the LED threads and sleeps on the queue
+ *          with a timeout that ends at the next debounce or gesture
+ *          deadline, so a press reaches its subscribers within the tick it
+ *          happened in. Handlers run on this thread and must not block.
+ */
+class InputDispatcher {
+public:
+  using Gesture = ButtonGesture::Gesture;
+  /// Called on the input thread for a subscribed gesture
+  using Handler = void (*)(void *context, Gesture g, std::uint32_t tick);
+
+  static constexpr std::size_t MAX_SUBSCRIBERS = 8U; ///< Subscription slots
+
+  static InputDispatcher &getInstance(); /*!< Get singleton instance */
+
+  /// Create the edge queue and the thread for the button on pin
+  void init(std::uint32_t pin, bool activeHigh = true);
+
+  /// Call fn for every g from now on; false if all slots are taken
+  bool subscribe(Gesture g, Handler fn, void *context);
+
+  /// GPIO interrupt: an edge on pin (ISR-safe, never blocks)
+  void edgeFromIsr(std::uint32_t pin);
+
+  /// Gestures of one kind reported since start
+  std::uint32_t getCount(Gesture g) const {
+    return counts[static_cast<std::size_t>(g)].load();
+  }
+  std::uint32_t getDropped() const { return dropped.load(); } ///< Queue full
+  /// Longest time from an edge to its handling, in ticks
+  std::uint32_t getWorstLatency() const { return worstLatency.load(); }
+
+  osThreadId_t getThreadId() const { return threadId; } /*!< Get thread ID */
+
+private:
+  /// Handler of one gesture
+  struct Subscriber {
+    Gesture gesture = Gesture::PRESS; ///< Gesture it waits for
+    Handler fn = nullptr;             ///< Callback
+    void *context = nullptr;          ///< Passed to the callback
+  };
+
+  InputDispatcher();                                  /*!< Singleton */
+  InputDispatcher(const InputDispatcher &) = delete;  /*!< Prevent copy */
+  InputDispatcher &operator=(const InputDispatcher &) = delete;
+  static void threadWrapper(void *argument);          /*!< Thread wrapper */
+  static void emitWrapper(void *context, Gesture g, std::uint32_t tick);
+  void run();                                   /*!< Dispatcher thread loop */
+  void publish(Gesture g, std::uint32_t tick);  /*!< Count, call, log */
+  bool level() const;                           /*!< Pin level, true: pressed */
+
+  ButtonGesture gesture;               ///< Owned by the input thread
+  std::array<Subscriber, MAX_SUBSCRIBERS> subscribers{}; ///< Handlers
+  std::atomic<std::size_t> subscriberCount = 0U;         ///< Slots in use
+  std::array<std::atomic_uint32_t, ButtonGesture::GESTURES> counts{};
+  std::atomic_uint32_t dropped = 0U;      ///< Edges lost to a full queue
+  std::atomic_bool resync = false;        ///< Re-read the pin (edge lost)
+  std::atomic_uint32_t worstLatency = 0U; ///< Edge to handling, ticks
+  std::uint32_t pin = 0U;                 ///< Button pin (port * 16 + pin)
+  bool activeHigh = true;                 ///< Pressed reads as high
+  osThreadId_t threadId = nullptr;        ///< RTOS thread ID
+};
+
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif    // INPUT_H
+/** @} */ // end of input
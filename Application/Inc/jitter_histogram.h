@@ -0,0 +1,73 @@
+/**
+ * @file jitter_histogram.h
+ * @brief Fixed-memory histogram of edge timing errors
+ * @author Mitul Goti
+ * @version 1.0
+ * @date 2025-10-15
+ * @ingroup led_thread
+ * @{
+ * @details
+ * This file declares JitterHistogram, which counts how late an output edge
+ * came against its ideal time in power-of-two microsecond buckets. It has
+ * no RTOS or hardware dependency; the caller passes the error.
+ */
+
+#ifndef JITTER_HISTOGRAM_H
+#define JITTER_HISTOGRAM_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#ifdef __cplusplus
+
+/**
+ * @class JitterHistogram
+ * @brief Edge error counts in log2 buckets, plus the extremes
+ * @details Bucket 0 counts early edges, bucket 1 errors below 1 us and
+ *          bucket k (k >= 2) errors from 2^(k-2) up to 2^(k-1) us; the
+ *          last bucket takes everything from 8.192 ms up. One thread
+ *          records, any thread may read: every field is a lock-free word,
+ *          so a reader sees each count whole, though not all of them from
+ *          the same instant.
+ */
+class JitterHistogram {
+public:
+  static constexpr std::uint32_t BUCKETS = 16U; ///< 64 bytes of counts
+
+  /// Count one edge that came errorUs after its ideal time
+  void record(std::int32_t errorUs);
+
+  void reset(); ///< Clear every count
+
+  /// Edges counted in bucket i
+  std::uint32_t bucket(std::uint32_t i) const { return bins[i].load(); }
+  std::uint32_t count() const;                    ///< Edges counted
+  std::int32_t earliest() const { return minUs.load(); } ///< Smallest error
+  std::int32_t latest() const { return maxUs.load(); }   ///< Largest error
+
+  /// Bucket an error falls into
+  static std::uint32_t bucketOf(std::int32_t errorUs);
+
+  /// Upper bound of bucket i in us (exclusive), 0 for the last bucket
+  static std::uint32_t bucketLimitUs(std::uint32_t i);
+
+  /// Error in us between two readings of a wrapping counter
+  static std::int32_t errorUs(std::uint32_t actual, std::uint32_t ideal,
+                              std::uint32_t countsPerUs);
+
+private:
+  std::array<std::atomic_uint32_t, BUCKETS> bins{}; ///< Counts per bucket
+  std::atomic<std::int32_t> minUs{INT32_MAX};       ///< Smallest error
+  std::atomic<std::int32_t> maxUs{INT32_MIN};       ///< Largest error
+};
+
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif    // JITTER_HISTOGRAM_H
+/** @} */ // end of led_thread
@@ -16,15 +16,21 @@
 
 #ifdef __cplusplus
 
+class GpioBatch;
+class LedPwm;
+
 /**
  * @class Led
  * @brief Base class for controlling an LED on a GPIO pin
  *
  * Provides the basic toggle functionality. Threading logic is implemented in
- * derived classes.
+ * derived classes. With a LedPwm attached, the TIM4 pins (PD12..PD15) are
+ * driven by the timer instead of GPIO writes.
  */
 class Led {
 private:
+  LedPwm *pwm = nullptr; /*!< TIM4 backend, attached once at start-up */
+
 public:
   static Led &getInstance() {
     static Led instance; // Guaranteed to be destroyed.
@@ -35,6 +41,11 @@ public:
   void on(uint32_t pin);     /*!< Turn on LED */
   void off(uint32_t pin);    /*!< Turn off LED */
   void toggle(uint32_t pin); /*!< Toggle LED state */
+  void stage(GpioBatch &batch, uint32_t pin, bool lit); /*!< Batched on/off */
+
+  void attach(LedPwm *driver);                 /*!< Use PWM for TIM4 pins */
+  LedPwm *getPwm() const { return pwm; }       /*!< nullptr without PWM */
+  bool setLevel(uint32_t pin, uint8_t level);  /*!< Brightness (PWM pins) */
 };
 
 extern "C" {
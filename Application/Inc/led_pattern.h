@@ -0,0 +1,206 @@
+/**
+ * @file led_pattern.h
+ * @brief Bytecode LED patterns: compiler and interpreter
+ * @author Mitul Goti
+ * @version 1.0
+ * @date 2025-10-10
+ * @ingroup led_thread
+ * @{
+ * @details
+ * This file declares LedPattern: a compact pattern language, a constexpr
+ * compiler that turns it into bytecode (at build time for the built-in
+ * patterns, at run time for patterns sent over USB) and the interpreter
+ * the LED scheduler runs for every channel.
+ *
+ * Pattern text is a list of tokens separated by spaces:
+ * | Token   | Meaning                                        |
+ * |---------|------------------------------------------------|
+ * | on, off, tog | Switch the LED                            |
+ * | <ms>    | Wait 1-65535 ms                                |
+ * | t       | Wait the LED's on-time (own, else shared)      |
+ * | n[ ... ] | Repeat the body n times (1-255), two levels   |
+ * | [ ... ] | Repeat the body forever                        |
+ * | halt    | Stop; the LED keeps its state                  |
+ * The program starts over when it reaches its end.
+ * Example (SOS): "3[on 150 off 150] 3[on 450 off 150] 3[on 150 off 150] 900"
+ */
+
+#ifndef LED_PATTERN_H
+#define LED_PATTERN_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#ifdef __cplusplus
+
+/**
+ * @class LedPattern
+ * @brief Pattern compiler, interpreter and built-in pattern table
+ */
+class LedPattern {
+public:
+  /// Bytecode operations
+  enum Op : std::uint8_t {
+    OP_ON = 0x01U,     ///< LED on
+    OP_OFF = 0x02U,    ///< LED off
+    OP_TOGGLE = 0x03U, ///< Invert the LED
+    OP_WAIT8 = 0x04U,  ///< Wait, 1 byte of ms follows
+    OP_WAIT16 = 0x05U, ///< Wait, 2 bytes of ms follow (little endian)
+    OP_WAIT_T = 0x06U, ///< Wait the LED's on-time
+    OP_LOOP = 0x07U,   ///< Loop start, 1 byte count follows (0: forever)
+    OP_NEXT = 0x08U,   ///< Loop end
+    OP_HALT = 0x09U,   ///< Stop
+  };
+
+  static constexpr std::size_t MAX_DEPTH = 2U;  ///< Loop nesting
+  static constexpr std::uint32_t MAX_OPS = 64U; ///< Operations per step()
+  static constexpr std::uint32_t HALT = 0xFFFFFFFFU;    ///< step(): stopped
+  static constexpr std::uint32_t RUNAWAY = 0xFFFFFFFEU; ///< step(): no wait
+
+  /// Interpreter state of one LED
+  struct State {
+    /// Active loop
+    struct Loop {
+      std::uint16_t start = 0U; ///< First operation of the body
+      std::uint8_t left = 0U;   ///< Passes left, 0: forever
+    };
+    std::uint16_t pc = 0U;                 ///< Next operation
+    std::uint8_t depth = 0U;               ///< Active loops
+    bool lit = false;                      ///< LED state the program set
+    std::array<Loop, MAX_DEPTH> loops{};   ///< Loop stack
+  };
+
+  /// Compiled program of at most N bytes
+  template <std::size_t N> struct Code {
+    std::array<std::uint8_t, N> bytes{}; ///< Bytecode
+    std::uint16_t size = 0U;             ///< Bytes used
+    std::uint16_t error = 0U; ///< 0: ok, else 1 + offset of the bad token
+    constexpr bool ok() const { return error == 0U; }
+  };
+
+  /// Built-in pattern in flash
+  struct Builtin {
+    const char *name;          ///< Name used by the USB command
+    const std::uint8_t *code;  ///< Bytecode
+    std::uint16_t size;        ///< Bytes of bytecode
+  };
+
+  /** @brief Compile pattern text.
+   * @tparam N Largest program accepted.
+   * @param text Pattern text (see the file description).
+   * @return Bytecode, or error set to the column of the first bad token
+   *         (one past the end for unbalanced brackets or no wait at all).
+   */
+  template <std::size_t N>
+  static constexpr Code<N> compile(std::string_view text) {
+    Code<N> out{};
+    std::size_t depth = 0U;
+    bool waits = false;
+    bool halts = false;
+    auto emit = [&out](std::uint32_t byte) {
+      if (out.size >= N) {
+        return false;
+      }
+      out.bytes[out.size++] = static_cast<std::uint8_t>(byte);
+      return true;
+    };
+    auto fail = [&out](std::size_t at) {
+      out.size = 0U;
+      out.error = static_cast<std::uint16_t>(at + 1U);
+      return out;
+    };
+    std::size_t i = 0U;
+    while (i < text.size()) {
+      const std::size_t at = i;
+      const char c = text[i];
+      bool ok = true;
+      if (c == ' ') {
+        i++;
+        continue;
+      }
+      if (c >= '0' && c <= '9') {
+        std::uint32_t n = 0U;
+        while (i < text.size() && text[i] >= '0' && text[i] <= '9') {
+          n = (n > 0xFFFFU) ? n : (n * 10U + (text[i] - '0'));
+          i++;
+        }
+        if (i < text.size() && text[i] == '[') {
+          i++;
+          ok = n >= 1U && n <= 0xFFU && depth < MAX_DEPTH && emit(OP_LOOP) &&
+               emit(n);
+          depth++;
+        } else if (n >= 1U && n <= 0xFFU) {
+          ok = emit(OP_WAIT8) && emit(n);
+          waits = true;
+        } else {
+          ok = n >= 1U && n <= 0xFFFFU && emit(OP_WAIT16) &&
+               emit(n & 0xFFU) && emit(n >> 8);
+          waits = true;
+        }
+      } else if (c == '[') {
+        i++;
+        ok = depth < MAX_DEPTH && emit(OP_LOOP) && emit(0U);
+        depth++;
+      } else if (c == ']') {
+        i++;
+        ok = depth > 0U && emit(OP_NEXT);
+        depth = (depth > 0U) ? (depth - 1U) : 0U;
+      } else {
+        while (i < text.size() && text[i] >= 'a' && text[i] <= 'z') {
+          i++;
+        }
+        const std::string_view word = text.substr(at, i - at);
+        if (word == "on") {
+          ok = emit(OP_ON);
+        } else if (word == "off") {
+          ok = emit(OP_OFF);
+        } else if (word == "tog") {
+          ok = emit(OP_TOGGLE);
+        } else if (word == "t") {
+          ok = emit(OP_WAIT_T);
+          waits = true;
+        } else if (word == "halt") {
+          ok = emit(OP_HALT);
+          halts = true;
+        } else {
+          ok = false;
+        }
+      }
+      if (!ok) {
+        return fail(at);
+      }
+    }
+    if (depth != 0U || (!waits && !halts)) {
+      return fail(text.size());
+    }
+    return out;
+  }
+
+  /** @brief Run a program up to its next wait.
+   * @param code Bytecode.
+   * @param size Bytes of bytecode.
+   * @param s Interpreter state, lit holds the LED state to show.
+   * @param sharedMs On-time of the LED for 't'.
+   * @return Milliseconds until the next step(), HALT or RUNAWAY.
+   */
+  static std::uint32_t step(const std::uint8_t *code, std::size_t size,
+                            State &s, std::uint32_t sharedMs);
+
+  /// Built-in pattern by name, nullptr if unknown
+  static const Builtin *find(std::string_view name);
+
+  /// Built-in pattern table; count receives the number of entries
+  static const Builtin *builtins(std::size_t &count);
+};
+
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif    // LED_PATTERN_H
+/** @} */ // end of led_thread
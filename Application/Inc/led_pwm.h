@@ -0,0 +1,92 @@
+/**
+ * @file led_pwm.h
+ * @brief TIM4 PWM driver for the four Discovery board LEDs
+ * @author Mitul Goti
+ * @version 1.0
+ * @date 2025-10-11
+ * @ingroup led
+ * @{
+ * @details
+ * This file declares LedPwm: the LEDs on PD12..PD15 are TIM4 CH1..CH4
+ * (alternate function 2), so the timer can drive them. In dim mode the
+ * timer runs a 1 kHz PWM and each LED has a brightness; in blink mode it
+ * runs a slow timebase and blinks the LEDs by itself. Either way the CPU
+ * only writes compare registers. The driver is written against the device
+ * header; Tools/led_pwm builds it against a mock register file.
+ */
+
+#ifndef LED_PWM_H
+#define LED_PWM_H
+
+#include <array>
+#include <cstdint>
+
+#ifdef __cplusplus
+
+/**
+ * @class LedPwm
+ * @brief Register-level TIM4 PWM for PD12..PD15
+ * @details Not thread-safe: one thread (the LED scheduler) switches modes;
+ *          level changes from other threads are single register writes.
+ */
+class LedPwm {
+public:
+  static constexpr std::uint32_t CHANNELS = 4U;   ///< TIM4 CH1..CH4
+  static constexpr std::uint32_t FIRST_PIN = 60U; ///< GPIO number of PD12
+  static constexpr std::uint32_t PWM_HZ = 1000U;  ///< Dim mode frequency
+  static constexpr std::uint32_t PWM_STEPS = 1000U; ///< Dim mode resolution
+  static constexpr std::uint32_t BLINK_TICK_HZ = 10000U; ///< Blink timebase
+  static constexpr std::uint32_t BLINK_PERIOD_MAX_MS =
+      0x10000U / (BLINK_TICK_HZ / 1000U); ///< 16-bit ARR limit
+  static constexpr std::uint8_t LEVEL_MAX = 255U; ///< Full brightness
+
+  /// What the timer generates
+  enum class Mode : std::uint8_t {
+    DIM = 0,   ///< 1 kHz PWM; LEDs on at their level, or off
+    BLINK = 1, ///< Slow timebase; the timer blinks the LEDs
+  };
+
+  bool init(); ///< Clocks, pins to TIM4, dim mode, all LEDs off
+
+  /// TIM4 channel of a GPIO pin number; false for other pins
+  bool channel(std::uint32_t pin, std::uint32_t &ch) const;
+
+  void on(std::uint32_t ch);     ///< Light at the channel's level
+  void off(std::uint32_t ch);    ///< Dark
+  void toggle(std::uint32_t ch); ///< Invert
+  bool isOn(std::uint32_t ch) const { return lit[ch]; }
+
+  void setLevel(std::uint32_t ch, std::uint8_t lvl); ///< Brightness when on
+  std::uint8_t getLevel(std::uint32_t ch) const { return level[ch]; }
+
+  /// Switch to blink mode with a shared period; all LEDs dark
+  bool blink(std::uint32_t periodMs);
+  /// Blink a channel: on for onMs at the start (or end, late) of the period
+  bool setBlink(std::uint32_t ch, std::uint32_t onMs, bool late);
+  void dim(); ///< Back to dim mode, LEDs as on()/off() left them
+
+  Mode getMode() const { return mode; }
+
+private:
+  std::uint32_t timerClock() const;   ///< TIM4 kernel clock in Hz
+  void timebase(std::uint32_t hz, std::uint32_t steps);
+  void output(std::uint32_t ch, std::uint32_t ocMode, std::uint32_t compare);
+  std::uint32_t duty(std::uint32_t ch) const; ///< Dim mode compare value
+
+  std::array<std::uint8_t, CHANNELS> level{
+      LEVEL_MAX, LEVEL_MAX, LEVEL_MAX, LEVEL_MAX}; ///< Brightness when on
+  std::array<bool, CHANNELS> lit{};                ///< On in dim mode
+  std::uint32_t periodMs = 0U;                     ///< Blink period
+  Mode mode = Mode::DIM;                           ///< Current mode
+  bool ready = false;                              ///< init() succeeded
+};
+
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif    // LED_PWM_H
+/** @} */ // end of led
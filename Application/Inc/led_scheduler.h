@@ -0,0 +1,186 @@
+/**
+ * @file led_scheduler.h
+ * @brief All LED channels served by one thread from a timer wheel
+ * @author Mitul Goti
+ * @version 1.0
+ * @date 2025-10-09
+ * @ingroup led_thread
+ * @{
+ * @details
+ * This file declares the LedScheduler singleton. It replaces the thread per
+ * LED of LedThread with one thread that sleeps until the next LED deadline
+ * in a TimerWheel, so adding an LED costs a few bytes instead of a stack.
+ * In the PATTERN policy every LED runs its own LedPattern program.
+ */
+
+#ifndef LED_SCHEDULER_H
+#define LED_SCHEDULER_H
+
+#include "cmsis_os2.h"
+#include "gpio_pin.h"
+#include "jitter_histogram.h"
+#include "led_pattern.h"
+#include "led_thread.h"
+#include "timer_wheel.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#ifdef __cplusplus
+
+/**
+ * @class LedScheduler
+ * @brief Singleton LED scheduler on a hashed timer wheel
+ * @details Channels are registered with add() before init(). Their timing
+ *          follows the policy: ROUND_ROBIN lights one LED at a time in turn
+ *          (the order LedThread's shared semaphore gives), FREE_RUNNING
+ *          blinks every LED on its own on/off period, PATTERN runs a
+ *          bytecode program per LED, HARDWARE leaves the blinking to the
+ *          TIM4 PWM backend (LED_PWM builds).
+ */
+class LedScheduler {
+public:
+  static constexpr std::uint32_t MAX_CHANNELS =
+      TimerWheel::MAX_TIMERS; ///< LEDs one scheduler can drive
+  static constexpr std::size_t UPLOAD_SLOTS = 4U; ///< Uploaded programs
+  static constexpr std::size_t UPLOAD_SIZE = 64U; ///< Bytes per upload
+
+  /// How the channels share time
+  enum class Policy : std::uint8_t {
+    ROUND_ROBIN = 0,  ///< One LED lit at a time, in registration order
+    FREE_RUNNING = 1, ///< Each LED blinks on its own period
+    PATTERN = 2,      ///< Each LED runs its pattern program
+    HARDWARE = 3,     ///< TIM4 blinks the LEDs, the thread idles
+  };
+
+  /// Result of setPattern()
+  enum PatternStatus : std::int8_t {
+    PATTERN_OK = 0,       ///< Queued for the scheduler thread
+    PATTERN_NO_LED = -1,  ///< No channel of that name
+    PATTERN_UNKNOWN = -2, ///< No built-in pattern of that name
+    PATTERN_SYNTAX = -3,  ///< Pattern text does not compile
+    PATTERN_BUSY = -4,    ///< Not started or request queue full
+  };
+
+  static LedScheduler &getInstance(); ///< Get singleton instance
+
+  /// Register an LED; 0 ms selects the shared LedThread on-time.
+  /// Returns the channel index, -1 when full or already started.
+  int add(const char *name, std::uint32_t pin, std::uint32_t onMs = 0U,
+          std::uint32_t offMs = 0U);
+
+  void init(); ///< Start the scheduler thread
+
+  void setPolicy(Policy p); ///< Switch policy, restarts the pattern
+  Policy getPolicy() const { return policy.load(); }
+
+  /// Give an LED ("all" for every LED) a built-in pattern by name, or
+  /// compiled pattern text given as "= <text>"; selects PATTERN.
+  /// errorAt receives the column of a syntax error (1-based).
+  PatternStatus setPattern(std::string_view led, std::string_view spec,
+                           std::size_t *errorAt = nullptr);
+
+  int find(std::string_view name) const; ///< Channel index, -1 if none
+
+  /// On/off time of an LED, changed at run time; nullptr if no such LED
+  LedTiming *timing(std::string_view name);
+
+  /// Brightness of an LED ("all" for every LED); false without PWM
+  bool setLevel(std::string_view led, std::uint8_t level);
+
+  osThreadId_t getThreadId() const { return threadId; }
+  std::uint32_t channelCount() const { return count; }
+
+  /// Name of channel id (id < channelCount())
+  const char *getName(std::uint32_t id) const { return channels[id].name; }
+
+  /// Errors of an LED's edges against its wheel deadlines
+  const JitterHistogram &getOnJitter(std::uint32_t id) const {
+    return channels[id].onJitter;
+  }
+  const JitterHistogram &getOffJitter(std::uint32_t id) const {
+    return channels[id].offJitter;
+  }
+  /// Deadlines of an LED restarted from now
+  std::uint32_t getSlips(std::uint32_t id) const {
+    return channels[id].slips.load();
+  }
+  void resetJitter(std::uint32_t id); ///< Clear an LED's histograms, slips
+
+private:
+  LedScheduler() = default;
+  LedScheduler(const LedScheduler &) = delete;
+  LedScheduler &operator=(const LedScheduler &) = delete;
+
+  /// One LED
+  struct Channel {
+    const char *name = nullptr; ///< Name used in log records
+    std::uint32_t pin = 0U;     ///< GPIO pin
+    LedTiming timing;           ///< On time (0: shared), off time (0: on)
+    bool lit = false;           ///< LED currently on
+    std::uint16_t size = 0U;    ///< Bytes of the pattern program
+    const std::uint8_t *code = nullptr; ///< Pattern program
+    LedPattern::State vm{};     ///< Pattern interpreter state
+    JitterHistogram onJitter;   ///< Switch-on edge errors
+    JitterHistogram offJitter;  ///< Switch-off edge errors
+    std::atomic_uint32_t slips{0U}; ///< Deadlines restarted from now
+  };
+
+  /// LED change staged for the next GPIO commit
+  struct Edge {
+    std::uint32_t due = 0U; ///< Wheel deadline it belongs to
+    std::uint16_t id = 0U;  ///< Channel switched
+    bool on = false;        ///< Switches the LED on
+  };
+
+  /// Pattern change posted to the scheduler thread
+  struct PatternRequest {
+    std::int16_t channel = -1;             ///< Channel, -1: all
+    std::uint16_t size = 0U;               ///< Bytes of code
+    const std::uint8_t *builtin = nullptr; ///< Flash code or nullptr
+    std::array<std::uint8_t, UPLOAD_SIZE> code{}; ///< Uploaded code
+  };
+
+  static void threadWrapper(void *argument);
+  static void fireWrapper(void *context, std::uint16_t id);
+  void run();
+  void restart(std::uint32_t now); ///< All off, arm the policy's timers
+  bool hardwareBlink();            ///< Program TIM4 for HARDWARE
+  void fire(std::uint16_t id);     ///< A channel timer expired
+  void light(std::uint16_t id, bool on);
+  void logOn(std::uint16_t id) const; ///< "Event: LED ... ON" record
+  void applyPatterns();               ///< Drain the request queue
+  void apply(const PatternRequest &req);
+  std::uint32_t onTime(std::uint16_t id) const;
+  std::uint32_t offTime(std::uint16_t id) const;
+  /// Arm a channel period after due, or after now if that is past
+  void rearm(std::uint16_t id, std::uint32_t due, std::uint32_t period,
+             std::uint32_t now);
+  /// Note an edge staged this tick
+  void edge(std::uint16_t id, std::uint32_t due, bool on);
+  void recordEdges(); ///< Measure the edges just committed
+
+  std::array<Channel, MAX_CHANNELS> channels{}; ///< Registered LEDs
+  std::array<std::array<std::uint8_t, UPLOAD_SIZE>, UPLOAD_SLOTS>
+      uploads{}; ///< Uploaded programs (scheduler thread only)
+  std::uint32_t count = 0U;                     ///< Channels in use
+  TimerWheel wheel;                   ///< Channel deadlines (thread only)
+  GpioBatch gpio;                     ///< LED changes of one tick
+  std::array<Edge, MAX_CHANNELS> edges{}; ///< Staged this tick
+  std::uint32_t edgeCount = 0U;       ///< Entries in edges
+  std::atomic<Policy> policy = Policy::ROUND_ROBIN; ///< Active policy
+  osThreadId_t threadId = nullptr;    ///< Scheduler thread
+  osMessageQueueId_t patternQueue = nullptr; ///< Pending pattern changes
+};
+
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif    // LED_SCHEDULER_H
+/** @} */ // end of led_thread
@@ -14,6 +14,9 @@
 /* includes
  * --------------------------------------------------------------------------*/
 #include "cmsis_os2.h"
+#include "jitter_histogram.h"
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <string_view>
 
@@ -21,21 +24,67 @@
 
 #define LED_ON_TIME_MIN 100U  ///< Minimum LED on-time in ms
 #define LED_ON_TIME_MAX 2000U ///< Maximum LED on-time in ms
+#define LED_TIME_MAX 0xFFFFU  ///< Longest per-LED on or off time in ms
+
+/**
+ * @class LedTiming
+ * @brief On and off time of one LED, published as one atomic word
+ *
+ * Both times share a 32-bit word, so a writer (the USB thread) replaces
+ * them with one store and a reader takes a snapshot with one load: it
+ * never sees the on-time of one update with the off-time of another, and
+ * neither side ever waits. A time of 0 selects the default.
+ */
+class LedTiming {
+public:
+  /// Snapshot of the times
+  struct Times {
+    uint16_t onMs = 0U;  ///< On time, 0: shared on-time
+    uint16_t offMs = 0U; ///< Off time, 0: policy default
+  };
+
+  void set(Times t) { word.store(pack(t), std::memory_order_release); }
+  Times get() const { return unpack(word.load(std::memory_order_acquire)); }
+
+private:
+  static constexpr uint32_t pack(Times t) {
+    return t.onMs | (static_cast<uint32_t>(t.offMs) << 16U);
+  }
+  static constexpr Times unpack(uint32_t w) {
+    return Times{static_cast<uint16_t>(w), static_cast<uint16_t>(w >> 16U)};
+  }
+  static_assert(std::atomic<uint32_t>::is_always_lock_free,
+                "LED timing must be a lock-free word");
+
+  std::atomic<uint32_t> word{0U}; ///< offMs << 16 | onMs
+};
 
 /**
  * @class LedThread
  * @brief RTOS-threaded LED controller class
  *
  * Controls an LED using a dedicated RTOS thread. Provides static methods to
- * adjust the LED on-time within defined limits. Uses a semaphore for
- * synchronized access.
+ * adjust the shared LED on-time within defined limits, and per-LED times
+ * (LedTiming) that the thread reads once per cycle. Uses a semaphore for
+ * synchronized access. Edges are scheduled on absolute ticks and their
+ * error against the ideal time is kept in two JitterHistograms.
  */
 class LedThread {
+public:
+  static constexpr uint32_t MAX_LEDS = 8U; ///< LED threads find() knows
+
 private:
   uint32_t pin; ///< GPIO pin associated with this LED
   static void thread_entry(void *argument);
 
-  static uint32_t onTime;           ///< Delay time for LED ON state
+  static std::atomic<uint32_t> onTime; ///< Shared delay for LED ON state
+  static std::array<LedThread *, MAX_LEDS> leds; ///< Constructed threads
+  static std::atomic<uint32_t> ledCount;         ///< Entries in leds
+  static std::atomic<uint32_t> slotEnd; ///< Ideal tick the LED slot ends
+  LedTiming timing;                 ///< Own on/off time, 0: shared
+  JitterHistogram onJitter;         ///< Switch-on edge errors
+  JitterHistogram offJitter;        ///< Switch-off edge errors
+  std::atomic<uint32_t> slips{0U};  ///< Schedule moved to a late start
   osThreadId_t thread_id = nullptr; ///< CMSIS RTOS thread ID
   osSemaphoreId_t sem;              ///< Shared semaphore pointer
 
@@ -46,7 +95,6 @@ private:
 
   osThreadAttr_t thread_attr; ///< Thread attributes used by osThreadNew
 
-  void checkButtonEvent(void *arg);
   void start(void); // It creates a new thread
   void run(void);   // It contains the control logic for an LED.
 
@@ -54,23 +102,47 @@ public:
   // Constructor initializes the LED pin and thread attributes
   LedThread(std::string_view threadName, uint32_t pin);
   osThreadId_t getThreadId(void) const { return thread_id; }
-
-  inline static uint32_t getOnTime(void) { return onTime; } // Getter for onTime
-  inline static void setOnTime(uint32_t t) { onTime = t; }  // Setter for onTime
+  LedTiming &getTiming(void) { return timing; } // Own on/off time
+  const JitterHistogram &getOnJitter(void) const { return onJitter; }
+  const JitterHistogram &getOffJitter(void) const { return offJitter; }
+  uint32_t getSlips(void) const { return slips.load(); } // Schedule slips
+  void resetJitter(void); // Clear the histograms and the slip count
+  static uint32_t getLedCount(void) { return ledCount.load(); }
+  static LedThread *get(uint32_t i); // LED thread i, nullptr if none
+  const char *getName(void) const { return thread_attr.name; }
+
+  static LedThread *find(std::string_view name); // LED thread by name
+
+  inline static uint32_t getOnTime(void) {
+    return onTime.load(std::memory_order_relaxed);
+  } // Getter for onTime
+  inline static void setOnTime(uint32_t t) {
+    onTime.store(t, std::memory_order_relaxed);
+  } // Setter for onTime
 
   inline static void increaseOnTime(uint32_t delta) {
-    onTime =
-        (onTime + delta) > LED_ON_TIME_MAX ? LED_ON_TIME_MAX : (onTime + delta);
-  } // Increase onTime
+    uint32_t t = onTime.load(std::memory_order_relaxed);
+    while (!onTime.compare_exchange_weak(
+        t, (t + delta > LED_ON_TIME_MAX || t + delta < t) ? LED_ON_TIME_MAX
+                                                          : (t + delta),
+        std::memory_order_relaxed)) {
+    }
+  } // Increase onTime with upper limit
   inline static void decreaseOnTime(uint32_t delta) {
-    onTime = (onTime > delta) ? (onTime - delta) : LED_ON_TIME_MAX;
+    uint32_t t = onTime.load(std::memory_order_relaxed);
+    while (!onTime.compare_exchange_weak(
+        t,
+        (t > LED_ON_TIME_MIN && t - LED_ON_TIME_MIN > delta) ? (t - delta)
+                                                             : LED_ON_TIME_MIN,
+        std::memory_order_relaxed)) {
+    }
   } // Decrease onTime with lower limit
 };
 
-osEventFlagsId_t app_events_get(void); // Get event flags for button press
+osEventFlagsId_t app_events_get(void); // Get application event flags
 
-constexpr uint32_t USER_BUTTON_FLAG = 0x00000001U
-                                      << 0U; ///< Event flag for user button
+constexpr uint32_t LED_WAKE_FLAG = 0x00000001U
+                                   << 1U; ///< Event flag: LED setup changed
 
 extern "C" {
 #endif
@@ -0,0 +1,82 @@
+/**
+ * @file    log_codec.h
+ * @brief   Block compressor for log text (small-window LZ77).
+ * @author  Mitul Goti
+ * @version 1.0
+ * @date    2025-09-28
+ * @ingroup Logger
+ * @{
+ * @details
+ *   This header declares LogCodec, which packs up to BLOCK_SIZE bytes of log
+ *   text into a self-contained frame and unpacks it again. Frames do not
+ *   reference each other, so the match window is the block itself and the
+ *   memory needed is bounded by the block size. The class has no RTOS
+ *   dependency, so the host decompressor builds the same source.
+ */
+
+#ifndef LOG_CODEC_H
+#define LOG_CODEC_H
+
+#include <cstdint>
+
+#ifdef __cplusplus
+
+/**
+ * @class   LogCodec
+ * @brief   LZ77 frame encoder/decoder for log blocks.
+ * @details
+ *   Frame layout: 8-byte header (magic "LZ", raw length, packed length, low
+ *   16 bits of the CRC-32 of the raw text), then the payload. A payload as
+ *   long as the raw text is stored uncompressed.
+ *
+ *   Payload: sequences of a token byte (high nibble literal count, low
+ *   nibble match length - MIN_MATCH; 15 means more length bytes follow,
+ *   each adding up to 255), the literals, a 16-bit little-endian match
+ *   offset and the extra match length bytes. The last sequence may end
+ *   after its literals.
+ */
+class LogCodec {
+public:
+  static constexpr std::uint32_t BLOCK_SIZE = 2048U; /*!< Raw bytes/frame */
+  static constexpr std::uint32_t FRAME_HEADER_SIZE = 8U; /*!< Bytes */
+  static constexpr std::uint32_t FRAME_MAX_SIZE =
+      FRAME_HEADER_SIZE + BLOCK_SIZE; /*!< Largest frame (stored) */
+  static constexpr std::uint32_t HASH_SIZE = 512U; /*!< Match finder slots */
+  static constexpr std::uint16_t FRAME_MAGIC = 0x5A4CU; /*!< "LZ" */
+
+  /** @brief Decoded frame header */
+  struct FrameHeader {
+    std::uint16_t rawLen;    /*!< Text bytes in the frame */
+    std::uint16_t packedLen; /*!< Payload bytes after the header */
+    std::uint16_t check;     /*!< Low 16 bits of CRC-32 of the text */
+  };
+
+  static std::uint32_t
+  encodeFrame(const char *raw, std::uint32_t len, std::uint8_t *frame,
+              std::uint16_t *table); /*!< Pack text into a frame */
+  static std::int32_t decodeFrame(const std::uint8_t *frame, char *raw,
+                                  std::uint32_t size); /*!< Unpack a frame */
+  static bool readHeader(const std::uint8_t *frame,
+                         FrameHeader &hdr); /*!< Parse and check a header */
+  static void writeHeader(const char *raw, std::uint32_t rawLen,
+                          std::uint32_t packedLen,
+                          std::uint8_t *frame); /*!< Build a header */
+
+private:
+  static constexpr std::uint32_t MIN_MATCH = 4U; /*!< Shortest match */
+  static std::uint32_t compress(const char *src, std::uint32_t len,
+                                std::uint8_t *dst, std::uint32_t cap,
+                                std::uint16_t *table); /*!< LZ77 encode */
+  static std::int32_t decompress(const std::uint8_t *src, std::uint32_t len,
+                                 char *dst,
+                                 std::uint32_t cap); /*!< LZ77 decode */
+};
+
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+#endif    // LOG_CODEC_H
+/** @} */ // end of Logger
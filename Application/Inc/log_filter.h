@@ -0,0 +1,85 @@
+/**
+ * @file    log_filter.h
+ * @brief   Severity, keyword and time-range filtering of log lines.
+ * @author  Mitul Goti
+ * @version 1.0
+ * @date    2025-09-21
+ * @ingroup Logger
+ * @{
+ * @details
+ *   This header declares the LogFilter specification (small, copyable, fits in
+ *   an RTOS message queue) and the LogScanner that evaluates it. The scanner
+ *   finds all severity tags and the user keyword in one pass over a line using
+ *   a first-byte dispatch table, so filtering a 256-byte read buffer costs a
+ *   table lookup per byte plus a compare for each candidate.
+ */
+
+#ifndef LOG_FILTER_H
+#define LOG_FILTER_H
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+#ifdef __cplusplus
+
+/** @brief Severity of a log line, derived from its tag (e.g. "Error:") */
+enum class LogLevel : std::uint8_t {
+  NONE = 0,     /*!< Untagged line */
+  INFO = 1,     /*!< Info, Reply, Supervisor */
+  EVENT = 2,    /*!< Event */
+  WARNING = 3,  /*!< Warning, Overflow */
+  ERROR = 4,    /*!< Error, Fail, Program Fault */
+  CRITICAL = 5, /*!< Critical, Hardware Fault, System Fault */
+};
+
+/**
+ * @struct LogFilter
+ * @brief  Filter specification for a log replay.
+ * @details A default-constructed filter matches every line.
+ */
+struct LogFilter {
+  static constexpr std::uint32_t NO_TIME = 0xFFFFFFFFU; /*!< Unset bound */
+  static constexpr std::size_t KEYWORD_SIZE = 16U;      /*!< Incl. '\0' */
+
+  LogLevel minLevel = LogLevel::NONE; /*!< Lowest severity to keep */
+  std::uint32_t fromMs = NO_TIME;     /*!< Earliest time of day (ms) */
+  std::uint32_t toMs = NO_TIME;       /*!< Latest time of day (ms) */
+  std::array<char, KEYWORD_SIZE> keyword{}; /*!< Substring to require */
+
+  bool parse(std::string_view args); /*!< Parse "err since hh:mm:ss ..." */
+  bool isActive() const;             /*!< True if any criterion is set */
+};
+
+/**
+ * @class  LogScanner
+ * @brief  Multi-pattern matcher evaluating a LogFilter on log lines.
+ */
+class LogScanner {
+public:
+  explicit LogScanner(const LogFilter &filter); /*!< Build dispatch table */
+
+  bool match(std::string_view line) const; /*!< Evaluate one line */
+  /** @brief Keep only matching lines of buf in place, return new length */
+  std::size_t compact(char *buf, std::size_t len) const;
+
+  static LogLevel levelOf(std::string_view line); /*!< Severity of a line */
+
+private:
+  static constexpr std::uint8_t KEYWORD_ID = 15U; /*!< Pattern id of keyword */
+  /** @brief Scan a line, return max level seen and whether keyword was hit */
+  LogLevel scan(std::string_view line, bool &keywordHit) const;
+
+  const LogFilter &filter;          /*!< Filter being evaluated */
+  std::string_view keyword;         /*!< Keyword view into filter */
+  std::array<std::uint16_t, 256> firstByte{}; /*!< Pattern ids per 1st byte */
+};
+
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+#endif    // LOG_FILTER_H
+/** @} */ // end of Logger
@@ -0,0 +1,107 @@
+/**
+ * @file    log_replay.h
+ * @brief   Background worker that replays file system logs to USB.
+ * @author  Mitul Goti
+ * @version 1.0
+ * @date    2025-09-20
+ * @ingroup Logger
+ * @{
+ * @details
+ *   This header declares the LogReplay singleton class, which owns a dedicated
+ *   RTOS thread and request queue for replaying file system logs over USB.
+ *   Callers only post a request and return immediately; progress, throttling
+ *   and cancellation are handled by the worker. A second thread streams new
+ *   records live while follow mode is enabled.
+ */
+
+#ifndef LOG_REPLAY_H
+#define LOG_REPLAY_H
+
+#include <atomic>
+#include <cmsis_os2.h>
+#include <cstdint>
+#include <fs_log.h>
+#include <log_filter.h>
+
+#ifdef __cplusplus
+
+/**
+ * @class   LogReplay
+ * @brief   Singleton worker thread for asynchronous log replay.
+ * @details
+ *   Replay requests are posted into a message queue (ISR and thread safe) and
+ *   served one at a time by a low-priority thread, so neither LED threads nor
+ *   the USB command thread block while a log file streams out.
+ */
+class LogReplay {
+public:
+  /** @brief Origin of a replay request */
+  enum class Source : std::uint8_t {
+    COMMAND = 0, /*!< Requested via USB command */
+    BUTTON = 1,  /*!< Requested via user button */
+  };
+
+  /** @brief Result codes for request posting */
+  enum ReplayStatus : std::int8_t {
+    REPLAY_OK = 0,               /*!< Request accepted */
+    REPLAY_DEBOUNCED = 1,        /*!< Button request ignored (debounce/busy) */
+    REPLAY_NOT_INITIALIZED = -1, /*!< Worker not initialized */
+    REPLAY_QUEUE_FULL = -2,      /*!< Request queue full */
+  };
+
+  static LogReplay &getInstance(); /*!< Get singleton instance */
+
+  void init(); /*!< Create request queue and worker thread */
+
+  ReplayStatus request(Source src,
+                       const LogFilter &filter = {}); /*!< Post a request */
+  ReplayStatus requestDump(std::uint32_t offset); /*!< Post a volume dump */
+  ReplayStatus requestWindow(bool resume,
+                             std::uint32_t position); /*!< Acked replay */
+#ifdef FS_BENCH
+  ReplayStatus requestBench(); /*!< Post a format benchmark (erases R0:) */
+#endif
+#ifdef RAW_LOG
+  ReplayStatus requestRaw(const LogFilter &filter = {}); /*!< RawLog replay */
+#endif
+  void ack(std::uint32_t seq); /*!< Host received all chunks below seq */
+  void cancel();                    /*!< Cancel running and pending replays */
+
+  void setThrottle(std::uint32_t ms); /*!< Delay between replay chunks */
+  std::uint32_t getThrottle() const;  /*!< Current throttle in ms */
+
+  void follow(bool enable); /*!< Start/stop live follow of new records */
+
+  bool isBusy() const; /*!< True while a replay is streaming */
+  /** @brief Bytes sent and bytes requested by the current/last replay */
+  void getProgress(std::uint32_t &sent, std::uint32_t &total) const;
+
+  osThreadId_t getThreadId() const { return threadId; } /*!< Get thread ID */
+
+private:
+  LogReplay();                                      /*!< Singleton */
+  LogReplay(const LogReplay &) = delete;            /*!< Prevent copy */
+  LogReplay &operator=(const LogReplay &) = delete; /*!< Prevent assignment */
+  static void workerThreadWrapper(void *argument);  /*!< Thread wrapper */
+  static void followThreadWrapper(void *argument);  /*!< Thread wrapper */
+  void workerThread();                              /*!< Worker thread loop */
+  void followThread();                              /*!< Follow thread loop */
+
+  osThreadId_t threadId = nullptr; /*!< RTOS thread ID for replay worker */
+  osThreadId_t followId = nullptr; /*!< RTOS thread ID for follow mode */
+  FsReader *windowReader = nullptr; /*!< Acknowledged position of windowed
+                                       replays, kept for resuming */
+  FsReplayControl control;         /*!< Shared progress/cancel state */
+  std::atomic_bool busy = false;   /*!< Replay currently streaming */
+  std::atomic_uint32_t generation = 0U; /*!< Bumped by every cancel() */
+  std::atomic_uint32_t lastButtonTick = 0; /*!< Tick of last button request */
+};
+
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+#endif    // LOG_REPLAY_H
+/** @} */ // end of Logger
@@ -14,6 +14,10 @@
 #ifndef LOG_ROUTER_H
 #define LOG_ROUTER_H
 
+#include <array>
+#include <atomic>
+#include <cmsis_os2.h>
+#include <log_filter.h>
 #include <stdint.h>
 #include <string_view> // For std::string_view
 
@@ -38,6 +42,9 @@ public:
   /** @brief Enable or disable filesystem logging. */
   void enableFsLogging(bool enable);
 
+  /** @brief Enable or disable raw partition logging (RawLog). */
+  void enableRawLogging(bool enable);
+
   /** @name Logging API */
   ///@{
   void log(std::string_view msg);
@@ -48,8 +55,37 @@ public:
            uint32_t val);
   ///@}
 
-  /** @brief If FS logging is enabled, request replay of FS logs to USB. */
-  void replayFsLogsToUsb();
+  /** @brief Log to all persistent sinks, regardless of the enable flags. */
+  void logPersistent(std::string_view msg);
+
+  /** @brief Request an asynchronous replay of FS logs to USB. */
+  void replayFsLogsToUsb(const LogFilter &filter = {});
+
+  /** @brief Time source of the record timestamps. */
+  enum class Stamp : uint8_t {
+    TICK = 0,   /**< "[HH:MM:SS.mmm]" from the kernel tick. */
+    CYCLES = 1, /**< "[HH:MM:SS.fffffff]" from the cycle counter. */
+  };
+
+  /** @brief Select the timestamp source; CYCLES needs a cycle counter. */
+  bool setStamp(Stamp source);
+  Stamp getStamp() const { return stampSource.load(); }
+
+  /** @brief Events that flush the flight recorder ring. */
+  enum class Trigger : uint8_t {
+    ERROR_RECORD = 0, /**< Record at Error level or above. */
+    SUPERVISOR = 1,   /**< Supervisor thread-state alarm. */
+    COMMAND = 2,      /**< USB command. */
+    BUTTON = 3,       /**< User button double press. */
+  };
+
+  /** @name Flight recorder */
+  ///@{
+  void enableFlightRecorder(bool enable);
+  bool isFlightRecorderEnabled() const;
+  bool setFlightWindow(uint32_t preBytes, uint32_t postRecords);
+  void trigger(Trigger source);
+  ///@}
 
 private:
   LogRouter();
@@ -59,6 +95,26 @@ private:
 
   bool usbLoggingEnabled = false; /**< USB sink flag. */
   bool fsLoggingEnabled = false;  /**< FS sink flag. */
+  bool rawLoggingEnabled = false; /**< Raw partition sink flag. */
+
+  void route(std::string_view msg); /**< Send to the enabled sink. */
+  void dispatch(const char *record); /**< Flight ring or route(). */
+  /** Stamp msg into record; true if a date record must go first. */
+  bool stamp(std::string_view msg, std::array<char, 256> &record,
+             std::array<char, 64> &dateRecord);
+  void drain(Trigger source); /**< Flush the flight ring now. */
+  static void flightThreadWrapper(void *argument); /**< Thread wrapper. */
+  void flightThread(); /**< Drains the ring for posted triggers. */
+
+  std::atomic<Stamp> stampSource = Stamp::TICK; /**< Timestamp source. */
+  /** Day of the last stamp (days since 1970-01-01), for date records. */
+  std::atomic_uint32_t stampDay = 0xFFFFFFFFU;
+
+  std::atomic_bool flightEnabled = false;   /**< Flight recorder mode. */
+  std::atomic_uint32_t postRemaining = 0U;  /**< Records left in post window. */
+  uint32_t flightPostRecords = 10U;         /**< Post-trigger window. */
+  std::atomic_uint32_t pendingTriggers = 0U; /**< Bit per posted Trigger. */
+  osThreadId_t flightThreadId = nullptr;    /**< Flight recorder drain. */
 };
 
 extern "C" {
@@ -0,0 +1,79 @@
+/**
+ * @file    raw_log.h
+ * @brief   Log backend on a raw RAM partition, without a file system.
+ * @author  Mitul Goti
+ * @version 1.0
+ * @date    2025-10-03
+ * @ingroup Logger
+ * @{
+ * @details
+ *   This header declares the RawLog singleton, a Logger that appends every
+ *   message as one record to a RawStore ring in no-init CCM RAM. It is the
+ *   FAT-free alternative to FsLog for append-and-replay logging: log() is a
+ *   bounded copy under a mutex, and the replay API matches
+ *   FsLog::replayLogsToUsb().
+ */
+
+#ifndef RAW_LOG_H
+#define RAW_LOG_H
+
+#include <cmsis_os2.h>
+#include <cstdint>
+#include <fs_log.h>
+#include <logger.h>
+#include <string_view>
+
+#ifdef __cplusplus
+
+/**
+ * @class   RawLog
+ * @brief   Singleton logger on a RAM record ring.
+ */
+class RawLog : public Logger {
+public:
+  static constexpr std::uint32_t RAW_PAGE_SIZE = 512U; /*!< Bytes per page */
+  static constexpr std::uint32_t RAW_PAGES = 32U;      /*!< Pages (16 KB) */
+
+  /** @brief Status codes for the raw logger */
+  enum RawLogStatus : std::int8_t {
+    RAW_LOG_OK = 0,               /*!< Success */
+    RAW_LOG_NOT_INITIALIZED = -1, /*!< init() not called or failed */
+    RAW_LOG_MOUNT_ERROR = -2,     /*!< Store could not be mounted */
+    RAW_LOG_RTOS_ERROR = -3,      /*!< Mutex creation failed */
+  };
+
+  /** @brief Snapshot of the ring for status replies */
+  struct Stats {
+    std::uint32_t used = 0U;     /*!< Bytes written in live pages */
+    std::uint32_t capacity = 0U; /*!< Bytes the ring can hold */
+    std::uint32_t pages = 0U;    /*!< Pages opened since the format */
+    std::uint32_t worstUs = 0U;  /*!< Slowest append so far in us */
+  };
+
+  static RawLog &getInstance(); /*!< Get singleton instance */
+
+  RawLogStatus init(); /*!< Mount (or format) the ring, create the mutex */
+
+  void log(std::string_view msg) override; /*!< Append one record */
+
+  /** @brief Send all records to USB, same contract as FsLog's replay */
+  FsLog::FsLogStatus replayLogsToUsb(FsReplayControl *ctrl = nullptr);
+  void getStats(Stats &stats); /*!< Fill a status snapshot */
+
+private:
+  RawLog();                                   /*!< Singleton */
+  RawLog(const RawLog &) = delete;            /*!< Prevent copy */
+  RawLog &operator=(const RawLog &) = delete; /*!< Prevent assignment */
+
+  osMutexId_t mutexId = nullptr; /*!< Guards the store */
+  std::uint32_t worstTicks = 0U; /*!< Slowest append (system timer ticks) */
+};
+
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+#endif    // RAW_LOG_H
+/** @} */ // end of Logger
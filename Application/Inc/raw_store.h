@@ -0,0 +1,124 @@
+/**
+ * @file    raw_store.h
+ * @brief   Circular append-only record log on a raw partition (no FAT).
+ * @author  Mitul Goti
+ * @version 1.0
+ * @date    2025-10-03
+ * @ingroup Logger
+ * @{
+ * @details
+ *   This header declares RawStore, a strictly circular log of CRC-checked
+ *   records over the pages (sectors) of a FlashPort. Pages are written in
+ *   index order and stamped with consecutive sequence numbers, so mount
+ *   finds the head by binary search over the page headers. The class has no
+ *   RTOS dependency (callers serialize access), so it also builds on a host.
+ */
+
+#ifndef RAW_STORE_H
+#define RAW_STORE_H
+
+#include "flash_port.h"
+#include <cstdint>
+
+#ifdef __cplusplus
+
+/**
+ * @class   RawStore
+ * @brief   Append-only record ring without file system metadata.
+ * @details
+ *   Page layout: 12-byte header (magic, sequence number, check word)
+ *   followed by records. A record is an 8-byte header (length, marker,
+ *   CRC-32 of the payload) and the payload padded to 4 bytes. Erased bytes
+ *   (0xFF) mark the end of the written area. Page i of lap n carries
+ *   sequence number n * pages + i + 1, counted from the first format.
+ */
+class RawStore {
+public:
+  static constexpr std::uint32_t PAGE_HEADER_SIZE = 12U;  /*!< Bytes */
+  static constexpr std::uint32_t RECORD_HEADER_SIZE = 8U; /*!< Bytes */
+
+  /** @brief Status codes for store operations */
+  enum RawStatus : std::int8_t {
+    RAW_FORMATTED = 1,       /*!< Mounted an empty (new) ring */
+    RAW_OK = 0,              /*!< Success */
+    RAW_NOT_MOUNTED = -1,    /*!< mount() not called or failed */
+    RAW_PORT_ERROR = -2,     /*!< Read/program/erase failed */
+    RAW_TOO_LARGE = -3,      /*!< Record does not fit in a page */
+    RAW_GEOMETRY_ERROR = -4, /*!< Unsupported partition geometry */
+  };
+
+  /** @brief Read result of read() besides a payload length */
+  enum ReadStatus : std::int32_t {
+    READ_END = 0,        /*!< No more records */
+    READ_CRC_ERROR = -1, /*!< Record skipped: payload CRC mismatch */
+  };
+
+  /** @brief Read position: page sequence number and offset in it */
+  struct Cursor {
+    std::uint32_t seq;    /*!< Sequence number of the page */
+    std::uint32_t offset; /*!< Offset of the next record header */
+  };
+
+  explicit RawStore(FlashPort &port); /*!< Bind to a partition */
+
+  RawStatus mount();  /*!< Binary search for the head page */
+  RawStatus format(); /*!< Drop all records, restart at page 0 */
+  RawStatus append(const void *data, std::uint32_t len); /*!< Add record */
+
+  Cursor oldest() const; /*!< Cursor at the oldest record */
+  /** @brief Read the record at cursor into buf and advance the cursor */
+  std::int32_t read(Cursor &cursor, void *buf, std::uint32_t size);
+
+  std::uint32_t maxRecord() const; /*!< Largest payload append() takes */
+  std::uint32_t capacity() const;  /*!< Bytes the ring can hold */
+  std::uint32_t usedBytes() const; /*!< Bytes written in live pages */
+  std::uint32_t headSeq() const { return seq; } /*!< Pages opened so far */
+
+private:
+  bool pageSeq(std::uint32_t page, std::uint32_t &pageSeq); /*!< Header */
+  RawStatus open(std::uint32_t page, std::uint32_t pageSeq); /*!< New page */
+  std::uint32_t scanEnd(std::uint32_t page); /*!< Walk record headers */
+
+  FlashPort &port;             /*!< Partition */
+  std::uint32_t pages = 0U;    /*!< Pages in the ring */
+  std::uint32_t head = 0U;     /*!< Page being written */
+  std::uint32_t seq = 0U;      /*!< Sequence number of the head page */
+  std::uint32_t live = 0U;     /*!< Pages holding records, head included */
+  std::uint32_t end = 0U;      /*!< Written bytes in the head page */
+  bool mounted = false;        /*!< mount() succeeded */
+};
+
+/**
+ * @class   RamFlashPort
+ * @brief   FlashPort on a RAM buffer, for RawStore on a RAM region.
+ * @details Erase fills a page with 0xFF, so RawStore finds the same erased
+ *          state as on NOR flash; program is a plain copy.
+ */
+class RamFlashPort : public FlashPort {
+public:
+  /** @brief Bind to count x size bytes at base (word aligned) */
+  RamFlashPort(void *base, std::uint32_t count, std::uint32_t size)
+      : base(static_cast<std::uint8_t *>(base)), count(count), size(size) {}
+
+  std::uint32_t sectorCount() const override { return count; }
+  std::uint32_t sectorSize() const override { return size; }
+  bool read(std::uint32_t sector, std::uint32_t offset, void *buf,
+            std::uint32_t len) override;
+  bool program(std::uint32_t sector, std::uint32_t offset, const void *data,
+               std::uint32_t len) override;
+  bool erase(std::uint32_t sector) override;
+
+private:
+  std::uint8_t *base;  /*!< Region start */
+  std::uint32_t count; /*!< Pages */
+  std::uint32_t size;  /*!< Bytes per page */
+};
+
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+#endif    // RAW_STORE_H
+/** @} */ // end of Logger
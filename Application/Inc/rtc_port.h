@@ -0,0 +1,67 @@
+/**
+ * @file rtc_port.h
+ * @brief Battery-backed calendar access used by the boot clock
+ * @author Mitul Goti
+ * @version 1.0
+ * @date 2025-10-06
+ * @ingroup boot_clock
+ * @{
+ * @details
+ * This file declares the RtcPort interface (read and write a DateTime) and
+ * the STM32F4 implementation on the RTC peripheral. BootClock only talks to
+ * RtcPort, so host builds use the stub in Tools/rtc_sim instead.
+ */
+
+#ifndef RTC_PORT_H
+#define RTC_PORT_H
+
+#include <calendar.h>
+#include <cstdint>
+
+#ifdef __cplusplus
+
+/**
+ * @class RtcPort
+ * @brief Abstract real-time clock holding a calendar date and time
+ */
+class RtcPort {
+public:
+  virtual ~RtcPort() = default; ///< Virtual destructor
+
+  /// Read the date and time; false if the RTC was never set or is stopped
+  virtual bool read(DateTime &dt) = 0;
+  /// Set the date and time; false if the RTC can not hold it
+  virtual bool write(const DateTime &dt) = 0;
+};
+
+/**
+ * @class Stm32RtcPort
+ * @brief RtcPort on the STM32F4 RTC (backup domain, BCD calendar)
+ * @details The RTC runs from the LSE crystal if one starts, else from the
+ *          LSI oscillator, and keeps counting across resets (and on VBAT).
+ *          Years 2000..2099 only: the calendar stores a two-digit year.
+ */
+class Stm32RtcPort : public RtcPort {
+public:
+  bool init(); ///< Start the RTC clock if the backup domain is not running
+
+  bool read(DateTime &dt) override;
+  bool write(const DateTime &dt) override;
+
+private:
+  bool enterInit(); ///< Unlock and stop the calendar for an update
+  void exitInit();  ///< Restart the calendar and lock it again
+
+  std::uint32_t syncPrescaler = 255U; ///< PREDIV_S (sub-second counter)
+  bool running = false;               ///< init() succeeded
+};
+
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif    // RTC_PORT_H
+/** @} */ // end of boot_clock
@@ -0,0 +1,84 @@
+/**
+ * @file timer_wheel.h
+ * @brief Hashed timer wheel for millisecond timers
+ * @author Mitul Goti
+ * @version 1.0
+ * @date 2025-10-09
+ * @ingroup led_thread
+ * @{
+ * @details
+ * This file declares TimerWheel: a fixed set of one-shot timers hashed by
+ * expiry tick into a small ring of slots. Arm, cancel and expire are O(1)
+ * per timer, the memory is constant, and there is no RTOS dependency.
+ */
+
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <array>
+#include <cstdint>
+
+#ifdef __cplusplus
+
+/**
+ * @class TimerWheel
+ * @brief Fixed-size hashed timing wheel
+ * @details Timer ids are 0..MAX_TIMERS-1. Each slot holds a doubly linked
+ *          list of the timers whose expiry tick maps to it; timers more
+ *          than one turn ahead wait in their slot until their tick comes.
+ *          Not thread-safe: one thread owns the wheel.
+ */
+class TimerWheel {
+public:
+  static constexpr std::uint32_t SLOTS = 64U;      ///< Ticks per turn
+  static constexpr std::uint32_t MAX_TIMERS = 32U; ///< Timer ids
+  static constexpr std::uint16_t NONE = 0xFFFFU;   ///< End of a slot list
+
+  /// Called for each expired timer; may arm or cancel any timer
+  using FireHandler = void (*)(void *context, std::uint16_t id);
+
+  /// Cancel every timer; the next tick to process is now
+  void reset(std::uint32_t now);
+
+  /// (Re)arm timer id for tick expiry; an expiry in the past fires on the
+  /// next advance()
+  void arm(std::uint16_t id, std::uint32_t expiry);
+
+  void cancel(std::uint16_t id); ///< Stop timer id if it is armed
+  bool armed(std::uint16_t id) const { return timers[id].armed; }
+  /// Tick timer id was armed for
+  std::uint32_t expiry(std::uint16_t id) const { return timers[id].expiry; }
+
+  /// Process every tick up to and including now
+  void advance(std::uint32_t now, FireHandler fire, void *context);
+
+  /// Ticks after the last advance() until the next expiry, at most limit
+  std::uint32_t untilNext(std::uint32_t limit) const;
+
+private:
+  /// One timer, linked into the slot of its expiry tick
+  struct Timer {
+    std::uint32_t expiry = 0U;  ///< Tick the timer fires at
+    std::uint16_t next = NONE;  ///< Next timer in the slot
+    std::uint16_t prev = NONE;  ///< Previous timer in the slot
+    std::uint8_t slot = 0U;     ///< Slot it is linked into
+    bool armed = false;         ///< Linked into a slot
+  };
+
+  void unlink(std::uint16_t id); ///< Remove from its slot list
+
+  std::array<std::uint16_t, SLOTS> heads{}; ///< First timer of each slot
+  std::array<Timer, MAX_TIMERS> timers{};   ///< Timer pool
+  std::uint32_t cursor = 0U;                ///< Next tick to process
+  bool ready = false;                       ///< reset() was called
+};
+
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif    // TIMER_WHEEL_H
+/** @} */ // end of led_thread
@@ -34,6 +34,7 @@ public:
   void init();                             /*!< Initialize logger */
   void log(std::string_view msg) override; /*!< Log a message */
   UsbXferStatus usbXferChunk(std::string_view msg);     /*!< Send data chunk */
+  void crashDrain(); /*!< Fault context: move queued messages to CrashDump */
   osThreadId_t getThreadId() const { return threadId; } /*!< Get thread ID */
 
 private:
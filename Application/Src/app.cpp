@@ -27,7 +27,9 @@
  * - Initializes USB and file system loggers as configured.
  * - Supervisor thread monitors health of all threads and logs status/heartbeat.
  * - Uses CMSIS-RTOS2 for threading, synchronization, and static allocation.
- * - Handles button press events via GPIO interrupt and event flags.
+ * - Hands user button edges to the input dispatcher: a short press replays
+ *   the log, a double press triggers the flight recorder and a long press
+ *   switches the LED scheduler to its next policy.
  *
  * # 📋 Usage
  * The application starts by calling the `app_main` function, which sets up all
@@ -36,13 +38,13 @@
  *
  * # 🔧 Implementation Details
  * - The `app_main` function configures the GPIO pin for the user button to
- * trigger an event on a rising edge, initializes loggers, and creates LED
+ * trigger an event on both edges, initializes loggers, and creates LED
  * threads.
  * - Thread IDs are stored in an array for easy health monitoring.
  * - The supervisor thread checks the state of all threads and logs warnings if
  *   any are not running, as well as a periodic heartbeat.
- * - The GPIO event callback function `ARM_GPIO_SignalEvent` signals the LED
- * thread on button press using event flags (ISR-safe).
+ * - The GPIO event callback function `ARM_GPIO_SignalEvent` queues each
+ * button edge to the input dispatcher thread (ISR-safe).
  * - All RTOS objects (threads, stacks, control blocks) use static allocation.
  * - The implementation is robust for concurrent logging and log replay over
  * USB.
@@ -54,15 +56,41 @@
 #include "app.h"
 #include "Driver_GPIO.h"
 #include "cmsis_os2.h" // Include CMSIS-RTOS2 header for RTOS functions
+#include "crash_dump.h"
+#include "gpio_pin.h"
+#include "input.h"
 #include "led_thread.h"
 #include "log_router.h"
 #include "stdio.h"
 #include "stm32f4xx.h" // IWYU pragma: keep
 #include "usb_logger.h"
+#include <atomic>
 #include <cstdint>
 
 #ifdef FS_LOG
 #include "fs_log.h"
+#include "log_replay.h"
+#endif
+#ifdef FLASH_LOG
+#include "flash_log.h"
+#endif
+#ifdef RAW_LOG
+#include "raw_log.h"
+#endif
+#ifdef RTC_CLOCK
+#include "boot_clock.h"
+#include "rtc_port.h"
+#endif
+#ifdef CYCLE_STAMP
+#include "boot_clock.h"
+#include "cycle_counter.h"
+#endif
+#ifdef LED_SCHEDULER
+#include "led_scheduler.h"
+#endif
+#ifdef LED_PWM
+#include "led.h"
+#include "led_pwm.h"
 #endif
 
 extern ARM_DRIVER_GPIO Driver_GPIO0; // External GPIO driver instance
@@ -76,8 +104,11 @@ constexpr std::uint32_t LED_BLUE_PIN = 63U;   ///< GPIO pin for blue LED
 constexpr std::uint32_t LED_RED_PIN = 62U;    ///< GPIO pin for red LED
 constexpr std::uint32_t LED_ORANGE_PIN = 61U; ///< GPIO pin for orange LED
 constexpr std::uint32_t LED_GREEN_PIN = 60U;  ///< GPIO pin for green LED
+using BoardLeds =
+    GpioGroup<GpioPin<LED_GREEN_PIN>, GpioPin<LED_ORANGE_PIN>,
+              GpioPin<LED_RED_PIN>, GpioPin<LED_BLUE_PIN>>; ///< PD12..PD15
 
-osThreadId_t osThreadIds[5]; /*!< Array to hold thread IDs */
+osThreadId_t osThreadIds[6]; /*!< Array to hold thread IDs */
 
 osThreadId_t supervisor_id;
 uint64_t supervisor_stack[256]
@@ -95,6 +126,58 @@ osThreadAttr_t supervisor_attr = {
     .tz_module = 0U,                        /*!< Not used in this application */
 };
 
+/** @brief Short press: replay the file system log to USB.
+ * @param context Unused.
+ * @param g Gesture (SHORT).
+ * @param tick Tick of the gesture.
+ */
+void onShortPress(void *context, InputDispatcher::Gesture g,
+                  std::uint32_t tick) {
+  UNUSED(context);
+  UNUSED(g);
+  UNUSED(tick);
+#ifdef FS_LOG
+  LogReplay::getInstance().request(
+      LogReplay::Source::BUTTON); /* Queue replay, never blocks */
+#endif
+}
+
+/** @brief Double press: send the flight recorder history to the sinks.
+ * @param context Unused.
+ * @param g Gesture (DOUBLE).
+ * @param tick Tick of the gesture.
+ */
+void onDoublePress(void *context, InputDispatcher::Gesture g,
+                   std::uint32_t tick) {
+  UNUSED(context);
+  UNUSED(g);
+  UNUSED(tick);
+  LogRouter::getInstance().trigger(LogRouter::Trigger::BUTTON);
+}
+
+#ifdef LED_SCHEDULER
+/** @brief Long press: switch the LED scheduler to its next policy.
+ * @param context Unused.
+ * @param g Gesture (LONG).
+ * @param tick Tick of the gesture.
+ */
+void onLongPress(void *context, InputDispatcher::Gesture g,
+                 std::uint32_t tick) {
+  UNUSED(context);
+  UNUSED(g);
+  UNUSED(tick);
+#ifdef LED_PWM
+  constexpr std::uint8_t policies = 4U; // Up to HARDWARE
+#else
+  constexpr std::uint8_t policies = 3U; // HARDWARE needs TIM4
+#endif
+  LedScheduler &leds = LedScheduler::getInstance();
+  const std::uint8_t next =
+      (static_cast<std::uint8_t>(leds.getPolicy()) + 1U) % policies;
+  leds.setPolicy(static_cast<LedScheduler::Policy>(next));
+}
+#endif
+
 } // namespace
 
 /**
@@ -109,15 +192,63 @@ extern "C" void app_main(void *argument) {
 
   // Setup GPIO for user button with event callback
   Driver_GPIO0.Setup(USER_BUTTON_PIN, ARM_GPIO_SignalEvent);
-  // Set event trigger for rising edge on user button pin
-  Driver_GPIO0.SetEventTrigger(USER_BUTTON_PIN, ARM_GPIO_TRIGGER_RISING_EDGE);
+  // Press and release both matter: long presses are timed between them
+  Driver_GPIO0.SetEventTrigger(USER_BUTTON_PIN, ARM_GPIO_TRIGGER_EITHER_EDGE);
 #ifdef RUN_TIME
   UsbLogger::getInstance().init(); // Initialize USB Logger for runtime logging
 #endif
+#ifdef RTC_CLOCK
+  static Stm32RtcPort rtc; // Battery-backed calendar for the boot clock
+  if (rtc.init()) {
+    BootClock::getInstance().attachRtc(&rtc); // Adopt the time if it is set
+  } else {
+    UsbLogger::getInstance().log("Error: RTC did not start.\r\n");
+  }
+#endif
+#ifdef CYCLE_STAMP
+  static DwtCycleCounter dwt; // Core cycle counter for 100 ns stamps
+  if (dwt.init() && BootClock::getInstance().attachCycleCounter(&dwt)) {
+    LogRouter::getInstance().setStamp(LogRouter::Stamp::CYCLES);
+  } else {
+    UsbLogger::getInstance().log("Error: Cycle counter not available.\r\n");
+  }
+#endif
 #if defined(FS_LOG) && !defined(DEBUG)
-  FsLog::getInstance().init(); // Initialize File System Logger
+  FsLog::getInstance().init();     // Mount File System Logger in background
+  LogReplay::getInstance().init(); // Start background log replay worker
+#endif
+#ifdef FLASH_LOG
+  FlashLog::getInstance().init(); // Mount persistent log in internal flash
+#endif
+#ifdef RAW_LOG
+  RawLog::getInstance().init(); // Mount (or format) the raw RAM log ring
 #endif
+  CrashDump::getInstance().emit(); // Report a fault from the previous run
+  RCC->CSR |= RCC_CSR_RMVF; // Reset cause read above; judge the next anew
+  BoardLeds::clear();              // All four LEDs dark, one BSRR store
+#ifdef LED_PWM
+  static LedPwm pwm; // TIM4 drives PD12..PD15 before any LED thread starts
+  if (pwm.init()) {
+    Led::getInstance().attach(&pwm);
+  } else {
+    UsbLogger::getInstance().log("Error: LED PWM did not start.\r\n");
+  }
+#endif
+
+#ifdef LED_SCHEDULER
+  // One thread and a timer wheel serve all LEDs
+  LedScheduler &leds = LedScheduler::getInstance();
+  leds.add("blue", LED_BLUE_PIN);
+  leds.add("red", LED_RED_PIN);
+  leds.add("orange", LED_ORANGE_PIN);
+  leds.add("green", LED_GREEN_PIN);
+  leds.init();
 
+  osThreadIds[0] = leds.getThreadId(); // Supervise the scheduler thread
+  osThreadIds[1] = nullptr;            // Slots of the LED threads unused
+  osThreadIds[2] = nullptr;
+  osThreadIds[3] = nullptr;
+#else
   // Create static LED threads, one for each LED color
   static LedThread blue("blue", LED_BLUE_PIN);
   static LedThread red("red", LED_RED_PIN);
@@ -128,9 +259,20 @@ extern "C" void app_main(void *argument) {
   osThreadIds[1] = red.getThreadId();    // Get thread ID for red LED thread
   osThreadIds[2] = orange.getThreadId(); // Get thread ID for orange LED thread
   osThreadIds[3] = green.getThreadId();  // Get thread ID for green LED thread
+#endif
   osThreadIds[4] =
       UsbLogger::getInstance().getThreadId(); // Reserved for supervisor thread
 
+  // Button gestures, served by their own thread above the LED threads
+  InputDispatcher &input = InputDispatcher::getInstance();
+  input.subscribe(InputDispatcher::Gesture::SHORT, onShortPress, nullptr);
+  input.subscribe(InputDispatcher::Gesture::DOUBLE, onDoublePress, nullptr);
+#ifdef LED_SCHEDULER
+  input.subscribe(InputDispatcher::Gesture::LONG, onLongPress, nullptr);
+#endif
+  input.init(USER_BUTTON_PIN); // B1 reads high while pressed
+  osThreadIds[5] = input.getThreadId();
+
   // Create a supervisor thread to monitor LED threads
   supervisor_id = osThreadNew(supervisor_thread, nullptr, &supervisor_attr);
 
@@ -154,7 +296,8 @@ extern "C" void app_main(void *argument) {
 /**
  * @brief   Supervisor thread to monitor LED threads
  * @details Monitors the health of LED threads and logs their status. If any
- * thread is found to be inactive, an error message is logged. The supervisor
+ * thread is found to be inactive, an error message is logged, and the first
+ * time it is seen dead the flight recorder is triggered. The supervisor
  * also logs a heartbeat message every second if all threads are healthy.
  * @param   argument Unused (reserved for future extensions)
  */
@@ -163,18 +306,27 @@ static void supervisor_thread(void *argument) {
   osThreadState_t state;
   std::string_view name;
   static std::atomic_uint8_t heartbeat = 0;
+  std::uint32_t reported = 0U; // Bit i: thread i already dumped as dead
+  size_t i = 0;
   while (1) {
     auto threadHealthCheck = [&]() {
+      const std::uint32_t bit = 1U << i;
       if (state == osThreadInactive || state == osThreadError || state == osThreadTerminated) {
 #if defined(DEBUG) && !defined(FS_LOG)
         printf("%s thread not running!\r\n", name.data());
 #endif
         LogRouter::getInstance().log("%s thread state is %d!\r\n", name.data(),
                                      state);
+        if ((reported & bit) == 0U) { // One flight dump per death
+          reported |= bit;
+          LogRouter::getInstance().trigger(LogRouter::Trigger::SUPERVISOR);
+        }
+      } else {
+        reported &= ~bit; // Running again: report the next death too
       }
     };
 
-    for (size_t i = 0; i < sizeof(osThreadIds) / sizeof(osThreadIds[0]); i++) {
+    for (i = 0; i < sizeof(osThreadIds) / sizeof(osThreadIds[0]); i++) {
       if (osThreadIds[i] == nullptr) {
         continue;
       }
@@ -192,35 +344,13 @@ static void supervisor_thread(void *argument) {
 /**
  * @brief Signal event callback for GPIO pin events
  * This function is called by the GPIO driver when a pin event occurs.
- * It signals the event to the LED thread to handle the button press.
+ * It queues the button edge to the input dispatcher, which reads the pin
+ * level itself (the driver may not tell rising from falling edges).
  * @param pin GPIO pin that triggered the event
- * @param event Event type (e.g., rising edge)
+ * @param event Event type (unused)
  * @note This function is called from the GPIO driver interrupt context.
  */
 static void ARM_GPIO_SignalEvent(ARM_GPIO_Pin_t pin, uint32_t event) {
-  if (pin == USER_BUTTON_PIN && event == ARM_GPIO_EVENT_RISING_EDGE) {
-    if (app_events_get() != nullptr) {
-      // Signal the event to the LED thread
-      uint32_t returnFlag = osEventFlagsSet(app_events_get(), USER_BUTTON_FLAG);
-      if (returnFlag != USER_BUTTON_FLAG) {
-#if defined(DEBUG) && !defined(FS_LOG)
-        printf(
-            "Failed to set event flag for button press: file: %s, line: %d\r\n",
-            __FILE__, __LINE__);
-#elif RUN_TIME
-        LogRouter::getInstance().log(
-            "Program Fault: Failed to set event flag for button press\r\n");
-#endif
-      }
-    } else {
-#if defined(DEBUG) && !defined(FS_LOG)
-      printf("Failed to get event flags ID for button press: file: %s, line: "
-             "%d\r\n",
-             __FILE__, __LINE__);
-#elif RUN_TIME
-      LogRouter::getInstance().log(
-          "Program Fault: Failed to get event flags ID for button press\r\n");
-#endif
-    }
-  }
+  UNUSED(event);
+  InputDispatcher::getInstance().edgeFromIsr(pin); // Never blocks
 }
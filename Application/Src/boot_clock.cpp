@@ -7,10 +7,10 @@
  * @ingroup boot_clock
  * @details
  * This file defines the methods of the BootClock class which provides system
- * time in a human-readable format. It uses the RTOS tick count to calculate
- * hours, minutes, seconds, and milliseconds since system start.
- * The implementation includes a method to set the RTC time based on a provided
- * string in "hh:mm:ss" format.
+ * time in a human-readable format. It extends the RTOS tick count to 64 bits
+ * and adds a wall-clock offset to it.
+ * The implementation includes a method to set the clock from a string in
+ * "hh:mm:ss" or ISO "YYYY-MM-DDThh:mm:ss" format.
  */
 
 /* Boot Clock
@@ -18,35 +18,202 @@
  # 📝 Overview
   The Boot Clock module provides a way to retrieve the current system time in a
  human-readable format. It uses the RTOS tick count to calculate the elapsed
- time since system start.
+ time since system start, and a wall-clock offset to turn it into a date and
+ time of day.
 
  # ⚙️ Features
  - Retrieve current system time in a human-readable format.
- - Uses RTOS tick count for accurate timekeeping.
- - Set RTC time based on "hh:mm:ss" input.
+ - 64-bit millisecond and microsecond time since start: no wrap after 49.7
+   days, monotonic for the lifetime of the device.
+ - Calendar date: `formatIso()` gives "YYYY-MM-DDTHH:MM:SS.mmm".
+ - Set the clock from "hh:mm:ss" (keeps the date) or an ISO date-time.
+ - Follow a host clock (`steer()`): rate correction and slewing, no steps
+   in the timestamp sequence for errors below one second.
+ - Optional RTC backing (`attachRtc()`): the time is written to the RTC on
+   every set and read back at start-up, so it survives resets.
+ - Optional cycle counter (`attachCycleCounter()`, DWT CYCCNT): `nowNs()`
+   and `formatTimeFine()` ("HH:MM:SS.fffffff") resolve one core cycle.
+ - Reentrant: timestamps are written into caller buffers.
+ - No printf: digits come from a "00".."99" pair table, and each thread only
+   re-renders the fields that changed since its previous timestamp.
 
  # 📋 Usage
  To use the Boot Clock module, obtain the singleton instance using
- `BootClock::getInstance()`. Call `getCurrentTimeString()` to get the current
- time as a formatted string. To set the RTC time, use the `setRTC()` method
- with a string in "hh:mm:ss" format.
+ `BootClock::getInstance()`. Call `formatTime(buf)` with a buffer of
+ `BootClock::TIME_STRING_SIZE` bytes to get the current time. To set the
+ clock, use the `setRTC()` method with "hh:mm:ss" or "YYYY-MM-DD hh:mm:ss".
+ `nowMs()`, `nowUs()` and `nowNs()` give the monotonic time for
+ measurements.
 
  # 🔧 Implementation Details
  The BootClock class is implemented as a singleton to ensure a single instance
  throughout the application. It uses the CMSIS-RTOS2 API to get the system tick
- count and calculates the elapsed time. The time is formatted as "HH:MM:SS.mmm"
- where HH is hours, MM is minutes, SS is seconds, and mmm is milliseconds.
+ count (1 kHz, so one tick is one millisecond) and calculates the elapsed
+ time. The time is formatted as "HH:MM:SS.mmm" where HH is hours, MM is
+ minutes, SS is seconds, and mmm is milliseconds.
 
- The `setRTC()` method parses a string in "hh:mm:ss" format and adjusts the
- clock offset accordingly. It validates the input to ensure correct time values.
+ The 32-bit tick is extended without a lock. One atomic word holds the
+ number of tick wraps seen so far and the top bit of the last tick read.
+ A reader that finds the top bit fall from 1 to 0 has seen a wrap and
+ publishes epoch + 1 with compare-and-swap; whoever loses the race re-reads
+ both. This only needs a call at least every 24.8 days (half the tick
+ range); every log record and the supervisor heartbeat make one.
+ `nowUs()` adds the SysTick count within the current tick.
+
+ SysTick and the DWT cycle counter both count the core clock, so they never
+ drift apart. `attachCycleCounter()` measures the cycle count at kernel
+ start once (interrupts masked, both counters read back to back, about
+ 0.1 us apart); from then on `nowNs()` is a CycleClock read minus that
+ offset. CycleClock extends the 32-bit count like the tick above; it needs
+ a read every 12.7 s, which a 1 s RTOS timer guarantees. Without a cycle
+ counter `nowNs()` uses the SysTick count instead, which reads the tick
+ with interrupts masked.
+
+ The wall clock is a small model on top of `nowMs()`: an anchor (local
+ time and Unix time), a rate correction for the tick crystal against the
+ reference, and a temporary slew rate. The Cortex-M4 has no 64-bit atomics,
+ so the model is written with interrupts masked and a sequence counter
+ bumped; readers retry if the counter moved while they read. Until the
+ clock is set the anchor is 0 and the date is 1970-01-01 plus the uptime.
+
+ `steer()` (used by ClockSync) starts a new model where the old one is
+ now, so the wall clock is continuous: errors up to 1 s are slewed at
+ 500 ppm, larger ones are stepped. Rates are fixed point (2^-32 per ms), so
+ evaluating the model is two multiplies and shifts, no division.
+
+ Each thread claims one of eight cache slots (compare-and-swap on the thread
+ ID, no lock). A slot holds the last text the thread rendered and the
+ second it was for; a new timestamp in the same second only rewrites the
+ three millisecond digits, so the 64-bit division into day and time of day
+ runs once per second per thread. A new second rewrites SS, and so on.
+ Slots are only touched by their owner. A thread that finds every slot
+ taken reclaims one whose owner has terminated (the one-shot mount thread,
+ for example), so exited threads do not hold slots for good. Interrupt
+ handlers, threads beyond eight live ones and calls before the kernel runs
+ render all fields (still without printf).
+
+ The `setRTC()` method parses the input with `Calendar::parse()`, validates
+ the date and time and steps the wall clock. A step of the clock
+ (forwards or backwards) never changes `nowMs()`.
 */
 
 #include "boot_clock.h"
+#include "calendar.h"
 #include "cmsis_os2.h"
+#include "cycle_counter.h"
+#include "rtc_port.h"
+#include "stm32f4xx.h" // IWYU pragma: keep
+#include <array>
+#include <atomic>
 #include <cstdint>
-#include <cstdio>
+#include <cstring>
 #include <string_view>
 
+/**
+ * @brief   Anonymous namespace for internal linkage.
+ * @details Contains the digit-pair table and the per-thread render cache.
+ */
+namespace {
+constexpr std::uint32_t STAMP_SLOTS = 8U;          ///< Threads with a cache
+constexpr std::uint64_t NO_SECOND = ~0ULL;         ///< Slot not rendered yet
+constexpr std::uint32_t TICK_TOP = 1U;             ///< Top bit in tick_state
+constexpr std::int64_t RATE_ONE = 1LL << 32;       ///< Rate 1.0 (2^-32 units)
+constexpr std::int32_t MAX_SKEW_PPB = 500000;      ///< Crystal + host limit
+constexpr std::uint32_t SLEW_PPM = 500U;           ///< Slew rate
+constexpr std::int32_t SLEW_RATE =
+    static_cast<std::int32_t>(RATE_ONE * SLEW_PPM / 1000000); ///< 2^-32
+constexpr std::uint64_t STEP_LIMIT_US = 1000000U;  ///< Step above 1 s
+constexpr std::uint32_t CYCLE_TRACK_MS = 1000U;    ///< CYCCNT wraps: 25.6 s
+
+/// "00".."99": two characters per value, one load for two digits
+constexpr char DIGIT_PAIRS[] =
+    "000102030405060708091011121314151617181920212223242526272829"
+    "303132333435363738394041424344454647484950515253545556575859"
+    "606162636465666768697071727374757677787980818283848586878889"
+    "90919293949596979899";
+
+/// Last timestamp rendered by one thread
+struct StampSlot {
+  std::atomic<osThreadId_t> owner = nullptr; ///< Thread using the slot
+  std::uint64_t secondStart = NO_SECOND;     ///< Wall ms the second began
+  std::uint32_t second = 0U;                 ///< Second of the day rendered
+  std::uint32_t day = 0U;                    ///< Days since 1970-01-01
+  std::array<char, BootClock::TIME_STRING_SIZE> text; ///< "HH:MM:SS.mmm"
+};
+std::array<StampSlot, STAMP_SLOTS> stamp_slots; ///< Per-thread caches
+
+uint64_t cycle_timer_cb[16]
+    __attribute__((aligned(8))); /*!< Static timer control block */
+const osTimerAttr_t cycle_timer_attr = {
+    .name = "cycleTrack",             /*!< Timer name */
+    .attr_bits = 0U,                  /*!< No special timer attributes */
+    .cb_mem = cycle_timer_cb,         /*!< Use static control block memory */
+    .cb_size = sizeof(cycle_timer_cb) /*!< Static control block size */
+};
+
+/**
+ * @brief   Timer callback: read the cycle clock so no wrap is missed.
+ */
+void track_cycles(void *argument) {
+  (void)argument;
+  BootClock::getInstance().nowNs();
+}
+
+/**
+ * @brief   Write a value 0..99 as two digits.
+ */
+inline void put_pair(char *dst, std::uint32_t value) {
+  std::memcpy(dst, &DIGIT_PAIRS[2U * value], 2U);
+}
+
+/**
+ * @brief   Write the millisecond field.
+ */
+inline void put_millis(char *dst, std::uint32_t ms) {
+  dst[0] = static_cast<char>('0' + ms / 100U);
+  put_pair(dst + 1, ms % 100U);
+}
+
+/**
+ * @brief   Find or claim the calling thread's cache slot.
+ * @details With no free slot, takes over the slot of a thread that has
+ *          terminated. Every thread has static control block memory, so a
+ *          stale owner ID still reads its state safely.
+ * @return  Slot, or nullptr in an interrupt, before the kernel runs or when
+ *          all slots are held by live threads.
+ */
+StampSlot *stamp_slot() {
+  if (__get_IPSR() != 0U) {
+    return nullptr; /* Would share the interrupted thread's slot */
+  }
+  osThreadId_t self = osThreadGetId();
+  if (self == nullptr) {
+    return nullptr;
+  }
+  for (StampSlot &slot : stamp_slots) {
+    if (slot.owner.load(std::memory_order_relaxed) == self) {
+      return &slot;
+    }
+  }
+  for (StampSlot &slot : stamp_slots) {
+    osThreadId_t none = nullptr;
+    if (slot.owner.compare_exchange_strong(none, self)) {
+      return &slot;
+    }
+  }
+  for (StampSlot &slot : stamp_slots) {
+    osThreadId_t owner = slot.owner.load();
+    const osThreadState_t state = osThreadGetState(owner);
+    if ((state == osThreadTerminated || state == osThreadError) &&
+        slot.owner.compare_exchange_strong(owner, self)) {
+      slot.secondStart = NO_SECOND; /* Render all fields first */
+      return &slot;
+    }
+  }
+  return nullptr;
+}
+} // namespace
+
 /** @brief Get the singleton instance of BootClock
  * This method returns a reference to the single instance of the BootClock
  * class.
@@ -57,44 +224,360 @@ BootClock &BootClock::getInstance() {
   return instance;
 }
 
-/** @brief Get the current time as a formatted string.
- * The time is formatted as "HH:MM:SS.mmm" where HH is hours, MM is minutes,
- * SS is seconds, and mmm is milliseconds since system start.
- * @return Pointer to a static string containing the formatted time.
- * @note The returned pointer is valid until the next call to this function
- *       from any thread. Copy the string immediately if you need to retain it.
+/** @brief Render a time as "HH:MM:SS.mmm".
+ * Pure function: reentrant and callable from interrupts.
+ * @param milliseconds Time in milliseconds (hours wrap at 24).
+ * @param buf Destination of at least TIME_STRING_SIZE bytes.
+ * @return Characters written, without the terminator.
  */
-std::string_view BootClock::getCurrentTimeString(void) {
-  std::uint32_t totalMilliseconds =
-      osKernelGetTickCount() + clock_offset.load();
-  std::uint32_t hours = (totalMilliseconds / 3600000) % 24;
-  std::uint32_t minutes = (totalMilliseconds / 60000) % 60;
-  std::uint32_t seconds = (totalMilliseconds / 1000) % 60;
-  std::uint32_t milliseconds = totalMilliseconds % 1000;
+std::size_t BootClock::formatTime(std::uint32_t milliseconds, char *buf) {
+  const std::uint32_t second = milliseconds / 1000U;
+  put_pair(buf, (second / 3600U) % 24U);
+  buf[2] = ':';
+  put_pair(buf + 3, (second / 60U) % 60U);
+  buf[5] = ':';
+  put_pair(buf + 6, second % 60U);
+  buf[8] = '.';
+  put_millis(buf + 9, milliseconds - second * 1000U);
+  buf[TIME_STRING_LENGTH] = '\0';
+  return TIME_STRING_LENGTH;
+}
 
-  snprintf(timeString.data(), timeString.size(), "%02u:%02u:%02u.%03u", hours,
-           minutes, seconds, milliseconds); // Format time string
-  return timeString.data(); // Return pointer to formatted time string
+/** @brief Milliseconds since start.
+ * Extends the 32-bit tick count with the number of wraps seen so far.
+ * Lock-free and callable from interrupts.
+ * @return 64-bit monotonic time in milliseconds.
+ */
+std::uint64_t BootClock::nowMs() {
+  std::uint32_t state = tick_state.load();
+  for (;;) {
+    const std::uint32_t tick = osKernelGetTickCount(); // Read after state
+    const std::uint32_t top = tick >> 31;
+    if ((state & TICK_TOP) == top) {
+      return (static_cast<std::uint64_t>(state >> 1) << 32) | tick;
+    }
+    // Top bit rose (same epoch) or fell (the tick wrapped)
+    const std::uint32_t next =
+        (top != 0U) ? (state | TICK_TOP) : (((state >> 1) + 1U) << 1);
+    if (tick_state.compare_exchange_weak(state, next)) {
+      state = next;
+    } // else: state was reloaded, read a tick that is newer than it
+  }
 }
 
-/** @brief Set the RTC time based on a provided string.
- * The input string should be in the format "hh:mm:ss".
- * @param buf Pointer to a string containing the time in "hh:mm:ss" format.
- * @return Status code indicating success or type of error.
+/** @brief Microseconds since start.
+ * Adds the SysTick count within the current tick to nowMs().
+ * @return 64-bit monotonic time in microseconds.
  */
-BootClock::SetRTCStatus BootClock::setRTC(std::string_view buf) {
+std::uint64_t BootClock::nowUs() {
+  const std::uint32_t perTick = osKernelGetSysTimerFreq() / 1000U;
+  const std::uint64_t ms = nowMs();
+  // Cycles since the start of tick ms; more than perTick if a tick passed
+  const std::uint32_t cycles =
+      osKernelGetSysTimerCount() - static_cast<std::uint32_t>(ms) * perTick;
+  return ms * 1000U + static_cast<std::uint64_t>(cycles) * 1000U / perTick;
+}
 
-  std::uint32_t hours, minutes, seconds;
-  if (std::sscanf(buf.data(), "%2u:%2u:%2u", &hours, &minutes, &seconds) != 3) {
-    return SetRTCStatus::INVALID_RX_FORMAT; // Parsing error
+/** @brief Kernel timer cycles since start.
+ * The kernel timer (SysTick) counts the core clock; its 32-bit count is
+ * placed within the current tick of nowMs().
+ * @return 64-bit cycle count.
+ */
+std::uint64_t BootClock::sysCycles() {
+  const std::uint32_t perTick = osKernelGetSysTimerFreq() / 1000U;
+  const std::uint64_t ms = nowMs();
+  // Cycles since the start of tick ms; more than perTick if a tick passed
+  const std::uint32_t cycles =
+      osKernelGetSysTimerCount() - static_cast<std::uint32_t>(ms) * perTick;
+  return ms * perTick + cycles;
+}
+
+/** @brief Nanoseconds since start.
+ * From the attached cycle counter (one register read, no interrupt
+ * masking), else from the kernel timer. Resolution is one core clock cycle
+ * either way (5.95 ns at 168 MHz).
+ * @return 64-bit monotonic time in nanoseconds.
+ */
+std::uint64_t BootClock::nowNs() {
+  const std::uint32_t perTick = osKernelGetSysTimerFreq() / 1000U;
+  const std::uint64_t cycles =
+      cycles_on.load() ? cycle_clock.cycles() - cycle_offset : sysCycles();
+  const std::uint64_t ms = cycles / perTick;
+  return ms * 1000000U + (cycles - ms * perTick) * 1000000U / perTick;
+}
+
+/** @brief Milliseconds since 1970-01-01T00:00:00.000 (UTC).
+ * Equal to nowMs() until the clock is set.
+ * @return Wall-clock time.
+ */
+std::uint64_t BootClock::wallMs() {
+  const Discipline d = discipline(); // Before nowMs(): anchorMs <= now
+  return static_cast<std::uint64_t>(wallAt(d, nowMs())) / 1000U;
+}
+
+/** @brief Microseconds since 1970-01-01T00:00:00.000000 (UTC).
+ * The rate correction is applied per millisecond; the microseconds within
+ * the current millisecond come straight from the SysTick count.
+ * @return Wall-clock time.
+ */
+std::uint64_t BootClock::wallUs() {
+  const Discipline d = discipline();
+  const std::uint64_t us = nowUs();
+  const std::uint64_t ms = us / 1000U;
+  return static_cast<std::uint64_t>(wallAt(d, ms)) + (us - ms * 1000U);
+}
+
+/** @brief Evaluate a wall clock model.
+ * wall = anchorWallUs + dt + dt * skew + min(dt, slewMs) * slew, rates in
+ * units of 2^-32 (1 ppm is about 4295). The rate terms are kept in
+ * microseconds, so re-anchoring in steer() loses no fraction of a
+ * millisecond. The products stay below 2^63 for 30 years at 500 ppm.
+ * @param d Model.
+ * @param ms Local time (nowMs()), not before d.anchorMs.
+ * @return Unix microseconds at the start of local millisecond ms.
+ */
+std::int64_t BootClock::wallAt(const Discipline &d, std::uint64_t ms) {
+  const std::int64_t dt = static_cast<std::int64_t>(ms - d.anchorMs);
+  const std::int64_t slewDt =
+      (dt < static_cast<std::int64_t>(d.slewMs)) ? dt : d.slewMs;
+  // (x >> 32) * 1000 in two halves: x * 1000 would overflow
+  const std::int64_t rateUs = (((dt * d.skew) >> 16) * 1000) >> 16;
+  const std::int64_t slewUs = (((slewDt * d.slew) >> 16) * 1000) >> 16;
+  return d.anchorWallUs + dt * 1000 + rateUs + slewUs;
+}
+
+/** @brief Read the wall clock model.
+ * Retries while publish() changed it in between.
+ * @return Copy of the model.
+ */
+BootClock::Discipline BootClock::discipline() {
+  for (;;) {
+    const std::uint32_t seq = model_seq.load(std::memory_order_acquire);
+    const Discipline copy = model;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (model_seq.load(std::memory_order_relaxed) == seq) {
+      return copy;
+    }
+  }
+}
+
+/** @brief Replace the wall clock model.
+ * Interrupts are masked for the copy, so no reader can run in the middle;
+ * one that was interrupted sees model_seq change and retries.
+ * @param next New model.
+ */
+void BootClock::publish(const Discipline &next) {
+  const std::uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  model = next;
+  model_seq.fetch_add(1U, std::memory_order_release);
+  __set_PRIMASK(primask);
+}
+
+/** @brief Jump the wall clock to a time.
+ * The rate correction found by steer() stays, a running slew is dropped.
+ * @param unixMs New wall-clock time now.
+ */
+void BootClock::stepTo(std::int64_t unixMs) {
+  Discipline next = discipline();
+  next.anchorMs = nowMs();
+  next.anchorWallUs = unixMs * 1000;
+  next.slew = 0;
+  next.slewMs = 0U;
+  publish(next);
+  clock_set = true;
+}
+
+/** @brief Steer the wall clock towards a reference clock.
+ * The new model starts where the current one is now, so the wall clock does
+ * not jump. It runs at the reference rate (skewPpb) plus a fixed 500 ppm
+ * slew until errorUs is made up. Errors above one second, or any error
+ * while the clock was never set, are stepped instead.
+ * @param errorUs Reference time minus wall clock time now.
+ * @param skewPpb Reference rate over kernel tick rate, minus 1, in ppb.
+ * @return True if the clock was stepped.
+ */
+bool BootClock::steer(std::int64_t errorUs, std::int32_t skewPpb) {
+  skewPpb = (skewPpb > MAX_SKEW_PPB)    ? MAX_SKEW_PPB
+            : (skewPpb < -MAX_SKEW_PPB) ? -MAX_SKEW_PPB
+                                        : skewPpb;
+  const Discipline d = discipline();
+  Discipline next;
+  next.anchorMs = nowMs();
+  next.anchorWallUs = wallAt(d, next.anchorMs);
+  next.skew = static_cast<std::int32_t>(static_cast<std::int64_t>(skewPpb) *
+                                        RATE_ONE / 1000000000);
+  const std::uint64_t magnitude =
+      static_cast<std::uint64_t>((errorUs < 0) ? -errorUs : errorUs);
+  const bool step = !clock_set.load() || magnitude > STEP_LIMIT_US;
+  if (step) {
+    next.anchorWallUs += errorUs;
+  } else {
+    next.slew = (errorUs < 0) ? -SLEW_RATE : SLEW_RATE;
+    next.slewMs = static_cast<std::uint32_t>(magnitude * 1000U / SLEW_PPM);
+  }
+  publish(next);
+  clock_set = true;
+  if (step && rtc != nullptr) {
+    rtc->write(Calendar::fromUnixMs(wallMs())); // Keep the new time
+  }
+  return step;
+}
+
+/** @brief Back the wall clock with a hardware RTC.
+ * If the RTC holds a valid time, the wall clock is set from it. Every later
+ * setRTC() also writes the RTC.
+ * @param port RTC to use (nullptr detaches).
+ * @return True if the time was taken from the RTC.
+ */
+bool BootClock::attachRtc(RtcPort *port) {
+  rtc = port;
+  DateTime dt;
+  if (port == nullptr || !port->read(dt)) {
+    return false;
+  }
+  stepTo(static_cast<std::int64_t>(Calendar::toUnixMs(dt)));
+  return true;
+}
+
+/** @brief Fine time from a cycle counter.
+ * The counter must run at the kernel timer frequency (both count the core
+ * clock). Its count at kernel start is measured once, with interrupts
+ * masked; a 1 s timer keeps the wrap tracking alive.
+ * @param counter Counter to use, nullptr to go back to the kernel timer.
+ * @return True if nowNs() now reads the counter.
+ */
+bool BootClock::attachCycleCounter(CycleCounter *counter) {
+  cycles_on = false;
+  cycle_clock.attach(nullptr);
+  if (counter == nullptr || counter->frequency() != osKernelGetSysTimerFreq()) {
+    return false;
+  }
+  static osTimerId_t tracker =
+      osTimerNew(track_cycles, osTimerPeriodic, nullptr, &cycle_timer_attr);
+  if (tracker == nullptr || osTimerStart(tracker, CYCLE_TRACK_MS) != osOK) {
+    return false; // A wrap would be missed in a quiet 25.6 s
   }
+  cycle_clock.attach(counter);
+  const std::uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  const std::uint64_t local = sysCycles();
+  cycle_offset = cycle_clock.cycles() - local;
+  __set_PRIMASK(primask);
+  cycles_on = true;
+  return true;
+}
+
+/** @brief Get the current time as "HH:MM:SS.mmm".
+ * Reentrant: each caller owns its buffer. Only the fields that changed since
+ * the calling thread's previous timestamp are rendered again.
+ * @param buf Destination of at least TIME_STRING_SIZE bytes.
+ * @param day Optional: receives the days since 1970-01-01 of the stamp.
+ * @return Characters written, without the terminator.
+ */
+std::size_t BootClock::formatTime(char *buf, std::uint32_t *day) {
+  return formatWall(wallMs(), buf, day);
+}
+
+/** @brief Get the current time as "HH:MM:SS.fffffff".
+ * The wall clock model is evaluated at nowNs(), so with a cycle counter
+ * two records within the same millisecond still get distinct, ordered
+ * stamps.
+ * @param buf Destination of at least FINE_STRING_SIZE bytes.
+ * @param day Optional: receives the days since 1970-01-01 of the stamp.
+ * @return Characters written, without the terminator.
+ */
+std::size_t BootClock::formatTimeFine(char *buf, std::uint32_t *day) {
+  const Discipline d = discipline(); // Before nowNs(): anchorMs <= now
+  const std::uint64_t ns = nowNs();
+  const std::uint64_t ms = ns / 1000000U;
+  const std::uint64_t wallNs =
+      static_cast<std::uint64_t>(wallAt(d, ms)) * 1000U + (ns - ms * 1000000U);
+  formatWall(wallNs / 1000000U, buf, day);
+  // Four more digits after the milliseconds: 100 ns steps
+  const std::uint32_t sub =
+      static_cast<std::uint32_t>(wallNs % 1000000U) / 100U;
+  put_pair(buf + TIME_STRING_LENGTH, sub / 100U);
+  put_pair(buf + TIME_STRING_LENGTH + 2U, sub % 100U);
+  buf[FINE_STRING_LENGTH] = '\0';
+  return FINE_STRING_LENGTH;
+}
 
-  if (hours >= 24 || minutes >= 60 || seconds >= 60) {
-    return SetRTCStatus::INVALID_VALUE; // Invalid time values
+/** @brief Render a wall clock time as "HH:MM:SS.mmm".
+ * Uses the calling thread's cache slot if it has one.
+ * @param now Wall clock time (Unix milliseconds).
+ * @param buf Destination of at least TIME_STRING_SIZE bytes.
+ * @param day Optional: receives the days since 1970-01-01 of the stamp.
+ * @return Characters written, without the terminator.
+ */
+std::size_t BootClock::formatWall(std::uint64_t now, char *buf,
+                                  std::uint32_t *day) {
+  StampSlot *slot = stamp_slot();
+  if (slot == nullptr) {
+    if (day != nullptr) {
+      *day = static_cast<std::uint32_t>(now / Calendar::MS_PER_DAY);
+    }
+    return formatTime(static_cast<std::uint32_t>(now % Calendar::MS_PER_DAY),
+                      buf);
+  }
+  char *const text = slot->text.data();
+  // Unsigned: a clock set backwards also gives a large difference
+  std::uint64_t into = now - slot->secondStart;
+  if (slot->secondStart == NO_SECOND || into >= 1000U) {
+    const std::uint32_t msOfDay =
+        static_cast<std::uint32_t>(now % Calendar::MS_PER_DAY);
+    const std::uint32_t second = msOfDay / 1000U;
+    const std::uint32_t last = slot->second;
+    if (slot->secondStart == NO_SECOND) {
+      formatTime(msOfDay, text);
+    } else if (second != last) {
+      if (second / 60U != last / 60U) {
+        if (second / 3600U != last / 3600U) {
+          put_pair(text, second / 3600U);
+        }
+        put_pair(text + 3, (second / 60U) % 60U);
+      }
+      put_pair(text + 6, second % 60U);
+    }
+    into = msOfDay - second * 1000U;
+    slot->secondStart = now - into;
+    slot->second = second;
+    slot->day = static_cast<std::uint32_t>(now / Calendar::MS_PER_DAY);
   }
+  put_millis(text + 9, static_cast<std::uint32_t>(into));
+  std::memcpy(buf, text, TIME_STRING_SIZE);
+  if (day != nullptr) {
+    *day = slot->day;
+  }
+  return TIME_STRING_LENGTH;
+}
 
-  clock_offset.store((hours * 3600000) + (minutes * 60000) + (seconds * 1000) -
-                     osKernelGetTickCount()); // Adjust clock offset
+/** @brief Get the current date and time as "YYYY-MM-DDTHH:MM:SS.mmm".
+ * @param buf Destination of at least Calendar::ISO_STRING_SIZE bytes.
+ * @return Characters written, without the terminator.
+ */
+std::size_t BootClock::formatIso(char *buf) {
+  return Calendar::formatIso(wallMs(), buf);
+}
 
+/** @brief Set the wall clock based on a provided string.
+ * "hh:mm:ss" sets the time of day and keeps the current date;
+ * "YYYY-MM-DD hh:mm:ss" (or with 'T') sets both. The monotonic time base is
+ * not touched. With an attached RTC the new time is also written there.
+ * @param buf String containing the time.
+ * @return Status code indicating success or type of error.
+ */
+BootClock::SetRTCStatus BootClock::setRTC(std::string_view buf) {
+  DateTime dt = Calendar::fromUnixMs(wallMs());
+  if (Calendar::parse(buf, dt) == Calendar::Parsed::NONE) {
+    return SetRTCStatus::INVALID_RX_FORMAT; // Parsing error
+  }
+  if (!Calendar::valid(dt)) {
+    return SetRTCStatus::INVALID_VALUE; // Invalid date or time values
+  }
+  stepTo(static_cast<std::int64_t>(Calendar::toUnixMs(dt))); // Step the clock
+  if (rtc != nullptr) {
+    rtc->write(dt); // Keep the time across resets
+  }
   return SetRTCStatus::SUCCESS; // Success
-}
\ No newline at end of file
+}
@@ -0,0 +1,179 @@
+/**
+ * @file button_gesture.cpp
+ * @brief Button debounce and press gesture detection
+ * @author Mitul Goti
+ * @version 1.0
+ * @date 2025-10-14
+ * @ingroup input
+ * @details
+ * This file implements ButtonGesture: the debounce window, the long press
+ * hold and the double press gap, all as deadlines on the caller's clock.
+ */
+
+/* Button Gesture
+ ---
+ # 📝 Overview
+ The user button was debounced by dropping requests less than 50 ms
+ apart, and every press meant the same thing. ButtonGesture turns the raw
+ edges into debounced presses and releases and tells a short press, a long
+ press and a double press apart, so one button can carry several actions.
+
+ # ⚙️ Features
+ - Leading-edge debounce: a press is reported at its first edge, bounce
+   within DEBOUNCE_MS (20 ms) after it is ignored.
+ - A level change hidden by the bounce (a tap shorter than the window) is
+   caught when the window closes.
+ - SHORT once no second press followed within DOUBLE_MS (300 ms), DOUBLE
+   for two presses, LONG as soon as a press is held for LONG_MS (800 ms).
+ - PRESS and RELEASE for every debounced change, for immediate feedback.
+
+ # 📋 Usage
+ ```
+ gesture.edge(level, tick, emit, ctx);       // For every raw edge
+ gesture.expire(now, emit, ctx);             // When a deadline is due
+ if (gesture.untilNext(now, ticks)) { ... }  // Sleep this long at most
+ ```
+
+ # 🔧 Implementation Details
+ Three deadlines are kept: the end of the debounce window, the long press
+ hold and the double press gap. edge() first handles the deadlines that
+ fell due before the edge, so a late caller still sees events in time
+ order. A second press within the gap cancels the gap; its release gives
+ DOUBLE, or its hold gives SHORT for the first click and then LONG.
+
+ # ⚠️ Limitations
+ - Tick resolution: gestures are timed to the ms tick of the caller.
+ - A missed edge leaves the raw level wrong until the next edge; the
+   caller resynchronises by passing the sampled pin level as an edge.
+ */
+
+#include "button_gesture.h"
+#include <cstdint>
+#include <initializer_list>
+
+/**
+ * @brief   Anonymous namespace for internal linkage.
+ * @details Contains the deadline comparison.
+ */
+namespace {
+/** @brief True once tick at has been reached (wrap-safe). */
+bool due(std::uint32_t at, std::uint32_t now) {
+  return static_cast<std::int32_t>(at - now) <= 0;
+}
+} // namespace
+
+/**
+ * @brief   Forget all state; the button is taken as released.
+ */
+void ButtonGesture::reset() {
+  settle = Deadline{};
+  hold = Deadline{};
+  gap = Deadline{};
+  raw = false;
+  pressed = false;
+  longSent = false;
+  clickPending = false;
+}
+
+/** @brief Feed a raw edge.
+ * @param level Pin level after the edge, true when pressed.
+ * @param tick Tick the edge was seen at.
+ * @param emit Handler for the gestures this edge completes.
+ * @param context Passed to the handler.
+ */
+void ButtonGesture::edge(bool level, std::uint32_t tick, EmitHandler emit,
+                         void *context) {
+  expire(tick, emit, context); // Deadlines before the edge come first
+  raw = level;
+  if (settle.armed) {
+    return; // Bounce; the level is checked when the window closes
+  }
+  if (level != pressed) {
+    accept(level, tick, emit, context);
+  }
+}
+
+/** @brief Take a debounced level change.
+ * @param level New level, true when pressed.
+ * @param tick Tick of the change.
+ * @param emit Gesture handler.
+ * @param context Passed to the handler.
+ */
+void ButtonGesture::accept(bool level, std::uint32_t tick, EmitHandler emit,
+                           void *context) {
+  pressed = level;
+  settle = {tick + DEBOUNCE_MS, true};
+  if (level) {
+    emit(context, Gesture::PRESS, tick);
+    hold = {tick + LONG_MS, true};
+    gap.armed = false; // A second click: decided on release or hold
+    longSent = false;
+    return;
+  }
+  emit(context, Gesture::RELEASE, tick);
+  hold.armed = false;
+  if (longSent) {
+    clickPending = false;
+  } else if (clickPending) {
+    clickPending = false;
+    emit(context, Gesture::DOUBLE, tick);
+  } else {
+    clickPending = true;
+    gap = {tick + DOUBLE_MS, true};
+  }
+}
+
+/** @brief Handle every deadline due by now, earliest first.
+ * @param now Current tick.
+ * @param emit Gesture handler.
+ * @param context Passed to the handler.
+ */
+void ButtonGesture::expire(std::uint32_t now, EmitHandler emit,
+                           void *context) {
+  for (;;) {
+    Deadline *next = nullptr;
+    for (Deadline *d : {&settle, &hold, &gap}) {
+      if (d->armed && due(d->at, now) &&
+          (next == nullptr || due(d->at, next->at))) {
+        next = d;
+      }
+    }
+    if (next == nullptr) {
+      return;
+    }
+    next->armed = false;
+    if (next == &settle) {
+      if (raw != pressed) {
+        accept(raw, settle.at, emit, context); // Change hidden by bounce
+      }
+    } else if (next == &hold) {
+      if (clickPending) {
+        clickPending = false; // The first click was a click on its own
+        emit(context, Gesture::SHORT, hold.at);
+      }
+      longSent = true;
+      emit(context, Gesture::LONG, hold.at);
+    } else if (clickPending) {
+      clickPending = false;
+      emit(context, Gesture::SHORT, gap.at);
+    }
+  }
+}
+
+/** @brief Time to the next deadline.
+ * @param now Current tick.
+ * @param ticks Set to the ticks until the earliest deadline (0 if due).
+ * @return false if no deadline is pending.
+ */
+bool ButtonGesture::untilNext(std::uint32_t now, std::uint32_t &ticks) const {
+  bool any = false;
+  for (const Deadline *d : {&settle, &hold, &gap}) {
+    if (!d->armed) {
+      continue;
+    }
+    const std::uint32_t left = due(d->at, now) ? 0U : (d->at - now);
+    ticks = (!any || left < ticks) ? left : ticks;
+    any = true;
+  }
+  return any;
+}
@@ -0,0 +1,250 @@
+/**
+ * @file calendar.cpp
+ * @brief Civil date/time conversions for the boot clock
+ * @author Mitul Goti
+ * @version 1.0
+ * @date 2025-10-06
+ * @ingroup boot_clock
+ * @details
+ * This file implements the Calendar helpers: day numbers, Unix millisecond
+ * conversion, the "set clock" parser and ISO 8601 rendering.
+ */
+
+/* Calendar
+ ---
+ # 📝 Overview
+ The boot clock counts milliseconds since 1970-01-01 in 64 bits. Calendar
+ turns that count into a date and time of day and back, so `set clock` can
+ take a full date and log records can carry one.
+
+ # ⚙️ Features
+ - Proleptic Gregorian calendar, years 1970..9999, UTC (no time zones, no
+   leap seconds).
+ - `parse()` accepts "hh:mm:ss" (time only) or "YYYY-MM-DD hh:mm:ss",
+   with 'T' as separator, optional ".mmm" and optional trailing 'Z'.
+ - ISO 8601 output "YYYY-MM-DDTHH:MM:SS.mmm" without printf.
+
+ # 🔧 Implementation Details
+ Day numbers use the era-based algorithm: years are shifted to start in
+ March, so the leap day is the last day of the shifted year and the month
+ lengths follow the 153/5 pattern. Every step is unsigned integer
+ arithmetic, no tables and no loops over years.
+ */
+
+#include "calendar.h"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @brief   Anonymous namespace for internal linkage.
+ * @details Contains the digit helpers.
+ */
+namespace {
+constexpr std::uint32_t DAYS_TO_1970 = 719468U; ///< 0000-03-01 to 1970-01-01
+constexpr std::uint32_t DAYS_PER_ERA = 146097U; ///< 400 Gregorian years
+
+/**
+ * @brief   Read n decimal digits at pos.
+ * @return  False if a character is not a digit or text is too short.
+ */
+bool read_digits(std::string_view text, std::size_t pos, std::size_t n,
+                 std::uint32_t &value) {
+  if (pos + n > text.size()) {
+    return false;
+  }
+  value = 0U;
+  for (std::size_t i = pos; i < pos + n; i++) {
+    if (text[i] < '0' || text[i] > '9') {
+      return false;
+    }
+    value = value * 10U + static_cast<std::uint32_t>(text[i] - '0');
+  }
+  return true;
+}
+
+/**
+ * @brief   Write value as n decimal digits (leading zeros).
+ */
+void put_digits(char *dst, std::uint32_t value, std::size_t n) {
+  for (std::size_t i = n; i > 0U; i--) {
+    dst[i - 1U] = static_cast<char>('0' + value % 10U);
+    value /= 10U;
+  }
+}
+
+/**
+ * @brief   Parse "hh:mm:ss[.mmm]" at pos into dt.
+ * @return  Position after the time, 0 on a format error.
+ */
+std::size_t parse_time(std::string_view text, std::size_t pos, DateTime &dt) {
+  std::uint32_t h, m, s;
+  if (!read_digits(text, pos, 2U, h) || pos + 8U > text.size() ||
+      text[pos + 2U] != ':' || !read_digits(text, pos + 3U, 2U, m) ||
+      text[pos + 5U] != ':' || !read_digits(text, pos + 6U, 2U, s)) {
+    return 0U;
+  }
+  std::uint32_t ms = 0U;
+  pos += 8U;
+  if (pos < text.size() && text[pos] == '.') {
+    if (!read_digits(text, pos + 1U, 3U, ms)) {
+      return 0U;
+    }
+    pos += 4U;
+  }
+  dt.hour = static_cast<std::uint8_t>(h);
+  dt.minute = static_cast<std::uint8_t>(m);
+  dt.second = static_cast<std::uint8_t>(s);
+  dt.millis = static_cast<std::uint16_t>(ms);
+  return pos;
+}
+} // namespace
+
+/** @brief Check that every field of a DateTime is in range.
+ * @param dt Date and time to check.
+ * @return True if the date exists and the time of day is valid.
+ */
+bool Calendar::valid(const DateTime &dt) {
+  static constexpr std::uint8_t DAYS_IN_MONTH[12] = {31, 29, 31, 30, 31, 30,
+                                                     31, 31, 30, 31, 30, 31};
+  if (dt.year < 1970U || dt.year > 9999U || dt.month < 1U || dt.month > 12U ||
+      dt.day < 1U || dt.day > DAYS_IN_MONTH[dt.month - 1U] || dt.hour > 23U ||
+      dt.minute > 59U || dt.second > 59U || dt.millis > 999U) {
+    return false;
+  }
+  const bool leap = (dt.year % 4U == 0U) &&
+                    ((dt.year % 100U != 0U) || (dt.year % 400U == 0U));
+  return !(dt.month == 2U && dt.day == 29U && !leap);
+}
+
+/** @brief Count days from 1970-01-01 to a date.
+ * @param year 1970..9999.
+ * @param month 1..12.
+ * @param day 1..31.
+ * @return Days since the epoch.
+ */
+std::uint32_t Calendar::daysFromCivil(std::uint32_t year, std::uint32_t month,
+                                      std::uint32_t day) {
+  year -= (month <= 2U) ? 1U : 0U; // Year starts in March
+  const std::uint32_t era = year / 400U;
+  const std::uint32_t yoe = year - era * 400U;
+  const std::uint32_t doy =
+      (153U * (month > 2U ? month - 3U : month + 9U) + 2U) / 5U + day - 1U;
+  const std::uint32_t doe = yoe * 365U + yoe / 4U - yoe / 100U + doy;
+  return era * DAYS_PER_ERA + doe - DAYS_TO_1970;
+}
+
+/** @brief Convert a DateTime to milliseconds since the epoch.
+ * @param dt Valid date and time (see valid()).
+ * @return Milliseconds since 1970-01-01T00:00:00.000.
+ */
+std::uint64_t Calendar::toUnixMs(const DateTime &dt) {
+  const std::uint32_t msOfDay =
+      ((dt.hour * 60U + dt.minute) * 60U + dt.second) * 1000U + dt.millis;
+  return static_cast<std::uint64_t>(daysFromCivil(dt.year, dt.month, dt.day)) *
+             MS_PER_DAY +
+         msOfDay;
+}
+
+/** @brief Convert milliseconds since the epoch to a DateTime.
+ * @param unixMs Milliseconds since 1970-01-01T00:00:00.000.
+ * @return Broken-down date and time.
+ */
+DateTime Calendar::fromUnixMs(std::uint64_t unixMs) {
+  const std::uint32_t days = static_cast<std::uint32_t>(unixMs / MS_PER_DAY);
+  std::uint32_t rest = static_cast<std::uint32_t>(unixMs % MS_PER_DAY);
+  DateTime dt;
+  dt.millis = static_cast<std::uint16_t>(rest % 1000U);
+  rest /= 1000U;
+  dt.second = static_cast<std::uint8_t>(rest % 60U);
+  rest /= 60U;
+  dt.minute = static_cast<std::uint8_t>(rest % 60U);
+  dt.hour = static_cast<std::uint8_t>(rest / 60U);
+
+  const std::uint32_t z = days + DAYS_TO_1970;
+  const std::uint32_t era = z / DAYS_PER_ERA;
+  const std::uint32_t doe = z - era * DAYS_PER_ERA;
+  const std::uint32_t yoe =
+      (doe - doe / 1460U + doe / 36524U - doe / 146096U) / 365U;
+  const std::uint32_t doy = doe - (365U * yoe + yoe / 4U - yoe / 100U);
+  const std::uint32_t mp = (5U * doy + 2U) / 153U; // 0 = March
+  const std::uint32_t month = (mp < 10U) ? mp + 3U : mp - 9U;
+  dt.year = static_cast<std::uint16_t>(yoe + era * 400U + (month <= 2U));
+  dt.month = static_cast<std::uint8_t>(month);
+  dt.day = static_cast<std::uint8_t>(doy - (153U * mp + 2U) / 5U + 1U);
+  return dt;
+}
+
+/** @brief Parse a clock setting.
+ * Accepts "hh:mm:ss" (only the time fields of dt are written) or
+ * "YYYY-MM-DD hh:mm:ss" / "YYYY-MM-DDThh:mm:ss", each with an optional
+ * ".mmm" and an optional trailing 'Z'. Trailing CR, LF and spaces are
+ * ignored. Field ranges are not checked here, see valid().
+ * @param text Input text.
+ * @param dt Fields found are written here.
+ * @return What was found, Parsed::NONE on a format error.
+ */
+Calendar::Parsed Calendar::parse(std::string_view text, DateTime &dt) {
+  while (!text.empty() && (text.back() == '\r' || text.back() == '\n' ||
+                           text.back() == ' ' || text.back() == '\0')) {
+    text.remove_suffix(1U);
+  }
+  if (!text.empty() && text.back() == 'Z') {
+    text.remove_suffix(1U);
+  }
+  if (text.size() > 2U && text[2] == ':') {
+    return (parse_time(text, 0U, dt) == text.size()) ? Parsed::TIME
+                                                     : Parsed::NONE;
+  }
+  std::uint32_t y, m, d;
+  if (!read_digits(text, 0U, 4U, y) || text.size() < 11U || text[4] != '-' ||
+      !read_digits(text, 5U, 2U, m) || text[7] != '-' ||
+      !read_digits(text, 8U, 2U, d) || (text[10] != 'T' && text[10] != ' ')) {
+    return Parsed::NONE;
+  }
+  DateTime parsed = dt;
+  if (parse_time(text, 11U, parsed) != text.size()) {
+    return Parsed::NONE;
+  }
+  parsed.year = static_cast<std::uint16_t>(y);
+  parsed.month = static_cast<std::uint8_t>(m);
+  parsed.day = static_cast<std::uint8_t>(d);
+  dt = parsed;
+  return Parsed::DATE_TIME;
+}
+
+/** @brief Render a day number as "YYYY-MM-DD".
+ * @param days Days since 1970-01-01.
+ * @param buf Destination of at least DATE_STRING_LENGTH + 1 bytes.
+ * @return Characters written, without the terminator.
+ */
+std::size_t Calendar::formatDate(std::uint32_t days, char *buf) {
+  const DateTime dt = fromUnixMs(static_cast<std::uint64_t>(days) * MS_PER_DAY);
+  put_digits(buf, dt.year, 4U);
+  buf[4] = '-';
+  put_digits(buf + 5, dt.month, 2U);
+  buf[7] = '-';
+  put_digits(buf + 8, dt.day, 2U);
+  buf[DATE_STRING_LENGTH] = '\0';
+  return DATE_STRING_LENGTH;
+}
+
+/** @brief Render a time as "YYYY-MM-DDTHH:MM:SS.mmm".
+ * @param unixMs Milliseconds since 1970-01-01T00:00:00.000.
+ * @param buf Destination of at least ISO_STRING_SIZE bytes.
+ * @return Characters written, without the terminator.
+ */
+std::size_t Calendar::formatIso(std::uint64_t unixMs, char *buf) {
+  const DateTime dt = fromUnixMs(unixMs);
+  formatDate(static_cast<std::uint32_t>(unixMs / MS_PER_DAY), buf);
+  buf[10] = 'T';
+  put_digits(buf + 11, dt.hour, 2U);
+  buf[13] = ':';
+  put_digits(buf + 14, dt.minute, 2U);
+  buf[16] = ':';
+  put_digits(buf + 17, dt.second, 2U);
+  buf[19] = '.';
+  put_digits(buf + 20, dt.millis, 3U);
+  buf[ISO_STRING_LENGTH] = '\0';
+  return ISO_STRING_LENGTH;
+}
@@ -0,0 +1,188 @@
+/**
+ * @file clock_sync.cpp
+ * @brief Host time synchronization over the CDC link
+ * @author Mitul Goti
+ * @version 1.0
+ * @date 2025-10-07
+ * @ingroup boot_clock
+ * @details
+ * This file implements ClockSync: sample collection from `sync` exchanges,
+ * the offset/skew fit and the hand-over to BootClock::steer().
+ */
+
+/* Clock Sync
+ ---
+ # 📝 Overview
+ `set clock` aligns the device to the host once, to the second. Over days
+ the crystal behind the kernel tick drifts away from the host clock by
+ tens of milliseconds. ClockSync measures the host clock with NTP-style
+ exchanges and keeps BootClock's wall clock on it, to about a millisecond,
+ without steps in the log timestamps.
+
+ # ⚙️ Features
+ - Four timestamps per exchange: host send (t1), device receive (t2),
+   device send (t3), host receive (t4). Offset and round-trip delay follow
+   as in NTP, independent of how long the device took to answer.
+ - Minimum-delay filter: samples with a round trip well above the best one
+   in the window (USB frame and host scheduling jitter) are not used.
+ - Skew: least-squares slope of offset over local time across the last
+   eight samples, once they span at least 10 s.
+ - Applied with BootClock::steer(): rate correction plus a 500 ppm slew;
+   only errors above one second (or the first sync) step the clock.
+
+ # 📋 Usage
+ Run `Tools/clock_sync` on the host; it sends `sync <t1> <t4>` every few
+ seconds and prints the device's answers. `sync status` shows the estimate.
+
+ # 🔧 Implementation Details
+ Samples are (local time, host minus local offset, delay) and are measured
+ against the monotonic `nowUs()`, not the wall clock, so steering does not
+ feed back into the fit. The fit runs in double precision on offsets
+ relative to the newest sample; it runs once per exchange on the USB
+ command thread, never on a logging path.
+
+ # ⚠️ Limitations
+ - The host must send t4 with its next `sync`; an exchange whose answer was
+   lost is simply replaced by the next one.
+ - Accuracy is bounded by the asymmetry of the USB round trip (full-speed
+   frames are 1 ms), which the minimum-delay filter only reduces.
+ */
+
+#include "clock_sync.h"
+#include "boot_clock.h"
+#include <array>
+#include <cstdint>
+
+/**
+ * @brief   Anonymous namespace for internal linkage.
+ * @details Contains the filter and fit limits.
+ */
+namespace {
+constexpr std::uint32_t DELAY_SLACK_US = 500U; ///< Kept above 2x min delay
+constexpr double MIN_SPAN_US = 10e6;           ///< Baseline for a skew fit
+constexpr double MAX_SKEW = 500e-6;            ///< Larger fits are noise
+} // namespace
+
+/** @brief Get the singleton instance of ClockSync
+ * @return Reference to the ClockSync instance.
+ */
+ClockSync &ClockSync::getInstance() {
+  static ClockSync instance;
+  return instance;
+}
+
+/** @brief Start an exchange.
+ * Replaces an exchange that was never completed.
+ * @param t1 Host send time (Unix microseconds).
+ * @param t2 Local receive time (BootClock::nowUs()).
+ * @param t3 Local send time (BootClock::nowUs()).
+ */
+void ClockSync::begin(std::uint64_t t1, std::uint64_t t2, std::uint64_t t3) {
+  open[0] = t1;
+  open[1] = t2;
+  open[2] = t3;
+  pending = true;
+}
+
+/** @brief Close the open exchange and update the estimate.
+ * @param t4 Host receive time of the reply (Unix microseconds).
+ * @return True if the exchange gave a sample.
+ */
+bool ClockSync::complete(std::uint64_t t4) {
+  if (!pending) {
+    return false;
+  }
+  pending = false;
+  const std::uint64_t t1 = open[0];
+  const std::uint64_t t2 = open[1];
+  const std::uint64_t t3 = open[2];
+  if (t4 < t1 || t4 - t1 > MAX_DELAY_US + (t3 - t2)) {
+    stats.rejected++; // Out of order or too slow to tell the offset
+    return false;
+  }
+  Sample &s = samples[next];
+  s.localUs = t2 + (t3 - t2) / 2U;
+  s.offsetUs = static_cast<std::int64_t>(t1 + (t4 - t1) / 2U) -
+               static_cast<std::int64_t>(s.localUs);
+  s.delayUs = (t4 - t1 > t3 - t2)
+                  ? static_cast<std::uint32_t>((t4 - t1) - (t3 - t2))
+                  : 0U;
+  next = (next + 1U) % SAMPLES;
+  count = (count < SAMPLES) ? count + 1U : SAMPLES;
+  stats.samples++;
+  stats.delayUs = s.delayUs;
+  estimate();
+  return true;
+}
+
+/** @brief Fit offset and skew to the good samples and steer the clock.
+ * @details
+ *  - Keeps samples whose delay is at most twice the smallest one plus
+ *    DELAY_SLACK_US.
+ *  - Skew is the least-squares slope of offset over local time once the
+ *    kept samples span MIN_SPAN_US; before that the last skew is kept.
+ *  - The offset now follows from the fitted line (or the best sample).
+ */
+void ClockSync::estimate() {
+  std::uint32_t minDelay = MAX_DELAY_US;
+  for (std::uint32_t i = 0; i < count; i++) {
+    minDelay = (samples[i].delayUs < minDelay) ? samples[i].delayUs : minDelay;
+  }
+  const std::uint32_t limit = 2U * minDelay + DELAY_SLACK_US;
+  const Sample &ref = samples[(next + SAMPLES - 1U) % SAMPLES]; // Newest
+  const Sample *best = &ref;
+  double n = 0.0, mx = 0.0, my = 0.0; // Relative to ref
+  double lo = 0.0, hi = 0.0;
+  for (std::uint32_t i = 0; i < count; i++) {
+    const Sample &s = samples[i];
+    if (s.delayUs > limit) {
+      continue;
+    }
+    const double x = static_cast<double>(static_cast<std::int64_t>(
+        s.localUs - ref.localUs));
+    mx += x;
+    my += static_cast<double>(s.offsetUs - ref.offsetUs);
+    lo = (x < lo) ? x : lo;
+    hi = (x > hi) ? x : hi;
+    n += 1.0;
+    best = (s.delayUs < best->delayUs) ? &s : best;
+  }
+  double skew = static_cast<double>(stats.skewPpb) * 1e-9;
+  double ax = static_cast<double>(static_cast<std::int64_t>(
+      best->localUs - ref.localUs)); // Point the line goes through
+  double ay = static_cast<double>(best->offsetUs - ref.offsetUs);
+  if (n >= 2.0 && hi - lo >= MIN_SPAN_US) {
+    mx /= n;
+    my /= n;
+    double sxx = 0.0, sxy = 0.0;
+    for (std::uint32_t i = 0; i < count; i++) {
+      const Sample &s = samples[i];
+      if (s.delayUs > limit) {
+        continue;
+      }
+      const double dx = static_cast<double>(static_cast<std::int64_t>(
+                            s.localUs - ref.localUs)) -
+                        mx;
+      sxx += dx * dx;
+      sxy += dx * (static_cast<double>(s.offsetUs - ref.offsetUs) - my);
+    }
+    skew = sxy / sxx;
+    skew = (skew > MAX_SKEW) ? MAX_SKEW : (skew < -MAX_SKEW) ? -MAX_SKEW : skew;
+    ax = mx;
+    ay = my;
+  }
+
+  BootClock &clock = BootClock::getInstance();
+  const std::uint64_t local = clock.nowUs();
+  const std::uint64_t wall = clock.wallUs();
+  const double x = static_cast<double>(static_cast<std::int64_t>(
+      local - ref.localUs));
+  const std::int64_t offset =
+      ref.offsetUs + static_cast<std::int64_t>(ay + skew * (x - ax));
+  const std::uint64_t host = local + static_cast<std::uint64_t>(offset);
+  stats.errorUs = static_cast<std::int64_t>(host - wall);
+  stats.skewPpb = static_cast<std::int32_t>(skew * 1e9);
+  if (clock.steer(stats.errorUs, stats.skewPpb)) {
+    stats.steps++;
+  }
+}
@@ -0,0 +1,202 @@
+/**
+ * @file    crash_dump.cpp
+ * @brief   Fault-time capture of pending log records, reported on next boot.
+ * @author  Mitul Goti
+ * @version 1.0
+ * @date    2025-09-26
+ * @ingroup Logger
+ * @{
+ * @details
+ * Connects the CMSIS-View Fault components to the logging stack: the fault
+ * handlers call ARM_FaultSave(), whose ARM_FaultExit() hook lands here.
+ */
+
+/* Crash Dump
+ ---
+ # 📝 Overview
+ When the firmware faults, the records explaining why are usually still in
+ the USB message queue, the FS staging ring or an unwritten flash page, and
+ the reset throws them away. Crash Dump keeps them.
+
+ # ⚙️ Features
+ - Fault registers saved by CMSIS-View Fault:Storage (ARM_FaultInfo).
+ - Up to 512 bytes of pending log records saved next to it, newest kept.
+ - Both live in no-init RAM (".bss.noinit*", CCM) and are CRC protected.
+ - Decoded after the reboot and logged as the first records; the fault is
+   also replayed to Event Recorder with ARM_FaultRecord().
+
+ # 📋 Usage
+ Call `CrashDump::getInstance().emit()` once the loggers are initialized.
+
+ # 🔧 Implementation Details
+ The fault path only copies bytes and computes one CRC: no locks, no
+ formatting, no RTOS calls except non-blocking queue reads, which
+ CMSIS-RTOS2 maps to the ISR variants in handler mode. All text formatting
+ happens on the next boot. Draining is best effort: if the fault corrupted
+ a logger's state, the tail may be incomplete.
+ */
+
+#include "crash_dump.h"
+#include "ARM_Fault.h"
+#include "flash_store.h"
+#include "log_router.h"
+#include "stm32f4xx.h" // IWYU pragma: keep
+#include "usb_logger.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#ifdef FLASH_LOG
+#include "flash_log.h"
+#endif
+#if defined(FS_LOG) && !defined(DEBUG)
+#include "fs_log.h"
+#endif
+
+/**
+ * @brief   Anonymous namespace for internal linkage.
+ * @details Contains the no-init crash area.
+ */
+namespace {
+constexpr uint32_t CRASH_MAGIC = 0x48534143U; /*!< "CASH" */
+
+/**
+ * @struct  CrashArea
+ * @brief   Pending log bytes captured at fault time.
+ */
+struct CrashArea {
+  uint32_t magic; /*!< CRASH_MAGIC once sealed */
+  uint32_t head;  /*!< Bytes captured in total */
+  uint32_t crc;   /*!< CRC-32 of head and data */
+  char data[CrashDump::CRASH_TAIL_SIZE]; /*!< Ring of captured bytes */
+};
+CrashArea crash_area
+    __attribute__((section(".bss.noinit.crash"))); /*!< Not zeroed at reset */
+
+/**
+ * @brief   CRC over the captured content.
+ * @return  CRC-32 of head and data.
+ */
+uint32_t crash_crc() {
+  uint32_t crc = FlashStore::crc32(&crash_area.head, sizeof(crash_area.head));
+  return FlashStore::crc32(crash_area.data, sizeof(crash_area.data), crc);
+}
+} // namespace
+
+/**
+ * @brief   Constructor (private for singleton pattern).
+ */
+CrashDump::CrashDump() {}
+
+/**
+ * @brief   Get the singleton instance of CrashDump.
+ * @return  Reference to CrashDump instance.
+ */
+CrashDump &CrashDump::getInstance() {
+  static CrashDump instance;
+  return instance;
+}
+
+/**
+ * @brief   Append bytes to the crash ring (fault context).
+ * @param   data Bytes to keep; older bytes are overwritten when full.
+ */
+void CrashDump::capture(std::string_view data) {
+  for (char c : data) {
+    crash_area.data[crash_area.head++ % CRASH_TAIL_SIZE] = c;
+  }
+}
+
+/**
+ * @brief   Drain all logger queues into the crash ring and seal it.
+ * @details Called from ARM_FaultExit() with the fault registers already
+ *          saved. Bounded work: at most the queue and page sizes.
+ */
+void CrashDump::capturePending() {
+  crash_area.magic = 0U;
+  crash_area.head = 0U;
+#if defined(FS_LOG) && !defined(DEBUG)
+  FsLog::getInstance().crashDrain(); /* Staged, not yet written */
+#endif
+#ifdef FLASH_LOG
+  FlashLog::getInstance().crashDrain(); /* Pages not yet programmed */
+#endif
+  UsbLogger::getInstance().crashDrain(); /* Queued, not yet sent */
+  crash_area.crc = crash_crc();
+  crash_area.magic = CRASH_MAGIC;
+}
+
+/**
+ * @brief   Log the fault record and the captured tail from the last boot.
+ * @details Records go to the persistent backends before anything else is
+ *          logged; both the fault record and the tail are cleared after.
+ * @return  true if a fault was reported.
+ */
+bool CrashDump::emit() {
+  bool found = false;
+  std::array<char, 64> line;
+  LogRouter &router = LogRouter::getInstance();
+
+  if (ARM_FaultOccurred() != 0U) {
+    found = true;
+    ARM_FaultRecord(); /* Also visible in the Event Recorder */
+    snprintf(line.data(), line.size(),
+             "Hardware Fault: #%u PC 0x%08X LR 0x%08X\r\n",
+             static_cast<unsigned>(ARM_FaultInfo.Count),
+             static_cast<unsigned>(ARM_FaultInfo.Registers.ReturnAddress),
+             static_cast<unsigned>(ARM_FaultInfo.Registers.LR));
+    router.logPersistent(line.data());
+    if (ARM_FaultInfo.Content.FaultRegsExist != 0U) {
+      snprintf(line.data(), line.size(),
+               "Hardware Fault: CFSR 0x%08X HFSR 0x%08X\r\n",
+               static_cast<unsigned>(ARM_FaultInfo.FaultRegisters.CFSR),
+               static_cast<unsigned>(ARM_FaultInfo.FaultRegisters.HFSR));
+      router.logPersistent(line.data());
+      snprintf(line.data(), line.size(),
+               "Hardware Fault: MMFAR 0x%08X BFAR 0x%08X\r\n",
+               static_cast<unsigned>(ARM_FaultInfo.FaultRegisters.MMFAR),
+               static_cast<unsigned>(ARM_FaultInfo.FaultRegisters.BFAR));
+      router.logPersistent(line.data());
+    }
+    ARM_FaultClear();
+  }
+
+  if (crash_area.magic == CRASH_MAGIC && crash_area.crc == crash_crc()) {
+    found = true;
+    const uint32_t end = crash_area.head;
+    uint32_t pos = (end > CRASH_TAIL_SIZE) ? end - CRASH_TAIL_SIZE : 0U;
+    snprintf(line.data(), line.size(),
+             "Hardware Fault: %u pending log bytes at fault:\r\n",
+             static_cast<unsigned>(end - pos));
+    router.logPersistent(line.data());
+    if (pos > 0U) {
+      /* Ring wrapped: skip the partial oldest line */
+      while (pos < end && crash_area.data[pos++ % CRASH_TAIL_SIZE] != '\n') {
+      }
+    }
+    uint32_t n = 0U;
+    for (; pos < end; pos++) {
+      char c = crash_area.data[pos % CRASH_TAIL_SIZE];
+      line[n++] = c;
+      if (c == '\n' || n == line.size() - 1U || pos + 1U == end) {
+        line[n] = '\0';
+        router.logPersistent(line.data());
+        n = 0U;
+      }
+    }
+  }
+  crash_area.magic = 0U;
+  return found;
+}
+
+/**
+ * @brief   CMSIS-View hook after ARM_FaultSave() stored the fault record.
+ * @details Overrides the weak default; captures pending logs, then resets.
+ */
+extern "C" void ARM_FaultExit(void) {
+  CrashDump::getInstance().capturePending();
+  NVIC_SystemReset();
+}
+
+/** @} */ // end of Logger
@@ -0,0 +1,98 @@
+/**
+ * @file cycle_clock.cpp
+ * @brief 64-bit extension of a 32-bit cycle counter
+ * @author Mitul Goti
+ * @version 1.0
+ * @date 2025-10-08
+ * @ingroup boot_clock
+ * @details
+ * This file implements CycleClock: lock-free wrap tracking for a
+ * CycleCounter.
+ */
+
+/* Cycle Clock
+ ---
+ # 📝 Overview
+ At 168 MHz the 32-bit DWT cycle counter wraps every 25.6 s. CycleClock
+ counts the wraps, so BootClock can turn cycles into nanoseconds since
+ start for as long as the board runs.
+
+ # ⚙️ Features
+ - 64-bit cycle count, callable from threads and interrupts.
+ - No lock and no interrupt masking: one counter read and one atomic load
+   on the fast path.
+
+ # 🔧 Implementation Details
+ Same scheme as BootClock::nowMs() for the kernel tick: one atomic word
+ holds the number of wraps seen so far and the top bit of the last count
+ read. A reader that finds the top bit fall from 1 to 0 has seen a wrap
+ and publishes wraps + 1 with compare-and-swap; whoever loses the race
+ re-reads both. The counter is read after the state, so a reader never
+ combines a new epoch with a count from before the wrap; the state is
+ loaded again after the count, so a reader that was held off for longer
+ than half a wrap (12.7 s is within reach of a starved low-priority
+ thread) retries instead of combining an old epoch with a newer count.
+
+ # ⚠️ Limitations
+ - A wrap is only seen if cycles() runs at least once per half wrap
+   (12.7 s at 168 MHz). BootClock runs a 1 s timer for that.
+ */
+
+#include "cycle_clock.h"
+#include "cycle_counter.h"
+#include <cstdint>
+
+/**
+ * @brief   Anonymous namespace for internal linkage.
+ * @details Contains the state bit layout.
+ */
+namespace {
+constexpr std::uint32_t COUNT_TOP = 1U; ///< Top bit of the count in state
+} // namespace
+
+/** @brief Attach a counter.
+ * Not meant to race with cycles(): attach once at start-up.
+ * @param counter Counter to extend, nullptr to detach.
+ */
+void CycleClock::attach(CycleCounter *counter) {
+  state.store((counter != nullptr) ? (counter->read() >> 31) : 0U);
+  source.store(counter);
+}
+
+/** @brief Cycles since the counter started.
+ * Lock-free and callable from interrupts.
+ * @return 64-bit cycle count, 0 without a counter.
+ */
+std::uint64_t CycleClock::cycles() {
+  CycleCounter *const counter = source.load();
+  if (counter == nullptr) {
+    return 0U;
+  }
+  std::uint32_t word = state.load();
+  for (;;) {
+    const std::uint32_t count = counter->read(); // Read after state
+    const std::uint32_t top = count >> 31;
+    if ((word & COUNT_TOP) == top) {
+      const std::uint32_t check = state.load();
+      if (check == word) {
+        return (static_cast<std::uint64_t>(word >> 1) << 32) | count;
+      }
+      word = check; // Held off across a half wrap: count may be too new
+      continue;
+    }
+    // Top bit rose (same epoch) or fell (the counter wrapped)
+    const std::uint32_t next =
+        (top != 0U) ? (word | COUNT_TOP) : (((word >> 1) + 1U) << 1);
+    if (state.compare_exchange_weak(word, next)) {
+      word = next;
+    } // else: word was reloaded, read a count that is newer than it
+  }
+}
+
+/** @brief Frequency of the attached counter.
+ * @return Counts per second, 0 without a counter.
+ */
+std::uint32_t CycleClock::frequency() const {
+  CycleCounter *const counter = source.load();
+  return (counter != nullptr) ? counter->frequency() : 0U;
+}
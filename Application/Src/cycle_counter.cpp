@@ -0,0 +1,60 @@
+/**
+ * @file cycle_counter.cpp
+ * @brief DWT cycle counter access for the boot clock
+ * @author Mitul Goti
+ * @version 1.0
+ * @date 2025-10-08
+ * @ingroup boot_clock
+ * @details
+ * Implements DwtCycleCounter on the CoreDebug and DWT registers from the
+ * CMSIS core header.
+ */
+
+/* DWT Cycle Counter
+ ---
+ # 📝 Overview
+ The Data Watchpoint and Trace unit of the Cortex-M4 has a 32-bit counter
+ of core clock cycles. Reading it is a single load, from any context and
+ without masking interrupts, which makes it the cheapest fine time source
+ on the chip. BootClock uses it for sub-microsecond log timestamps.
+
+ # ⚙️ Features
+ - Turns on the trace block (DEMCR.TRCENA) and CYCCNT (DWT_CTRL.CYCCNTENA).
+ - Checks that the counter exists and actually counts.
+ - Reports SystemCoreClock as its frequency.
+
+ # 🔧 Implementation Details
+ The Event Recorder (EVENT_TIMESTAMP_SOURCE 0) and debuggers use the same
+ counter, so init() neither resets nor stops it: readers only ever take
+ differences. The counter stops while the core is halted by a debugger;
+ timestamps then lag the kernel tick by the time spent halted.
+ */
+
+#include "cycle_counter.h"
+#include "stm32f4xx.h" // IWYU pragma: keep
+#include <cstdint>
+
+/** @brief Enable the cycle counter.
+ * @return True if CYCCNT is implemented and running.
+ */
+bool DwtCycleCounter::init() {
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  if ((DWT->CTRL & DWT_CTRL_NOCYCCNT_Msk) != 0U) {
+    return false; // Core built without a cycle counter
+  }
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+  const std::uint32_t start = DWT->CYCCNT;
+  __NOP();
+  __NOP();
+  return DWT->CYCCNT != start;
+}
+
+/** @brief Read the cycle counter.
+ * @return Core clock cycles, modulo 2^32.
+ */
+std::uint32_t DwtCycleCounter::read() { return DWT->CYCCNT; }
+
+/** @brief Cycle counter frequency.
+ * @return Core clock in Hz.
+ */
+std::uint32_t DwtCycleCounter::frequency() const { return SystemCoreClock; }
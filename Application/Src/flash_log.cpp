@@ -0,0 +1,311 @@
+/**
+ * @file    flash_log.cpp
+ * @brief   Persistent log in internal flash.
+ * @author  Mitul Goti
+ * @version 1.0
+ * @date    2025-09-24
+ * @ingroup Logger
+ * @{
+ * @details
+ * This module keeps a copy of every routed log message in the internal flash
+ * partition managed by FlashStore. Messages are collected in RAM pages and
+ * written by a background thread, so logging never waits for flash.
+ */
+
+/* Flash Logger
+ ---
+ # 📝 Overview
+ The RL-ARM RAM drive is lost on reset. FlashLog mirrors the routed log
+ stream into the last three 128 KB flash sectors (Stm32FlashPort), where it
+ survives power cycles; `flashLog out` streams it back over USB.
+
+ # ⚙️ Features
+ - Double-buffered 256-byte RAM pages; log() is a memcpy under a mutex.
+ - One flash record per page (whole messages only), CRC-checked.
+ - Partial pages are flushed after 1 s of inactivity.
+ - The next sector is erased right after a sector switch, on the writer
+   thread, so appends never erase.
+ - Header-only mount at start-up.
+
+ # 📋 Usage
+ Call `FlashLog::getInstance().init()` once at start-up; LogRouter forwards
+ every message when built with FLASH_LOG.
+
+ # 🔧 Implementation Details
+ `pageMutexId` guards the page buffers (hot path), `storeMutexId` guards the
+ store (writer thread and replay). If the writer has not finished the
+ previous page when the current one fills up, new messages are dropped and
+ counted rather than blocking the caller.
+
+ # ⚠️ Limitations
+ The F407 has one flash bank: a 128 KB erase stalls instruction fetches,
+ interrupts included, for 1-2 s. It happens once per 128 KB of logs. The
+ SysTick handler cannot run meanwhile and a pending SysTick is one bit, so
+ the kernel tick falls 1-2 s behind wall time, every deadline and LED edge
+ in that window comes late, and USB is not serviced. FLASH_LOG is therefore
+ off by default; enable it only where that pause is acceptable.
+ */
+
+#include "flash_log.h"
+#include "cmsis_os2.h"
+#include "crash_dump.h"
+#include "flash_port.h"
+#include "flash_store.h"
+#include "usb_logger.h"
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+/**
+ * @brief   Anonymous namespace for internal linkage.
+ * @details Contains the page buffers, the store and thread memory.
+ */
+namespace {
+constexpr uint32_t FLASH_PAGE_FLAG = 0x0001U; /*!< Full page pending */
+constexpr uint32_t FLASH_FLUSH_MS = 1000U;    /*!< Partial page flush delay */
+
+/** @brief RAM page collecting messages for one flash record */
+struct Page {
+  uint32_t len;                             /*!< Bytes used */
+  char data[FlashLog::FLASH_PAGE_SIZE];     /*!< Message bytes */
+};
+
+std::array<Page, 2> pages;   /*!< Fill page and write page */
+uint32_t fillIdx = 0U;       /*!< Page being filled (under pageMutexId) */
+bool pending = false;        /*!< Other page awaits writing (pageMutexId) */
+std::atomic_uint32_t dropped = 0U; /*!< Messages dropped, writer behind */
+
+Stm32FlashPort flashPort;           /*!< Internal flash sectors 9..11 */
+FlashStore store(flashPort);        /*!< Record store on the partition */
+osMutexId_t pageMutexId = nullptr;  /*!< Guards page buffers */
+osMutexId_t storeMutexId = nullptr; /*!< Guards the store */
+std::array<char, FlashLog::FLASH_PAGE_SIZE> replay_buf; /*!< Replay buffer */
+
+uint64_t flash_stack[256]
+    __attribute__((aligned(64))); /*!< Static thread stack (aligned) */
+uint64_t flash_cb[32]
+    __attribute__((aligned(64))); /*!< Static thread control block (aligned) */
+
+constexpr osThreadAttr_t flashThreadAttr = {
+    .name = "Flash Log",               /*!< Name for debugging */
+    .attr_bits = 0U,                   /*!< No special thread attributes */
+    .cb_mem = flash_cb,                /*!< Memory for thread control block */
+    .cb_size = sizeof(flash_cb),       /*!< Size of control block */
+    .stack_mem = flash_stack,          /*!< Pointer to static stack */
+    .stack_size = sizeof(flash_stack), /*!< Stack size in bytes */
+    .priority = osPriorityLow          /*!< Below replay threads */
+};
+
+constexpr osMutexAttr_t pageMutexAttr = {
+    .name = "FlashPageMutex",       /*!< Name for debugging */
+    .attr_bits = osMutexPrioInherit /*!< Priority inheritance */
+};
+
+constexpr osMutexAttr_t storeMutexAttr = {
+    .name = "FlashStoreMutex",      /*!< Name for debugging */
+    .attr_bits = osMutexPrioInherit /*!< Priority inheritance */
+};
+} // namespace
+
+/**
+ * @brief   Constructor (private for singleton pattern).
+ */
+FlashLog::FlashLog() {}
+
+/**
+ * @brief   Get the singleton instance of FlashLog.
+ * @return  Reference to FlashLog instance.
+ */
+FlashLog &FlashLog::getInstance() {
+  static FlashLog instance;
+  return instance;
+}
+
+/**
+ * @brief   Mount the flash store and start the page writer.
+ * @return  FLASH_LOG_OK or an error code.
+ */
+FlashLog::FlashLogStatus FlashLog::init() {
+  FlashStore::FlashStatus status = store.mount();
+  if (status < FlashStore::FLASH_OK) {
+    UsbLogger::getInstance().log("Error: Flash log store mount failed.\r\n");
+    return FLASH_LOG_MOUNT_ERROR;
+  }
+
+  pageMutexId = osMutexNew(&pageMutexAttr);
+  storeMutexId = osMutexNew(&storeMutexAttr);
+  if (pageMutexId == nullptr || storeMutexId == nullptr) {
+    UsbLogger::getInstance().log(
+        "Error: Flash log mutex can not be created.\r\n");
+    return FLASH_LOG_RTOS_ERROR;
+  }
+
+  threadId = osThreadNew(writerThreadWrapper, this, &flashThreadAttr);
+  if (threadId == nullptr) {
+    UsbLogger::getInstance().log(
+        "Error: Flash log thread can not be created.\r\n");
+    return FLASH_LOG_RTOS_ERROR;
+  }
+  ready = true;
+  if (status == FlashStore::FLASH_FORMATTED) {
+    log("Info: Flash log store formatted.\r\n");
+  }
+  return FLASH_LOG_OK;
+}
+
+/**
+ * @brief   Queue a message for the flash store.
+ * @details Copies the message into the fill page. When it does not fit, the
+ *          page is handed to the writer thread and the other page is used.
+ *          Messages longer than a page are truncated.
+ * @param   msg Message to store.
+ */
+void FlashLog::log(std::string_view msg) {
+  if (!ready) {
+    return;
+  }
+  const uint32_t len = (msg.length() < FLASH_PAGE_SIZE)
+                           ? static_cast<uint32_t>(msg.length())
+                           : FLASH_PAGE_SIZE;
+  osMutexAcquire(pageMutexId, osWaitForever);
+  if (pages[fillIdx].len + len > FLASH_PAGE_SIZE) {
+    if (pending) {
+      osMutexRelease(pageMutexId);
+      dropped.fetch_add(1U); /* Writer behind: drop, never block */
+      return;
+    }
+    pending = true;
+    fillIdx ^= 1U;
+    pages[fillIdx].len = 0U;
+    osThreadFlagsSet(threadId, FLASH_PAGE_FLAG);
+  }
+  Page &page = pages[fillIdx];
+  std::memcpy(page.data + page.len, msg.data(), len);
+  page.len += len;
+  osMutexRelease(pageMutexId);
+}
+
+/**
+ * @brief   Stream every stored record to USB, oldest first.
+ * @details Runs on the caller's thread; records are read one at a time under
+ *          the store mutex, so the writer thread keeps running in between.
+ * @return  FLASH_LOG_OK or FLASH_LOG_NOT_INITIALIZED.
+ */
+FlashLog::FlashLogStatus FlashLog::replayToUsb() {
+  if (!ready) {
+    return FLASH_LOG_NOT_INITIALIZED;
+  }
+  uint32_t skipped = 0U;
+  UsbLogger::getInstance().usbXferChunk(
+      "Reply: Replaying logs from flash to USB...\r\n");
+  osMutexAcquire(storeMutexId, osWaitForever);
+  FlashStore::Cursor cursor = store.oldest();
+  osMutexRelease(storeMutexId);
+  for (;;) {
+    osMutexAcquire(storeMutexId, osWaitForever);
+    int32_t n = store.read(cursor, replay_buf.data(), replay_buf.size());
+    osMutexRelease(storeMutexId);
+    if (n == FlashStore::READ_END) {
+      break;
+    }
+    if (n < 0) {
+      skipped++; /* Damaged record, continue with the next one */
+      continue;
+    }
+    while (UsbLogger::getInstance().usbXferChunk(
+               std::string_view(replay_buf.data(), n)) != 0) {
+      osDelay(10); /* Wait and retry if USB transfer fails */
+    }
+  }
+  std::array<char, 64> reply;
+  snprintf(reply.data(), reply.size(),
+           "Reply: Flash replay done, %u records skipped.\r\n",
+           static_cast<unsigned>(skipped));
+  UsbLogger::getInstance().usbXferChunk(reply.data());
+  return FLASH_LOG_OK;
+}
+
+/**
+ * @brief   Fill a status snapshot.
+ * @param   stats Snapshot to fill (zero if not initialized).
+ */
+void FlashLog::getStats(Stats &stats) {
+  stats = Stats{};
+  if (!ready) {
+    return;
+  }
+  osMutexAcquire(storeMutexId, osWaitForever);
+  stats.used = store.usedBytes();
+  stats.capacity = store.capacity();
+  store.eraseCounts(stats.minErase, stats.maxErase);
+  osMutexRelease(storeMutexId);
+  stats.dropped = dropped.load();
+}
+
+/**
+ * @brief   Move unwritten page contents into the crash dump.
+ * @details Fault context only: reads the pages without the mutex.
+ */
+void FlashLog::crashDrain() {
+  if (!ready) {
+    return;
+  }
+  if (pending) {
+    const Page &page = pages[fillIdx ^ 1U];
+    CrashDump::getInstance().capture(std::string_view(page.data, page.len));
+  }
+  const Page &page = pages[fillIdx];
+  CrashDump::getInstance().capture(std::string_view(page.data, page.len));
+}
+
+/**
+ * @brief   Static wrapper to run the writer loop.
+ * @param   argument Pointer to FlashLog instance.
+ */
+void FlashLog::writerThreadWrapper(void *argument) {
+  static_cast<FlashLog *>(argument)->writerThread();
+}
+
+/**
+ * @brief   Page writer loop.
+ * @details Writes full pages as they are handed over and partial pages
+ *          after FLASH_FLUSH_MS without a full one. Erases the spare sector
+ *          after a sector switch.
+ */
+void FlashLog::writerThread() {
+  for (;;) {
+    uint32_t flags =
+        osThreadFlagsWait(FLASH_PAGE_FLAG, osFlagsWaitAny, FLASH_FLUSH_MS);
+    bool timeout = (flags == static_cast<uint32_t>(osErrorTimeout));
+
+    osMutexAcquire(pageMutexId, osWaitForever);
+    if (!pending && timeout && pages[fillIdx].len > 0U) {
+      pending = true; /* Flush the partial page */
+      fillIdx ^= 1U;
+      pages[fillIdx].len = 0U;
+    }
+    const bool write = pending;
+    const Page &page = pages[fillIdx ^ 1U];
+    osMutexRelease(pageMutexId);
+    if (!write) {
+      continue;
+    }
+
+    osMutexAcquire(storeMutexId, osWaitForever);
+    FlashStore::FlashStatus status = store.append(page.data, page.len);
+    if (status == FlashStore::FLASH_OK && store.needsPrepare()) {
+      status = store.prepare(); /* Erase now, not in a later append */
+    }
+    osMutexRelease(storeMutexId);
+
+    osMutexAcquire(pageMutexId, osWaitForever);
+    pending = false;
+    osMutexRelease(pageMutexId);
+    if (status != FlashStore::FLASH_OK) {
+      UsbLogger::getInstance().log("Error: Flash log write failed.\r\n");
+    }
+  }
+}
+
+/** @} */ // end of Logger
@@ -0,0 +1,101 @@
+/**
+ * @file    flash_port.cpp
+ * @brief   STM32F4 internal flash access for the flash log store.
+ * @author  Mitul Goti
+ * @version 1.0
+ * @date    2025-09-24
+ * @ingroup Logger
+ * @{
+ * @details
+ * Implements Stm32FlashPort on top of the HAL flash driver. The partition is
+ * the last three 128 KB sectors of the 1 MB flash.
+ */
+
+/* STM32 Flash Port
+ ---
+ # 📝 Overview
+ Maps the FlashPort sector/offset addressing onto absolute flash addresses and
+ HAL sector numbers.
+
+ # 🔧 Implementation Details
+ Words are programmed with FLASH_TYPEPROGRAM_WORD (2.7-3.6 V range). The
+ STM32F407 has a single flash bank, so instruction fetches stall while a
+ word is programmed (~16 us) or a sector is erased (~1-2 s for 128 KB); the
+ store therefore only erases from its background thread, once per sector.
+ Interrupts stall too: the kernel loses the SysTicks of an erase.
+ */
+
+#include "flash_port.h"
+#include "stm32f4xx_hal.h"
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @brief   Read from the partition.
+ * @param   sector Sector index within the partition.
+ * @param   offset Byte offset within the sector.
+ * @param   buf    Destination.
+ * @param   len    Bytes to read.
+ * @return  true on success.
+ */
+bool Stm32FlashPort::read(std::uint32_t sector, std::uint32_t offset,
+                          void *buf, std::uint32_t len) {
+  if (sector >= SECTOR_COUNT || offset + len > SECTOR_SIZE) {
+    return false;
+  }
+  std::memcpy(buf,
+              reinterpret_cast<const void *>(BASE_ADDRESS +
+                                             sector * SECTOR_SIZE + offset),
+              len);
+  return true;
+}
+
+/**
+ * @brief   Program words into the partition.
+ * @param   sector Sector index within the partition.
+ * @param   offset Byte offset within the sector (word aligned).
+ * @param   data   Source data.
+ * @param   len    Bytes to program (multiple of 4).
+ * @return  true on success.
+ */
+bool Stm32FlashPort::program(std::uint32_t sector, std::uint32_t offset,
+                             const void *data, std::uint32_t len) {
+  if (sector >= SECTOR_COUNT || offset + len > SECTOR_SIZE ||
+      ((offset | len) & 3U) != 0U) {
+    return false;
+  }
+  const std::uint8_t *src = static_cast<const std::uint8_t *>(data);
+  std::uint32_t address = BASE_ADDRESS + sector * SECTOR_SIZE + offset;
+  bool ok = true;
+  HAL_FLASH_Unlock();
+  for (std::uint32_t i = 0; ok && i < len; i += 4U) {
+    std::uint32_t word;
+    std::memcpy(&word, src + i, sizeof(word));
+    ok = HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, address + i, word) == HAL_OK;
+  }
+  HAL_FLASH_Lock();
+  return ok;
+}
+
+/**
+ * @brief   Erase one sector of the partition.
+ * @param   sector Sector index within the partition.
+ * @return  true on success.
+ */
+bool Stm32FlashPort::erase(std::uint32_t sector) {
+  if (sector >= SECTOR_COUNT) {
+    return false;
+  }
+  FLASH_EraseInitTypeDef erase = {};
+  erase.TypeErase = FLASH_TYPEERASE_SECTORS;
+  erase.Sector = FIRST_SECTOR + sector;
+  erase.NbSectors = 1U;
+  erase.VoltageRange = FLASH_VOLTAGE_RANGE_3;
+  std::uint32_t badSector = 0U;
+  HAL_FLASH_Unlock();
+  bool ok = HAL_FLASHEx_Erase(&erase, &badSector) == HAL_OK;
+  HAL_FLASH_Lock();
+  return ok;
+}
+
+/** @} */ // end of Logger
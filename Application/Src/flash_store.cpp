@@ -0,0 +1,506 @@
+/**
+ * @file    flash_store.cpp
+ * @brief   Log-structured record store on a NOR flash partition.
+ * @author  Mitul Goti
+ * @version 1.0
+ * @date    2025-09-24
+ * @ingroup Logger
+ * @{
+ * @details
+ * Implements FlashStore: append-only CRC-checked records, a header-only
+ * mount and sector selection by erase count. Used by FlashLog on the target
+ * and by Tools/flash_sim on a host.
+ */
+
+/* Flash Store
+ ---
+ # 📝 Overview
+ The RAM drive loses its contents on every reset. FlashStore keeps log records
+ in a reserved flash partition so they survive power cycles.
+
+ # ⚙️ Features
+ - Append-only records with a CRC-32 over the payload.
+ - Mount reads only sector headers and record headers, never payloads.
+ - Sectors form a ring ordered by a 32-bit sequence number.
+ - Sector-level wear leveling: spare sectors are picked by lowest erase count,
+   and the erase count is carried across erases in the sector header.
+ - Erasing can be done ahead of time (prepare()) so append() rarely erases.
+
+ # 📋 Usage
+ ```
+ FlashStore store(port);
+ store.mount();
+ store.append(msg, len);
+ FlashStore::Cursor c = store.oldest();
+ while ((n = store.read(c, buf, sizeof(buf))) != FlashStore::READ_END) { ... }
+ ```
+
+ # 🔧 Implementation Details
+ Sector header words: magic, erase count, ~(magic ^ erase count), sequence.
+ The first three are programmed right after the erase (PREPARED), the
+ sequence word when the sector becomes the write sector (USED); NOR flash
+ allows programming an erased word later without another erase.
+
+ Records: {uint16 length, uint16 marker, uint32 crc} + payload padded to a
+ word. The header is programmed before the payload; a payload torn by a power
+ loss fails its CRC and is skipped on read. A damaged record header seals the
+ rest of its sector: mount treats it as full and writing continues in the
+ next sector.
+
+ One sector is kept erased as a spare when prepare() is used, so the ring
+ holds (sectors - 1) sectors of records.
+
+ # ⚠️ Limitations
+ - Not thread safe; the owner serializes calls.
+ - Records are limited to one sector minus headers (and 65534 bytes).
+ */
+
+#include "flash_store.h"
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @brief   Anonymous namespace for internal linkage.
+ * @details Contains on-flash layout constants.
+ */
+namespace {
+constexpr std::uint32_t SECTOR_MAGIC = 0x474F4C46U; /*!< "FLOG" */
+constexpr std::uint16_t RECORD_MARKER = 0x5AA5U;   /*!< Valid record header */
+constexpr std::uint32_t ERASED_WORD = 0xFFFFFFFFU; /*!< Erased flash word */
+constexpr std::uint32_t SEQ_OFFSET = 12U; /*!< Offset of sequence word */
+
+/** @brief On-flash record header */
+struct RecordHeader {
+  std::uint16_t length; /*!< Payload length in bytes */
+  std::uint16_t marker; /*!< RECORD_MARKER */
+  std::uint32_t crc;    /*!< CRC-32 of the payload */
+};
+static_assert(sizeof(RecordHeader) == FlashStore::RECORD_HEADER_SIZE,
+              "Record header layout");
+
+/**
+ * @brief   Space taken by a record on flash.
+ * @param   len Payload length.
+ * @return  Header plus word-padded payload.
+ */
+constexpr std::uint32_t recordSize(std::uint32_t len) {
+  return FlashStore::RECORD_HEADER_SIZE + ((len + 3U) & ~3U);
+}
+} // namespace
+
+/**
+ * @brief   Bind the store to a flash partition.
+ * @param   port Partition (must outlive the store).
+ */
+FlashStore::FlashStore(FlashPort &port) : port(port) {}
+
+/**
+ * @brief   Mount the store.
+ * @details Reads every sector header, then walks the record headers of the
+ *          used sectors to find their ends. Starts a new ring if no used
+ *          sector exists.
+ * @return  FLASH_OK, FLASH_FORMATTED for a new store, or an error.
+ */
+FlashStore::FlashStatus FlashStore::mount() {
+  mounted = false;
+  active = -1;
+  nextSeq = 1U;
+  sectorCount = port.sectorCount();
+  if (sectorCount < 2U || sectorCount > MAX_SECTORS ||
+      port.sectorSize() <= SECTOR_HEADER_SIZE + RECORD_HEADER_SIZE) {
+    return FLASH_GEOMETRY_ERROR;
+  }
+
+  for (std::uint32_t s = 0; s < sectorCount; s++) {
+    std::uint32_t hdr[4];
+    SectorInfo &info = sectors[s];
+    info = SectorInfo{};
+    if (!port.read(s, 0U, hdr, sizeof(hdr))) {
+      return FLASH_PORT_ERROR;
+    }
+    if (hdr[0] == ERASED_WORD && hdr[1] == ERASED_WORD &&
+        hdr[2] == ERASED_WORD && hdr[3] == ERASED_WORD) {
+      info.state = SectorState::BLANK;
+    } else if (hdr[0] == SECTOR_MAGIC && hdr[2] == ~(SECTOR_MAGIC ^ hdr[1])) {
+      info.eraseCount = hdr[1];
+      info.end = SECTOR_HEADER_SIZE;
+      if (hdr[3] == ERASED_WORD) {
+        info.state = SectorState::PREPARED;
+      } else {
+        info.state = SectorState::USED;
+        info.seq = hdr[3];
+        info.end = scanEnd(s);
+        if (active < 0 || info.seq > sectors[active].seq) {
+          active = static_cast<std::int32_t>(s);
+          nextSeq = info.seq + 1U;
+        }
+      }
+    } else {
+      info.state = SectorState::INVALID;
+    }
+  }
+
+  mounted = true;
+  if (active < 0) {
+    FlashStatus status = activate(); /* Empty partition: start the ring */
+    mounted = (status == FLASH_OK);
+    return mounted ? FLASH_FORMATTED : status;
+  }
+  return FLASH_OK;
+}
+
+/**
+ * @brief   Append one record.
+ * @details Switches to the next sector when the record does not fit in the
+ *          current one; that may erase a sector if prepare() was not called.
+ * @param   data Payload.
+ * @param   len  Payload length (empty payloads are ignored).
+ * @return  FLASH_OK or an error.
+ */
+FlashStore::FlashStatus FlashStore::append(const void *data,
+                                           std::uint32_t len) {
+  if (!mounted) {
+    return FLASH_NOT_MOUNTED;
+  }
+  if (len == 0U) {
+    return FLASH_OK;
+  }
+  const std::uint32_t need = recordSize(len);
+  if (len >= 0xFFFFU || need > port.sectorSize() - SECTOR_HEADER_SIZE) {
+    return FLASH_TOO_LARGE;
+  }
+  if (sectors[active].end + need > port.sectorSize()) {
+    FlashStatus status = activate();
+    if (status != FLASH_OK) {
+      return status;
+    }
+  }
+
+  const std::uint32_t s = static_cast<std::uint32_t>(active);
+  const std::uint32_t off = sectors[s].end;
+  /* Advance first: a failed program must never be programmed over again */
+  sectors[s].end = off + need;
+
+  const RecordHeader hdr = {static_cast<std::uint16_t>(len), RECORD_MARKER,
+                            crc32(data, len)};
+  const std::uint8_t *src = static_cast<const std::uint8_t *>(data);
+  const std::uint32_t body = len & ~3U;
+  bool ok = port.program(s, off, &hdr, sizeof(hdr));
+  if (ok && body > 0U) {
+    ok = port.program(s, off + sizeof(hdr), src, body);
+  }
+  if (ok && (len & 3U) != 0U) {
+    std::uint32_t tail = ERASED_WORD;
+    std::memcpy(&tail, src + body, len & 3U);
+    ok = port.program(s, off + sizeof(hdr) + body, &tail, sizeof(tail));
+  }
+  return ok ? FLASH_OK : FLASH_PORT_ERROR;
+}
+
+/**
+ * @brief   Check whether an erased spare sector is available.
+ * @return  true if the next sector switch would have to erase.
+ */
+bool FlashStore::needsPrepare() const {
+  return mounted && pickSpare(true) < 0;
+}
+
+/**
+ * @brief   Erase the next sector ahead of time.
+ * @details Meant for a background context: the erase (and the loss of the
+ *          oldest sector of records) happens here instead of in append().
+ * @return  FLASH_OK or an error.
+ */
+FlashStore::FlashStatus FlashStore::prepare() {
+  if (!mounted) {
+    return FLASH_NOT_MOUNTED;
+  }
+  if (!needsPrepare()) {
+    return FLASH_OK;
+  }
+  std::int32_t s = pickSpare(false);
+  return (s >= 0) ? format(static_cast<std::uint32_t>(s))
+                  : FLASH_GEOMETRY_ERROR;
+}
+
+/**
+ * @brief   Cursor at the oldest record in the ring.
+ * @return  Cursor for read().
+ */
+FlashStore::Cursor FlashStore::oldest() const {
+  Cursor cursor = {nextSeq, SECTOR_HEADER_SIZE};
+  for (std::uint32_t s = 0; s < sectorCount; s++) {
+    if (sectors[s].state == SectorState::USED && sectors[s].seq < cursor.seq) {
+      cursor.seq = sectors[s].seq;
+    }
+  }
+  return cursor;
+}
+
+/**
+ * @brief   Read the record at a cursor.
+ * @details Advances the cursor past the record. If the cursor's sector was
+ *          recycled meanwhile, reading resumes at the oldest remaining
+ *          sector. A cursor at the end stays valid and picks up records
+ *          appended later.
+ * @param   cursor Read position (updated).
+ * @param   buf    Destination for the payload.
+ * @param   size   Size of buf.
+ * @return  Payload length, READ_END, or READ_CRC_ERROR for a skipped record
+ *          (damaged, or larger than buf).
+ */
+std::int32_t FlashStore::read(Cursor &cursor, void *buf, std::uint32_t size) {
+  if (!mounted) {
+    return READ_END;
+  }
+  for (;;) {
+    std::int32_t s = findSeq(cursor.seq);
+    if (s < 0) {
+      /* Sector recycled: continue with the oldest newer one */
+      Cursor first = oldest();
+      if (first.seq <= cursor.seq || first.seq == nextSeq) {
+        return READ_END;
+      }
+      cursor = first;
+      continue;
+    }
+    const SectorInfo &info = sectors[s];
+    if (cursor.offset + RECORD_HEADER_SIZE <= info.end) {
+      RecordHeader hdr;
+      if (!port.read(s, cursor.offset, &hdr, sizeof(hdr))) {
+        return READ_END;
+      }
+      const std::uint32_t off = cursor.offset;
+      const std::uint32_t need = recordSize(hdr.length);
+      if (hdr.marker != RECORD_MARKER || off + need > info.end) {
+        cursor.offset = info.end; /* Rest of the sector is sealed */
+        continue;
+      }
+      cursor.offset = off + need;
+      if (hdr.length > size ||
+          !port.read(s, off + sizeof(hdr), buf, hdr.length) ||
+          crc32(buf, hdr.length) != hdr.crc) {
+        return READ_CRC_ERROR;
+      }
+      return hdr.length;
+    }
+    if (s == active || findSeq(cursor.seq + 1U) < 0) {
+      return READ_END; /* Caught up with the writer */
+    }
+    cursor = {cursor.seq + 1U, SECTOR_HEADER_SIZE};
+  }
+}
+
+/**
+ * @brief   Payload capacity of the ring.
+ * @return  Bytes in all sectors but the spare, excluding sector headers.
+ */
+std::uint32_t FlashStore::capacity() const {
+  return (sectorCount > 0U)
+             ? (sectorCount - 1U) * (port.sectorSize() - SECTOR_HEADER_SIZE)
+             : 0U;
+}
+
+/**
+ * @brief   Bytes currently written.
+ * @return  Sum over used sectors, including record headers.
+ */
+std::uint32_t FlashStore::usedBytes() const {
+  std::uint32_t used = 0U;
+  for (std::uint32_t s = 0; s < sectorCount; s++) {
+    if (sectors[s].state == SectorState::USED) {
+      used += sectors[s].end - SECTOR_HEADER_SIZE;
+    }
+  }
+  return used;
+}
+
+/**
+ * @brief   Lowest and highest erase count of formatted sectors.
+ * @param   min Lowest erase count.
+ * @param   max Highest erase count.
+ */
+void FlashStore::eraseCounts(std::uint32_t &min, std::uint32_t &max) const {
+  min = 0xFFFFFFFFU;
+  max = 0U;
+  for (std::uint32_t s = 0; s < sectorCount; s++) {
+    if (sectors[s].state == SectorState::USED ||
+        sectors[s].state == SectorState::PREPARED) {
+      min = (sectors[s].eraseCount < min) ? sectors[s].eraseCount : min;
+      max = (sectors[s].eraseCount > max) ? sectors[s].eraseCount : max;
+    }
+  }
+  if (min > max) {
+    min = 0U;
+  }
+}
+
+/**
+ * @brief   CRC-32 (polynomial 0xEDB88320, reflected).
+ * @details Nibble table: 64 bytes of constants, two lookups per byte.
+ * @param   data Input.
+ * @param   len  Input length.
+ * @param   crc  Result of a previous call to continue a running CRC.
+ * @return  CRC value.
+ */
+std::uint32_t FlashStore::crc32(const void *data, std::size_t len,
+                                std::uint32_t crc) {
+  static constexpr std::uint32_t table[16] = {
+      0x00000000U, 0x1DB71064U, 0x3B6E20C8U, 0x26D930ACU,
+      0x76DC4190U, 0x6B6B51F4U, 0x4DB26158U, 0x5005713CU,
+      0xEDB88320U, 0xF00F9344U, 0xD6D6A3E8U, 0xCB61B38CU,
+      0x9B64C2B0U, 0x86D3D2D4U, 0xA00AE278U, 0xBDBDF21CU};
+  const std::uint8_t *p = static_cast<const std::uint8_t *>(data);
+  crc = ~crc;
+  for (std::size_t i = 0; i < len; i++) {
+    crc ^= p[i];
+    crc = (crc >> 4) ^ table[crc & 0x0FU];
+    crc = (crc >> 4) ^ table[crc & 0x0FU];
+  }
+  return ~crc;
+}
+
+/**
+ * @brief   Erase a sector and stamp its header.
+ * @param   sector Sector to format.
+ * @return  FLASH_OK or FLASH_PORT_ERROR.
+ */
+FlashStore::FlashStatus FlashStore::format(std::uint32_t sector) {
+  SectorInfo &info = sectors[sector];
+  const bool known = info.state == SectorState::USED ||
+                     info.state == SectorState::PREPARED;
+  const std::uint32_t count = (known ? info.eraseCount : maxEraseCount()) + 1U;
+  const std::uint32_t hdr[3] = {SECTOR_MAGIC, count, ~(SECTOR_MAGIC ^ count)};
+  if (!port.erase(sector) || !port.program(sector, 0U, hdr, sizeof(hdr))) {
+    info.state = SectorState::INVALID;
+    return FLASH_PORT_ERROR;
+  }
+  info = SectorInfo{SectorState::PREPARED, count, 0U, SECTOR_HEADER_SIZE};
+  return FLASH_OK;
+}
+
+/**
+ * @brief   Make the next sector the write sector.
+ * @details Uses a prepared sector if there is one, otherwise formats the
+ *          best candidate first.
+ * @return  FLASH_OK or an error.
+ */
+FlashStore::FlashStatus FlashStore::activate() {
+  std::int32_t s = pickSpare(true);
+  if (s < 0) {
+    s = pickSpare(false);
+    if (s < 0) {
+      return FLASH_GEOMETRY_ERROR;
+    }
+    FlashStatus status = format(static_cast<std::uint32_t>(s));
+    if (status != FLASH_OK) {
+      return status;
+    }
+  }
+  const std::uint32_t seq = nextSeq;
+  if (!port.program(s, SEQ_OFFSET, &seq, sizeof(seq))) {
+    sectors[s].state = SectorState::INVALID;
+    return FLASH_PORT_ERROR;
+  }
+  sectors[s].state = SectorState::USED;
+  sectors[s].seq = seq;
+  sectors[s].end = SECTOR_HEADER_SIZE;
+  active = s;
+  nextSeq++;
+  return FLASH_OK;
+}
+
+/**
+ * @brief   Choose the sector to write next (wear leveling).
+ * @details Prepared sectors first, lowest erase count wins. Otherwise blank
+ *          or damaged sectors, again by erase count (estimated as the
+ *          highest known count). Only then the oldest used sector.
+ * @param   preparedOnly Only consider prepared sectors.
+ * @return  Sector index or -1.
+ */
+std::int32_t FlashStore::pickSpare(bool preparedOnly) const {
+  std::int32_t best = -1;
+  std::uint32_t bestCount = 0xFFFFFFFFU;
+  const std::uint32_t estimate = maxEraseCount();
+  for (std::uint32_t s = 0; s < sectorCount; s++) {
+    const SectorInfo &info = sectors[s];
+    if (static_cast<std::int32_t>(s) == active ||
+        info.state == SectorState::USED ||
+        (preparedOnly && info.state != SectorState::PREPARED)) {
+      continue;
+    }
+    std::uint32_t count =
+        (info.state == SectorState::PREPARED) ? info.eraseCount : estimate;
+    /* Prefer prepared sectors at equal wear: no erase needed */
+    if (best < 0 || count < bestCount ||
+        (count == bestCount && info.state == SectorState::PREPARED)) {
+      best = static_cast<std::int32_t>(s);
+      bestCount = count;
+    }
+  }
+  if (best < 0 && !preparedOnly) {
+    std::uint32_t oldestSeq = 0xFFFFFFFFU;
+    for (std::uint32_t s = 0; s < sectorCount; s++) {
+      if (static_cast<std::int32_t>(s) != active &&
+          sectors[s].state == SectorState::USED &&
+          sectors[s].seq < oldestSeq) {
+        best = static_cast<std::int32_t>(s);
+        oldestSeq = sectors[s].seq;
+      }
+    }
+  }
+  return best;
+}
+
+/**
+ * @brief   Find the used sector with a sequence number.
+ * @param   seq Sequence number.
+ * @return  Sector index or -1.
+ */
+std::int32_t FlashStore::findSeq(std::uint32_t seq) const {
+  for (std::uint32_t s = 0; s < sectorCount; s++) {
+    if (sectors[s].state == SectorState::USED && sectors[s].seq == seq) {
+      return static_cast<std::int32_t>(s);
+    }
+  }
+  return -1;
+}
+
+/**
+ * @brief   Find the end of the written area of a sector.
+ * @details Hops from record header to record header; payloads are not read.
+ * @param   sector Used sector.
+ * @return  Offset of the first erased record header (or sector size if
+ *          the sector is full or sealed by a damaged header).
+ */
+std::uint32_t FlashStore::scanEnd(std::uint32_t sector) {
+  const std::uint32_t size = port.sectorSize();
+  std::uint32_t off = SECTOR_HEADER_SIZE;
+  while (off + RECORD_HEADER_SIZE <= size) {
+    RecordHeader hdr;
+    if (!port.read(sector, off, &hdr, sizeof(hdr))) {
+      return size;
+    }
+    if (hdr.length == 0xFFFFU && hdr.marker == 0xFFFFU) {
+      return off; /* Erased: end of written area */
+    }
+    if (hdr.marker != RECORD_MARKER || off + recordSize(hdr.length) > size) {
+      return size; /* Damaged header: seal the sector */
+    }
+    off += recordSize(hdr.length);
+  }
+  return size;
+}
+
+/**
+ * @brief   Highest erase count of any formatted sector.
+ * @return  Erase count (0 on a fresh partition).
+ */
+std::uint32_t FlashStore::maxEraseCount() const {
+  std::uint32_t min = 0U;
+  std::uint32_t max = 0U;
+  eraseCounts(min, max);
+  return max;
+}
+
+/** @} */ // end of Logger
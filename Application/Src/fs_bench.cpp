@@ -0,0 +1,351 @@
+/**
+ * @file    fs_bench.cpp
+ * @brief   Format and write-amplification benchmark for the RAM log drive.
+ * @author  Mitul Goti
+ * @version 1.0
+ * @date    2025-10-02
+ * @ingroup Logger
+ * @{
+ * @details
+ * Measures how the FlashFS format of R0: affects the cost of log appends,
+ * so FS_LOG_FORMAT is picked from data instead of by habit.
+ */
+
+/* FS Bench
+ ---
+ # 📝 Overview
+ FsLog appends every record (or every compressed frame) with an
+ fopen/fseek/fwrite/fclose cycle. What that costs depends on the volume
+ layout: each append also rewrites FAT and directory sectors. FS Bench
+ formats the drive with every candidate option string and replays
+ synthetic log traffic until the drive is full.
+
+ # ⚙️ Features
+ - Candidates: FS_LOG_FORMAT, FlashFS automatic choice ("") and "/FAT32".
+ - Traffic: one record per append (about 48 bytes) and 512-byte appends
+   (one 2 KB block compressed about 4x, as with FS_LOG_COMPRESS).
+ - Reports the boot sector geometry (FAT type, sectors per cluster, FAT
+   copies, root entries) and the free space after format.
+ - Reports bytes touched per logged byte, p50/p99 append latency and the
+   log bytes held when the drive is full.
+
+ # 📋 Usage
+ Build with FS_BENCH and send `fs bench`. The run takes a few seconds; log
+ messages are staged in RAM meanwhile. The drive is then formatted with
+ FS_LOG_FORMAT again, so the log file is lost. Put the best option string
+ into FS_LOG_FORMAT (project defines) and rebuild.
+
+ # 🔧 Implementation Details
+ The drive is memory, so writes are seen directly: after each append every
+ 512-byte sector of the image is hashed and compared with the previous
+ hash. A sector counts as touched when its contents changed; a sector
+ rewritten with identical bytes is not seen, so the figure is a lower
+ bound of the sector writes. Latency is taken with the RTOS system timer
+ around the append only, not around the hashing.
+
+ FlashFS picks the cluster size from the volume size and fformat() has no
+ cluster option; EFS only serves NOR flash drives. The geometry that can
+ be chosen for R0: is therefore the FAT type (and RAM0_SIZE at build time).
+ */
+
+#include "fs_bench.h"
+
+#ifdef FS_BENCH
+#include "cmsis_os2.h"
+#include "fs_log.h"
+#include "retarget_fs.h"
+#include "rl_fs.h"
+#include "usb_logger.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+extern "C" {
+/* One of the two regions holds the drive, the other is empty */
+extern char Image$$RW_RAM0$$ZI$$Base[];       /*!< RAM drive start */
+extern char Image$$RW_RAM0_KEPT$$ZI$$Limit[]; /*!< RAM drive end */
+}
+
+/**
+ * @brief   Anonymous namespace for internal linkage.
+ * @details Contains the candidate list, the measurement buffers and helpers.
+ */
+namespace {
+constexpr const char *BENCH_DRIVE = "R0:";          /*!< Drive under test */
+constexpr const char *BENCH_FILE = "R0:bench.txt";  /*!< Appended file */
+constexpr const char *BENCH_FORMATS[] = {FS_LOG_FORMAT, "",
+                                         "/FAT32"}; /*!< fformat() options */
+constexpr uint32_t BENCH_APPENDS[] = {64U, 512U};   /*!< Append sizes */
+constexpr uint32_t BENCH_SECTOR_SIZE = 512U;        /*!< RAM drive sector */
+constexpr uint32_t BENCH_MAX_SECTORS = 64U;         /*!< 32 KB drive */
+constexpr uint32_t BENCH_SAMPLES = 1024U;           /*!< Latency samples */
+
+std::array<uint32_t, BENCH_MAX_SECTORS> sector_hash; /*!< Last sector hashes */
+std::array<uint16_t, BENCH_SAMPLES> samples;         /*!< Append latency, us */
+std::array<char, 512> text;                          /*!< Append payload */
+
+/** @brief Volume layout read from the boot sector */
+struct Geometry {
+  const char *fat;          /*!< "FAT12", "FAT16" or "FAT32" */
+  uint32_t clusterSectors;  /*!< Sectors per cluster */
+  uint32_t fats;            /*!< FAT copies */
+  uint32_t rootEntries;     /*!< Fixed root directory entries (FAT12/16) */
+};
+
+/** @brief Outcome of one fill of the drive */
+struct Result {
+  uint32_t logical = 0U; /*!< Log bytes appended */
+  uint32_t touched = 0U; /*!< Bytes of the sectors that changed */
+  uint32_t appends = 0U; /*!< Successful appends */
+  uint32_t p50 = 0U;     /*!< Median append latency in us */
+  uint32_t p99 = 0U;     /*!< 99th percentile append latency in us */
+};
+
+/**
+ * @brief   Read the layout of a freshly formatted volume.
+ * @param   image Start of the drive (boot sector).
+ * @return  Geometry.
+ */
+Geometry boot_geometry(const uint8_t *image) {
+  auto le16 = [image](uint32_t i) {
+    return static_cast<uint32_t>(image[i] | (image[i + 1U] << 8));
+  };
+  Geometry g = {.fat = "FAT32",
+                .clusterSectors = image[0x0DU],
+                .fats = image[0x10U],
+                .rootEntries = le16(0x11U)};
+  const uint32_t fatSectors = le16(0x16U);
+  if (fatSectors != 0U && g.clusterSectors != 0U) {
+    const uint32_t data = le16(0x13U) - le16(0x0EU) - g.fats * fatSectors -
+                          (g.rootEntries * 32U + BENCH_SECTOR_SIZE - 1U) /
+                              BENCH_SECTOR_SIZE;
+    g.fat = (data / g.clusterSectors < 4085U) ? "FAT12" : "FAT16";
+  }
+  return g;
+}
+
+/**
+ * @brief   Count sectors whose contents changed since the last call.
+ * @param   image   Start of the drive.
+ * @param   sectors Sectors to check (<= BENCH_MAX_SECTORS).
+ * @return  Changed sectors.
+ */
+uint32_t sectors_changed(const uint8_t *image, uint32_t sectors) {
+  uint32_t changed = 0U;
+  for (uint32_t s = 0; s < sectors; s++) {
+    uint32_t h = 2166136261U; /* FNV-1a over 32-bit words */
+    for (uint32_t i = 0; i < BENCH_SECTOR_SIZE; i += 4U) {
+      uint32_t w;
+      std::memcpy(&w, image + s * BENCH_SECTOR_SIZE + i, sizeof(w));
+      h = (h ^ w) * 16777619U;
+    }
+    if (h != sector_hash[s]) {
+      sector_hash[s] = h;
+      changed++;
+    }
+  }
+  return changed;
+}
+
+/**
+ * @brief   Fill the text buffer with whole synthetic log lines.
+ * @param   size Upper bound for the text (at least one line is written).
+ * @param   line Running line number.
+ * @return  Text length.
+ */
+uint32_t synthetic_text(uint32_t size, uint32_t &line) {
+  static const char *const leds[] = {"Green", "Orange", "Red", "Blue"};
+  std::array<char, 64> one;
+  uint32_t len = 0U;
+  for (;;) {
+    const uint32_t s = line / 5U;
+    int n = (line % 5U == 4U)
+                ? std::snprintf(one.data(), one.size(),
+                                "[%02u:%02u:%02u.999] Supervisor: Heartbeat "
+                                "%u\r\n",
+                                static_cast<unsigned>(s / 3600U),
+                                static_cast<unsigned>((s / 60U) % 60U),
+                                static_cast<unsigned>(s % 60U),
+                                static_cast<unsigned>(s % 256U))
+                : std::snprintf(one.data(), one.size(),
+                                "[%02u:%02u:%02u.%03u] Event: %s LED toggled "
+                                "%u\r\n",
+                                static_cast<unsigned>(s / 3600U),
+                                static_cast<unsigned>((s / 60U) % 60U),
+                                static_cast<unsigned>(s % 60U),
+                                static_cast<unsigned>((line % 5U) * 137U),
+                                leds[line % 5U],
+                                static_cast<unsigned>(s));
+    if (len > 0U && len + n > size) {
+      return len;
+    }
+    std::memcpy(text.data() + len, one.data(), n);
+    len += n;
+    line++;
+  }
+}
+
+/**
+ * @brief   Append synthetic log text until the drive is full.
+ * @details Each append is the same fopen/fseek/fwrite/fclose cycle FsLog
+ *          uses for a record.
+ * @param   image   Start of the drive.
+ * @param   sectors Sectors of the drive.
+ * @param   size    Append size.
+ * @param   r       Measurements.
+ * @param   ctrl    Optional cancel flag (may be nullptr).
+ * @return  false if cancelled or the file could not be created.
+ */
+bool bench_fill(const uint8_t *image, uint32_t sectors, uint32_t size,
+                Result &r, FsReplayControl *ctrl) {
+  int32_t fd = fs_fopen(BENCH_FILE, FS_FOPEN_CREATE | FS_FOPEN_WR);
+  if (fd < 0) {
+    return false;
+  }
+  fs_fclose(fd);
+  sectors_changed(image, sectors); /* Baseline */
+  const uint64_t freq = osKernelGetSysTimerFreq();
+  uint32_t line = 0U;
+  for (;;) {
+    if (ctrl != nullptr && ctrl->cancel.load()) {
+      return false;
+    }
+    const uint32_t len = synthetic_text(size, line);
+    const uint32_t t0 = osKernelGetSysTimerCount();
+    fd = fs_fopen(BENCH_FILE, FS_FOPEN_APPEND);
+    if (fd < 0) {
+      break;
+    }
+    fs_fseek(fd, 0, SEEK_END);
+    const int32_t n = fs_fwrite(fd, text.data(), len);
+    fs_fclose(fd);
+    const uint32_t dt = osKernelGetSysTimerCount() - t0;
+    if (n > 0) {
+      r.logical += n;
+      r.touched += sectors_changed(image, sectors) * BENCH_SECTOR_SIZE;
+    }
+    if (n != static_cast<int32_t>(len)) {
+      break; /* Drive full */
+    }
+    if (r.appends < BENCH_SAMPLES) {
+      samples[r.appends] =
+          static_cast<uint16_t>(std::min<uint64_t>(dt * 1000000ULL / freq,
+                                                   UINT16_MAX));
+    }
+    r.appends++;
+  }
+  const uint32_t count = std::min(r.appends, BENCH_SAMPLES);
+  if (count > 0U) {
+    std::sort(samples.begin(), samples.begin() + count);
+    r.p50 = samples[count / 2U];
+    r.p99 = samples[count * 99U / 100U];
+  }
+  return true;
+}
+} // namespace
+
+/**
+ * @brief   Run the benchmark and report over USB.
+ * @details Borrows the drive from FsLog (suspend/resume), formats it with
+ *          each candidate in turn and formats it with FS_LOG_FORMAT at the
+ *          end.
+ * @param   ctrl Optional cancel flag (may be nullptr).
+ * @return  FS_TO_USB_OK, FS_TO_USB_CANCELLED or an error status.
+ */
+FsLog::FsLogStatus FsBench::run(FsReplayControl *ctrl) {
+  const uint8_t *image =
+      reinterpret_cast<const uint8_t *>(Image$$RW_RAM0$$ZI$$Base);
+  const uint32_t sectors = std::min<uint32_t>(
+      (Image$$RW_RAM0_KEPT$$ZI$$Limit - Image$$RW_RAM0$$ZI$$Base) /
+          BENCH_SECTOR_SIZE,
+      BENCH_MAX_SECTORS);
+  if (sectors == 0U) {
+    UsbLogger::getInstance().log(
+        "Error: RAM drive region missing in scatter file.\r\n");
+    return FsLog::FS_TO_USB_INIT_ERROR;
+  }
+  if (FsLog::getInstance().suspend() != FsLog::FS_INITIALIZED) {
+    UsbLogger::getInstance().usbXferChunk(
+        "Reply: Bench needs the mounted log drive.\r\n");
+    return FsLog::FS_NOT_INITIALIZED;
+  }
+  UsbLogger::getInstance().usbXferChunk(
+      "Reply: Bench started, log drive erased, logging staged.\r\n");
+
+  std::array<char, 112> line;
+  bool cancelled = false;
+  for (uint32_t f = 0; f < std::size(BENCH_FORMATS) && !cancelled; f++) {
+    const char *fmt = BENCH_FORMATS[f];
+    if (std::find_if(BENCH_FORMATS, BENCH_FORMATS + f, [fmt](const char *o) {
+          return std::strcmp(o, fmt) == 0;
+        }) != BENCH_FORMATS + f) {
+      continue; /* FS_LOG_FORMAT is one of the others */
+    }
+    for (uint32_t a = 0; a < std::size(BENCH_APPENDS) && !cancelled; a++) {
+      fsStatus status = fformat(BENCH_DRIVE, fmt);
+      if (status == fsOK) {
+        status = fmount(BENCH_DRIVE);
+      }
+      if (status != fsOK) {
+        std::snprintf(line.data(), line.size(),
+                      "Reply: Bench \"%s\": format failed (%d).\r\n", fmt,
+                      static_cast<int>(status));
+        UsbLogger::getInstance().usbXferChunk(line.data());
+        break;
+      }
+      if (a == 0U) {
+        const Geometry g = boot_geometry(image);
+        std::snprintf(line.data(), line.size(),
+                      "Reply: Bench \"%s\": %s, %u sectors/cluster, %u FATs, "
+                      "%u root entries, %u B free.\r\n",
+                      fmt, g.fat, static_cast<unsigned>(g.clusterSectors),
+                      static_cast<unsigned>(g.fats),
+                      static_cast<unsigned>(g.rootEntries),
+                      static_cast<unsigned>(ffree(BENCH_DRIVE)));
+        UsbLogger::getInstance().usbXferChunk(line.data());
+      }
+      Result r;
+      cancelled = !bench_fill(image, sectors, BENCH_APPENDS[a], r, ctrl);
+      if (cancelled) {
+        break;
+      }
+      if (r.appends == 0U) {
+        /* Drive full or file not opened: nothing to average */
+        std::snprintf(line.data(), line.size(),
+                      "Reply:   %u B appends: n/a, %u B held.\r\n",
+                      static_cast<unsigned>(BENCH_APPENDS[a]),
+                      static_cast<unsigned>(r.logical));
+        UsbLogger::getInstance().usbXferChunk(line.data());
+        continue;
+      }
+      const uint32_t ratio = static_cast<uint32_t>(
+          static_cast<uint64_t>(r.touched) * 100U / r.logical);
+      std::snprintf(line.data(), line.size(),
+                    "Reply:   %u B appends: %u.%02u B touched/B, p50 %u us, "
+                    "p99 %u us, %u B held.\r\n",
+                    static_cast<unsigned>(r.logical / r.appends),
+                    static_cast<unsigned>(ratio / 100U),
+                    static_cast<unsigned>(ratio % 100U),
+                    static_cast<unsigned>(r.p50),
+                    static_cast<unsigned>(r.p99),
+                    static_cast<unsigned>(r.logical));
+      UsbLogger::getInstance().usbXferChunk(line.data());
+    }
+  }
+
+  const FsLog::FsLogStatus status = FsLog::getInstance().resume();
+  std::snprintf(line.data(), line.size(),
+                "Reply: Bench %s, R0: formatted with \"%s\" (%d).\r\n",
+                cancelled ? "stopped" : "done", FS_LOG_FORMAT,
+                static_cast<int>(status));
+  UsbLogger::getInstance().usbXferChunk(line.data());
+  if (status != FsLog::FS_INITIALIZED) {
+    return status;
+  }
+  return cancelled ? FsLog::FS_TO_USB_CANCELLED : FsLog::FS_TO_USB_OK;
+}
+#endif // FS_BENCH
+
+/** @} */ // end of Logger
@@ -21,9 +21,19 @@
  - Log messages to a file in the embedded file system.
  - Replay log messages over USB CDC.
  - Thread-safe logging using RTOS mutexes.
- - Memory pool management for log buffers.
+ - Memory pool of reader handles, each with its own cursor and buffer.
+ - Follow mode ("tail -f") fed directly by committed records.
  - Configurable log file name and path.
  - Automatic log file rotation.
+ - Cached free-space accounting in clusters of the mounted drive (ffree()
+   only at mount and on re-sync).
+ - Background mount; early messages staged in RAM, USB fallback on failure.
+ - Optional warm-reset survival of the RAM drive (FS_LOG_WARM_RESET).
+ - Optional LZ77 block compression of the log file (FS_LOG_COMPRESS).
+ - Raw image export of the R0: drive over USB ("fs dump").
+ - fformat() options from FS_LOG_FORMAT; suspend()/resume() lend the drive
+   to the format benchmark (FsBench).
+ - Windowed replay acknowledged by the host, resumable ("fsLog get").
  - Integration with USB Logger for unified logging.
  - Error handling for file system operations.
  - Profiling support using Event Recorder.
@@ -38,7 +48,12 @@
  Command         | Description |
  |-----------------|------------------------------------------------------------------|
  | `<number>`      | Set LED ON time in milliseconds (valid range: 100–2000). |
- | `fsLog out`     | Replay file system logs to USB. |
+ | `fsLog out`     | Replay file system logs to USB (background worker). |
+ | `fsLog out <filter>` | Replay only matching lines (e.g. `err since 12:00:00`). |
+ | `fsLog stop`    | Cancel a running replay. |
+ | `fsLog follow on/off` | Stream new records to USB as they are committed. |
+ | `fsLog status`  | Show replay progress. |
+ | `fsLog throttle <ms>` | Delay between replay chunks. |
  | `fsLog on`      | Enable file system logging (disables USB logging). |
  | `fsLog off`     | Disable file system logging. |
  | `help`          | Show this help message. |
@@ -52,7 +67,48 @@
  synchronization. The logger maintains a mutex for thread-safe access to the
  file system and a memory pool for log buffers.
 
- The log file is created during initialization, and messages are appended to it.
+ The drive is mounted and the log file created by a one-shot "Fs Mount" thread,
+so start-up is not blocked by finit()/fformat(). Until the mount completes,
+messages go into a 1 KB RAM staging ring (oldest whole messages dropped).
+Holding the mutex, the mount thread flushes the ring into the file, or to
+the USB logger if the mount failed, and only then publishes the final
+state, so no later message can overtake a staged one. Afterwards messages
+are appended to the file.
+
+With FS_LOG_WARM_RESET the drive buffer lives in no-init RAM next to a small
+CRC-protected superblock. After a reset that was not a power-on/brown-out
+reset and with a valid superblock, the drive is remounted and checked with
+fcheck() instead of formatted, so the log from before the reset is kept.
+The superblock is cleared before any format. Every other mount formats the
+drive, and without the define the buffer is ordinary zeroed RAM. init()
+samples the reset flags in RCC->CSR; app_main() clears them afterwards.
+
+With FS_LOG_COMPRESS, log() copies records into a 2 KB block in RAM. A full
+block is compressed by LogCodec and appended as one frame ("log.lzb"), so
+the drive holds about four times more log and sees one fopen/fwrite/fclose
+per block instead of per record. Follow mode still gets every record right
+away. A replay first flushes the open block, then decodes the frame at its
+cursor and streams the text in whole lines; damaged frames are skipped by
+searching for the next valid frame header. Compression needs about 7 KB of
+RAM (block, frame scratch, match table, decoded frame). The open block
+lives in no-init RAM with a running CRC-32: with FS_LOG_WARM_RESET a warm
+mount adopts it and later records are appended behind the old ones, and
+faults hand it to CrashDump instead. `fs dump` flushes it first, so the
+image holds every record logged before the dump.
+
+dumpToUsb() sends the drive buffer itself (RW_RAM0 or RW_RAM0_KEPT in the
+scatter file) in 1 KB blocks, each copied under the mutex and sent with its
+offset and CRC-32 in one USB transfer. It runs on the replay worker and
+ends with the CRC of the whole image and the number of file writes during
+the dump, so the host can tell a consistent image from one that changed
+underneath.
+
+replayWindowToUsb() is the reliable replay: chunks carry a sequence number,
+the reader position behind them and a CRC-32, up to FS_WINDOW_CHUNKS are in
+flight, and the host acknowledges cumulatively. Lost chunks are re-read
+from the file (go-back-N), so the window costs no RAM beyond one chunk.
+The reader is left behind the last acknowledged chunk only; a later
+`fsLog get` continues there.
  If a write error occurs or the file system is full, the logger attempts to
  recreate the log file. The logger can replay logs over USB by reading from
  the file and sending the data via the USB Logger.
@@ -83,10 +139,15 @@
 
 #include "fs_log.h"
 #include "cmsis_os2.h"
+#include "crash_dump.h"
+#include "flash_store.h"
+#include "log_codec.h"
 #include "logger.h"
 #include "retarget_fs.h"
 #include "rl_fs.h"
+#include "stm32f4xx.h" // IWYU pragma: keep
 #include "usb_logger.h"
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <cstddef>
@@ -105,21 +166,145 @@
  */
 namespace {
 std::string_view drive_r0 = "R0:";      /*!< Drive name for FlashFS */
+#ifdef FS_LOG_COMPRESS
+std::string_view file_name = "log.lzb"; /*!< Log file name (LZ frames) */
+#else
 std::string_view file_name = "log.txt"; /*!< Log file name */
+#endif
 std::array<char, 16> file_path;         /*!< Full path for log file */
-std::atomic_uint32_t cursor_pos = 0;    /*!< Cursor position for reading logs */
-constexpr uint32_t block_count = 1;     /*!< Number of memory pool blocks */
-osMemoryPoolId_t fsMemPoolId;           /*!< Memory pool ID for log buffer */
+constexpr uint32_t block_count = 3;     /*!< Number of reader pool blocks */
+osMemoryPoolId_t fsMemPoolId;           /*!< Memory pool ID for readers */
 osMutexId_t fsMutexId;                  /*!< Mutex ID for file system access */
 osThreadId_t threadId = nullptr;        /*!< RTOS thread ID for logger */
-char *fs_buf = nullptr; /*!< Buffer for file system operations */
-constexpr uint32_t FS_DATA_PACKET_SIZE =
-    256; /*!< Data packet size for USB transfer */
+FsReader *defaultReader = nullptr;      /*!< Reader behind plain replays */
+std::atomic_uint32_t fileGeneration = 0; /*!< Bumped when file is recreated */
+
+constexpr uint32_t FS_FOLLOW_SIZE = 512; /*!< Follow ring size (power of 2) */
+std::array<char, FS_FOLLOW_SIZE> follow_ring; /*!< Committed, unread records,
+                                                 each '\0'-terminated */
+uint32_t follow_head = 0;               /*!< Write index (under fsMutexId) */
+uint32_t follow_tail = 0;               /*!< Read index (under fsMutexId) */
+std::atomic_bool follow_active = false; /*!< Follow mode enabled */
+std::atomic_uint32_t follow_dropped = 0; /*!< Records lost to overflow */
+osSemaphoreId_t followSemId = nullptr;  /*!< Signals new follow data */
+
+constexpr uint32_t FS_CLUSTER_SIZE = 512U; /*!< Allocation unit assumed if
+                                              the boot sector is unreadable */
+uint32_t fs_cluster_size = FS_CLUSTER_SIZE; /*!< Allocation unit of the drive,
+                                               read from its boot sector */
+constexpr uint32_t FS_FREE_RESYNC_WRITES = 64U; /*!< Appends between ffree()
+                                                   re-syncs */
+std::atomic_uint32_t fs_free_bytes = 0U; /*!< Cached free space on drive */
+std::atomic_uint32_t fs_writes = 0U;     /*!< File writes since boot */
+std::array<uint8_t, sizeof(FsLog::DumpBlockHeader) + FsLog::FS_DUMP_BLOCK_SIZE>
+    dump_buf; /*!< Header and image copy of one dump block */
+uint32_t writes_since_sync = 0U;         /*!< Appends since last re-sync */
+
+constexpr uint32_t FS_WINDOW_TIMEOUT_MS = 500U; /*!< No ack: resend window */
+constexpr uint32_t FS_WINDOW_RETRIES = 10U; /*!< Resends before pausing */
+constexpr uint32_t FS_WINDOW_POLL_MS = 5U;  /*!< Ack polling interval */
+uint32_t window_seq = 0U; /*!< Next chunk sequence number (replay worker);
+                             never reused, so late acks are ignored */
+std::array<uint8_t,
+           sizeof(FsLog::ReplayChunkHeader) + FsLog::FS_DATA_PACKET_SIZE>
+    window_buf; /*!< Header and text of one windowed replay chunk */
+
+constexpr uint32_t FS_STAGING_SIZE = 1024; /*!< Staging ring size (power of 2) */
+std::array<char, FS_STAGING_SIZE> staging_ring; /*!< Messages logged while
+                                                   the drive is mounting */
+uint32_t staging_head = 0;          /*!< Write index (under fsMutexId) */
+uint32_t staging_tail = 0;          /*!< Read index (under fsMutexId) */
+uint32_t staging_dropped = 0;       /*!< Messages lost to ring overflow */
+std::array<char, FS_STAGING_SIZE> staging_line; /*!< One popped message; as
+                          large as the ring, so never cut (under fsMutexId) */
+
+#ifdef FS_LOG_COMPRESS
+std::array<uint8_t, LogCodec::FRAME_MAX_SIZE> block_frame; /*!< Frame
+                       scratch for writes and replay reads (fsMutexId) */
+std::array<uint16_t, LogCodec::HASH_SIZE> block_hash; /*!< Match finder */
+std::array<char, LogCodec::BLOCK_SIZE> frame_text; /*!< Text of the last
+                                        decoded frame (under fsMutexId) */
+uint32_t frame_text_pos = UINT32_MAX; /*!< File offset of that frame */
+uint32_t frame_text_gen = 0U;         /*!< File generation of that frame */
+uint32_t frame_text_len = 0U;         /*!< Text bytes of that frame */
+uint32_t frame_file_len = 0U;         /*!< File bytes of that frame */
+#endif
+
+#ifdef FS_LOG_WARM_RESET
+constexpr bool FS_KEEP_RAM0 = true; /*!< RAM drive kept across warm resets */
+#else
+constexpr bool FS_KEEP_RAM0 = false; /*!< RAM drive formatted on every boot */
+#endif
+bool fs_cold_start = true; /*!< Reset cause, sampled by FsLog::init() */
+constexpr uint32_t FS_SUPERBLOCK_MAGIC = 0x42535346U; /*!< "FSSB" */
+constexpr uint32_t FS_RAM0_SIZE = 0x8000U; /*!< RAM0_SIZE, FS_Config_RAM_0.h */
+
+/**
+ * @struct  FsSuperblock
+ * @brief   Validity stamp of the RAM drive, kept in no-init RAM.
+ * @details Written once the drive is mounted, cleared before formatting.
+ *          Lives next to the drive buffer (".bss.noinit.*" sections, see the
+ *          scatter file), so both survive a warm reset together.
+ */
+struct FsSuperblock {
+  uint32_t magic;     /*!< FS_SUPERBLOCK_MAGIC */
+  uint32_t size;      /*!< Drive size the stamp was written for */
+  uint32_t warmBoots; /*!< Warm resets survived by the drive contents */
+  uint32_t crc;       /*!< CRC-32 of the fields above */
+};
+FsSuperblock fs_superblock
+    __attribute__((section(".bss.noinit.fs"))); /*!< Not zeroed at reset */
+
+#ifdef FS_LOG_COMPRESS
+constexpr uint32_t FS_BLOCK_MAGIC = 0x4B4C4246U; /*!< "FBLK" */
+
+/**
+ * @struct  FsOpenBlock
+ * @brief   Records not yet compressed into a frame, kept in no-init RAM.
+ * @details The CRC is extended with every append, so checking it costs one
+ *          pass over the block at mount only. A reset between the copy and
+ *          the header update leaves a CRC that does not match: the block is
+ *          dropped rather than half kept.
+ */
+struct FsOpenBlock {
+  uint32_t magic; /*!< FS_BLOCK_MAGIC while the fields below are in use */
+  uint32_t len;   /*!< Bytes in raw */
+  uint32_t crc;   /*!< CRC-32 of raw[0, len) */
+  std::array<char, LogCodec::BLOCK_SIZE> raw; /*!< Records, oldest first */
+};
+FsOpenBlock fs_block __attribute__((
+    section(".bss.noinit.fs"))); /*!< Open block (under fsMutexId) */
+#endif
+} // namespace
+
+extern "C" {
+/* One of the two regions holds the drive, the other is empty */
+extern char Image$$RW_RAM0$$ZI$$Base[];       /*!< RAM drive start */
+extern char Image$$RW_RAM0_KEPT$$ZI$$Limit[]; /*!< RAM drive end */
+}
+
+/**
+ * @struct  FsReader
+ * @brief   Reader handle: private cursor and read buffer.
+ * @details Allocated from the reader memory pool, so concurrent replays never
+ *          share a cursor or a buffer.
+ */
+struct FsReader {
+  std::uint32_t cursor;     /*!< Next file offset to read */
+  std::uint32_t generation; /*!< File generation the cursor refers to */
+#ifdef FS_LOG_COMPRESS
+  std::uint32_t textPos;  /*!< Text already sent from the frame at cursor */
+  std::uint32_t textLen;  /*!< Text bytes of the frame at cursor */
+  std::uint32_t frameLen; /*!< File bytes of the frame at cursor */
+#endif
+  char buf[FsLog::FS_DATA_PACKET_SIZE]; /*!< Private read buffer */
+};
 
-uint64_t fs_buf_mem[FS_DATA_PACKET_SIZE / 8]
-    __attribute__((aligned(64))); /*!< Memory buffer for file system */
+namespace {
+uint64_t fs_buf_mem[block_count * ((sizeof(FsReader) + 7) / 8)]
+    __attribute__((aligned(64))); /*!< Memory for the reader pool */
 uint64_t fs_buf_cb[32]
-    __attribute__((aligned(64))); /*!< Control block for file system */
+    __attribute__((aligned(64))); /*!< Control block for the reader pool */
 
 /**
  * @brief   Memory pool attributes for log buffer.
@@ -141,6 +326,236 @@ constexpr osMutexAttr_t fsMutexAttr = {
     .attr_bits = osMutexPrioInherit /*!< Priority inheritance */
 };
 
+uint64_t fs_mount_stack[384]
+    __attribute__((aligned(64))); /*!< Stack for the mount thread */
+uint64_t fs_mount_cb[32]
+    __attribute__((aligned(64))); /*!< Control block for the mount thread */
+
+/**
+ * @brief   Thread attributes for the one-shot mount thread.
+ */
+constexpr osThreadAttr_t fsMountThreadAttr = {
+    .name = "Fs Mount",                   /*!< Name for debugging */
+    .attr_bits = 0U,                      /*!< No special thread attributes */
+    .cb_mem = fs_mount_cb,                /*!< Memory for thread control block */
+    .cb_size = sizeof(fs_mount_cb),       /*!< Size of control block */
+    .stack_mem = fs_mount_stack,          /*!< Pointer to static stack */
+    .stack_size = sizeof(fs_mount_stack), /*!< Stack size in bytes */
+    .priority = osPriorityBelowNormal     /*!< Below LED threads */
+};
+
+/**
+ * @brief   Stage a message while the drive is still mounting.
+ * @details Messages are stored '\0'-terminated; on overflow the oldest whole
+ *          messages are dropped. Called with fsMutexId held.
+ * @param   msg Message to stage.
+ */
+void staging_push(std::string_view msg) {
+  uint32_t len = static_cast<uint32_t>(msg.size());
+  if (len >= FS_STAGING_SIZE) {
+    staging_dropped++;
+    return;
+  }
+  while (FS_STAGING_SIZE - (staging_head - staging_tail) < len + 1U) {
+    /* Drop the oldest message */
+    while (staging_ring[staging_tail++ & (FS_STAGING_SIZE - 1)] != '\0') {
+    }
+    staging_dropped++;
+  }
+  for (char c : msg) {
+    staging_ring[staging_head++ & (FS_STAGING_SIZE - 1)] = c;
+  }
+  staging_ring[staging_head++ & (FS_STAGING_SIZE - 1)] = '\0';
+}
+
+/**
+ * @brief   Take the oldest staged message.
+ * @details Called with fsMutexId held while fsInit is still
+ *          FS_NOT_INITIALIZED.
+ * @param   buf  Destination (null-terminated, truncated to size - 1).
+ * @param   size Size of buf.
+ * @return  Length copied, 0 if the ring is empty.
+ */
+uint32_t staging_pop(char *buf, uint32_t size) {
+  uint32_t n = 0;
+  if (staging_tail == staging_head) {
+    return 0U;
+  }
+  for (char c = staging_ring[staging_tail++ & (FS_STAGING_SIZE - 1)];
+       c != '\0'; c = staging_ring[staging_tail++ & (FS_STAGING_SIZE - 1)]) {
+    if (n + 1U < size) {
+      buf[n++] = c;
+    }
+  }
+  buf[n] = '\0';
+  return (n > 0U) ? n : 1U; /* Empty messages still count as popped */
+}
+
+/**
+ * @brief   Read the cluster size of the mounted drive.
+ * @details The drive buffer holds the volume image, so its first sector is
+ *          the FAT boot sector: bytes per sector at 0x0B, sectors per
+ *          cluster at 0x0D. This follows whatever FS_LOG_FORMAT and the
+ *          volume size made fformat() choose.
+ */
+void cluster_size_sync() {
+  const uint8_t *boot =
+      reinterpret_cast<const uint8_t *>(Image$$RW_RAM0$$ZI$$Base);
+  uint32_t size = 0U;
+  if (static_cast<uint32_t>(Image$$RW_RAM0_KEPT$$ZI$$Limit -
+                            Image$$RW_RAM0$$ZI$$Base) >= FS_RAM0_SIZE) {
+    size = (boot[0x0BU] | (static_cast<uint32_t>(boot[0x0CU]) << 8U)) *
+           boot[0x0DU];
+  }
+  fs_cluster_size = (size != 0U) ? size : FS_CLUSTER_SIZE;
+}
+
+/**
+ * @brief   Re-read the free space of the drive.
+ * @details The only place that calls ffree(); called with fsMutexId held (or
+ *          before it exists during init).
+ */
+void free_space_sync() {
+  int64_t free = ffree(drive_r0.data());
+  fs_free_bytes.store(free > 0 ? static_cast<uint32_t>(free) : 0U);
+  writes_since_sync = 0U;
+  cluster_size_sync(); /* A format may have changed the geometry */
+}
+
+/**
+ * @brief   Account for an append of len bytes at file offset end.
+ * @details Free space only shrinks when the file grows into a new cluster.
+ * @param   end  File size before the append.
+ * @param   len  Bytes appended.
+ */
+void free_space_account(uint32_t end, uint32_t len) {
+  uint32_t before = (end + fs_cluster_size - 1U) / fs_cluster_size;
+  uint32_t after = (end + len + fs_cluster_size - 1U) / fs_cluster_size;
+  uint32_t used = (after - before) * fs_cluster_size;
+  uint32_t free = fs_free_bytes.load();
+  fs_free_bytes.store(free > used ? free - used : 0U);
+  writes_since_sync++;
+}
+
+/**
+ * @brief   Check the reset cause.
+ * @details Power-on and brown-out resets leave no-init RAM undefined. The
+ *          flags are only read here; app_main() clears them once every
+ *          module has seen them.
+ * @return  true for a cold start.
+ */
+bool cold_start() {
+  return (RCC->CSR & (RCC_CSR_PORRSTF | RCC_CSR_BORRSTF)) != 0U;
+}
+
+/**
+ * @brief   Check the superblock left by the previous boot.
+ * @return  true if the RAM drive contents can be trusted.
+ */
+bool superblock_valid() {
+  return fs_superblock.magic == FS_SUPERBLOCK_MAGIC &&
+         fs_superblock.size == FS_RAM0_SIZE &&
+         fs_superblock.crc ==
+             FlashStore::crc32(&fs_superblock, offsetof(FsSuperblock, crc));
+}
+
+/**
+ * @brief   Stamp the superblock after a successful mount.
+ * @param   warmBoots Warm resets survived so far.
+ */
+void superblock_write(uint32_t warmBoots) {
+  fs_superblock.magic = FS_SUPERBLOCK_MAGIC;
+  fs_superblock.size = FS_RAM0_SIZE;
+  fs_superblock.warmBoots = warmBoots;
+  fs_superblock.crc =
+      FlashStore::crc32(&fs_superblock, offsetof(FsSuperblock, crc));
+}
+
+/**
+ * @brief   Invalidate the superblock before the drive is formatted.
+ */
+void superblock_invalidate() { fs_superblock.magic = 0U; }
+
+#ifdef FS_LOG_COMPRESS
+/**
+ * @brief   Check the open block left by the previous boot.
+ * @return  true if its records can be appended to the log.
+ */
+bool block_valid() {
+  return fs_block.magic == FS_BLOCK_MAGIC &&
+         fs_block.len <= LogCodec::BLOCK_SIZE &&
+         fs_block.crc == FlashStore::crc32(fs_block.raw.data(), fs_block.len);
+}
+
+/**
+ * @brief   Start an empty open block.
+ */
+void block_reset() {
+  fs_block.len = 0U;
+  fs_block.crc = FlashStore::crc32(nullptr, 0U);
+  fs_block.magic = FS_BLOCK_MAGIC;
+}
+#endif
+
+/**
+ * @brief   Format the drive with FS_LOG_FORMAT and mount it.
+ * @return  FS_INITIALIZED, FS_FORMAT_ERROR or FS_MOUNT_ERROR.
+ */
+FsLog::FsLogStatus drive_format() {
+  superblock_invalidate(); /* Never trust a half-formatted drive */
+  if (fformat(drive_r0.data(), FS_LOG_FORMAT) != fsOK) {
+    UsbLogger::getInstance().log("Error: Failed to format the drive.\r\n");
+    return FsLog::FS_FORMAT_ERROR;
+  }
+  if (fmount(drive_r0.data()) != fsOK) {
+    UsbLogger::getInstance().log(
+        "Error: Failed to mount the formatted drive.\r\n");
+    return FsLog::FS_MOUNT_ERROR;
+  }
+  return FsLog::FS_INITIALIZED;
+}
+
+/**
+ * @brief   Create the log file if it does not exist.
+ * @return  FS_INITIALIZED or FS_FILE_CREATE_ERROR.
+ */
+FsLog::FsLogStatus log_file_create() {
+  int32_t fd = fs_fopen(file_path.data(),
+                        FS_FOPEN_CREATE | FS_FOPEN_WR); /* Create log file */
+  if (fd < 0) {
+    UsbLogger::getInstance().log("Error: Failed to create log file.\r\n");
+    return FsLog::FS_FILE_CREATE_ERROR;
+  }
+  fs_fclose(fd); /* Close the file after creation */
+  return FsLog::FS_INITIALIZED;
+}
+
+/**
+ * @brief   Append a committed record to the follow ring.
+ * @details Called with fsMutexId held. Records are stored '\0'-terminated,
+ *          like the staging ring, and on overflow the oldest whole records
+ *          are dropped, so a follower never gets half a line. A record too
+ *          long for one follower chunk is dropped itself.
+ * @param   msg Record that was just written to the file.
+ */
+void follow_push(std::string_view msg) {
+  uint32_t len = static_cast<uint32_t>(msg.size());
+  if (len >= FsLog::FS_DATA_PACKET_SIZE) {
+    follow_dropped.fetch_add(1U);
+    return;
+  }
+  while (FS_FOLLOW_SIZE - (follow_head - follow_tail) < len + 1U) {
+    /* Drop the oldest record */
+    while (follow_ring[follow_tail++ & (FS_FOLLOW_SIZE - 1)] != '\0') {
+    }
+    follow_dropped.fetch_add(1U);
+  }
+  for (char c : msg) {
+    follow_ring[follow_head++ & (FS_FOLLOW_SIZE - 1)] = c;
+  }
+  follow_ring[follow_head++ & (FS_FOLLOW_SIZE - 1)] = '\0';
+}
+
 /**
  * @brief   Write a buffer to the file system.
  * @param   fd  File descriptor.
@@ -151,6 +566,26 @@ static std::int32_t fs_write(int32_t &fd, std::string_view buf) {
   return fs_fwrite(fd, buf.data(), buf.length());
 }
 
+/**
+ * @brief   Write a line of text as a record of the log file.
+ * @details With FS_LOG_COMPRESS the text becomes a stored frame, so the file
+ *          stays a sequence of frames; the frame scratch is not touched.
+ * @param   fd   File descriptor.
+ * @param   text Text to write.
+ * @return  Number of text bytes written or negative value on error.
+ */
+static std::int32_t fs_write_text(int32_t &fd, std::string_view text) {
+#ifdef FS_LOG_COMPRESS
+  std::array<uint8_t, LogCodec::FRAME_HEADER_SIZE> hdr;
+  LogCodec::writeHeader(text.data(), text.length(), text.length(), hdr.data());
+  if (fs_fwrite(fd, hdr.data(), hdr.size()) !=
+      static_cast<int32_t>(hdr.size())) {
+    return -1;
+  }
+#endif
+  return fs_write(fd, text);
+}
+
 /**
  * @brief   Recreate the log file after a write error.
  * @param   fd  File descriptor (reference).
@@ -164,13 +599,158 @@ static int32_t fs_recreate(int32_t &fd) {
     fd = fs_fopen(file_path.data(),
                   FS_FOPEN_CREATE | FS_FOPEN_WR); /* Recreate log file */
     if (fd >= 0) {
-      if (fs_write(fd, "Log file recreated after write error.\r\n") > 0) {
+      if (fs_write_text(fd, "Log file recreated after write error.\r\n") >
+          0) {
         return 0;
       }
     }
   } while (--retries > 0); /* Retry up to 3 times */
   return -1;
 }
+
+/**
+ * @brief   Point a reader at a file offset.
+ * @param   reader Reader handle.
+ * @param   offset File offset (a frame start with FS_LOG_COMPRESS).
+ */
+void reader_reset(FsReader *reader, std::uint32_t offset) {
+  reader->cursor = offset;
+  reader->generation = fileGeneration.load();
+#ifdef FS_LOG_COMPRESS
+  reader->textPos = 0U;
+#endif
+}
+
+/**
+ * @brief   Reader position as one number.
+ * @details The file offset; with FS_LOG_COMPRESS the offset of the frame in
+ *          the low 16 bits and the text already sent from it in the high 16
+ *          bits (the drive is 32 KB, a frame at most 2 KB of text).
+ * @param   reader Reader handle.
+ * @return  Position for reader_seek().
+ */
+std::uint32_t reader_tell(const FsReader *reader) {
+#ifdef FS_LOG_COMPRESS
+  return reader->cursor | (reader->textPos << 16);
+#else
+  return reader->cursor;
+#endif
+}
+
+/**
+ * @brief   Restore a position returned by reader_tell().
+ * @param   reader   Reader handle.
+ * @param   position Reader position.
+ */
+void reader_seek(FsReader *reader, std::uint32_t position) {
+#ifdef FS_LOG_COMPRESS
+  reader_reset(reader, position & 0xFFFFU);
+  reader->textPos = position >> 16;
+#else
+  reader_reset(reader, position);
+#endif
+}
+
+/**
+ * @brief   Length of the whole lines at the start of a buffer.
+ * @param   buf Text.
+ * @param   len Text length.
+ * @return  Bytes up to and including the last '\n', 0 if there is none.
+ */
+std::uint32_t line_end(const char *buf, std::uint32_t len) {
+  while (len > 0U && buf[len - 1U] != '\n') {
+    len--;
+  }
+  return len;
+}
+
+/**
+ * @brief   Read the next piece of log text for a reader.
+ * @details Copies whole lines from the reader's position into reader->buf.
+ *          With FS_LOG_COMPRESS the frame at the cursor is decoded first;
+ *          the decoded text is kept, so the following pieces of the same
+ *          frame cost a memcpy. Takes fsMutexId for the file access only.
+ * @param   fd     Log file opened for reading.
+ * @param   size   File size.
+ * @param   reader Reader handle.
+ * @return  Bytes of text in reader->buf, -1 if a damaged frame was skipped.
+ */
+std::int32_t chunk_read(std::int32_t fd, std::uint32_t size,
+                        FsReader *reader) {
+  constexpr std::uint32_t max =
+      FsLog::FS_DATA_PACKET_SIZE - 1U; /* Keep one byte for the null */
+  const std::uint32_t pos = reader->cursor;
+  std::int32_t m;
+  osMutexAcquire(fsMutexId, osWaitForever);
+#ifdef FS_LOG_COMPRESS
+  constexpr std::uint32_t hdr_size = LogCodec::FRAME_HEADER_SIZE;
+  if (frame_text_pos != pos || frame_text_gen != reader->generation) {
+    LogCodec::FrameHeader hdr;
+    std::int32_t len = -1;
+    fs_fseek(fd, pos, SEEK_SET);
+    if (fs_fread(fd, block_frame.data(), hdr_size) ==
+            static_cast<std::int32_t>(hdr_size) &&
+        LogCodec::readHeader(block_frame.data(), hdr) &&
+        pos + hdr_size + hdr.packedLen <= size &&
+        fs_fread(fd, block_frame.data() + hdr_size, hdr.packedLen) ==
+            static_cast<std::int32_t>(hdr.packedLen)) {
+      len = LogCodec::decodeFrame(block_frame.data(), frame_text.data(),
+                                  frame_text.size());
+    }
+    if (len < 0) {
+      frame_text_pos = UINT32_MAX;
+      osMutexRelease(fsMutexId);
+      reader->cursor = pos + 1U; /* Search for the next frame */
+      reader->textPos = 0U;
+      return -1;
+    }
+    frame_text_pos = pos;
+    frame_text_gen = reader->generation;
+    frame_text_len = static_cast<std::uint32_t>(len);
+    frame_file_len = hdr_size + hdr.packedLen;
+  }
+  reader->textPos = std::min(reader->textPos, frame_text_len); /* Seeked */
+  reader->textLen = frame_text_len;
+  reader->frameLen = frame_file_len;
+  m = static_cast<std::int32_t>(
+      std::min(frame_text_len - reader->textPos, max));
+  std::memcpy(reader->buf, frame_text.data() + reader->textPos, m);
+  osMutexRelease(fsMutexId);
+  if (reader->textPos + m < reader->textLen) {
+    std::uint32_t lines = line_end(reader->buf, m);
+    m = (lines > 0U) ? lines : m; /* Overlong line: send it in pieces */
+  }
+#else
+  fs_fseek(fd, pos, SEEK_SET);
+  m = fs_fread(fd, reader->buf, std::min(size - pos, max)); /* Read file */
+  osMutexRelease(fsMutexId);
+  if (m > 0) {
+    m = static_cast<std::int32_t>(line_end(reader->buf, m));
+  }
+#endif
+  return m;
+}
+
+/**
+ * @brief   Move a reader past text that was sent.
+ * @param   reader Reader handle.
+ * @param   len    Text bytes sent from reader->buf.
+ * @return  File bytes completed (for replay progress).
+ */
+std::uint32_t chunk_advance(FsReader *reader, std::uint32_t len) {
+#ifdef FS_LOG_COMPRESS
+  reader->textPos += len;
+  if (reader->textPos < reader->textLen) {
+    return 0U;
+  }
+  reader->cursor += reader->frameLen; /* Frame done: next one */
+  reader->textPos = 0U;
+  return reader->frameLen;
+#else
+  reader->cursor += len; /* Only this reader's cursor moves */
+  return len;
+#endif
+}
 } // namespace
 
 /**
@@ -195,143 +775,345 @@ FsLog &FsLog::getInstance() {
 /**
  * @brief   Initialize the file system logger.
  * @details
- *  - Initializes the file system and creates the log file.
- *  - Sets up mutex and memory pool for thread safety.
+ *  - Sets up mutex, memory pool and follow semaphore.
+ *  - Samples the reset cause before app_main() clears the reset flags.
+ *  - Starts a background thread that mounts (and if needed formats) the
+ *    drive, so application start-up does not wait for the file system.
+ *  - Messages logged meanwhile are staged in RAM (see log()).
  */
 void FsLog::init() {
-  std::int32_t status = 0;
   int32_t n = std::snprintf(file_path.data(), file_path.size(), "%s\\%s",
                             drive_r0.data(), file_name.data());
   // Check for snprintf errors
-  if (n < 0 || n >= file_path.size()) {
+  if (n < 0 || n >= static_cast<int32_t>(file_path.size())) {
     fsInit = FS_FILE_FORMAT_ERROR; /* Mark initialization failure */
     return;
   }
 
-  status = finit(drive_r0.data()); /* Initialize File System */
-  if (status == fsOK) {
-    status = fmount(drive_r0.data()); /* Try to mount the file system */
-    if (status == fsNoFileSystem) {
-      status = fformat(drive_r0.data(), "FAT32"); /* Format if no file system */
-    }
-    if (status == fsOK) {
-      status = fmount(drive_r0.data()); /* Mount again after formatting */
-      if (status == fsOK) {
-        int32_t fd =
-            fs_fopen(file_path.data(),
-                     FS_FOPEN_CREATE | FS_FOPEN_WR); /* Create log file */
-        // Check if file was created successfully
-        if (fd >= 0) {
-          fs_fclose(fd); /* Close the file after creation */
-          this->log("Log file system initialized.\r\n");
-        } else {
-          UsbLogger::getInstance().log("Error: Failed to create log file.\r\n");
-          fsInit = FS_FILE_CREATE_ERROR; /* Mark initialization failure */
-          return;
-        }
-      } else {
-        UsbLogger::getInstance().log(
-            "Error: Failed to mount the formatted drive.\r\n");
-        fsInit = FS_MOUNT_ERROR; /* Mark initialization failure */
-        return;
-      }
-    } else {
-      UsbLogger::getInstance().log("Error: Failed to format the drive.\r\n");
-      fsInit = FS_FORMAT_ERROR; /* Mark initialization failure */
-      return;
-    }
-  } else {
-    UsbLogger::getInstance().log(
-        "Error: RAM drive can not be initialized.\r\n");
-    fsInit = FS_DRIVE_INIT_ERROR; /* Mark initialization failure */
-    return;
-  }
-
   fsMutexId = osMutexNew(&fsMutexAttr);
   if (fsMutexId == nullptr) {
     fsInit = FS_MUTEX_ERROR; /* Mark initialization failure */
     return;
   }
 
-  fsMemPoolId = osMemoryPoolNew(block_count, sizeof(fs_buf_mem),
-                                &fsBufAttr); /* 1 block of 256 bytes */
+  fsMemPoolId =
+      osMemoryPoolNew(block_count, sizeof(fs_buf_mem) / block_count,
+                      &fsBufAttr); /* One block per concurrent reader */
   if (fsMemPoolId == nullptr) {
     UsbLogger::getInstance().log(
         "Error: Memory pool for file system logger can not be created.\r\n");
     fsInit = FS_MEMPOOL_ERROR; /* Mark initialization failure */
     return;
+  }
+  followSemId = osSemaphoreNew(1U, 0U, nullptr);
+
+  fs_cold_start = cold_start(); /* Before app_main() clears the flags */
+  threadId = osThreadNew(mountThreadWrapper, this, &fsMountThreadAttr);
+  if (threadId == nullptr) {
+    mount(); /* No thread available, mount in the caller's context */
+  }
+}
+
+/**
+ * @brief   Static wrapper to run mount() on the background thread.
+ * @param   argument Pointer to FsLog instance.
+ */
+void FsLog::mountThreadWrapper(void *argument) {
+  static_cast<FsLog *>(argument)->mount();
+  osThreadExit();
+}
+
+/**
+ * @brief   Mount the drive and open the log file.
+ * @details
+ *  - Initializes the file system and creates the log file.
+ *  - Flushes staged early-boot messages into the file on success.
+ *  - On failure, hands staged messages to the USB logger, which also becomes
+ *    the sink for all later messages.
+ */
+void FsLog::mount() {
+  std::int32_t status = 0;
+  FsLogStatus result = FS_INITIALIZED;
+
+  const bool kept = !fs_cold_start && FS_KEEP_RAM0; /* No-init RAM survived */
+  bool warm = kept && superblock_valid();
+#ifdef FS_LOG_COMPRESS
+  /* Records of the open block go on into the file after a warm reset */
+  const bool adopted = kept && block_valid() && fs_block.len > 0U;
+  if (!adopted) {
+    block_reset();
+  }
+#endif
+
+  status = finit(drive_r0.data()); /* Initialize File System */
+  if (status == fsOK) {
+    if (warm) {
+      /* Drive survived a warm reset: remount it without formatting */
+      status = fmount(drive_r0.data());
+      if (status == fsOK) {
+        status = fcheck(drive_r0.data()); /* FAT consistency check */
+      }
+      warm = (status == fsOK);
+      if (!warm) {
+        UsbLogger::getInstance().log(
+            "Warning: Kept RAM drive is damaged, formatting.\r\n");
+      }
+    }
+    if (!warm) {
+      superblock_invalidate(); /* Never trust a half-formatted drive */
+      status = fmount(drive_r0.data()); /* Try to mount the file system */
+      /* Not a checked warm remount: whatever the RAM holds, format it */
+      if (status == fsOK || status == fsNoFileSystem) {
+        result = drive_format();
+      } else if (status != fsOK) {
+        UsbLogger::getInstance().log("Error: Failed to mount the drive.\r\n");
+        result = FS_MOUNT_ERROR; /* Mark initialization failure */
+      }
+    }
+    if (result == FS_INITIALIZED) {
+      result = log_file_create();
+    }
   } else {
-    fs_buf = static_cast<char *>(osMemoryPoolAlloc(fsMemPoolId, 0));
-    if (fs_buf == nullptr) {
+    UsbLogger::getInstance().log(
+        "Error: RAM drive can not be initialized.\r\n");
+    result = FS_DRIVE_INIT_ERROR; /* Mark initialization failure */
+  }
+
+  if (result == FS_INITIALIZED) {
+    defaultReader = static_cast<FsReader *>(osMemoryPoolAlloc(fsMemPoolId, 0));
+    if (defaultReader == nullptr) {
       UsbLogger::getInstance().log(
           "Error: Memory pool for file system logger allocation failed.\r\n");
-      fsInit = FS_MEMPOOL_ALLOC_ERROR; /* Mark initialization failure */
-      return;
+      result = FS_MEMPOOL_ALLOC_ERROR; /* Mark initialization failure */
+    } else {
+      reader_reset(defaultReader, 0U);
+    }
+  }
+
+  osMutexAcquire(fsMutexId, osWaitForever);
+  if (result == FS_INITIALIZED) {
+    free_space_sync(); /* Only full free-space query until re-sync */
+    superblock_write(warm ? fs_superblock.warmBoots + 1U : 0U);
+  }
+#ifdef FS_LOG_COMPRESS
+  if (result != FS_INITIALIZED) {
+    block_reset(); /* No file to take the adopted records */
+  }
+#endif
+  /* Staged messages first; log() waits on the mutex meanwhile */
+  flushStaging(result == FS_INITIALIZED);
+  fsInit = result;
+  osMutexRelease(fsMutexId);
+
+  std::array<char, 64> line;
+  if (result == FS_INITIALIZED) {
+    if (warm) {
+      std::snprintf(line.data(), line.size(),
+                    "Info: Log file system kept across reset #%u.\r\n",
+                    static_cast<unsigned>(fs_superblock.warmBoots));
+      logsToFs(line.data());
+    } else {
+      logsToFs("Log file system initialized.\r\n");
+    }
+#ifdef FS_LOG_COMPRESS
+    if (adopted) {
+      logsToFs("Info: Open log block kept across reset.\r\n");
+    }
+#endif
+  }
+}
+
+/**
+ * @brief   Write staged messages to their final sink.
+ * @details Called with fsMutexId held, before fsInit leaves
+ *          FS_NOT_INITIALIZED: log() blocks on the mutex until the ring is
+ *          empty, so every staged message lands before any newer one.
+ * @param   toFile true to append to the file, false to fall back to USB.
+ */
+void FsLog::flushStaging(bool toFile) {
+  auto emit = [&](std::string_view msg) {
+    if (toFile) {
+      appendRecord(msg); /* Staged message into the file */
+    } else {
+      UsbLogger::getInstance().log(msg); /* Fall back to USB */
     }
+  };
+  while (staging_pop(staging_line.data(), staging_line.size()) > 0U) {
+    emit(staging_line.data());
+  }
+  if (staging_dropped > 0U) {
+    std::snprintf(staging_line.data(), staging_line.size(),
+                  "Overflow: %u staged log messages dropped.\r\n",
+                  static_cast<unsigned>(staging_dropped));
+    staging_dropped = 0U;
+    emit(staging_line.data());
+  }
+}
+
+/**
+ * @brief   Hand the drive over to a benchmark.
+ * @details Until resume(), log() stages messages in RAM as during the
+ *          mount, and the drive may be formatted at will. The log file is
+ *          lost: resume() formats the drive again.
+ * @return  FS_INITIALIZED if the drive was handed over.
+ */
+FsLog::FsLogStatus FsLog::suspend() {
+  if (fsInit.load() != FS_INITIALIZED) {
+    return FS_NOT_INITIALIZED;
+  }
+  osMutexAcquire(fsMutexId, osWaitForever);
+#ifdef FS_LOG_COMPRESS
+  block_reset(); /* Goes with the file */
+#endif
+  fsInit = FS_NOT_INITIALIZED; /* log() stages from now on */
+  superblock_invalidate();
+  osMutexRelease(fsMutexId);
+  return FS_INITIALIZED;
+}
+
+/**
+ * @brief   Take the drive back after suspend().
+ * @details Formats with FS_LOG_FORMAT, recreates the log file and writes
+ *          the messages staged meanwhile. Reader cursors start over.
+ * @return  Resulting logger state.
+ */
+FsLog::FsLogStatus FsLog::resume() {
+  if (fsInit.load() != FS_NOT_INITIALIZED || defaultReader == nullptr) {
+    return fsInit.load(); /* Not suspended */
+  }
+  FsLogStatus result = drive_format();
+  if (result == FS_INITIALIZED) {
+    result = log_file_create();
   }
-  fsInit = FS_INITIALIZED; /* Mark successful initialization */
-  return;
+  osMutexAcquire(fsMutexId, osWaitForever);
+  if (result == FS_INITIALIZED) {
+    fileGeneration.fetch_add(1U); /* Invalidate all reader cursors */
+    free_space_sync();
+    superblock_write(0U);
+  }
+  flushStaging(result == FS_INITIALIZED); /* Before log() may append */
+  fsInit = result;
+  osMutexRelease(fsMutexId);
+  return result;
 }
 
 /**
  * @brief   Write a message to the log file.
+ * @details With FS_LOG_COMPRESS the message goes into the open block, which
+ *          is compressed and written as one frame when it is full.
  * @param   msg Null-terminated string to write.
  */
 void FsLog::logsToFs(std::string_view msg) {
-  std::int32_t status;
-  std::int32_t fd;
-
   /* Acquire mutex for thread safety */
   osMutexAcquire(fsMutexId, osWaitForever);
-  /* Open log file in append mode */
-  auto append_msg = [&](std::string_view msg) {
-    int32_t status = fs_write(fd, msg.data());
-    fs_fclose(fd);
-    return status;
+  appendRecord(msg);
+  osMutexRelease(fsMutexId);
+}
+
+/**
+ * @brief   Append a message to the log file, fsMutexId already held.
+ * @param   msg Message to write.
+ */
+void FsLog::appendRecord(std::string_view msg) {
+  /* Hand a committed record to a live follower */
+  auto commit = [&](int32_t written) {
+    if (written > 0 && follow_active.load()) {
+      follow_push(msg.substr(0, written));
+      osSemaphoreRelease(followSemId);
+    }
   };
 
-  fd = fs_fopen(file_path.data(), FS_FOPEN_APPEND);
-  if (fd >= 0) {
-    /* Move cursor to end of file */
-    if (fs_fseek(fd, 0, SEEK_END) >= 0) {
-      /* Check free space whether it is greater than the message size */
-      if (ffree(drive_r0.data()) < msg.length()) {
-        /* Not enough space, attempt to recreate the log file */
-        if (fs_recreate(fd) == 0) {
-          int32_t n = append_msg(
-              msg.data());     /* Retry writing the message in the new file */
-          cursor_pos.store(0); /* Reset cursor position */
-          osMutexRelease(fsMutexId);
-          if (n < 0) {
-            UsbLogger::getInstance().log(
-                "Error: Failed to write in the new log file.\r\n");
-          }
-        } else {
-          osMutexRelease(fsMutexId);
-          UsbLogger::getInstance().log("Error: Failed to recreate log file "
-                                       "after multiple attempts.\r\n");
-          return;
-        }
-      } else {
-        int32_t n = append_msg(msg.data()); /* Write the message to the file */
-        osMutexRelease(fsMutexId);
-        if (n < 0) {
-          UsbLogger::getInstance().log(
-              "Error: Failed to write in the log file.\r\n");
-        }
-      }
-    } else {
-      osMutexRelease(fsMutexId);
+#ifdef FS_LOG_COMPRESS
+  msg = msg.substr(0, LogCodec::BLOCK_SIZE);
+  if (fs_block.len + msg.length() > LogCodec::BLOCK_SIZE) {
+    flushBlock(); /* Block full: one file write for the whole block */
+  }
+  std::memcpy(fs_block.raw.data() + fs_block.len, msg.data(), msg.length());
+  fs_block.crc = FlashStore::crc32(msg.data(), msg.length(), fs_block.crc);
+  fs_block.len += msg.length();
+  commit(static_cast<int32_t>(msg.length()));
+#else
+  commit(fileAppend(msg));
+#endif
+}
+
+#ifdef FS_LOG_COMPRESS
+/**
+ * @brief   Compress the open block and append it to the file as a frame.
+ * @details Called with fsMutexId held.
+ */
+void FsLog::flushBlock() {
+  if (fs_block.len == 0U) {
+    return;
+  }
+  uint32_t len = LogCodec::encodeFrame(fs_block.raw.data(), fs_block.len,
+                                       block_frame.data(), block_hash.data());
+  block_reset();
+  fileAppend(std::string_view(
+      reinterpret_cast<const char *>(block_frame.data()), len));
+}
+#endif
+
+/**
+ * @brief   Append bytes to the log file.
+ * @details Called with fsMutexId held. Recreates the file when the drive is
+ *          full.
+ * @param   data Bytes to append.
+ * @return  Number of bytes written or negative value on error.
+ */
+std::int32_t FsLog::fileAppend(std::string_view data) {
+  std::int32_t n;
+  fs_writes.fetch_add(1U); /* Lets a volume dump detect changes */
+  /* Open log file in append mode */
+  std::int32_t fd = fs_fopen(file_path.data(), FS_FOPEN_APPEND);
+  if (fd < 0) {
+    UsbLogger::getInstance().log(
+        "Error: Failed to open the requested file.\r\n");
+    return -1;
+  }
+  /* Move cursor to end of file */
+  int64_t end = fs_fseek(fd, 0, SEEK_END);
+  if (end < 0) {
+    fs_fclose(fd);
+    UsbLogger::getInstance().log(
+        "Error: Failed to set the cursor at the end of the file.\r\n");
+    return -1;
+  }
+  /* Re-sync the cached free space periodically or when it gets tight */
+  if (writes_since_sync >= FS_FREE_RESYNC_WRITES ||
+      fs_free_bytes.load() < data.length() + fs_cluster_size) {
+    free_space_sync();
+  }
+  /* Check free space whether it is greater than the message size */
+  if (fs_free_bytes.load() < data.length()) {
+    /* Not enough space, attempt to recreate the log file */
+    if (fs_recreate(fd) != 0) {
+      UsbLogger::getInstance().log("Error: Failed to recreate log file "
+                                   "after multiple attempts.\r\n");
+      return -1;
+    }
+    n = fs_write(fd, data); /* Retry writing the message in the new file */
+    fs_fclose(fd);
+    fileGeneration.fetch_add(1U); /* Invalidate all reader cursors */
+    free_space_sync();            /* File was removed, start over */
+    if (n < 0) {
       UsbLogger::getInstance().log(
-          "Error: Failed to set the cursor at the end of the file.\r\n");
-      return;
+          "Error: Failed to write in the new log file.\r\n");
     }
   } else {
-    osMutexRelease(fsMutexId);
-    UsbLogger::getInstance().log(
-        "Error: Failed to open the requested file.\r\n");
-    return;
+    n = fs_write(fd, data); /* Write the message to the file */
+    fs_fclose(fd);
+    if (n > 0) {
+      free_space_account(static_cast<uint32_t>(end), n);
+    } else {
+      free_space_sync(); /* Do not trust the cache after an error */
+    }
+    if (n < 0) {
+      UsbLogger::getInstance().log(
+          "Error: Failed to write in the log file.\r\n");
+    }
   }
+  return n;
 }
 
 /**
@@ -339,19 +1121,126 @@ void FsLog::logsToFs(std::string_view msg) {
  * @param   msg Null-terminated string to log.
  */
 void FsLog::log(std::string_view msg) {
-  if (fsInit !=
-      (FS_NOT_INITIALIZED | FS_MEMPOOL_ERROR | FS_MEMPOOL_ALLOC_ERROR)) {
+  switch (fsInit.load()) {
+  case FS_INITIALIZED:
     logsToFs(msg.data());
+    break;
+  case FS_NOT_INITIALIZED:
+    /* Drive still mounting: keep the message in RAM until mount() is done */
+    if (fsMutexId != nullptr) {
+      osMutexAcquire(fsMutexId, osWaitForever);
+    }
+    if (fsInit.load() == FS_NOT_INITIALIZED) {
+      staging_push(msg);
+      if (fsMutexId != nullptr) {
+        osMutexRelease(fsMutexId);
+      }
+    } else {
+      osMutexRelease(fsMutexId);
+      log(msg); /* Mount finished meanwhile */
+    }
+    break;
+  default:
+    UsbLogger::getInstance().log(msg); /* File system unavailable */
+    break;
   }
 }
 
+/**
+ * @brief   Move staged, unwritten messages into the crash dump.
+ * @details Fault context only: reads the staging ring without the mutex.
+ */
+void FsLog::crashDrain() {
+  for (uint32_t i = staging_tail; i != staging_head; i++) {
+    char c = staging_ring[i & (FS_STAGING_SIZE - 1)];
+    if (c != '\0') {
+      CrashDump::getInstance().capture(std::string_view(&c, 1));
+    }
+  }
+#ifdef FS_LOG_COMPRESS
+  /* Records in the open block, not compressed yet */
+  if (block_valid()) {
+    CrashDump::getInstance().capture(
+        std::string_view(fs_block.raw.data(), fs_block.len));
+    fs_block.magic = 0U; /* The crash dump owns them now: not adopted twice */
+  }
+#endif
+}
+
+/**
+ * @brief   Free space on the log drive.
+ * @details Cached value maintained from appended bytes and clusters; no file
+ *          system query is made, so it is cheap enough for telemetry.
+ * @return  Free bytes (0 if not initialized).
+ */
+std::uint32_t FsLog::fsFreeBytes() const { return fs_free_bytes.load(); }
+
+/**
+ * @brief   Open a reader handle with its own cursor and buffer.
+ * @param   offset File offset to start reading from.
+ * @return  Reader handle, or nullptr if the pool is exhausted or the logger
+ *          is not initialized.
+ */
+FsReader *FsLog::openReader(std::uint32_t offset) {
+  if (fsInit != FS_INITIALIZED) {
+    return nullptr;
+  }
+  FsReader *reader = static_cast<FsReader *>(osMemoryPoolAlloc(fsMemPoolId, 0));
+  if (reader != nullptr) {
+    reader_reset(reader, offset);
+  }
+  return reader;
+}
+
+/**
+ * @brief   Return a reader handle to the pool.
+ * @param   reader Handle obtained from openReader() (nullptr is ignored).
+ */
+void FsLog::closeReader(FsReader *reader) {
+  if (reader != nullptr && reader != defaultReader) {
+    osMemoryPoolFree(fsMemPoolId, reader);
+  }
+}
+
+/**
+ * @brief   Get the position of a reader.
+ * @param   reader Reader handle.
+ * @return  Opaque position for seekReader() and `fsLog get`.
+ */
+std::uint32_t FsLog::tellReader(const FsReader *reader) const {
+  return reader_tell(reader);
+}
+
+/**
+ * @brief   Move a reader to a position from tellReader().
+ * @details A position from an older log file generation is not detected;
+ *          with FS_LOG_COMPRESS a bad one is skipped like a damaged frame.
+ * @param   reader   Reader handle.
+ * @param   position Reader position.
+ */
+void FsLog::seekReader(FsReader *reader, std::uint32_t position) {
+  reader_seek(reader, position);
+}
+
 /**
  * @brief   Replay log file contents to USB.
- * @details Reads the log file and sends its contents over USB.
+ * @details Uses the shared default reader, i.e. sends what was logged since
+ *          the previous plain replay.
+ * @param   ctrl Optional progress/cancel block (may be nullptr).
  */
-FsLog::FsLogStatus FsLog::replayLogsToUsb() {
-  if (fsInit == FsLog::FsLogStatus::FS_INITIALIZED) {
-    return FsLog::getInstance().fsLogsToUsb();
+FsLog::FsLogStatus FsLog::replayLogsToUsb(FsReplayControl *ctrl) {
+  return replayLogsToUsb(defaultReader, ctrl);
+}
+
+/**
+ * @brief   Replay log file contents to USB through a reader handle.
+ * @param   reader Reader handle (cursor is advanced).
+ * @param   ctrl   Optional progress/cancel block (may be nullptr).
+ */
+FsLog::FsLogStatus FsLog::replayLogsToUsb(FsReader *reader,
+                                          FsReplayControl *ctrl) {
+  if (fsInit == FsLog::FsLogStatus::FS_INITIALIZED && reader != nullptr) {
+    return FsLog::getInstance().fsLogsToUsb(reader, ctrl);
   }
   return FsLog::FsLogStatus::FS_NOT_INITIALIZED;
 }
@@ -359,20 +1248,46 @@ FsLog::FsLogStatus FsLog::replayLogsToUsb() {
 /**
  * @brief   Logger function to send logs to USB.
  * @details
- *  - Reads new log data from the file.
+ *  - Reads new log data from the file into the reader's own buffer.
+ *  - Drops lines rejected by the optional filter before they reach USB.
  *  - Sends data to USB in chunks.
- *  - Updates cursor position.
+ *  - Updates the reader cursor and progress.
+ *  - Stops between chunks if cancellation is requested and applies the
+ *    configured throttle delay.
+ * @param   reader Reader handle.
+ * @param   ctrl   Optional progress/cancel block (may be nullptr).
  */
-FsLog::FsLogStatus FsLog::fsLogsToUsb() {
+FsLog::FsLogStatus FsLog::fsLogsToUsb(FsReader *reader, FsReplayControl *ctrl) {
   std::int32_t n;
   std::int32_t fd;
-  if (fsInit == FS_NOT_INITIALIZED) {
+  if (fsInit != FS_INITIALIZED) {
     return FsLog::FsLogStatus::FS_TO_USB_INIT_ERROR;
   }
 
+  auto cancelled = [ctrl]() {
+    return (ctrl != nullptr) && ctrl->cancel.load();
+  };
+  const LogScanner *scanner = (ctrl != nullptr) ? ctrl->scanner : nullptr;
+  char *const buf = reader->buf;
+  if (reader->generation != fileGeneration.load()) {
+    reader_reset(reader, 0U); /* File was recreated since the last read */
+  }
+#ifdef FS_LOG_COMPRESS
+  osMutexAcquire(fsMutexId, osWaitForever);
+  flushBlock(); /* The replay includes the records still in RAM */
+  osMutexRelease(fsMutexId);
+#endif
+
   fd = fs_fopen(file_path.data(), FS_FOPEN_RD);
   if (fd >= 0) {
     n = fs_fsize(fd); /* Get file size */
+    if (ctrl != nullptr) {
+      ctrl->sent.store(0U);
+      ctrl->matched.store(0U);
+      ctrl->total.store(n > static_cast<int32_t>(reader->cursor)
+                            ? n - reader->cursor
+                            : 0U);
+    }
     if (n == 0) {
       std::string_view msg = "Info: No logs in the filesystem to replay.\r\n";
       UsbLogger::getInstance().usbXferChunk(msg.data());
@@ -384,33 +1299,49 @@ FsLog::FsLogStatus FsLog::fsLogsToUsb() {
       UsbLogger::getInstance().usbXferChunk(msg.data());
       osDelay(10); /* Small delay to ensure USB is ready */
     }
-    while (n > cursor_pos.load()) {
-      osMutexAcquire(fsMutexId, osWaitForever);
-      fs_fseek(fd, cursor_pos.load(), SEEK_SET);
-
-      int32_t m = fs_fread(fd, fs_buf,
-                           (n - cursor_pos.load()) < FS_DATA_PACKET_SIZE
-                               ? n - cursor_pos.load()
-                               : FS_DATA_PACKET_SIZE); /* Read file content */
-                                                       //     fs_fclose(fd);
-      osMutexRelease(fsMutexId);
-      const char *end_ptr = fs_buf + m;
-      const char *start_ptr = fs_buf;
-      while (end_ptr != start_ptr) {
-        end_ptr--; /* Trim trailing newlines */
-        if (*end_ptr == '\n')
-          break;
+    std::uint32_t damaged = 0U;
+    while (n > static_cast<int32_t>(reader->cursor)) {
+      if (cancelled()) {
+        fs_fclose(fd);
+        return FsLog::FsLogStatus::FS_TO_USB_CANCELLED;
       }
-      m = end_ptr - start_ptr + 1;
-      fs_buf[m] = '\0'; /* Null-terminate the string */
-      if (m > 1) {
-        while (UsbLogger::getInstance().usbXferChunk(fs_buf) ==
-               USB_XFER_ERROR) {
+      /* Whole lines, decompressed with FS_LOG_COMPRESS */
+      int32_t m = chunk_read(fd, static_cast<std::uint32_t>(n), reader);
+      if (m < 0) {
+        damaged++; /* Damaged frame: searching the next one */
+        continue;
+      }
+      if (m > 0) {
+        /* Only matching lines use USB bandwidth */
+        int32_t len = (scanner != nullptr)
+                          ? static_cast<int32_t>(scanner->compact(buf, m))
+                          : m;
+        buf[len] = '\0'; /* Null-terminate the string */
+        while (len > 0 &&
+               UsbLogger::getInstance().usbXferChunk(buf) == USB_XFER_ERROR) {
+          if (cancelled()) {
+            fs_fclose(fd);
+            return FsLog::FsLogStatus::FS_TO_USB_CANCELLED;
+          }
           osDelay(10); /* Wait and retry if USB transfer fails */
         }
-        cursor_pos.fetch_add(m); /* Update cursor position atomically */
+        std::uint32_t done = chunk_advance(reader, m);
+        if (ctrl != nullptr) {
+          ctrl->sent.fetch_add(done);
+          ctrl->matched.fetch_add(len);
+          if (len > 0 && ctrl->throttleMs.load() > 0U) {
+            osDelay(ctrl->throttleMs.load()); /* Yield USB bandwidth */
+          }
+        }
       }
     }
+    if (damaged > 0U) {
+      std::array<char, 64> msg;
+      std::snprintf(msg.data(), msg.size(),
+                    "Error: %u damaged log bytes skipped.\r\n",
+                    static_cast<unsigned>(damaged));
+      UsbLogger::getInstance().log(msg.data());
+    }
   } else {
     UsbLogger::getInstance().log(
         "Error: Failed to open log file for reading.\r\n");
@@ -420,4 +1351,319 @@ FsLog::FsLogStatus FsLog::fsLogsToUsb() {
   return FsLog::FsLogStatus::FS_TO_USB_OK;
 }
 
+/**
+ * @brief   Replay the log file with acknowledged, resumable chunks.
+ * @details
+ *  - Sends chunks of whole lines, each behind a ReplayChunkHeader with a
+ *    sequence number and CRC-32, in one USB transfer per chunk.
+ *  - Keeps up to FS_WINDOW_CHUNKS chunks unacknowledged; the host
+ *    acknowledges cumulatively through ctrl->acked (`fsLog ack <seq>`).
+ *  - Without progress for FS_WINDOW_TIMEOUT_MS the window is sent again
+ *    from the oldest unacknowledged chunk (go-back-N); the file is the
+ *    retransmit buffer, so no chunk copies are kept.
+ *  - After FS_WINDOW_RETRIES resends without progress the replay pauses.
+ *  - On return the reader points behind the last acknowledged chunk, never
+ *    behind data the host did not confirm.
+ * @param   reader Reader handle (left at the acknowledged position).
+ * @param   ctrl   Progress/cancel block carrying the acknowledgements.
+ */
+FsLog::FsLogStatus FsLog::replayWindowToUsb(FsReader *reader,
+                                            FsReplayControl *ctrl) {
+  if (fsInit != FS_INITIALIZED || reader == nullptr || ctrl == nullptr) {
+    return FsLog::FsLogStatus::FS_TO_USB_INIT_ERROR;
+  }
+  if (reader->generation != fileGeneration.load()) {
+    reader_reset(reader, 0U); /* File was recreated since the last read */
+  }
+#ifdef FS_LOG_COMPRESS
+  osMutexAcquire(fsMutexId, osWaitForever);
+  flushBlock(); /* The replay includes the records still in RAM */
+  osMutexRelease(fsMutexId);
+#endif
+  const std::int32_t fd = fs_fopen(file_path.data(), FS_FOPEN_RD);
+  if (fd < 0) {
+    UsbLogger::getInstance().log(
+        "Error: Failed to open log file for reading.\r\n");
+    return FsLog::FsLogStatus::FS_TO_USB_FILE_OPEN_ERROR;
+  }
+  const std::uint32_t size = static_cast<std::uint32_t>(fs_fsize(fd));
+
+  /** @brief Chunk in flight */
+  struct WindowSlot {
+    std::uint32_t next; /*!< Reader position after the chunk */
+    std::uint32_t done; /*!< File bytes the chunk completed */
+  };
+  std::array<WindowSlot, FS_WINDOW_CHUNKS> slots;
+  std::uint32_t committed = reader_tell(reader); /* Acknowledged position */
+  std::uint32_t base = window_seq;               /* Oldest unacknowledged */
+  std::uint32_t next = base;                     /* Next to send */
+  ctrl->acked.store(base);
+  ctrl->sent.store(0U);
+  ctrl->matched.store(0U);
+  ctrl->total.store(size > reader->cursor ? size - reader->cursor : 0U);
+
+  std::array<char, 80> line;
+  std::snprintf(line.data(), line.size(),
+                "Reply: Replay window %u from 0x%X, seq %u, %u bytes.\r\n",
+                static_cast<unsigned>(FS_WINDOW_CHUNKS),
+                static_cast<unsigned>(committed),
+                static_cast<unsigned>(base),
+                static_cast<unsigned>(ctrl->total.load()));
+  UsbLogger::getInstance().usbXferChunk(line.data());
+
+  FsLogStatus status = FsLog::FsLogStatus::FS_TO_USB_OK;
+  std::uint32_t progressTick = osKernelGetTickCount();
+  std::uint32_t retries = 0U;
+  std::uint32_t damaged = 0U;
+  char *const text = reinterpret_cast<char *>(window_buf.data()) +
+                     sizeof(ReplayChunkHeader);
+  for (;;) {
+    if (ctrl->cancel.load()) {
+      status = FsLog::FsLogStatus::FS_TO_USB_CANCELLED;
+      break;
+    }
+    const std::uint32_t acked = ctrl->acked.load();
+    if (acked - base - 1U < next - base) { /* base < acked <= next */
+      for (; base != acked; base++) {
+        committed = slots[base % FS_WINDOW_CHUNKS].next;
+        ctrl->sent.fetch_add(slots[base % FS_WINDOW_CHUNKS].done);
+      }
+      progressTick = osKernelGetTickCount();
+      retries = 0U;
+    }
+    const bool eof = reader->cursor >= size;
+    if (eof && base == next) {
+      break; /* Everything acknowledged */
+    }
+
+    if (!eof && next - base < FS_WINDOW_CHUNKS) {
+      const std::int32_t m = chunk_read(fd, size, reader);
+      if (m < 0) {
+        damaged++; /* Damaged frame: searching the next one */
+        continue;
+      }
+      if (m == 0) {
+        if (chunk_advance(reader, 0U) == 0U) {
+          reader->cursor = size; /* No whole line left */
+        }
+        continue;
+      }
+      std::memcpy(text, reader->buf, m);
+      const std::uint32_t pos = reader_tell(reader);
+      const std::uint32_t done = chunk_advance(reader, m);
+      const ReplayChunkHeader hdr = {.magic = FS_CHUNK_MAGIC,
+                                     .seq = next,
+                                     .next = reader_tell(reader),
+                                     .length = static_cast<std::uint32_t>(m),
+                                     .crc = FlashStore::crc32(text, m)};
+      std::memcpy(window_buf.data(), &hdr, sizeof(hdr));
+      if (UsbLogger::getInstance().usbXferChunk(std::string_view(
+              reinterpret_cast<const char *>(window_buf.data()),
+              sizeof(hdr) + m)) != USB_XFER_SUCCESS) {
+        reader_seek(reader, pos); /* Not sent: read it again */
+        osDelay(FS_WINDOW_POLL_MS);
+        continue;
+      }
+      slots[next % FS_WINDOW_CHUNKS] = {.next = hdr.next, .done = done};
+      next++;
+      ctrl->matched.fetch_add(m);
+      if (ctrl->throttleMs.load() > 0U) {
+        osDelay(ctrl->throttleMs.load()); /* Yield USB bandwidth */
+      }
+      continue;
+    }
+
+    /* Window full or file sent: wait for acknowledgements */
+    if (osKernelGetTickCount() - progressTick < FS_WINDOW_TIMEOUT_MS) {
+      osDelay(FS_WINDOW_POLL_MS);
+    } else if (++retries > FS_WINDOW_RETRIES) {
+      status = FsLog::FsLogStatus::FS_TO_USB_PAUSED;
+      break;
+    } else {
+      reader_seek(reader, committed); /* Go back to the oldest unacked */
+      next = base;
+      progressTick = osKernelGetTickCount();
+    }
+  }
+  fs_fclose(fd);
+  reader_seek(reader, committed);
+  window_seq = base + FS_WINDOW_CHUNKS; /* Above every seq sent, so late
+                                          acks never match a new chunk */
+
+  if (damaged > 0U) {
+    std::snprintf(line.data(), line.size(),
+                  "Error: %u damaged log bytes skipped.\r\n",
+                  static_cast<unsigned>(damaged));
+    UsbLogger::getInstance().log(line.data());
+  }
+  if (status != FsLog::FsLogStatus::FS_TO_USB_CANCELLED) {
+    std::snprintf(line.data(), line.size(),
+                  (status == FsLog::FsLogStatus::FS_TO_USB_OK)
+                      ? "Reply: Replay synced to 0x%X.\r\n"
+                      : "Reply: Replay paused at 0x%X.\r\n",
+                  static_cast<unsigned>(committed));
+    UsbLogger::getInstance().usbXferChunk(line.data());
+  }
+  return status;
+}
+
+/**
+ * @brief   Stream the raw RAM drive image to USB.
+ * @details Sends FS_DUMP_BLOCK_SIZE blocks, each behind a DumpBlockHeader
+ *          with its own CRC-32, in one USB transfer per block. Each block is
+ *          copied under the FS mutex, so it is never torn by a concurrent
+ *          write. A text trailer reports the CRC-32 of the whole image and
+ *          the file writes made during the dump; a host that sees writes
+ *          re-requests the affected range.
+ * @param   offset First image byte to send (rounded down to a block).
+ * @param   ctrl   Optional progress/cancel block (may be nullptr).
+ */
+FsLog::FsLogStatus FsLog::dumpToUsb(std::uint32_t offset,
+                                    FsReplayControl *ctrl) {
+  const uint8_t *image =
+      reinterpret_cast<const uint8_t *>(Image$$RW_RAM0$$ZI$$Base);
+  if (fsMutexId == nullptr) {
+    return FsLog::FsLogStatus::FS_NOT_INITIALIZED;
+  }
+  if (static_cast<uint32_t>(Image$$RW_RAM0_KEPT$$ZI$$Limit -
+                            Image$$RW_RAM0$$ZI$$Base) < FS_RAM0_SIZE) {
+    UsbLogger::getInstance().log(
+        "Error: RAM drive region missing in scatter file.\r\n");
+    return FsLog::FsLogStatus::FS_TO_USB_INIT_ERROR;
+  }
+  auto cancelled = [ctrl]() {
+    return (ctrl != nullptr) && ctrl->cancel.load();
+  };
+#ifdef FS_LOG_COMPRESS
+  if (fsInit.load() == FS_INITIALIZED) {
+    osMutexAcquire(fsMutexId, osWaitForever);
+    flushBlock(); /* Open records into the image before it is sent */
+    osMutexRelease(fsMutexId);
+  }
+#endif
+  offset -= offset % FS_DUMP_BLOCK_SIZE;
+  offset = (offset < FS_RAM0_SIZE) ? offset : FS_RAM0_SIZE;
+  if (ctrl != nullptr) {
+    ctrl->sent.store(0U);
+    ctrl->matched.store(0U);
+    ctrl->total.store(FS_RAM0_SIZE - offset);
+  }
+  const uint32_t writes = fs_writes.load();
+  std::array<char, 80> line;
+  std::snprintf(line.data(), line.size(),
+                "Reply: Dump R0: %u bytes from %u, %u-byte blocks.\r\n",
+                static_cast<unsigned>(FS_RAM0_SIZE),
+                static_cast<unsigned>(offset),
+                static_cast<unsigned>(FS_DUMP_BLOCK_SIZE));
+  UsbLogger::getInstance().usbXferChunk(line.data());
+
+  uint8_t *const data = dump_buf.data() + sizeof(DumpBlockHeader);
+  for (uint32_t pos = offset; pos < FS_RAM0_SIZE; pos += FS_DUMP_BLOCK_SIZE) {
+    const uint32_t len = std::min(FS_RAM0_SIZE - pos, FS_DUMP_BLOCK_SIZE);
+    osMutexAcquire(fsMutexId, osWaitForever);
+    std::memcpy(data, image + pos, len); /* Consistent snapshot */
+    osMutexRelease(fsMutexId);
+    const DumpBlockHeader hdr = {.magic = FS_DUMP_MAGIC,
+                                 .offset = pos,
+                                 .length = len,
+                                 .crc = FlashStore::crc32(data, len)};
+    std::memcpy(dump_buf.data(), &hdr, sizeof(hdr));
+    const std::string_view block(
+        reinterpret_cast<const char *>(dump_buf.data()), sizeof(hdr) + len);
+    while (UsbLogger::getInstance().usbXferChunk(block) != USB_XFER_SUCCESS) {
+      if (cancelled()) {
+        return FsLog::FsLogStatus::FS_TO_USB_CANCELLED;
+      }
+      osDelay(10); /* Wait and retry if USB transfer fails */
+    }
+    if (ctrl != nullptr) {
+      ctrl->sent.fetch_add(len);
+    }
+    if (cancelled()) {
+      return FsLog::FsLogStatus::FS_TO_USB_CANCELLED;
+    }
+  }
+
+  osMutexAcquire(fsMutexId, osWaitForever);
+  const uint32_t crc = FlashStore::crc32(image, FS_RAM0_SIZE);
+  osMutexRelease(fsMutexId);
+  std::snprintf(line.data(), line.size(),
+                "Reply: Dump end, image crc 0x%08X, %u writes meanwhile.\r\n",
+                static_cast<unsigned>(crc),
+                static_cast<unsigned>(fs_writes.load() - writes));
+  UsbLogger::getInstance().usbXferChunk(line.data());
+  return FsLog::FsLogStatus::FS_TO_USB_OK;
+}
+
+/**
+ * @brief   Enable or disable follow mode.
+ * @details While enabled, every record committed to the log file is also
+ *          queued for followRead(); the file is never reopened or rescanned.
+ * @param   enable true to start following, false to stop.
+ */
+void FsLog::follow(bool enable) {
+  if (fsInit != FS_INITIALIZED) {
+    return;
+  }
+  osMutexAcquire(fsMutexId, osWaitForever);
+  follow_tail = follow_head; /* Start with new records only */
+  follow_dropped.store(0U);
+  follow_active.store(enable);
+  osMutexRelease(fsMutexId);
+  osSemaphoreRelease(followSemId); /* Wake a waiting follower */
+}
+
+/**
+ * @brief   Check whether follow mode is enabled.
+ * @return  true while following.
+ */
+bool FsLog::isFollowing() const { return follow_active.load(); }
+
+/**
+ * @brief   Take committed records from the follow ring.
+ * @details Copies whole records only, as many as fit. A record longer than
+ *          buf is cut to fit and its rest skipped (never happens with
+ *          FS_DATA_PACKET_SIZE, the longest record follow_push() keeps).
+ * @param   buf     Destination buffer.
+ * @param   size    Destination size (a null terminator is always written).
+ * @param   timeout Time to wait for new records in ticks.
+ * @return  Number of bytes copied (0 on timeout or when not following).
+ */
+std::uint32_t FsLog::followRead(char *buf, std::uint32_t size,
+                                std::uint32_t timeout) {
+  if (fsInit != FS_INITIALIZED || size == 0U) {
+    return 0U;
+  }
+  if (follow_head == follow_tail) {
+    osSemaphoreAcquire(followSemId, timeout);
+  }
+  osMutexAcquire(fsMutexId, osWaitForever);
+  std::uint32_t count = 0U;
+  while (follow_active.load() && follow_tail != follow_head) {
+    std::uint32_t len = 0U;
+    while (follow_ring[(follow_tail + len) & (FS_FOLLOW_SIZE - 1)] != '\0') {
+      len++;
+    }
+    if (count > 0U && count + len > size - 1U) {
+      break; /* Next record goes into the next chunk */
+    }
+    for (std::uint32_t i = 0U; i < len; i++) {
+      const char c = follow_ring[follow_tail++ & (FS_FOLLOW_SIZE - 1)];
+      if (count < size - 1U) {
+        buf[count++] = c;
+      }
+    }
+    follow_tail++; /* Terminator */
+  }
+  osMutexRelease(fsMutexId);
+  buf[count] = '\0';
+  return count;
+}
+
+/**
+ * @brief   Records lost because the follower did not keep up.
+ * @return  Dropped record count since follow mode was enabled.
+ */
+std::uint32_t FsLog::followDropped() const { return follow_dropped.load(); }
+
 /** @} */ // end of Logger
\ No newline at end of file
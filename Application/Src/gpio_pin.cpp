@@ -0,0 +1,144 @@
+/**
+ * @file gpio_pin.cpp
+ * @brief GPIO pins written through BSRR: run-time port lookup and batches
+ * @author Mitul Goti
+ * @version 1.0
+ * @date 2025-10-12
+ * @ingroup led
+ * @details
+ * This file implements the run-time half of gpio_pin.h: the port table and
+ * GpioBatch.
+ */
+
+/* GPIO Pins
+ ---
+ # 📝 Overview
+ Led used to switch a pin through the ARM_DRIVER_GPIO function table, and
+ toggle() took two driver calls (GetInput, then SetOutput). Changing
+ several LEDs took one call per LED, so other code could see them half
+ changed. gpio_pin.h binds pins to their port registers instead: at
+ compile time for pins known at build time (GpioPin, GpioGroup), at run
+ time for pin numbers held in data (gpioPort(), gpioWrite(), GpioBatch).
+
+ # ⚙️ Features
+ - GpioPin<N>: port and bit folded into constants; set, clear and write
+   are one store each.
+ - GpioGroup<Pins...>: any pins of one port written in one BSRR store, so
+   all four board LEDs change at the same instant. Mixing ports or listing
+   a pin twice fails to compile.
+ - gpioWrite()/gpioIsSet(): one pin by number, for Led.
+ - GpioBatch: stages pin changes by number and commits them with one
+   store per port, for code that only knows pins at run time (the LED
+   scheduler switches every LED due at a tick in one go).
+ - No read-modify-write of ODR: writes to pins outside a group or batch
+   are never undone by a concurrent update.
+
+ # 📋 Usage
+ ```
+ using BoardLeds = GpioGroup<GpioPin<60U>, GpioPin<61U>, GpioPin<62U>,
+                             GpioPin<63U>>;
+ BoardLeds::write(0b0101U); // Green and red on, orange and blue off
+ GpioBatch batch;
+ batch.write(pin, true);
+ batch.commit();
+ ```
+
+ # 🔧 Implementation Details
+ BSRR sets the pins written to its low half and resets the pins written
+ to its high half; pins with neither bit keep their state, and the set
+ bit wins if both are written. gpioBsrr() is the one place that encodes
+ this; every writer goes through it. gpioPort<P>() selects the port with
+ if constexpr, so GpioPin code compiles to a constant address and a store.
+
+ # ⚠️ Limitations
+ - Toggle reads ODR and writes BSRR: two toggles of the same pin from two
+   threads at once can cancel.
+ - Only pins configured as outputs (CubeMX MX_GPIO_Init) follow the
+   writes; pins in alternate function mode (LED_PWM) ignore them.
+ */
+
+#include "gpio_pin.h"
+#include "stm32f4xx.h" // IWYU pragma: keep
+#include <cstdint>
+
+/** @brief Port registers of a port index.
+ * @param port 0 for GPIOA .. 8 for GPIOI.
+ * @return Register block, nullptr if there is no such port.
+ */
+GPIO_TypeDef *gpioPort(std::uint32_t port) {
+  switch (port) {
+  case 0U:
+    return gpioPort<0U>();
+  case 1U:
+    return gpioPort<1U>();
+  case 2U:
+    return gpioPort<2U>();
+  case 3U:
+    return gpioPort<3U>();
+  case 4U:
+    return gpioPort<4U>();
+  case 5U:
+    return gpioPort<5U>();
+  case 6U:
+    return gpioPort<6U>();
+  case 7U:
+    return gpioPort<7U>();
+  case 8U:
+    return gpioPort<8U>();
+  default:
+    return nullptr;
+  }
+}
+
+/** @brief Drive one pin with one BSRR store.
+ * @param pin Pin number (port * 16 + pin).
+ * @param high true to drive the pin high.
+ * @return false if there is no such port.
+ */
+bool gpioWrite(std::uint32_t pin, bool high) {
+  GPIO_TypeDef *const port = gpioPort(pin / GPIO_PORT_PINS);
+  if (port == nullptr) {
+    return false;
+  }
+  port->BSRR = gpioBsrr(gpioMask(pin), high);
+  return true;
+}
+
+/** @brief Read the output latch of one pin.
+ * @param pin Pin number (port * 16 + pin).
+ * @return true if the pin is driven high; false also if there is no port.
+ */
+bool gpioIsSet(std::uint32_t pin) {
+  GPIO_TypeDef *const port = gpioPort(pin / GPIO_PORT_PINS);
+  return port != nullptr && (port->ODR & gpioMask(pin)) != 0U;
+}
+
+/** @brief Stage a pin change; a later change of the same pin replaces it.
+ * @param pin Pin number (port * 16 + pin).
+ * @param high true to drive the pin high.
+ * @return false if there is no such port.
+ */
+bool GpioBatch::write(std::uint32_t pin, bool high) {
+  const std::uint32_t port = pin / GPIO_PORT_PINS;
+  if (port >= GPIO_PORTS) {
+    return false;
+  }
+  const std::uint32_t mask = gpioMask(pin);
+  const std::uint32_t both = gpioBsrr(mask, true) | gpioBsrr(mask, false);
+  bsrr[port] = (bsrr[port] & ~both) | gpioBsrr(mask, high);
+  touched |= 1U << port;
+  return true;
+}
+
+/**
+ * @brief   Write the staged changes, one BSRR store per port, and clear.
+ */
+void GpioBatch::commit() {
+  for (std::uint32_t port = 0U; touched != 0U; port++) {
+    if ((touched & (1U << port)) != 0U) {
+      gpioPort(port)->BSRR = bsrr[port];
+      bsrr[port] = 0U;
+      touched &= ~(1U << port);
+    }
+  }
+}
@@ -0,0 +1,259 @@
+/**
+ * @file input.cpp
+ * @brief Input dispatcher: button edges to gesture subscribers
+ * @author Mitul Goti
+ * @version 1.0
+ * @date 2025-10-14
+ * @ingroup input
+ * @details
+ * This file implements InputDispatcher: the interrupt-side edge queue, the
+ * dispatcher thread and the subscriber table.
+ */
+
+/* Input Dispatcher
+ ---
+ # 📝 Overview
+ The button interrupt used to set USER_BUTTON_FLAG, which the LED threads
+ polled after each blink, so a press could wait a whole blink period for
+ an answer. The Input Dispatcher gives the button its own thread: the
+ interrupt stamps each edge and queues it, the thread debounces it and
+ calls the subscribers of the gesture within the same tick.
+
+ # ⚙️ Features
+ - EXTI edges on both flanks, stamped with the kernel tick in the ISR.
+ - Debounce and gesture timing by ButtonGesture, with the thread's queue
+   timeout as the software timer: no osDelay anywhere.
+ - Subscribers per gesture (PRESS, RELEASE, SHORT, LONG, DOUBLE), up to
+   eight, each a function and a context pointer.
+ - Counters per gesture, lost edges and the worst edge-to-handler
+   latency (`input` USB command).
+ - SHORT, LONG and DOUBLE are logged as "Event: Button <gesture>".
+
+ # 📋 Usage
+ ```
+ InputDispatcher &input = InputDispatcher::getInstance();
+ input.subscribe(InputDispatcher::Gesture::SHORT, onShort, nullptr);
+ input.init(USER_BUTTON_PIN);
+ // In the GPIO callback:
+ InputDispatcher::getInstance().edgeFromIsr(pin);
+ ```
+
+ # 🔧 Implementation Details
+ The ISR reads the pin's input register and posts {tick, level} with a
+ zero timeout; if the queue is full it counts the edge as dropped and asks
+ the thread to re-read the pin. The thread drains the queue before it
+ handles any deadline, so a gesture is never decided before an edge that
+ came earlier. It runs at osPriorityAboveNormal, above the LED threads and
+ the LED scheduler.
+
+ # ⚠️ Limitations
+ - One button per dispatcher.
+ - subscribe() is meant for start-up code: subscriptions are never
+   removed, and two threads must not subscribe at the same time.
+ - Handlers run on the input thread; a slow handler delays later gestures
+   (the edges are kept in the queue meanwhile).
+ */
+
+#include "input.h"
+#include "button_gesture.h"
+#include "cmsis_os2.h"
+#include "gpio_pin.h"
+#include "log_router.h"
+#include "usb_logger.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief   Anonymous namespace for internal linkage.
+ * @details Contains the edge queue and the static thread memory.
+ */
+namespace {
+constexpr std::uint32_t INPUT_QUEUE_LENGTH = 16U; /*!< Edges in flight */
+
+/** @brief Edge as posted by the interrupt */
+struct InputEdge {
+  std::uint32_t tick; /*!< Kernel tick of the edge */
+  std::uint8_t level; /*!< 1: pressed after the edge */
+};
+
+/** @brief Log names of the gestures, in Gesture order */
+constexpr std::array<const char *, ButtonGesture::GESTURES> gestureNames = {
+    "press", "release", "short", "long", "double"};
+
+osMessageQueueId_t inputQueueId = nullptr; /*!< Edge queue */
+
+uint64_t input_queue_mem[(INPUT_QUEUE_LENGTH * sizeof(InputEdge) + 7) / 8]
+    __attribute__((aligned(64))); /*!< Memory buffer for edge queue */
+uint64_t input_queue_cb[32]
+    __attribute__((aligned(64))); /*!< Control block for edge queue */
+uint64_t input_stack[256]
+    __attribute__((aligned(64))); /*!< Static thread stack (aligned) */
+uint64_t input_cb[32]
+    __attribute__((aligned(64))); /*!< Static thread control block (aligned) */
+
+constexpr osMessageQueueAttr_t inputQueueAttr = {
+    .name = "InputQueue",               /*!< Name for debugging */
+    .attr_bits = 0U,                    /*!< No special attributes */
+    .cb_mem = input_queue_cb,           /*!< Control block memory */
+    .cb_size = sizeof(input_queue_cb),  /*!< Control block size */
+    .mq_mem = input_queue_mem,          /*!< Pointer to memory for queue */
+    .mq_size = sizeof(input_queue_mem), /*!< Size of the memory buffer */
+};
+constexpr osThreadAttr_t inputThreadAttr = {
+    .name = "Input",                   /*!< Name for debugging */
+    .attr_bits = 0U,                   /*!< No special thread attributes */
+    .cb_mem = input_cb,                /*!< Memory for thread control block */
+    .cb_size = sizeof(input_cb),       /*!< Size of control block */
+    .stack_mem = input_stack,          /*!< Pointer to static stack */
+    .stack_size = sizeof(input_stack), /*!< Stack size in bytes */
+    .priority = osPriorityAboveNormal  /*!< Above LED threads */
+};
+} // namespace
+
+/**
+ * @brief   Constructor (private for singleton pattern).
+ */
+InputDispatcher::InputDispatcher() {}
+
+/**
+ * @brief   Get the singleton instance of InputDispatcher.
+ * @return  Reference to InputDispatcher instance.
+ */
+InputDispatcher &InputDispatcher::getInstance() {
+  static InputDispatcher instance;
+  return instance;
+}
+
+/**
+ * @brief   Start the dispatcher for one button.
+ * @details Creates the edge queue and the dispatcher thread. Edges before
+ *          this call are ignored; the thread starts from the pin level.
+ * @param   pin        Button pin (port * 16 + pin, 0 = PA0).
+ * @param   activeHigh true if the pin reads high while pressed.
+ */
+void InputDispatcher::init(std::uint32_t pin, bool activeHigh) {
+  this->pin = pin;
+  this->activeHigh = activeHigh;
+  if (gpioPort(pin / GPIO_PORT_PINS) == nullptr) {
+    UsbLogger::getInstance().log("Error: Input pin does not exist.\r\n");
+    return;
+  }
+  inputQueueId = osMessageQueueNew(INPUT_QUEUE_LENGTH, sizeof(InputEdge),
+                                   &inputQueueAttr);
+  if (inputQueueId == nullptr) {
+    UsbLogger::getInstance().log(
+        "Error: Input edge queue can not be created.\r\n");
+    return;
+  }
+  threadId = osThreadNew(threadWrapper, this, &inputThreadAttr);
+  if (threadId == nullptr) {
+    UsbLogger::getInstance().log(
+        "Error: Input thread can not be created.\r\n");
+  }
+}
+
+/** @brief Subscribe to a gesture.
+ * @param g Gesture to report.
+ * @param fn Handler, called on the input thread; must not block.
+ * @param context Passed to the handler.
+ * @return false if fn is null or all MAX_SUBSCRIBERS slots are taken.
+ */
+bool InputDispatcher::subscribe(Gesture g, Handler fn, void *context) {
+  const std::size_t n = subscriberCount.load(std::memory_order_relaxed);
+  if (fn == nullptr || n >= MAX_SUBSCRIBERS) {
+    return false;
+  }
+  subscribers[n] = {g, fn, context};
+  // Publish the entry before the thread may read it
+  subscriberCount.store(n + 1U, std::memory_order_release);
+  return true;
+}
+
+/** @brief Queue an edge of the button (GPIO interrupt context).
+ * @param pin Pin that raised the event; other pins are ignored.
+ */
+void InputDispatcher::edgeFromIsr(std::uint32_t pin) {
+  if (pin != this->pin || inputQueueId == nullptr) {
+    return;
+  }
+  const InputEdge edge = {.tick = osKernelGetTickCount(),
+                          .level = static_cast<std::uint8_t>(level())};
+  if (osMessageQueuePut(inputQueueId, &edge, 0U, 0U) != osOK) {
+    dropped.fetch_add(1U);
+    resync.store(true);
+  }
+}
+
+/** @brief Raw button level, read from the pin's input register.
+ * @return true while the button is pressed (bounce included).
+ */
+bool InputDispatcher::level() const {
+  const bool high = (gpioPort(pin / GPIO_PORT_PINS)->IDR &
+                     (1U << (pin % GPIO_PORT_PINS))) != 0U;
+  return high == activeHigh;
+}
+
+/**
+ * @brief   Thread entry point.
+ * @param   argument Pointer to the InputDispatcher instance.
+ */
+void InputDispatcher::threadWrapper(void *argument) {
+  static_cast<InputDispatcher *>(argument)->run();
+}
+
+/** @brief ButtonGesture callback.
+ * @param context Pointer to the InputDispatcher instance.
+ * @param g Gesture detected.
+ * @param tick Tick it happened at.
+ */
+void InputDispatcher::emitWrapper(void *context, Gesture g,
+                                  std::uint32_t tick) {
+  static_cast<InputDispatcher *>(context)->publish(g, tick);
+}
+
+/** @brief Count a gesture, call its subscribers, log it.
+ * @param g Gesture detected.
+ * @param tick Tick it happened at.
+ */
+void InputDispatcher::publish(Gesture g, std::uint32_t tick) {
+  counts[static_cast<std::size_t>(g)].fetch_add(1U);
+  const std::size_t n = subscriberCount.load(std::memory_order_acquire);
+  for (std::size_t i = 0U; i < n; i++) {
+    if (subscribers[i].gesture == g) {
+      subscribers[i].fn(subscribers[i].context, g, tick);
+    }
+  }
+  if (g != Gesture::PRESS && g != Gesture::RELEASE) {
+    LogRouter::getInstance().log("Event: Button %s\r\n",
+                                 gestureNames[static_cast<std::size_t>(g)]);
+  }
+}
+
+/**
+ * @brief   Dispatcher thread: drain edges, then handle due deadlines.
+ */
+void InputDispatcher::run() {
+  gesture.reset();
+  if (level()) {
+    gesture.edge(true, osKernelGetTickCount(), emitWrapper, this);
+  }
+  for (;;) {
+    std::uint32_t wait = osWaitForever;
+    gesture.untilNext(osKernelGetTickCount(), wait);
+    InputEdge edge;
+    if (osMessageQueueGet(inputQueueId, &edge, nullptr, wait) == osOK) {
+      const std::uint32_t latency = osKernelGetTickCount() - edge.tick;
+      if (latency > worstLatency.load()) {
+        worstLatency.store(latency);
+      }
+      gesture.edge(edge.level != 0U, edge.tick, emitWrapper, this);
+      continue; // Every queued edge before any deadline
+    }
+    const std::uint32_t now = osKernelGetTickCount();
+    if (resync.exchange(false)) {
+      gesture.edge(level(), now, emitWrapper, this); // Edges were lost
+    }
+    gesture.expire(now, emitWrapper, this);
+  }
+}
@@ -0,0 +1,123 @@
+/**
+ * @file jitter_histogram.cpp
+ * @brief Fixed-memory histogram of edge timing errors
+ * @author Mitul Goti
+ * @version 1.0
+ * @date 2025-10-15
+ * @ingroup led_thread
+ * @details
+ * This file implements JitterHistogram: bucket selection, recording and
+ * the counter-to-microsecond conversion.
+ */
+
+/* Jitter Histogram
+ ---
+ # 📝 Overview
+ The LED threads schedule their edges on absolute ticks. To show how well
+ they keep to them, every edge is compared with its ideal time and the
+ error goes into a histogram of fixed size, so hours of running cost no
+ more memory than a second.
+
+ # ⚙️ Features
+ - 16 buckets: early, below 1 us, then doubling up to 8.192 ms and above.
+ - Smallest and largest error kept exactly.
+ - Lock-free: the LED thread records, the USB thread reads and resets.
+ - errorUs() turns two readings of the RTOS system timer (which wraps
+   every 25 s at 168 MHz) into a signed error in us.
+
+ # 📋 Usage
+ ```
+ hist.record(JitterHistogram::errorUs(osKernelGetSysTimerCount(),
+                                      idealTick * countsPerTick,
+                                      countsPerUs));
+ ```
+
+ # 🔧 Implementation Details
+ The bucket of an error e >= 1 us is 2 plus the index of its highest set
+ bit, capped at the last bucket. One thread records, so each update is a
+ plain load and store of its word; only reset() from another thread can
+ race with it, and then a count may survive the reset.
+
+ # ⚠️ Limitations
+ - A bucket count wraps after 2^32 edges (50 days of 1 kHz edges).
+ - errorUs() is only meaningful for errors below half the counter range.
+ */
+
+#include "jitter_histogram.h"
+#include <cstdint>
+
+/** @brief Count one edge.
+ * @param errorUs Actual minus ideal edge time in us.
+ */
+void JitterHistogram::record(std::int32_t errorUs) {
+  std::atomic_uint32_t &bin = bins[bucketOf(errorUs)];
+  bin.store(bin.load(std::memory_order_relaxed) + 1U,
+            std::memory_order_relaxed);
+  if (errorUs < minUs.load(std::memory_order_relaxed)) {
+    minUs.store(errorUs, std::memory_order_relaxed);
+  }
+  if (errorUs > maxUs.load(std::memory_order_relaxed)) {
+    maxUs.store(errorUs, std::memory_order_relaxed);
+  }
+}
+
+/**
+ * @brief   Clear every count and the extremes.
+ */
+void JitterHistogram::reset() {
+  for (std::atomic_uint32_t &bin : bins) {
+    bin.store(0U, std::memory_order_relaxed);
+  }
+  minUs.store(INT32_MAX, std::memory_order_relaxed);
+  maxUs.store(INT32_MIN, std::memory_order_relaxed);
+}
+
+/** @brief Edges counted in all buckets.
+ * @return Sum of the buckets.
+ */
+std::uint32_t JitterHistogram::count() const {
+  std::uint32_t n = 0U;
+  for (const std::atomic_uint32_t &bin : bins) {
+    n += bin.load(std::memory_order_relaxed);
+  }
+  return n;
+}
+
+/** @brief Bucket of an error.
+ * @param errorUs Actual minus ideal edge time in us.
+ * @return 0 for early edges, 1 below 1 us, 2 + log2(errorUs) above.
+ */
+std::uint32_t JitterHistogram::bucketOf(std::int32_t errorUs) {
+  if (errorUs < 0) {
+    return 0U;
+  }
+  std::uint32_t b = 1U;
+  for (std::uint32_t e = static_cast<std::uint32_t>(errorUs);
+       e != 0U && b < BUCKETS - 1U; e >>= 1U) {
+    b++;
+  }
+  return b;
+}
+
+/** @brief Exclusive upper bound of a bucket.
+ * @param i Bucket index.
+ * @return Bound in us; 0 for the early bucket and the last bucket, which
+ *         have none.
+ */
+std::uint32_t JitterHistogram::bucketLimitUs(std::uint32_t i) {
+  return (i == 0U || i >= BUCKETS - 1U) ? 0U : (1U << (i - 1U));
+}
+
+/** @brief Signed difference of two wrapping counter readings.
+ * @param actual Counter when the edge happened.
+ * @param ideal Counter value of the ideal edge time.
+ * @param countsPerUs Counter increments per us (0 is taken as 1).
+ * @return actual - ideal in us.
+ */
+std::int32_t JitterHistogram::errorUs(std::uint32_t actual,
+                                      std::uint32_t ideal,
+                                      std::uint32_t countsPerUs) {
+  const std::int32_t counts = static_cast<std::int32_t>(actual - ideal);
+  return counts / static_cast<std::int32_t>(countsPerUs != 0U ? countsPerUs
+                                                               : 1U);
+}
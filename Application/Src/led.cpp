@@ -23,60 +23,120 @@
  # ⚙️ Features
  - Turn LEDs on and off.
  - Toggle LED states.
+ - Optional TIM4 PWM backend (LedPwm) for the four board LEDs: brightness
+   levels and hardware blinking.
+ - Batched changes (stage() into a GpioBatch): several LEDs switch in one
+   register store.
 
  # 📋 Usage
  To use the LED control module, create an instance of the `Led` class and call
  the desired methods (on, off, toggle) with the appropriate GPIO pin number.
 
  # 🔧 Implementation Details
- The `Led` class uses the CMSIS-compliant `ARM_DRIVER_GPIO` interface to
- manipulate GPIO pins. The `toggle` method reads the current state of the pin
- and sets it to the opposite state.
+ The `Led` class writes the port's bit set/reset register (BSRR) through
+ gpioWrite() (gpio_pin.h), one store per change instead of calls through the
+ `ARM_DRIVER_GPIO` function table. The `toggle` method reads the output latch
+ of the pin and sets it to the opposite state.
 
- The implementation ensures that the GPIO driver is properly initialized and
- configured before performing any operations.
+ The pins are configured as outputs by CubeMX (MX_GPIO_Init) before the
+ application starts.
 */
 
 #include "led.h"
-#include "Driver_GPIO.h" // CMSIS-Driver GPIO interface
-
-extern ARM_DRIVER_GPIO Driver_GPIO0; // External GPIO driver instance
+#include "gpio_pin.h"
+#include "led_pwm.h"
 
 /**
  * @brief Turn on the LED by setting the GPIO pin to HIGH.
  * @param pin GPIO pin number associated with the LED.
  * @details
- * This method uses the CMSIS-Driver GPIO interface to set the pin state.
+ * This method writes the pin's bit in the port's BSRR register.
  */
 void Led::on(uint32_t pin) {
+  uint32_t ch;
+  if (pwm != nullptr && pwm->channel(pin, ch)) {
+    pwm->on(ch);
+    return;
+  }
   // Set the pin to HIGH (logic 1) to turn on the LED
-  Driver_GPIO0.SetOutput(pin, 1U);
+  gpioWrite(pin, true);
 }
 
 /**
  * @brief Turn off the LED by setting the GPIO pin to LOW.
  * @param pin GPIO pin number associated with the LED.
  * @details
- * This method uses the CMSIS-Driver GPIO interface to set the pin state.
+ * This method writes the pin's reset bit in the port's BSRR register.
  */
 void Led::off(uint32_t pin) {
+  uint32_t ch;
+  if (pwm != nullptr && pwm->channel(pin, ch)) {
+    pwm->off(ch);
+    return;
+  }
   // Set the pin to LOW (logic 0) to turn off the LED
-  Driver_GPIO0.SetOutput(pin, 0U);
+  gpioWrite(pin, false);
 }
 
 /**
  * @brief Toggle the state of the LED.
  * @param pin GPIO pin number associated with the LED.
  * @details
- * This method reads the current state of the GPIO pin associated with the LED.
+ * This method reads the output latch (ODR) of the pin associated with the LED.
  * If the pin is LOW (logic 0), it sets it HIGH (logic 1), and vice versa.
- * The implementation uses the CMSIS-Driver `ARM_DRIVER_GPIO` interface.
  */
 void Led::toggle(uint32_t pin) {
-  // Read the current state of the pin
-  uint32_t pin_state = Driver_GPIO0.GetInput(pin);
+  uint32_t ch;
+  if (pwm != nullptr && pwm->channel(pin, ch)) {
+    pwm->toggle(ch);
+    return;
+  }
+  // Read the output latch and drive the opposite state
+  gpioWrite(pin, !gpioIsSet(pin));
+}
+
+/**
+ * @brief Switch an LED as part of a batch.
+ * @param batch Batch to stage GPIO pins in; the caller commits it.
+ * @param pin GPIO pin number associated with the LED.
+ * @param lit true to turn the LED on.
+ * @details
+ * PWM pins switch at once (their compare registers latch at the next PWM
+ * period anyway); GPIO pins change when the batch is committed, together
+ * with every other pin of their port staged in it.
+ */
+void Led::stage(GpioBatch &batch, uint32_t pin, bool lit) {
+  uint32_t ch;
+  if (pwm != nullptr && pwm->channel(pin, ch)) {
+    if (lit) {
+      pwm->on(ch);
+    } else {
+      pwm->off(ch);
+    }
+    return;
+  }
+  batch.write(pin, lit);
+}
 
-  // Apply the new output state to the pin
-  Driver_GPIO0.SetOutput(pin, pin_state == 0 ? 1U : 0U);
-  // Note: The pin state is inverted here to toggle the LED
+/**
+ * @brief Drive the TIM4 channel pins through a PWM backend.
+ * @param driver Initialised LedPwm, or nullptr for plain GPIO.
+ * @details
+ * Call once at start-up, before any thread uses the LEDs.
+ */
+void Led::attach(LedPwm *driver) { pwm = driver; }
+
+/**
+ * @brief Set the brightness of an LED.
+ * @param pin GPIO pin number associated with the LED.
+ * @param level 0 (dark) .. 255 (full).
+ * @return false if the pin has no PWM channel.
+ */
+bool Led::setLevel(uint32_t pin, uint8_t level) {
+  uint32_t ch;
+  if (pwm == nullptr || !pwm->channel(pin, ch)) {
+    return false;
+  }
+  pwm->setLevel(ch, level);
+  return true;
 }
@@ -0,0 +1,192 @@
+/**
+ * @file led_pattern.cpp
+ * @brief Bytecode LED patterns: interpreter and built-in patterns
+ * @author Mitul Goti
+ * @version 1.0
+ * @date 2025-10-10
+ * @ingroup led_thread
+ * @details
+ * This file implements the LedPattern interpreter and holds the built-in
+ * patterns, compiled from text at build time.
+ */
+
+/* LED Pattern
+ ---
+ # 📝 Overview
+ LedThread knows one behaviour: on for the on-time, then off. LedPattern
+ turns LED behaviour into data. A pattern is a few bytes of bytecode, and
+ the LED scheduler runs one program per LED from its single thread. Error
+ codes, heartbeats or a software-PWM breathing effect then cost a few
+ bytes of state per LED, not a thread.
+
+ # ⚙️ Features
+ - Compact text form ("3[on 150 off 150] 900"), compiled by a constexpr
+   compiler: built-in patterns are checked and encoded at build time and
+   live in flash; the same compiler accepts patterns sent over USB.
+ - Millisecond waits, the shared on-time, two levels of counted or endless
+   loops, halt.
+ - Interpreter state is 12 bytes per LED; step() runs until the next wait
+   and returns its length, so the scheduler arms one timer per LED.
+ - Runaway guard: a program that does not wait within 64 operations is
+   stopped instead of starving the other LEDs.
+
+ # 📋 Usage
+ ```
+ constexpr auto SOS = LedPattern::compile<32>("3[on 150 off 150] ...");
+ static_assert(SOS.ok(), "SOS");
+ LedPattern::State s;
+ std::uint32_t ms = LedPattern::step(SOS.bytes.data(), SOS.size, s, 500U);
+ // Show s.lit, call step() again after ms
+ ```
+ Over USB: 'led pattern <led|all> <name>' or 'led pattern <led|all> =
+ <text>'.
+
+ # 🔧 Implementation Details
+ Waits below 256 ms take two bytes, longer ones three. A loop is OP_LOOP
+ with its count, the body, then OP_NEXT; the interpreter keeps the body
+ start and the passes left on a two-entry stack. Reaching the end of the
+ program clears the stack and starts over. Malformed bytecode (only
+ possible with hand-made tables) halts the program.
+
+ # ⚠️ Limitations
+ - Timing is at tick granularity (1 ms), so breathing is software PWM on
+   a 10 ms period with visible steps.
+ - A USB command line holds 64 bytes, which limits uploaded pattern text
+   to about 45 characters.
+ */
+
+#include "led_pattern.h"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @brief   Anonymous namespace for internal linkage.
+ * @details Contains the built-in patterns, compiled at build time.
+ */
+namespace {
+constexpr auto BLINK = LedPattern::compile<8>("on t off t");
+constexpr auto HEARTBEAT =
+    LedPattern::compile<16>("on 80 off 120 on 80 off 720");
+constexpr auto SOS = LedPattern::compile<32>(
+    "3[on 150 off 150] 3[on 450 off 150] 3[on 150 off 150] 900");
+constexpr auto STROBE = LedPattern::compile<8>("on 20 off 80");
+constexpr auto ALERT = LedPattern::compile<16>("4[on 60 off 60] 1000");
+constexpr auto BREATHE = LedPattern::compile<160>(
+    "6[on 1 off 9] 6[on 2 off 8] 6[on 3 off 7] 6[on 4 off 6] "
+    "6[on 5 off 5] 6[on 6 off 4] 6[on 7 off 3] 6[on 8 off 2] "
+    "6[on 9 off 1] 6[on 8 off 2] 6[on 7 off 3] 6[on 6 off 4] "
+    "6[on 5 off 5] 6[on 4 off 6] 6[on 3 off 7] 6[on 2 off 8] "
+    "6[on 1 off 9] 300");
+static_assert(BLINK.ok() && HEARTBEAT.ok() && SOS.ok() && STROBE.ok() &&
+                  ALERT.ok() && BREATHE.ok(),
+              "Built-in LED pattern does not compile");
+
+constexpr LedPattern::Builtin BUILTINS[] = {
+    {"blink", BLINK.bytes.data(), BLINK.size},             /*!< On-time */
+    {"heartbeat", HEARTBEAT.bytes.data(), HEARTBEAT.size}, /*!< Two beats */
+    {"sos", SOS.bytes.data(), SOS.size},                   /*!< Morse SOS */
+    {"strobe", STROBE.bytes.data(), STROBE.size},          /*!< 10 Hz */
+    {"alert", ALERT.bytes.data(), ALERT.size},             /*!< Burst */
+    {"breathe", BREATHE.bytes.data(), BREATHE.size},       /*!< Soft PWM */
+};
+constexpr std::size_t BUILTIN_COUNT =
+    sizeof(BUILTINS) / sizeof(BUILTINS[0]); /*!< Built-in patterns */
+} // namespace
+
+/** @brief Run a program up to its next wait.
+ * @param code Bytecode.
+ * @param size Bytes of bytecode.
+ * @param s Interpreter state; lit holds the LED state to show.
+ * @param sharedMs On-time of the LED for OP_WAIT_T.
+ * @return Milliseconds until the next step(), HALT when the program
+ *         stopped, RUNAWAY when it did not wait within MAX_OPS.
+ */
+std::uint32_t LedPattern::step(const std::uint8_t *code, std::size_t size,
+                               State &s, std::uint32_t sharedMs) {
+  if (code == nullptr || size == 0U) {
+    return HALT;
+  }
+  for (std::uint32_t ops = 0U; ops < MAX_OPS; ops++) {
+    if (s.pc >= size) {
+      s.pc = 0U; // Start over
+      s.depth = 0U;
+    }
+    const std::uint8_t op = code[s.pc++];
+    const std::size_t operands = size - s.pc;
+    switch (op) {
+    case OP_ON:
+      s.lit = true;
+      break;
+    case OP_OFF:
+      s.lit = false;
+      break;
+    case OP_TOGGLE:
+      s.lit = !s.lit;
+      break;
+    case OP_WAIT8:
+      if (operands < 1U || code[s.pc] == 0U) {
+        return HALT;
+      }
+      return code[s.pc++];
+    case OP_WAIT16: {
+      if (operands < 2U) {
+        return HALT;
+      }
+      const std::uint32_t ms =
+          code[s.pc] | (static_cast<std::uint32_t>(code[s.pc + 1U]) << 8);
+      s.pc += 2U;
+      return (ms != 0U) ? ms : HALT;
+    }
+    case OP_WAIT_T:
+      return (sharedMs != 0U) ? sharedMs : 1U;
+    case OP_LOOP:
+      if (operands < 1U || s.depth >= MAX_DEPTH) {
+        return HALT;
+      }
+      s.loops[s.depth].left = code[s.pc++];
+      s.loops[s.depth].start = s.pc;
+      s.depth++;
+      break;
+    case OP_NEXT: {
+      if (s.depth == 0U) {
+        return HALT;
+      }
+      State::Loop &loop = s.loops[s.depth - 1U];
+      if (loop.left == 0U || --loop.left > 0U) {
+        s.pc = loop.start; // Forever, or passes left
+      } else {
+        s.depth--;
+      }
+      break;
+    }
+    case OP_HALT:
+    default:
+      s.pc--; // Stay on the halt
+      return HALT;
+    }
+  }
+  return RUNAWAY;
+}
+
+/** @brief Look up a built-in pattern.
+ * @param name Pattern name.
+ * @return Table entry, nullptr if there is none.
+ */
+const LedPattern::Builtin *LedPattern::find(std::string_view name) {
+  for (const Builtin &b : BUILTINS) {
+    if (name == b.name) {
+      return &b;
+    }
+  }
+  return nullptr;
+}
+
+/** @brief Built-in pattern table.
+ * @param count Receives the number of entries.
+ * @return First entry.
+ */
+const LedPattern::Builtin *LedPattern::builtins(std::size_t &count) {
+  count = BUILTIN_COUNT;
+  return BUILTINS;
+}
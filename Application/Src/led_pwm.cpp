@@ -0,0 +1,260 @@
+/**
+ * @file led_pwm.cpp
+ * @brief TIM4 PWM driver for the four Discovery board LEDs
+ * @author Mitul Goti
+ * @version 1.0
+ * @date 2025-10-11
+ * @ingroup led
+ * @details
+ * This file implements LedPwm on the TIM4 and GPIOD registers.
+ */
+
+/* LED PWM
+ ---
+ # 📝 Overview
+ Led drives the LEDs through Driver_GPIO0: full on or off, and every blink
+ edge is a thread waking up. The four LEDs sit on the TIM4 channel pins,
+ so with LED_PWM the timer drives them instead. Brightness becomes a
+ compare value, and in blink mode the timer produces the blink waveform
+ with no CPU time and no jitter at all.
+
+ # ⚙️ Features
+ - Dim mode: 1 kHz PWM with 1000 steps and 256 perceptual levels (square
+   law), on/off/toggle are single compare register writes.
+ - Blink mode: 0.1 ms timebase, shared period up to 6.5 s; each LED is on
+   for its own time at the start or the end of the period.
+ - Preloaded compare and period registers: changes take effect at the
+   next period, so a waveform never shows a partial cycle.
+ - Timer clock read from RCC (APB1 prescaler), not assumed.
+
+ # 📋 Usage
+ ```
+ static LedPwm pwm;
+ if (pwm.init()) {
+   Led::getInstance().attach(&pwm); // on/off of PD12..PD15 go to TIM4
+ }
+ Led::getInstance().setLevel(LED_BLUE_PIN, 64U);
+ ```
+
+ # 🔧 Implementation Details
+ PD12..PD15 are switched to alternate function 2 (TIM4_CH1..CH4). Each
+ channel runs in PWM mode 1 (output high while CNT < CCR): CCR = 0 is off,
+ CCR = ARR + 1 is fully on. A late blink uses PWM mode 2 (high from CCR to
+ the end of the period). A mode change writes PSC and ARR and issues an
+ update event, so the counter restarts with the new timebase at once.
+
+ # ⚠️ Limitations
+ - All blinking LEDs share one period: TIM4 has one counter.
+ - In blink mode on()/off() only record the state; dim() applies it.
+ */
+
+#include "led_pwm.h"
+#include "stm32f4xx.h" // IWYU pragma: keep
+#include <cstdint>
+
+extern uint32_t SystemCoreClock; // HCLK in Hz (system_stm32f4xx.c)
+
+/**
+ * @brief   Anonymous namespace for internal linkage.
+ * @details Contains the pin and output compare constants.
+ */
+namespace {
+constexpr std::uint32_t FIRST_PD_PIN = 12U;  /*!< PD12 = TIM4_CH1 */
+constexpr std::uint32_t AF_TIM4 = 2U;        /*!< Alternate function */
+constexpr std::uint32_t MODER_AF = 2U;       /*!< Alternate function mode */
+constexpr std::uint32_t OC_PWM1 = 6U;        /*!< High while CNT < CCR */
+constexpr std::uint32_t OC_PWM2 = 7U;        /*!< High while CNT >= CCR */
+constexpr std::uint32_t OCM_SHIFT = 4U;      /*!< OCxM in its CCMR byte */
+constexpr std::uint32_t OCPE_SHIFT = 3U;     /*!< OCxPE in its CCMR byte */
+constexpr std::uint32_t LEVEL_RANGE =
+    LedPwm::LEVEL_MAX * LedPwm::LEVEL_MAX; /*!< Square-law denominator */
+
+/** @brief Compare register of a channel (CCR1..CCR4 are consecutive). */
+volatile uint32_t &ccr(std::uint32_t ch) { return (&TIM4->CCR1)[ch]; }
+} // namespace
+
+/** @brief Enable the clocks, route the pins to TIM4 and start dim mode.
+ * @return true once the timer runs.
+ */
+bool LedPwm::init() {
+  RCC->AHB1ENR |= RCC_AHB1ENR_GPIODEN;
+  RCC->APB1ENR |= RCC_APB1ENR_TIM4EN;
+  (void)RCC->APB1ENR; /* Let the clock enable take effect */
+  if (timerClock() / BLINK_TICK_HZ == 0U) {
+    return false;
+  }
+
+  TIM4->CR1 = TIM_CR1_ARPE; /* Stopped, up-counting, ARR preloaded */
+  TIM4->CCER = 0U;
+  for (std::uint32_t ch = 0U; ch < CHANNELS; ch++) {
+    lit[ch] = false;
+    output(ch, OC_PWM1, 0U);
+  }
+  timebase(PWM_HZ * PWM_STEPS, PWM_STEPS);
+  TIM4->CCER = TIM_CCER_CC1E | TIM_CCER_CC2E | TIM_CCER_CC3E | TIM_CCER_CC4E;
+  TIM4->CR1 |= TIM_CR1_CEN;
+
+  for (std::uint32_t ch = 0U; ch < CHANNELS; ch++) {
+    const std::uint32_t pin = FIRST_PD_PIN + ch;
+    const std::uint32_t af = (pin - 8U) * 4U; /* AFR[1] holds pins 8..15 */
+    GPIOD->AFR[1] = (GPIOD->AFR[1] & ~(0xFU << af)) | (AF_TIM4 << af);
+    GPIOD->OTYPER &= ~(1U << pin); /* Push-pull */
+    GPIOD->MODER = (GPIOD->MODER & ~(3U << (2U * pin))) |
+                   (MODER_AF << (2U * pin));
+  }
+  mode = Mode::DIM;
+  ready = true;
+  return true;
+}
+
+/** @brief Map a Driver_GPIO0 pin number to a TIM4 channel.
+ * @param pin GPIO pin number (port * 16 + pin).
+ * @param ch Receives the channel (0..3).
+ * @return false if the pin is not PD12..PD15 or the driver is not ready.
+ */
+bool LedPwm::channel(std::uint32_t pin, std::uint32_t &ch) const {
+  if (!ready || pin < FIRST_PIN || pin >= FIRST_PIN + CHANNELS) {
+    return false;
+  }
+  ch = pin - FIRST_PIN;
+  return true;
+}
+
+/** @brief Kernel clock of TIM4.
+ * APB1 timers run at twice the APB1 clock when APB1 is divided.
+ * @return Clock in Hz.
+ */
+std::uint32_t LedPwm::timerClock() const {
+  const std::uint32_t ppre1 =
+      (RCC->CFGR & RCC_CFGR_PPRE1) >> RCC_CFGR_PPRE1_Pos;
+  if (ppre1 < 4U) {
+    return SystemCoreClock; /* APB1 = HCLK */
+  }
+  return (SystemCoreClock >> (ppre1 - 3U)) * 2U; /* 100: /2 ... 111: /16 */
+}
+
+/** @brief Set the counter frequency and period, restart the counter.
+ * @param hz Counter ticks per second.
+ * @param steps Ticks per period (ARR + 1).
+ */
+void LedPwm::timebase(std::uint32_t hz, std::uint32_t steps) {
+  TIM4->PSC = timerClock() / hz - 1U;
+  TIM4->ARR = steps - 1U;
+  TIM4->EGR = TIM_EGR_UG; /* Load PSC, ARR and CCRs now */
+}
+
+/** @brief Program a channel's output compare mode and compare value.
+ * @param ch Channel (0..3).
+ * @param ocMode OCxM value (PWM mode 1 or 2).
+ * @param compare CCR value.
+ */
+void LedPwm::output(std::uint32_t ch, std::uint32_t ocMode,
+                    std::uint32_t compare) {
+  volatile uint32_t &ccmr = (ch < 2U) ? TIM4->CCMR1 : TIM4->CCMR2;
+  const std::uint32_t shift = (ch % 2U) * 8U;
+  ccmr = (ccmr & ~(0xFFU << shift)) |
+         (((ocMode << OCM_SHIFT) | (1U << OCPE_SHIFT)) << shift);
+  ccr(ch) = compare;
+}
+
+/** @brief Dim mode compare value for a lit channel.
+ * @param ch Channel (0..3).
+ * @return CCR value; PWM_STEPS (above ARR) keeps the output high.
+ */
+std::uint32_t LedPwm::duty(std::uint32_t ch) const {
+  const std::uint32_t l = level[ch];
+  return (l * l * PWM_STEPS + LEVEL_RANGE / 2U) / LEVEL_RANGE;
+}
+
+/** @brief Light a channel at its level.
+ * @param ch Channel (0..3).
+ */
+void LedPwm::on(std::uint32_t ch) {
+  lit[ch] = true;
+  if (mode == Mode::DIM) {
+    ccr(ch) = duty(ch);
+  }
+}
+
+/** @brief Turn a channel dark.
+ * @param ch Channel (0..3).
+ */
+void LedPwm::off(std::uint32_t ch) {
+  lit[ch] = false;
+  if (mode == Mode::DIM) {
+    ccr(ch) = 0U;
+  }
+}
+
+/** @brief Invert a channel.
+ * @param ch Channel (0..3).
+ */
+void LedPwm::toggle(std::uint32_t ch) {
+  if (lit[ch]) {
+    off(ch);
+  } else {
+    on(ch);
+  }
+}
+
+/** @brief Set the brightness a channel has when on.
+ * @param ch Channel (0..3).
+ * @param lvl 0 (dark) .. LEVEL_MAX (full), square-law to duty.
+ */
+void LedPwm::setLevel(std::uint32_t ch, std::uint8_t lvl) {
+  level[ch] = lvl;
+  if (mode == Mode::DIM && lit[ch]) {
+    ccr(ch) = duty(ch);
+  }
+}
+
+/** @brief Switch to blink mode; every channel starts dark.
+ * @param period Blink period in ms (1..BLINK_PERIOD_MAX_MS).
+ * @return false if the period is out of range or the driver is not ready.
+ */
+bool LedPwm::blink(std::uint32_t period) {
+  if (!ready || period == 0U || period > BLINK_PERIOD_MAX_MS) {
+    return false;
+  }
+  for (std::uint32_t ch = 0U; ch < CHANNELS; ch++) {
+    output(ch, OC_PWM1, 0U);
+  }
+  periodMs = period;
+  timebase(BLINK_TICK_HZ, period * (BLINK_TICK_HZ / 1000U));
+  mode = Mode::BLINK;
+  return true;
+}
+
+/** @brief Blink a channel in hardware.
+ * @param ch Channel (0..3).
+ * @param onMs On time per period (0: dark, >= period: always on).
+ * @param late true to be on at the end of the period instead of the start.
+ * @return false outside blink mode.
+ */
+bool LedPwm::setBlink(std::uint32_t ch, std::uint32_t onMs, bool late) {
+  if (mode != Mode::BLINK || ch >= CHANNELS) {
+    return false;
+  }
+  const std::uint32_t ticksPerMs = BLINK_TICK_HZ / 1000U;
+  const std::uint32_t on = (onMs < periodMs) ? onMs : periodMs;
+  if (late && on > 0U && on < periodMs) {
+    output(ch, OC_PWM2, (periodMs - on) * ticksPerMs);
+  } else {
+    output(ch, OC_PWM1, on * ticksPerMs);
+  }
+  return true;
+}
+
+/**
+ * @brief   Return to dim mode with the on/off state each LED was left in.
+ */
+void LedPwm::dim() {
+  if (!ready) {
+    return;
+  }
+  mode = Mode::DIM;
+  for (std::uint32_t ch = 0U; ch < CHANNELS; ch++) {
+    output(ch, OC_PWM1, lit[ch] ? duty(ch) : 0U);
+  }
+  timebase(PWM_HZ * PWM_STEPS, PWM_STEPS);
+}
@@ -0,0 +1,600 @@
+/**
+ * @file led_scheduler.cpp
+ * @brief All LED channels served by one thread from a timer wheel
+ * @author Mitul Goti
+ * @version 1.0
+ * @date 2025-10-09
+ * @ingroup led_thread
+ * @details
+ * This file implements the LedScheduler singleton: channel registration,
+ * the round-robin, free-running, pattern and hardware policies and the
+ * scheduler thread.
+ */
+
+/* LED Scheduler
+ ---
+ # 📝 Overview
+ LedThread gives every LED its own thread: a 1 KB stack and a control
+ block each, and a context switch through the shared semaphore for every
+ hand-over. LedScheduler drives all LEDs from one thread instead. Each LED
+ is a timer in a TimerWheel; the thread sleeps until the earliest deadline,
+ switches the LEDs that are due and sleeps again.
+
+ # ⚙️ Features
+ - Constant RAM: one 1 KB stack for up to 32 LEDs (about 190 bytes per
+   LED, most of it the two edge histograms).
+ - One wake-up per LED change, no semaphore hand-over between threads.
+ - ROUND_ROBIN policy (default): one LED lit at a time in turn, the same
+   sequence and "Event: LED ... ON" records as the LedThread build.
+ - FREE_RUNNING policy: every LED blinks on its own on/off period.
+ - Per-LED on/off times ('led <name> <on> [off]') in one atomic word per
+   channel: the USB thread writes, the scheduler reads at every timer arm,
+   no lock on either side.
+ - PATTERN policy: every LED runs a LedPattern bytecode program (built-in
+   or sent over USB); the thread is the interpreter for all of them.
+ - Deadlines advance from the previous deadline, so periods do not drift
+   by the time spent logging.
+ - All LEDs switched at one tick change in a single GPIO store, so the
+   round-robin hand-over never shows two LEDs or none.
+ - HARDWARE policy (LED_PWM builds): TIM4 blinks the LEDs in two
+   alternating pairs and the thread only waits for events.
+ - Edge jitter per LED: every change is measured against its wheel
+   deadline, with a count of deadlines restarted from now ('led jitter').
+
+ # 📋 Usage
+ Build with LED_SCHEDULER. app_main() registers the LEDs and starts the
+ thread:
+ ```
+ LedScheduler &leds = LedScheduler::getInstance();
+ leds.add("blue", LED_BLUE_PIN);
+ leds.init();
+ ```
+ USB command 'led policy rr|free|pattern|hw' switches the policy,
+ 'led pattern <led|all> <name>' or 'led pattern <led|all> = <text>' gives
+ LEDs a pattern.
+
+ # 🔧 Implementation Details
+ Timer id n belongs to channel n. In ROUND_ROBIN only the lit channel has a
+ timer; when it fires the LED goes off, the next one goes on and its timer
+ is armed one on-time after the old deadline. In FREE_RUNNING every channel
+ has a timer that toggles it. In PATTERN every channel's timer runs its
+ program up to the next wait and is armed for the length of that wait.
+ Channels start with the "blink" pattern (shared on-time). In HARDWARE no
+ timer is armed: TIM4 runs a period of twice the shared on-time, even
+ channels lit in its first half and odd ones in its second half, which is
+ the round-robin sequence of two LED pairs.
+
+ setPattern() runs in the USB thread: it compiles uploaded text there and
+ posts the bytecode through a message queue, so the scheduler thread is
+ the only one that touches channel programs. It copies uploads into one of
+ four 64-byte slots; a slot is reused once no other LED runs from it.
+
+ The thread waits on the application event flags with a timeout that ends
+ at the next deadline, so it sees LED_WAKE_FLAG (set by setPolicy() and
+ setPattern()) without polling; the user button goes to the input
+ dispatcher. A policy change turns all LEDs off and starts the new pattern
+ from the current tick. A deadline that has fallen more than a period
+ behind (the thread was starved) restarts from now instead of replaying
+ every missed step.
+
+ fire() notes each LED change with its deadline; once the tick's GPIO
+ store is done, recordEdges() reads the RTOS system timer once and puts
+ the error of every noted edge into the on or off histogram of its LED.
+
+ # ⚠️ Limitations
+ - Channels are registered before init(); the set is fixed afterwards.
+ - Changing a pattern restarts all LEDs from the current tick.
+ - On and off times are read when an LED changes, so a new value applies
+   from the next LED change (HARDWARE: from the next policy change).
+ - HARDWARE cannot light one LED of four at a time: TIM4 has one period.
+ */
+
+#include "led_scheduler.h"
+#include "cmsis_os2.h"
+#include "gpio_pin.h"
+#include "led.h"
+#include "led_pattern.h"
+#include "led_pwm.h"
+#include "led_thread.h"
+#include "log_router.h"
+#include "timer_wheel.h"
+#include "usb_logger.h"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @brief   Anonymous namespace for internal linkage.
+ * @details Contains the scheduler thread and pattern queue memory and
+ *          attributes.
+ */
+namespace {
+constexpr std::uint32_t IDLE_WAIT_MS = 1000U; /*!< Longest sleep, no LEDs */
+constexpr std::uint32_t CHANNEL_MS_MAX = 0xFFFFU; /*!< Per-channel limit */
+constexpr std::uint32_t PATTERN_QUEUE_LENGTH = 2U; /*!< Pending changes */
+constexpr std::uint32_t PATTERN_MSG_SIZE = 80U; /*!< Bytes per request */
+
+uint64_t pattern_queue_mem[PATTERN_QUEUE_LENGTH * PATTERN_MSG_SIZE / 8]
+    __attribute__((aligned(64))); /*!< Memory buffer for pattern queue */
+uint64_t pattern_queue_cb[32]
+    __attribute__((aligned(64))); /*!< Control block for pattern queue */
+constexpr osMessageQueueAttr_t patternQueueAttr = {
+    .name = "LedPatternQueue",            /*!< Name for debugging */
+    .attr_bits = 0U,                      /*!< No special attributes */
+    .cb_mem = pattern_queue_cb,           /*!< Control block memory */
+    .cb_size = sizeof(pattern_queue_cb),  /*!< Control block size */
+    .mq_mem = pattern_queue_mem,          /*!< Pointer to memory for queue */
+    .mq_size = sizeof(pattern_queue_mem), /*!< Size of the memory buffer */
+};
+
+uint64_t scheduler_stack[128]
+    __attribute__((aligned(64))); /*!< Static thread stack (aligned) */
+uint64_t scheduler_cb[32]
+    __attribute__((aligned(64))); /*!< Static thread control block (aligned) */
+constexpr osThreadAttr_t schedulerThreadAttr = {
+    .name = "LED Scheduler",               /*!< Name for debugging */
+    .attr_bits = 0U,                       /*!< No special attributes */
+    .cb_mem = scheduler_cb,                /*!< Thread control block */
+    .cb_size = sizeof(scheduler_cb),       /*!< Size of control block */
+    .stack_mem = scheduler_stack,          /*!< Pointer to static stack */
+    .stack_size = sizeof(scheduler_stack), /*!< Stack size in bytes */
+    .priority = osPriorityNormal           /*!< Same as the LED threads */
+};
+
+/** @brief Next deadline of a periodic channel.
+ * @param due Deadline that just expired.
+ * @param period Time to the next one.
+ * @param now Current tick.
+ * @return due + period, or now + period if that is already past.
+ */
+std::uint32_t nextDeadline(std::uint32_t due, std::uint32_t period,
+                           std::uint32_t now) {
+  const std::uint32_t next = due + period;
+  return (static_cast<std::int32_t>(next - now) < 0) ? (now + period) : next;
+}
+} // namespace
+
+/**
+ * @brief   Get the singleton instance of LedScheduler.
+ * @return  Reference to LedScheduler instance.
+ */
+LedScheduler &LedScheduler::getInstance() {
+  static LedScheduler instance;
+  return instance;
+}
+
+/** @brief Register an LED channel.
+ * @param name Name used in log records (static storage).
+ * @param pin GPIO pin of the LED.
+ * @param onMs On time in ms, 0 for the shared LedThread on-time.
+ * @param offMs Off time in ms for FREE_RUNNING, 0 for the on time.
+ * @return Channel index, -1 if full, started or a time is out of range.
+ */
+int LedScheduler::add(const char *name, std::uint32_t pin, std::uint32_t onMs,
+                      std::uint32_t offMs) {
+  if (threadId != nullptr || count >= MAX_CHANNELS ||
+      onMs > CHANNEL_MS_MAX || offMs > CHANNEL_MS_MAX) {
+    return -1;
+  }
+  Channel &ch = channels[count];
+  ch.name = name;
+  ch.pin = pin;
+  ch.timing.set({static_cast<std::uint16_t>(onMs),
+                 static_cast<std::uint16_t>(offMs)});
+  ch.lit = false;
+  const LedPattern::Builtin *const blink = LedPattern::find("blink");
+  ch.code = blink->code;
+  ch.size = blink->size;
+  return static_cast<int>(count++);
+}
+
+/** @brief Find a channel by name.
+ * @param name Name given to add().
+ * @return Channel index, -1 if there is none.
+ */
+int LedScheduler::find(std::string_view name) const {
+  for (std::uint32_t id = 0U; id < count; id++) {
+    if (name == channels[id].name) {
+      return static_cast<int>(id);
+    }
+  }
+  return -1;
+}
+
+/** @brief Timing of a channel, for changes at run time.
+ * The scheduler thread reads it whenever it arms the channel's timer, so
+ * a change applies from the channel's next on or off phase.
+ * @param name Channel name.
+ * @return Timing word of the channel, nullptr if there is none.
+ */
+LedTiming *LedScheduler::timing(std::string_view name) {
+  const int id = find(name);
+  return (id < 0) ? nullptr : &channels[id].timing;
+}
+
+/** @brief Set the brightness of LEDs.
+ * Called from the USB thread; a level is a single compare register write.
+ * @param led Channel name, or "all".
+ * @param level 0 (dark) .. 255 (full).
+ * @return false if there is no such LED or it has no PWM channel.
+ */
+bool LedScheduler::setLevel(std::string_view led, std::uint8_t level) {
+  bool ok = false;
+  for (std::uint32_t id = 0U; id < count; id++) {
+    if (led == "all" || led == channels[id].name) {
+      ok = Led::getInstance().setLevel(channels[id].pin, level) || ok;
+    }
+  }
+  return ok;
+}
+
+/**
+ * @brief   Start the scheduler thread.
+ */
+void LedScheduler::init() {
+  static_assert(sizeof(PatternRequest) <= PATTERN_MSG_SIZE,
+                "PATTERN_MSG_SIZE too small");
+  if (threadId != nullptr) {
+    return;
+  }
+  patternQueue = osMessageQueueNew(PATTERN_QUEUE_LENGTH,
+                                   sizeof(PatternRequest), &patternQueueAttr);
+  if (patternQueue == nullptr) {
+    UsbLogger::getInstance().log(
+        "Error: LED pattern queue can not be created.\r\n");
+  }
+  threadId = osThreadNew(threadWrapper, this, &schedulerThreadAttr);
+  if (threadId == nullptr) {
+    UsbLogger::getInstance().log(
+        "Error: LED scheduler thread can not be created.\r\n");
+  }
+}
+
+/** @brief Switch the policy.
+ * The scheduler turns all LEDs off and starts the new pattern.
+ * @param p New policy.
+ */
+void LedScheduler::setPolicy(Policy p) {
+  policy.store(p);
+  if (threadId != nullptr) {
+    osEventFlagsSet(app_events_get(), LED_WAKE_FLAG);
+  }
+}
+
+/** @brief Give LEDs a pattern.
+ * Called from the USB thread: compiles uploaded text here and posts the
+ * result to the scheduler thread, which applies it and restarts the LEDs.
+ * @param led Channel name, or "all".
+ * @param spec Built-in pattern name, or "= <pattern text>".
+ * @param errorAt Receives the column of a syntax error in the text.
+ * @return PATTERN_OK when the change is queued.
+ */
+LedScheduler::PatternStatus LedScheduler::setPattern(std::string_view led,
+                                                     std::string_view spec,
+                                                     std::size_t *errorAt) {
+  PatternRequest req;
+  if (led != "all") {
+    const int id = find(led);
+    if (id < 0) {
+      return PATTERN_NO_LED;
+    }
+    req.channel = static_cast<std::int16_t>(id);
+  }
+  if (!spec.empty() && spec.front() == '=') {
+    const auto code = LedPattern::compile<UPLOAD_SIZE>(spec.substr(1));
+    if (!code.ok()) {
+      if (errorAt != nullptr) {
+        *errorAt = code.error;
+      }
+      return PATTERN_SYNTAX;
+    }
+    req.code = code.bytes;
+    req.size = code.size;
+  } else {
+    const LedPattern::Builtin *const builtin = LedPattern::find(spec);
+    if (builtin == nullptr) {
+      return PATTERN_UNKNOWN;
+    }
+    req.builtin = builtin->code;
+    req.size = builtin->size;
+  }
+  if (patternQueue == nullptr ||
+      osMessageQueuePut(patternQueue, &req, 0U, 0U) != osOK) {
+    return PATTERN_BUSY;
+  }
+  policy.store(Policy::PATTERN);
+  osEventFlagsSet(app_events_get(), LED_WAKE_FLAG);
+  return PATTERN_OK;
+}
+
+/**
+ * @brief   Apply all queued pattern changes (scheduler thread).
+ */
+void LedScheduler::applyPatterns() {
+  PatternRequest req;
+  while (patternQueue != nullptr &&
+         osMessageQueueGet(patternQueue, &req, nullptr, 0U) == osOK) {
+    apply(req);
+  }
+}
+
+/** @brief Point channels at a new program.
+ * Uploaded code goes to a slot no other channel runs from.
+ * @param req Queued pattern change.
+ */
+void LedScheduler::apply(const PatternRequest &req) {
+  const std::uint8_t *code = req.builtin;
+  for (std::size_t slot = 0U; code == nullptr && slot < UPLOAD_SLOTS;
+       slot++) {
+    bool used = false;
+    for (std::uint32_t id = 0U; id < count && req.channel >= 0; id++) {
+      used = used || (channels[id].code == uploads[slot].data() &&
+                       id != static_cast<std::uint32_t>(req.channel));
+    }
+    if (!used) {
+      uploads[slot] = req.code;
+      code = uploads[slot].data();
+    }
+  }
+  if (code == nullptr) {
+    UsbLogger::getInstance().log("Error: No free LED pattern slot.\r\n");
+    return;
+  }
+  for (std::uint32_t id = 0U; id < count; id++) {
+    if (req.channel < 0 || id == static_cast<std::uint32_t>(req.channel)) {
+      channels[id].code = code;
+      channels[id].size = req.size;
+    }
+  }
+  const char *const name =
+      (req.channel < 0) ? "all" : channels[req.channel].name;
+  LogRouter::getInstance().log("Event: LED %s pattern changed\r\n", name);
+}
+
+/** @brief Thread entry point.
+ * @param argument Pointer to the LedScheduler instance.
+ */
+void LedScheduler::threadWrapper(void *argument) {
+  static_cast<LedScheduler *>(argument)->run();
+}
+
+/** @brief TimerWheel fire handler.
+ * @param context Pointer to the LedScheduler instance.
+ * @param id Expired channel timer.
+ */
+void LedScheduler::fireWrapper(void *context, std::uint16_t id) {
+  static_cast<LedScheduler *>(context)->fire(id);
+}
+
+/** @brief On time of a channel.
+ * @param id Channel index.
+ * @return Milliseconds.
+ */
+std::uint32_t LedScheduler::onTime(std::uint16_t id) const {
+  const std::uint32_t ms = channels[id].timing.get().onMs;
+  return (ms != 0U) ? ms : LedThread::getOnTime();
+}
+
+/** @brief Off time of a channel (FREE_RUNNING).
+ * @param id Channel index.
+ * @return Milliseconds.
+ */
+std::uint32_t LedScheduler::offTime(std::uint16_t id) const {
+  const std::uint32_t ms = channels[id].timing.get().offMs;
+  return (ms != 0U) ? ms : onTime(id);
+}
+
+/** @brief Switch a channel's LED.
+ * @param id Channel index.
+ * @param on true to light it.
+ */
+void LedScheduler::light(std::uint16_t id, bool on) {
+  Channel &ch = channels[id];
+  Led::getInstance().stage(gpio, ch.pin, on); // Committed after the tick
+  ch.lit = on;
+}
+
+/** @brief Log that a channel's LED went on (round-robin, free-running).
+ * @param id Channel index.
+ */
+void LedScheduler::logOn(std::uint16_t id) const {
+  LogRouter::getInstance().log("Event: LED %s ON for %d ms\r\n",
+                               channels[id].name, onTime(id));
+}
+
+/** @brief Turn all LEDs off and arm the timers of the current policy.
+ * @param now Tick the pattern starts at.
+ */
+void LedScheduler::restart(std::uint32_t now) {
+  LedPwm *const pwm = Led::getInstance().getPwm();
+  if (pwm != nullptr && pwm->getMode() == LedPwm::Mode::BLINK) {
+    pwm->dim(); // Software timing again
+  }
+  wheel.reset(now);
+  for (std::uint16_t id = 0U; id < count; id++) {
+    light(id, false);
+    channels[id].vm = LedPattern::State{};
+  }
+  gpio.commit();
+  if (count == 0U) {
+    return;
+  }
+  if (policy.load() == Policy::HARDWARE) {
+    if (hardwareBlink()) {
+      return;
+    }
+    UsbLogger::getInstance().log(
+        "Error: No hardware LED blink (LED_PWM builds only).\r\n");
+    policy.store(Policy::ROUND_ROBIN);
+  }
+  if (policy.load() == Policy::ROUND_ROBIN) {
+    // The last channel "expires" now and hands over to the first
+    wheel.arm(static_cast<std::uint16_t>(count - 1U), now);
+  } else {
+    for (std::uint16_t id = 0U; id < count; id++) {
+      wheel.arm(id, now);
+    }
+  }
+}
+
+/** @brief Let TIM4 blink the channels on its pins.
+ * @return false without a PWM backend or with an on-time out of range.
+ */
+bool LedScheduler::hardwareBlink() {
+  LedPwm *const pwm = Led::getInstance().getPwm();
+  const std::uint32_t half = LedThread::getOnTime();
+  if (pwm == nullptr || !pwm->blink(2U * half)) {
+    return false;
+  }
+  for (std::uint16_t id = 0U; id < count; id++) {
+    std::uint32_t ch;
+    if (pwm->channel(channels[id].pin, ch)) {
+      const std::uint32_t on = onTime(id);
+      pwm->setBlink(ch, (on < half) ? on : half, (id % 2U) != 0U);
+    }
+  }
+  LogRouter::getInstance().log("Event: LEDs blink in hardware, %d ms\r\n",
+                               2U * half);
+  return true;
+}
+
+/** @brief Handle an expired channel timer.
+ * @param id Channel whose deadline passed.
+ */
+void LedScheduler::fire(std::uint16_t id) {
+  const std::uint32_t due = wheel.expiry(id);
+  const std::uint32_t now = osKernelGetTickCount();
+  const Policy p = policy.load();
+  Channel &ch = channels[id];
+  if (p == Policy::PATTERN) {
+    const std::uint32_t wait =
+        LedPattern::step(ch.code, ch.size, ch.vm, onTime(id));
+    if (ch.vm.lit != ch.lit) {
+      light(id, ch.vm.lit);
+      edge(id, due, ch.vm.lit);
+    }
+    if (wait == LedPattern::RUNAWAY) {
+      LogRouter::getInstance().log(
+          "Error: LED %s pattern does not wait, stopped\r\n", ch.name);
+    } else if (wait != LedPattern::HALT) {
+      rearm(id, due, wait, now);
+    }
+  } else if (p == Policy::ROUND_ROBIN) {
+    const std::uint16_t next =
+        static_cast<std::uint16_t>((id + 1U) % count);
+    if (ch.lit) {
+      edge(id, due, false);
+    }
+    light(id, false);
+    light(next, true);
+    edge(next, due, true);
+    logOn(next);
+    rearm(next, due, onTime(next), now);
+  } else if (ch.lit) {
+    light(id, false);
+    edge(id, due, false);
+    rearm(id, due, offTime(id), now);
+  } else {
+    light(id, true);
+    edge(id, due, true);
+    logOn(id);
+    rearm(id, due, onTime(id), now);
+  }
+}
+
+/** @brief Arm a periodic channel timer.
+ * A deadline already past (the thread was starved for more than a period)
+ * restarts from now and counts as a slip.
+ * @param id Channel index.
+ * @param due Deadline that just expired.
+ * @param period Time to the next one.
+ * @param now Current tick.
+ */
+void LedScheduler::rearm(std::uint16_t id, std::uint32_t due,
+                         std::uint32_t period, std::uint32_t now) {
+  const std::uint32_t next = nextDeadline(due, period, now);
+  if (next != due + period) {
+    channels[id].slips.fetch_add(1U);
+  }
+  wheel.arm(id, next);
+}
+
+/** @brief Note an LED change staged for the next GPIO commit.
+ * @param id Channel switched.
+ * @param due Wheel deadline the change was due at.
+ * @param on true if the LED goes on.
+ */
+void LedScheduler::edge(std::uint16_t id, std::uint32_t due, bool on) {
+  if (edgeCount < edges.size()) {
+    edges[edgeCount++] = {due, id, on};
+  }
+}
+
+/** @brief Measure the edges just committed.
+ * All of them reached the pins with the same GPIO store, so one reading of
+ * the RTOS system timer serves every edge of the tick. Each error goes
+ * into the histograms of the LED it switched.
+ */
+void LedScheduler::recordEdges() {
+  if (edgeCount == 0U) {
+    return;
+  }
+  const std::uint32_t at = osKernelGetSysTimerCount();
+  const std::uint32_t countsPerTick =
+      osKernelGetSysTimerFreq() / osKernelGetTickFreq();
+  const std::uint32_t countsPerUs = osKernelGetSysTimerFreq() / 1000000U;
+  for (std::uint32_t i = 0U; i < edgeCount; i++) {
+    const std::int32_t error = JitterHistogram::errorUs(
+        at, edges[i].due * countsPerTick, countsPerUs);
+    Channel &ch = channels[edges[i].id];
+    (edges[i].on ? ch.onJitter : ch.offJitter).record(error);
+  }
+  edgeCount = 0U;
+}
+
+/**
+ * @brief   Clear an LED's edge histograms and slip count.
+ * @details Called from the USB thread; an edge recorded at the same time
+ *          may survive the reset.
+ * @param   id Channel index (below channelCount()).
+ */
+void LedScheduler::resetJitter(std::uint32_t id) {
+  Channel &ch = channels[id];
+  ch.onJitter.reset();
+  ch.offJitter.reset();
+  ch.slips.store(0U);
+}
+
+/**
+ * @brief   Scheduler thread: fire due timers, sleep to the next deadline.
+ */
+void LedScheduler::run() {
+  restart(osKernelGetTickCount());
+  for (;;) {
+    const std::uint32_t now = osKernelGetTickCount();
+    wheel.advance(now, fireWrapper, this);
+    gpio.commit(); // Every LED due at this tick in one store per port
+    recordEdges();
+    // untilNext() counts from the tick after now
+    const std::uint32_t wake = now + 1U + wheel.untilNext(IDLE_WAIT_MS);
+    const std::int32_t wait =
+        static_cast<std::int32_t>(wake - osKernelGetTickCount());
+    if (wait <= 0) {
+      continue; // Logging took us past the next deadline
+    }
+    const std::uint32_t flags =
+        osEventFlagsWait(app_events_get(), LED_WAKE_FLAG, osFlagsWaitAny,
+                         static_cast<std::uint32_t>(wait));
+    if (flags == osFlagsErrorTimeout) {
+      continue;
+    }
+    if ((flags & osFlagsError) != 0U) {
+      osDelay(static_cast<std::uint32_t>(wait)); // No event flags
+      continue;
+    }
+    if ((flags & LED_WAKE_FLAG) != 0U) {
+      applyPatterns();
+      restart(osKernelGetTickCount());
+    }
+  }
+}
@@ -26,8 +26,14 @@
   # ⚙️ Features
   - Each LED is controlled by a separate thread.
   - Shared semaphore for mutual exclusion on GPIO access.
-  - Event flags for inter-thread communication (e.g., button press events).
-  - Configurable LED on-time duration.
+  - Event flags for inter-thread communication (e.g., LED setup changes).
+  - Configurable LED on-time duration, shared or per LED.
+  - Per-LED on/off times published as one atomic word (LedTiming): the USB
+    thread changes them and each LED thread picks them up on its next
+    cycle, without a mutex.
+  - Drift-free timing: edges are placed on absolute ticks (osDelayUntil),
+    and every edge's error against its ideal time goes into a per-LED
+    histogram (JitterHistogram, `led jitter`).
   - Thread-safe design using CMSIS-RTOS2 primitives.
 
   # 📋 Usage
@@ -44,8 +50,8 @@
  also provides a static method to retrieve a shared semaphore instance, ensuring
  that it is created only once.
 
- Event flags are used to signal button press events to the LED threads, allowing
- them to respond accordingly. The LED on-time duration is configurable via a
+ The user button is served by the input dispatcher (input.h), so no LED
+ thread ever waits on it. The LED on-time duration is configurable via a
  static member variable, allowing all LED threads to share the same on-time
  setting.
 
@@ -69,7 +75,12 @@
 #include "eventrecorder.h"
 #endif
 
-uint32_t LedThread::onTime = 500; /*!< Definition of static member variable */
+std::atomic<uint32_t> LedThread::onTime{
+    500U}; /*!< Definition of static member variable */
+std::array<LedThread *, LedThread::MAX_LEDS>
+    LedThread::leds{}; /*!< Constructed LED threads, for find() */
+std::atomic<uint32_t> LedThread::ledCount{0U}; /*!< Entries in leds */
+std::atomic<uint32_t> LedThread::slotEnd{0U}; /*!< Ideal end of last slot */
 
 /**
  * @namespace App
@@ -108,12 +119,12 @@ osSemaphoreId_t shared_semaphore(void) {
 } // namespace
 
 /**
- * @brief Get the event flags for button press.
+ * @brief Get the application event flags.
  * @details
  *   Initializes the event flags only once using std::call_once to ensure
- *   thread-safe access. Returns the event flags ID used for signaling button
- *   presses to the LED threads.
- * @return osEventFlagsId_t Event flags ID for button press.
+ *   thread-safe access. Returns the event flags ID used for signaling LED
+ *   setup changes (LED_WAKE_FLAG) to the LED scheduler.
+ * @return osEventFlagsId_t Application event flags ID.
  */
 osEventFlagsId_t app_events_get() {
   static std::once_flag
@@ -151,6 +162,12 @@ LedThread::LedThread(std::string_view threadName, uint32_t pin) : pin(pin) {
       .stack_size = sizeof(stack), /*!< Stack size in bytes */
       .priority = osPriorityNormal /*!< Thread priority */
   };
+  /* Register for find() before the thread can be addressed by name */
+  const uint32_t slot = ledCount.load(std::memory_order_relaxed);
+  if (slot < MAX_LEDS) {
+    leds[slot] = this;
+    ledCount.store(slot + 1U, std::memory_order_release);
+  }
   /* Semaphore for multiplexing access to GPIO pins */
   this->sem = shared_semaphore();
   if (this->sem == nullptr) {
@@ -159,6 +176,39 @@ LedThread::LedThread(std::string_view threadName, uint32_t pin) : pin(pin) {
   this->start();
 }
 
+/**
+ * @brief Find an LED thread by its name.
+ * @param name Thread name given to the constructor.
+ * @return The LED thread, nullptr if there is none.
+ */
+LedThread *LedThread::find(std::string_view name) {
+  const uint32_t count = ledCount.load(std::memory_order_acquire);
+  for (uint32_t i = 0U; i < count; i++) {
+    if (name == leds[i]->thread_attr.name) {
+      return leds[i];
+    }
+  }
+  return nullptr;
+}
+
+/**
+ * @brief Get an LED thread by registration order.
+ * @param i Index, 0 for the first LED thread constructed.
+ * @return The LED thread, nullptr if there are not that many.
+ */
+LedThread *LedThread::get(uint32_t i) {
+  return (i < ledCount.load(std::memory_order_acquire)) ? leds[i] : nullptr;
+}
+
+/**
+ * @brief Clear the edge histograms and the slip count.
+ */
+void LedThread::resetJitter(void) {
+  onJitter.reset();
+  offJitter.reset();
+  slips.store(0U);
+}
+
 /**
  * @brief Start the thread to control LED blinking.
  */
@@ -196,39 +246,30 @@ void LedThread::thread_entry(void *argument) {
   thread->run();
 }
 
-/**
- * @brief Check for button press events.
- * @details
- *   Checks for a button press event. If detected, it replays the file system
- * logs to USB. Debounces the button press and clears the event flag.
- * @note This function is non-blocking and returns immediately if no event is
- *       detected.
- * @param arg Pointer to the LED thread instance.
- */
-void LedThread::checkButtonEvent(void *arg) {
-  if (osEventFlagsWait(app_events_get(), USER_BUTTON_FLAG, osFlagsWaitAny,
-                       0U) == USER_BUTTON_FLAG) {
-#ifdef FS_LOG
-    LogRouter::getInstance().replayFsLogsToUsb(); /* Replay logs to USB */
-#endif
-    osDelay(50U); /* Debounce delay */
-    osEventFlagsClear(app_events_get(),
-                      USER_BUTTON_FLAG); /* Clear the event flag */
-  }
-}
-
 /**
  * @brief Main control loop for the LED thread.
  * @details
  *   Contains the logic to toggle the LED on and off with a delay.
- *   Checks for button press events to adjust the on-time of the LED.
- *   Access to the LED GPIO pin is synchronized using a semaphore.
+ *   Access to the LED GPIO pin is synchronized using a semaphore. The LED's
+ *   own times are read once per cycle; an off time keeps the thread out of
+ *   the rotation for that long after its turn.
+ *
+ *   Edges are placed on absolute ticks with osDelayUntil(): a slot starts
+ *   when the previous one ideally ended (or when this LED became ready)
+ *   and ends on-time ticks later, so logging, semaphore hand-over and
+ *   rescheduling never add up to a drift. Each edge's error against its
+ *   ideal tick is measured with the RTOS system timer. A start more than
+ *   a slot late restarts the schedule from now and counts a slip.
  */
 void LedThread::run(void) {
 #ifdef DEBUG
   const char *const str = osThreadGetName(thread_id);
   const char *const blue = "blue";
 #endif
+  const uint32_t countsPerTick =
+      osKernelGetSysTimerFreq() / osKernelGetTickFreq();
+  const uint32_t countsPerUs = osKernelGetSysTimerFreq() / 1000000U;
+  uint32_t ready = osKernelGetTickCount(); /* Ideal tick to light again */
   for (;;) {
     /* Acquire semaphore before accessing the LED */
     osSemaphoreAcquire(sem, osWaitForever);
@@ -237,21 +278,44 @@ void LedThread::run(void) {
       EventStartA(10);
 #endif
 
+    const LedTiming::Times times = timing.get(); /* Snapshot, no lock */
+    const uint32_t onMs = (times.onMs != 0U) ? times.onMs : getOnTime();
+
+    /* The slot starts when the previous one ideally ended, or when this
+     * LED became ready, whichever is later */
+    const uint32_t slot = slotEnd.load(std::memory_order_relaxed);
+    uint32_t idealOn =
+        (static_cast<int32_t>(slot - ready) > 0) ? slot : ready;
+    if (static_cast<int32_t>(osKernelGetTickCount() - idealOn) >=
+        static_cast<int32_t>(onMs)) {
+      idealOn = osKernelGetTickCount(); /* Starved: restart from now */
+      slips.fetch_add(1U);
+    }
+    const uint32_t idealOff = idealOn + onMs;
+
     Led::getInstance().on(pin); /* Turn LED on */
+    onJitter.record(JitterHistogram::errorUs(
+        osKernelGetSysTimerCount(), idealOn * countsPerTick, countsPerUs));
 
     LogRouter::getInstance().log("Event: LED %s ON for %d ms\r\n",
-                                 thread_attr.name, getOnTime());
+                                 thread_attr.name, onMs);
 
-    osDelay(getOnTime());
+    osDelayUntil(idealOff); /* Absolute: the log call above is absorbed */
 
     Led::getInstance().off(pin);
+    offJitter.record(JitterHistogram::errorUs(
+        osKernelGetSysTimerCount(), idealOff * countsPerTick, countsPerUs));
 #ifdef DEBUG
     if (strcmp(str, blue) == 0)
       EventStopA(10);
 #endif
+    slotEnd.store(idealOff, std::memory_order_relaxed); /* Under sem */
     /* Release semaphore for next thread */
     osSemaphoreRelease(sem);
-    checkButtonEvent(this); /* Check for button press events */
+    ready = idealOff + times.offMs;
+    if (times.offMs != 0U) {
+      osDelayUntil(ready); /* Own off time, out of the rotation */
+    }
     /* Small delay to prevent aggressive rescheduling */
     osThreadYield();
   }
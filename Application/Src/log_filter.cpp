@@ -0,0 +1,294 @@
+/**
+ * @file    log_filter.cpp
+ * @brief   Severity, keyword and time-range filtering of log lines.
+ * @author  Mitul Goti
+ * @version 1.0
+ * @date    2025-09-21
+ * @ingroup Logger
+ * @{
+ * @details
+ * Implements LogFilter parsing and the LogScanner multi-pattern matcher used
+ * by the replay path to drop non-matching lines on the device, so only
+ * matching lines consume USB bandwidth.
+ */
+
+/* Log Filter
+ ---
+ # 📝 Overview
+ Operators usually only want errors, but a plain replay streams every line of
+ the log file. A filter is attached to the replay request and evaluated on
+ each 256-byte read buffer before it is handed to USB.
+
+ # ⚙️ Features
+ - Severity filter derived from the line tags used throughout the firmware.
+ - Keyword filter (case sensitive substring, up to 15 characters).
+ - Time-range filter on the "[hh:mm:ss.mmm]" timestamp prefix (also the
+   fine "[hh:mm:ss.fffffff]" form; the extra digits are ignored).
+ - Single pass over each line for all patterns.
+
+ # 📋 Usage
+ `fsLog out err`, `fsLog out warn since 12:00:00`,
+ `fsLog out find LED until 12:30:00`.
+
+ # 🔧 Implementation Details
+ All tag patterns plus the keyword are registered in a 256-entry table indexed
+ by the first byte of the pattern; each entry is a bitmask of pattern ids. The
+ scanner walks the line once and only compares patterns whose first byte
+ matches the current byte. Lines that pass are moved down in place, so no
+ second buffer is needed.
+ */
+
+#include "log_filter.h"
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string_view>
+
+/**
+ * @brief   Anonymous namespace for internal linkage.
+ * @details Contains the severity tag table and parsing helpers.
+ */
+namespace {
+/** @brief Severity tag as written by the firmware */
+struct Tag {
+  std::string_view text; /*!< Tag text */
+  LogLevel level;        /*!< Severity it implies */
+};
+
+/** @brief Tags recognized as severities (ids 0..n-1 in the scanner) */
+constexpr std::array<Tag, 12> tags = {{
+    {"Info", LogLevel::INFO},
+    {"Reply", LogLevel::INFO},
+    {"Supervisor", LogLevel::INFO},
+    {"Event", LogLevel::EVENT},
+    {"Warning", LogLevel::WARNING},
+    {"Overflow", LogLevel::WARNING},
+    {"Error", LogLevel::ERROR},
+    {"Fail", LogLevel::ERROR},
+    {"Program Fault", LogLevel::ERROR},
+    {"Critical", LogLevel::CRITICAL},
+    {"Hardware Fault", LogLevel::CRITICAL},
+    {"System Fault", LogLevel::CRITICAL},
+}};
+
+/** @brief Severity names accepted on the command line */
+constexpr std::array<Tag, 5> levelNames = {{
+    {"info", LogLevel::INFO},
+    {"event", LogLevel::EVENT},
+    {"warn", LogLevel::WARNING},
+    {"err", LogLevel::ERROR},
+    {"crit", LogLevel::CRITICAL},
+}};
+
+/**
+ * @brief   Parse "hh:mm:ss" into milliseconds of the day.
+ * @param   str  Input text.
+ * @param   ms   Parsed value.
+ * @return  true on success.
+ */
+bool parseTimeOfDay(std::string_view str, std::uint32_t &ms) {
+  unsigned h = 0, m = 0, s = 0;
+  if (str.size() < 8 || std::sscanf(str.data(), "%2u:%2u:%2u", &h, &m, &s) != 3 ||
+      h >= 24 || m >= 60 || s >= 60) {
+    return false;
+  }
+  ms = (h * 3600000U) + (m * 60000U) + (s * 1000U);
+  return true;
+}
+
+/**
+ * @brief   Extract the timestamp of a "[hh:mm:ss.mmm] ..." line.
+ * @details "[hh:mm:ss.fffffff]" stamps are read to the millisecond.
+ * @param   line Log line.
+ * @param   ms   Time of day in milliseconds.
+ * @return  true if the line carries a timestamp.
+ */
+bool lineTime(std::string_view line, std::uint32_t &ms) {
+  if (line.size() < 14 || line[0] != '[' || line[3] != ':' || line[6] != ':' ||
+      line[9] != '.' ||
+      (line[13] != ']' && (line.size() < 18 || line[17] != ']'))) {
+    return false;
+  }
+  auto d = [&](std::size_t i) {
+    return static_cast<std::uint32_t>(line[i] - '0');
+  };
+  ms = (d(1) * 10 + d(2)) * 3600000U + (d(4) * 10 + d(5)) * 60000U +
+       (d(7) * 10 + d(8)) * 1000U + d(10) * 100 + d(11) * 10 + d(12);
+  return true;
+}
+
+/**
+ * @brief   Split off the next space-separated token.
+ * @param   args Remaining text (advanced past the token).
+ * @return  The token (empty at end).
+ */
+std::string_view nextToken(std::string_view &args) {
+  std::size_t start = args.find_first_not_of(' ');
+  if (start == std::string_view::npos) {
+    args = {};
+    return {};
+  }
+  args.remove_prefix(start);
+  std::size_t end = args.find(' ');
+  std::string_view token = args.substr(0, end);
+  args.remove_prefix(end == std::string_view::npos ? args.size() : end);
+  return token;
+}
+} // namespace
+
+/**
+ * @brief   Parse a filter from command arguments.
+ * @details Tokens: a severity name (info, event, warn, err, crit),
+ *          "since hh:mm:ss", "until hh:mm:ss" and "find <word>".
+ * @param   args Command arguments.
+ * @return  true if all tokens were understood.
+ */
+bool LogFilter::parse(std::string_view args) {
+  *this = LogFilter{};
+  for (std::string_view token = nextToken(args); !token.empty();
+       token = nextToken(args)) {
+    bool known = false;
+    for (const auto &name : levelNames) {
+      if (token == name.text) {
+        minLevel = name.level;
+        known = true;
+      }
+    }
+    if (known) {
+      continue;
+    }
+    std::string_view value = nextToken(args);
+    if (token == "since") {
+      known = parseTimeOfDay(value, fromMs);
+    } else if (token == "until") {
+      known = parseTimeOfDay(value, toMs);
+      if (known) {
+        toMs += 999U; /* Inclusive up to the end of that second */
+      }
+    } else if (token == "find" && !value.empty() &&
+               value.size() < keyword.size()) {
+      std::memcpy(keyword.data(), value.data(), value.size());
+      keyword[value.size()] = '\0';
+      known = true;
+    }
+    if (!known) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief   Check if the filter restricts the output at all.
+ * @return  true if any criterion is set.
+ */
+bool LogFilter::isActive() const {
+  return minLevel != LogLevel::NONE || fromMs != NO_TIME || toMs != NO_TIME ||
+         keyword[0] != '\0';
+}
+
+/**
+ * @brief   Build the first-byte dispatch table for a filter.
+ * @param   filter Filter to evaluate (must outlive the scanner).
+ */
+LogScanner::LogScanner(const LogFilter &filter)
+    : filter(filter),
+      keyword(filter.keyword.data(),
+              strnlen(filter.keyword.data(), filter.keyword.size())) {
+  for (std::size_t i = 0; i < tags.size(); i++) {
+    firstByte[static_cast<std::uint8_t>(tags[i].text[0])] |= (1U << i);
+  }
+  if (!keyword.empty()) {
+    firstByte[static_cast<std::uint8_t>(keyword[0])] |= (1U << KEYWORD_ID);
+  }
+}
+
+/**
+ * @brief   Scan a line once for all severity tags and the keyword.
+ * @param   line        Log line.
+ * @param   keywordHit  Set if the keyword occurs in the line.
+ * @return  Highest severity found.
+ */
+LogLevel LogScanner::scan(std::string_view line, bool &keywordHit) const {
+  LogLevel level = LogLevel::NONE;
+  keywordHit = false;
+  for (std::size_t i = 0; i < line.size(); i++) {
+    std::uint16_t candidates = firstByte[static_cast<std::uint8_t>(line[i])];
+    while (candidates != 0U) {
+      std::uint32_t id = static_cast<std::uint32_t>(__builtin_ctz(candidates));
+      candidates &= static_cast<std::uint16_t>(candidates - 1U);
+      std::string_view pattern = (id == KEYWORD_ID) ? keyword : tags[id].text;
+      if (line.compare(i, pattern.size(), pattern) != 0) {
+        continue;
+      }
+      if (id == KEYWORD_ID) {
+        keywordHit = true;
+      } else if (tags[id].level > level) {
+        level = tags[id].level;
+      }
+    }
+  }
+  return level;
+}
+
+/**
+ * @brief   Evaluate the filter on one line.
+ * @param   line Log line (with or without line ending).
+ * @return  true if the line passes the filter.
+ */
+bool LogScanner::match(std::string_view line) const {
+  if (filter.fromMs != LogFilter::NO_TIME ||
+      filter.toMs != LogFilter::NO_TIME) {
+    std::uint32_t ms = 0;
+    if (!lineTime(line, ms) ||
+        (filter.fromMs != LogFilter::NO_TIME && ms < filter.fromMs) ||
+        (filter.toMs != LogFilter::NO_TIME && ms > filter.toMs)) {
+      return false;
+    }
+  }
+  bool keywordHit = false;
+  LogLevel level = scan(line, keywordHit);
+  if (level < filter.minLevel) {
+    return false;
+  }
+  return keyword.empty() || keywordHit;
+}
+
+/**
+ * @brief   Keep only matching lines of a buffer.
+ * @details Lines are separated by '\n'; a trailing partial line is kept as a
+ *          line of its own. Matching lines are moved down in place.
+ * @param   buf Buffer holding whole lines.
+ * @param   len Number of valid bytes in buf.
+ * @return  Number of bytes remaining in buf.
+ */
+std::size_t LogScanner::compact(char *buf, std::size_t len) const {
+  std::size_t out = 0;
+  std::size_t start = 0;
+  while (start < len) {
+    const void *nl = std::memchr(buf + start, '\n', len - start);
+    std::size_t end =
+        (nl != nullptr) ? static_cast<const char *>(nl) - buf + 1 : len;
+    if (match(std::string_view(buf + start, end - start))) {
+      std::memmove(buf + out, buf + start, end - start);
+      out += end - start;
+    }
+    start = end;
+  }
+  return out;
+}
+
+/**
+ * @brief   Severity of a log line.
+ * @param   line Log line.
+ * @return  Highest severity tag found in the line.
+ */
+LogLevel LogScanner::levelOf(std::string_view line) {
+  static const LogFilter none;
+  static const LogScanner scanner(none);
+  bool keywordHit = false;
+  return scanner.scan(line, keywordHit);
+}
+
+/** @} */ // end of Logger
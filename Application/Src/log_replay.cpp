@@ -0,0 +1,506 @@
+/**
+ * @file    log_replay.cpp
+ * @brief   Background worker that replays file system logs to USB.
+ * @author  Mitul Goti
+ * @version 1.0
+ * @date    2025-09-20
+ * @ingroup Logger
+ * @{
+ * @details
+ * This module owns the replay worker thread. Replay requests coming from the
+ * user button or the USB command interface are queued and served
+ * asynchronously, so the requesting thread never blocks on the file system or
+ * on USB transfers.
+ */
+
+/* Log Replay
+ ---
+ # 📝 Overview
+ Replaying the log file used to run on whichever thread requested it, so an LED
+ thread that saw the button flag stopped blinking for the whole replay. The
+ Log Replay worker moves that work onto a dedicated low-priority thread.
+
+ # ⚙️ Features
+ - Request queue served by a dedicated thread (static allocation).
+ - Progress reporting (bytes sent / bytes requested).
+ - Cancellation of the running and all pending replays (`fsLog stop`).
+ - Configurable throttle between 256-byte chunks (`fsLog throttle <ms>`).
+ - Button debounce handled by timestamp, no delay on the caller's thread.
+ - Optional on-device line filter per request (see log_filter.h).
+ - Every replay reads through its own FsLog reader handle; filtered replays
+   use a temporary reader starting at offset 0.
+ - Live follow mode (`fsLog follow on`) on a separate thread, fed by records
+   as FsLog commits them, so it can run next to a replay.
+ - Raw RAM drive image dumps (`fs dump [offset]`) served by the same worker.
+ - Windowed replay with host acknowledgements (`fsLog get`, `fsLog ack`)
+   that resumes from the last acknowledged position after a disconnect.
+ - Replays of the raw RAM log (`rawLog out`, RAW_LOG builds) through
+   RawLog::replayLogsToUsb(), with the same control block and filter.
+
+ # 📋 Usage
+ Call `LogReplay::getInstance().init()` once after the file system logger is
+ initialized. Post replays with `request()`; `LogRouter::replayFsLogsToUsb()`
+ does this for you.
+
+ # 🔧 Implementation Details
+ Requests are posted with a zero timeout, so `request()` never blocks. The
+ worker hands a shared `FsReplayControl` block to `FsLog::replayLogsToUsb()`,
+ which checks the cancel flag and applies the throttle between chunks.
+ Every request carries the generation it was posted in; cancel() bumps the
+ generation before it raises the flag, and the worker drops a request whose
+ generation is stale after clearing the flag, so a stop is never lost.
+ */
+
+#include "log_replay.h"
+#include "cmsis_os2.h"
+#ifdef FS_BENCH
+#include "fs_bench.h"
+#endif
+#include "fs_log.h"
+#include "log_router.h"
+#ifdef RAW_LOG
+#include "raw_log.h"
+#endif
+#include "usb_logger.h"
+#include <array>
+#include <cstdint>
+#include <cstdio>
+
+/**
+ * @brief   Anonymous namespace for internal linkage.
+ * @details Contains the request queue and the static worker thread memory.
+ */
+namespace {
+constexpr uint32_t REPLAY_QUEUE_LENGTH = 4; /*!< Pending replay requests */
+constexpr uint32_t REPLAY_DEBOUNCE_MS = 50; /*!< Button debounce window */
+constexpr uint32_t REPLAY_THROTTLE_MAX = 1000; /*!< Upper throttle bound */
+
+/** @brief Kind of work a request asks for */
+enum class ReplayKind : std::uint8_t {
+  LINES = 0,  /*!< Plain or filtered replay of log lines */
+  DUMP = 1,   /*!< Raw volume image */
+  WINDOW = 2, /*!< Acknowledged replay of log lines */
+  BENCH = 3,  /*!< Format benchmark of the log drive */
+  RAW = 4,    /*!< Plain or filtered replay of the raw log */
+};
+
+/** @brief Replay request as stored in the queue */
+struct ReplayRequest {
+  LogReplay::Source source; /*!< Origin of the request */
+  LogFilter filter;         /*!< Lines to keep (default: all) */
+  ReplayKind kind = ReplayKind::LINES; /*!< What to send */
+  std::uint32_t offset = 0U; /*!< First image byte / reader position */
+  bool resume = false; /*!< Window: continue at the acknowledged position */
+  std::uint32_t generation = 0U; /*!< LogReplay generation when posted */
+};
+
+osMessageQueueId_t replayQueueId = nullptr; /*!< Replay request queue */
+
+uint64_t replay_queue_mem[(REPLAY_QUEUE_LENGTH * sizeof(ReplayRequest) + 7) /
+                          8]
+    __attribute__((aligned(64))); /*!< Memory buffer for request queue */
+uint64_t replay_queue_cb[32]
+    __attribute__((aligned(64))); /*!< Control block for request queue */
+uint64_t replay_stack[256]
+    __attribute__((aligned(64))); /*!< Static thread stack (aligned) */
+uint64_t replay_cb[32]
+    __attribute__((aligned(64))); /*!< Static thread control block (aligned) */
+uint64_t follow_stack[256]
+    __attribute__((aligned(64))); /*!< Static thread stack (aligned) */
+uint64_t follow_cb[32]
+    __attribute__((aligned(64))); /*!< Static thread control block (aligned) */
+constexpr uint32_t FOLLOW_WAKE_FLAG = 0x1U; /*!< Follow mode toggled */
+
+constexpr osMessageQueueAttr_t replayQueueAttr = {
+    .name = "LogReplayQueue",            /*!< Name for debugging */
+    .attr_bits = 0U,                     /*!< No special attributes */
+    .cb_mem = replay_queue_cb,           /*!< Control block memory */
+    .cb_size = sizeof(replay_queue_cb),  /*!< Control block size */
+    .mq_mem = replay_queue_mem,          /*!< Pointer to memory for queue */
+    .mq_size = sizeof(replay_queue_mem), /*!< Size of the memory buffer */
+};
+constexpr osThreadAttr_t replayThreadAttr = {
+    .name = "Log Replay",               /*!< Name for debugging */
+    .attr_bits = 0U,                    /*!< No special thread attributes */
+    .cb_mem = replay_cb,                /*!< Memory for thread control block */
+    .cb_size = sizeof(replay_cb),       /*!< Size of control block */
+    .stack_mem = replay_stack,          /*!< Pointer to static stack */
+    .stack_size = sizeof(replay_stack), /*!< Stack size in bytes */
+    .priority = osPriorityLow1          /*!< Below LED threads */
+};
+constexpr osThreadAttr_t followThreadAttr = {
+    .name = "Log Follow",               /*!< Name for debugging */
+    .attr_bits = 0U,                    /*!< No special thread attributes */
+    .cb_mem = follow_cb,                /*!< Memory for thread control block */
+    .cb_size = sizeof(follow_cb),       /*!< Size of control block */
+    .stack_mem = follow_stack,          /*!< Pointer to static stack */
+    .stack_size = sizeof(follow_stack), /*!< Stack size in bytes */
+    .priority = osPriorityLow1          /*!< Below LED threads */
+};
+} // namespace
+
+/**
+ * @brief   Constructor (private for singleton pattern).
+ */
+LogReplay::LogReplay() {}
+
+/**
+ * @brief   Get the singleton instance of LogReplay.
+ * @return  Reference to LogReplay instance.
+ */
+LogReplay &LogReplay::getInstance() {
+  static LogReplay instance;
+  return instance;
+}
+
+/**
+ * @brief   Initialize the replay worker.
+ * @details Creates the request queue and starts the worker and follow
+ *          threads.
+ */
+void LogReplay::init() {
+  replayQueueId = osMessageQueueNew(REPLAY_QUEUE_LENGTH, sizeof(ReplayRequest),
+                                    &replayQueueAttr);
+  if (replayQueueId == nullptr) {
+#if defined(DEBUG) && !defined(FS_LOG)
+    printf("Failed to create replay request queue: %s, %d\r\n", __FILE__,
+           __LINE__);
+#elif RUN_TIME
+    LogRouter::getInstance().log(
+        "Program Fault: Failed to create replay request queue\r\n");
+#endif
+    return;
+  }
+  threadId = osThreadNew(workerThreadWrapper, this, &replayThreadAttr);
+  if (threadId == nullptr) {
+#if defined(DEBUG) && !defined(FS_LOG)
+    printf("Failed to create replay worker thread: %s, %d\r\n", __FILE__,
+           __LINE__);
+#elif RUN_TIME
+    LogRouter::getInstance().log(
+        "Program Fault: Failed to create replay worker thread\r\n");
+#endif
+  }
+  followId = osThreadNew(followThreadWrapper, this, &followThreadAttr);
+  if (followId == nullptr) {
+#if defined(DEBUG) && !defined(FS_LOG)
+    printf("Failed to create log follow thread: %s, %d\r\n", __FILE__,
+           __LINE__);
+#elif RUN_TIME
+    LogRouter::getInstance().log(
+        "Program Fault: Failed to create log follow thread\r\n");
+#endif
+  }
+}
+
+/**
+ * @brief   Start or stop live follow of newly committed records.
+ * @param   enable true to start, false to stop.
+ */
+void LogReplay::follow(bool enable) {
+  FsLog::getInstance().follow(enable);
+  if (followId != nullptr) {
+    osThreadFlagsSet(followId, FOLLOW_WAKE_FLAG);
+  }
+}
+
+/**
+ * @brief   Post a replay request.
+ * @details Never blocks. Button requests are dropped while a replay is running
+ *          or when they arrive within the debounce window of the previous one.
+ * @param   src    Origin of the request.
+ * @param   filter Lines to keep (default: all).
+ * @return  Request status.
+ */
+LogReplay::ReplayStatus LogReplay::request(Source src,
+                                           const LogFilter &filter) {
+  if (replayQueueId == nullptr) {
+    return REPLAY_NOT_INITIALIZED;
+  }
+  if (src == Source::BUTTON) {
+    std::uint32_t now = osKernelGetTickCount();
+    if (isBusy() || (now - lastButtonTick.load()) < REPLAY_DEBOUNCE_MS) {
+      lastButtonTick.store(now);
+      return REPLAY_DEBOUNCED;
+    }
+    lastButtonTick.store(now);
+  }
+  ReplayRequest req = {.source = src, .filter = filter};
+  req.generation = generation.load();
+  if (osMessageQueuePut(replayQueueId, &req, 0U, 0U) != osOK) {
+    return REPLAY_QUEUE_FULL;
+  }
+  return REPLAY_OK;
+}
+
+/**
+ * @brief   Post a dump of the raw RAM drive image.
+ * @details Served by the replay worker like a replay, so `fsLog stop` and
+ *          `fsLog status` apply to it as well.
+ * @param   offset First image byte to send (resume point).
+ * @return  Request status.
+ */
+LogReplay::ReplayStatus LogReplay::requestDump(std::uint32_t offset) {
+  if (replayQueueId == nullptr) {
+    return REPLAY_NOT_INITIALIZED;
+  }
+  ReplayRequest req = {.source = Source::COMMAND,
+                       .filter = {},
+                       .kind = ReplayKind::DUMP,
+                       .offset = offset};
+  req.generation = generation.load();
+  if (osMessageQueuePut(replayQueueId, &req, 0U, 0U) != osOK) {
+    return REPLAY_QUEUE_FULL;
+  }
+  return REPLAY_OK;
+}
+
+/**
+ * @brief   Post a windowed replay acknowledged by the host.
+ * @param   resume   true to continue behind the last acknowledged chunk.
+ * @param   position Reader position to start at when not resuming (0 for
+ *                   the start of the file, or `next` of a received chunk).
+ * @return  Request status.
+ */
+LogReplay::ReplayStatus LogReplay::requestWindow(bool resume,
+                                                 std::uint32_t position) {
+  if (replayQueueId == nullptr) {
+    return REPLAY_NOT_INITIALIZED;
+  }
+  ReplayRequest req = {.source = Source::COMMAND,
+                       .filter = {},
+                       .kind = ReplayKind::WINDOW,
+                       .offset = position,
+                       .resume = resume};
+  req.generation = generation.load();
+  if (osMessageQueuePut(replayQueueId, &req, 0U, 0U) != osOK) {
+    return REPLAY_QUEUE_FULL;
+  }
+  return REPLAY_OK;
+}
+
+#ifdef FS_BENCH
+/**
+ * @brief   Post a format benchmark of the log drive.
+ * @details Runs on the replay worker so it never overlaps a replay or dump,
+ *          and `fsLog stop` cancels it.
+ * @return  Request status.
+ */
+LogReplay::ReplayStatus LogReplay::requestBench() {
+  if (replayQueueId == nullptr) {
+    return REPLAY_NOT_INITIALIZED;
+  }
+  ReplayRequest req = {.source = Source::COMMAND,
+                       .filter = {},
+                       .kind = ReplayKind::BENCH};
+  req.generation = generation.load();
+  if (osMessageQueuePut(replayQueueId, &req, 0U, 0U) != osOK) {
+    return REPLAY_QUEUE_FULL;
+  }
+  return REPLAY_OK;
+}
+#endif
+
+#ifdef RAW_LOG
+/**
+ * @brief   Post a replay of the raw log (RawLog) instead of the log file.
+ * @param   filter Lines to keep (default: all).
+ * @return  Request status.
+ */
+LogReplay::ReplayStatus LogReplay::requestRaw(const LogFilter &filter) {
+  if (replayQueueId == nullptr) {
+    return REPLAY_NOT_INITIALIZED;
+  }
+  ReplayRequest req = {.source = Source::COMMAND,
+                       .filter = filter,
+                       .kind = ReplayKind::RAW};
+  req.generation = generation.load();
+  if (osMessageQueuePut(replayQueueId, &req, 0U, 0U) != osOK) {
+    return REPLAY_QUEUE_FULL;
+  }
+  return REPLAY_OK;
+}
+#endif
+
+/**
+ * @brief   Acknowledge windowed replay chunks.
+ * @details Cumulative: seq is the first chunk the host has not received.
+ *          Called from the USB command thread; the worker polls the value.
+ * @param   seq Sequence number after the last chunk received in order.
+ */
+void LogReplay::ack(std::uint32_t seq) {
+  if (seq > control.acked.load()) {
+    control.acked.store(seq);
+  }
+}
+
+/**
+ * @brief   Cancel the running replay and drop all pending requests.
+ */
+void LogReplay::cancel() {
+  generation.fetch_add(1U); // Requests posted before now are stale
+  if (replayQueueId != nullptr) {
+    osMessageQueueReset(replayQueueId);
+  }
+  control.cancel.store(true);
+}
+
+/**
+ * @brief   Set the delay inserted between replay chunks.
+ * @param   ms Delay in milliseconds (clamped to 1000 ms).
+ */
+void LogReplay::setThrottle(std::uint32_t ms) {
+  control.throttleMs.store(ms > REPLAY_THROTTLE_MAX ? REPLAY_THROTTLE_MAX : ms);
+}
+
+/**
+ * @brief   Get the delay inserted between replay chunks.
+ * @return  Delay in milliseconds.
+ */
+std::uint32_t LogReplay::getThrottle() const {
+  return control.throttleMs.load();
+}
+
+/**
+ * @brief   Check whether a replay is currently streaming.
+ * @return  true while the worker is inside a replay.
+ */
+bool LogReplay::isBusy() const {
+  return busy.load();
+}
+
+/**
+ * @brief   Get progress of the current (or last) replay.
+ * @param   sent  Bytes transferred so far.
+ * @param   total Bytes requested by the replay.
+ */
+void LogReplay::getProgress(std::uint32_t &sent, std::uint32_t &total) const {
+  sent = control.sent.load();
+  total = control.total.load();
+}
+
+/**
+ * @brief   Static wrapper to call workerThread from C-style function pointer.
+ * @param   argument Pointer to LogReplay instance.
+ */
+void LogReplay::workerThreadWrapper(void *argument) {
+  static_cast<LogReplay *>(argument)->workerThread();
+}
+
+/**
+ * @brief   Static wrapper to call followThread from C-style function pointer.
+ * @param   argument Pointer to LogReplay instance.
+ */
+void LogReplay::followThreadWrapper(void *argument) {
+  static_cast<LogReplay *>(argument)->followThread();
+}
+
+/**
+ * @brief   Follow thread.
+ * @details Sleeps until follow mode is enabled, then forwards committed
+ *          records to USB as they arrive.
+ */
+void LogReplay::followThread() {
+  std::array<char, FsLog::FS_DATA_PACKET_SIZE> buf;
+  std::uint32_t reportedDrops = 0;
+  for (;;) {
+    FsLog &fs = FsLog::getInstance();
+    if (!fs.isFollowing()) {
+      reportedDrops = 0;
+      osThreadFlagsWait(FOLLOW_WAKE_FLAG, osFlagsWaitAny, osWaitForever);
+      continue;
+    }
+    std::uint32_t n = fs.followRead(buf.data(), buf.size(), 100U);
+    while (n > 0 && fs.isFollowing() &&
+           UsbLogger::getInstance().usbXferChunk(buf.data()) != 0) {
+      osDelay(10); /* Wait and retry if USB transfer fails */
+    }
+    if (fs.followDropped() != reportedDrops) {
+      reportedDrops = fs.followDropped();
+      std::snprintf(buf.data(), buf.size(),
+                    "Warning: Follow dropped %u records.\r\n",
+                    static_cast<unsigned>(reportedDrops));
+      UsbLogger::getInstance().usbXferChunk(buf.data());
+    }
+  }
+}
+
+/**
+ * @brief   Replay worker thread.
+ * @details Waits for requests, runs the replay and reports the outcome.
+ *          Unfiltered requests continue from where the previous plain replay
+ *          stopped; filtered requests read the whole file through a temporary
+ *          reader.
+ */
+void LogReplay::workerThread() {
+  ReplayRequest req;
+  std::array<char, 64> reply;
+  for (;;) {
+    if (osMessageQueueGet(replayQueueId, &req, nullptr, osWaitForever) !=
+        osOK) {
+      continue;
+    }
+    control.cancel.store(false);
+    if (req.generation != generation.load()) {
+      continue; /* Stopped after it was posted; the stop may predate the
+                   clear above, so the flag alone would miss it */
+    }
+    LogScanner scanner(req.filter);
+    control.scanner = req.filter.isActive() ? &scanner : nullptr;
+    busy.store(true);
+    FsLog::FsLogStatus status;
+    if (req.kind == ReplayKind::DUMP) {
+      status = FsLog::getInstance().dumpToUsb(req.offset, &control);
+#ifdef FS_BENCH
+    } else if (req.kind == ReplayKind::BENCH) {
+      status = FsBench::run(&control);
+#endif
+#ifdef RAW_LOG
+    } else if (req.kind == ReplayKind::RAW) {
+      status = RawLog::getInstance().replayLogsToUsb(&control);
+#endif
+    } else if (req.kind == ReplayKind::WINDOW) {
+      if (windowReader == nullptr) {
+        windowReader = FsLog::getInstance().openReader(0U); /* Kept open */
+      }
+      if (windowReader != nullptr && !req.resume) {
+        FsLog::getInstance().seekReader(windowReader, req.offset);
+      }
+      status = FsLog::getInstance().replayWindowToUsb(windowReader, &control);
+    } else if (control.scanner != nullptr) {
+      FsReader *reader = FsLog::getInstance().openReader(0U);
+      status = FsLog::getInstance().replayLogsToUsb(reader, &control);
+      FsLog::getInstance().closeReader(reader);
+    } else {
+      status = FsLog::getInstance().replayLogsToUsb(&control);
+    }
+    busy.store(false);
+    control.scanner = nullptr;
+
+    switch (status) {
+    case FsLog::FS_TO_USB_OK:
+    case FsLog::FS_TO_USB_PAUSED:
+      if (req.kind != ReplayKind::LINES && req.kind != ReplayKind::RAW) {
+        continue; /* The dump/window/bench trailer is the reply */
+      }
+      std::snprintf(reply.data(), reply.size(),
+                    "Reply: Replay done, %u of %u bytes matched.\r\n",
+                    static_cast<unsigned>(control.matched.load()),
+                    static_cast<unsigned>(control.sent.load()));
+      break;
+    case FsLog::FS_TO_USB_CANCELLED:
+      std::snprintf(reply.data(), reply.size(),
+                    "Reply: Replay stopped at %u/%u bytes.\r\n",
+                    static_cast<unsigned>(control.sent.load()),
+                    static_cast<unsigned>(control.total.load()));
+      break;
+    default:
+      std::snprintf(reply.data(), reply.size(),
+                    "Reply: Replay failed (%d).\r\n", static_cast<int>(status));
+      break;
+    }
+    UsbLogger::getInstance().usbXferChunk(reply.data());
+  }
+}
+
+/** @} */ // end of Logger
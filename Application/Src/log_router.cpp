@@ -25,9 +25,20 @@
  correct destination.
 
  # ⚙️ Features
-  - Route log messages to USB CDC or file system.
+  - Route log messages to USB CDC, file system or the raw RAM log (RawLog).
+  - Flight recorder mode: records are kept in a RAM ring and only flushed to
+    the sinks on a trigger (Error or worse, supervisor alarm, command,
+    button double press).
   - Enable/disable logging for each mechanism.
   - Unified logging interface.
+  - Every record starts with a "[HH:MM:SS.mmm]" boot clock timestamp,
+    rendered without printf into the record buffer. With the cycle counter
+    as stamp source it is "[HH:MM:SS.fffffff]" (100 ns digits), so records
+    within one millisecond keep their order and short intervals can be
+    read off the log.
+  - The first record of each calendar day (and the first after boot or a
+    clock step to another day) is preceded by "Event: Date YYYY-MM-DD", so
+    time-of-day stamps stay ordered across midnight and across months.
   - Thread-safe logging using RTOS primitives.
   - Integration with existing logging classes (UsbLogger and FsLog).
   - Support for formatted log messages with variable arguments.
@@ -47,20 +58,130 @@
  method to support different types of log messages, including formatted strings
  with variable arguments.
 
+ In flight recorder mode `log` only copies the record into a 2 KB ring
+ (oldest whole records dropped, window 256-2048 bytes). A trigger only sets
+ a bit and wakes the "Flight Recorder" thread, so an Error record never
+ drains the ring on the stack of the thread that logged it. That thread
+ writes a stamped "Event: Flight recorder triggered" record, drains the ring
+ record by record and lets the next N records through before recording
+ resumes.
+
  The Log Router integrates with the `UsbLogger` and `FsLog` classes,
  which handle the actual logging to USB and file system, respectively.
  */
 
 #include "log_router.h"
 #include "boot_clock.h"
+#include "calendar.h"
 #include "fs_log.h"
+#ifdef FLASH_LOG
+#include "flash_log.h"
+#endif
+#ifdef RAW_LOG
+#include "raw_log.h"
+#endif
+#include "log_replay.h"
 #include "logger.h"
 #include "usb_logger.h"
+#include <algorithm>
 #include <array>
 #include <cstdio>
 #include <cstring>
 #include <string_view>
 
+/**
+ * @brief   Anonymous namespace for internal linkage.
+ * @details Contains the flight recorder ring.
+ */
+namespace {
+constexpr uint32_t FLIGHT_RING_SIZE = 2048U; /*!< Ring size (power of 2) */
+constexpr uint32_t FLIGHT_PRE_MIN = 256U;    /*!< Smallest pre window */
+constexpr uint32_t FLIGHT_POST_MAX = 100U;   /*!< Largest post window */
+std::array<char, FLIGHT_RING_SIZE> flight_ring; /*!< Recent records */
+uint32_t flight_head = 0U; /*!< Write index (under flightMutexId) */
+uint32_t flight_tail = 0U; /*!< Read index (under flightMutexId) */
+uint32_t flight_pre = 1024U; /*!< Pre-trigger window in bytes */
+osMutexId_t flightMutexId = nullptr; /*!< Guards the ring */
+constexpr uint32_t FLIGHT_TRIGGER_FLAG = 0x1U; /*!< A trigger was posted */
+
+uint64_t flight_stack[256]
+    __attribute__((aligned(64))); /*!< Static thread stack (aligned) */
+uint64_t flight_cb[32]
+    __attribute__((aligned(64))); /*!< Static thread control block (aligned) */
+
+/**
+ * @brief   Thread attributes for the flight recorder drain.
+ */
+constexpr osThreadAttr_t flightThreadAttr = {
+    .name = "Flight Recorder",          /*!< Name for debugging */
+    .attr_bits = 0U,                    /*!< No special thread attributes */
+    .cb_mem = flight_cb,                /*!< Memory for thread control block */
+    .cb_size = sizeof(flight_cb),       /*!< Size of control block */
+    .stack_mem = flight_stack,          /*!< Pointer to static stack */
+    .stack_size = sizeof(flight_stack), /*!< Stack size in bytes */
+    .priority = osPriorityLow1          /*!< Below LED threads */
+};
+
+/**
+ * @brief   Mutex attributes for the flight recorder ring.
+ */
+constexpr osMutexAttr_t flightMutexAttr = {
+    .name = "FlightMutex",          /*!< Name for debugging */
+    .attr_bits = osMutexPrioInherit /*!< Priority inheritance */
+};
+
+/**
+ * @brief   Create the ring mutex on first use.
+ * @return  True if the mutex exists.
+ */
+bool flight_mutex() {
+  if (flightMutexId == nullptr) {
+    flightMutexId = osMutexNew(&flightMutexAttr);
+  }
+  return flightMutexId != nullptr;
+}
+
+/**
+ * @brief   Append a record, dropping the oldest whole records if needed.
+ * @details Called with flightMutexId held.
+ * @param   msg Record (truncated to the window size).
+ */
+void flight_push(std::string_view msg) {
+  const uint32_t len = (msg.size() < flight_pre)
+                           ? static_cast<uint32_t>(msg.size())
+                           : flight_pre;
+  while (flight_pre - (flight_head - flight_tail) < len) {
+    /* Drop the oldest record */
+    while (flight_tail != flight_head &&
+           flight_ring[flight_tail++ & (FLIGHT_RING_SIZE - 1)] != '\n') {
+    }
+  }
+  for (uint32_t i = 0; i < len; i++) {
+    flight_ring[flight_head++ & (FLIGHT_RING_SIZE - 1)] = msg[i];
+  }
+}
+
+/**
+ * @brief   Take the oldest record out of the ring.
+ * @details Called with flightMutexId held.
+ * @param   buf  Destination (null-terminated).
+ * @param   size Size of buf.
+ * @return  Bytes copied, 0 if the ring is empty.
+ */
+uint32_t flight_pop(char *buf, uint32_t size) {
+  uint32_t n = 0U;
+  while (flight_tail != flight_head && n + 1U < size) {
+    char c = flight_ring[flight_tail++ & (FLIGHT_RING_SIZE - 1)];
+    buf[n++] = c;
+    if (c == '\n') {
+      break;
+    }
+  }
+  buf[n] = '\0';
+  return n;
+}
+} // namespace
+
 /** @brief Get the singleton instance of LogRouter
  * This method returns a reference to the single instance of the LogRouter
  * class, creating it if it does not already exist.
@@ -85,6 +206,24 @@ void LogRouter::enableUsbLogging(bool enable) { usbLoggingEnabled = enable; }
  */
 void LogRouter::enableFsLogging(bool enable) { fsLoggingEnabled = enable; }
 
+/** @brief Enable or disable raw partition logging.
+ * The file system sink wins while both are enabled.
+ * @param enable True to log to RawLog, false to stop.
+ */
+void LogRouter::enableRawLogging(bool enable) { rawLoggingEnabled = enable; }
+
+/** @brief Select the timestamp source of new records.
+ * @param source Stamp::TICK or Stamp::CYCLES.
+ * @return False if CYCLES was asked for and no cycle counter is attached.
+ */
+bool LogRouter::setStamp(Stamp source) {
+  if (source == Stamp::CYCLES && !BootClock::getInstance().hasCycleCounter()) {
+    return false;
+  }
+  stampSource = source;
+  return true;
+}
+
 /** @brief Log a simple message.
  * Routes the message to the appropriate logging mechanism based on
  * the enabled flags.
@@ -98,34 +237,91 @@ void LogRouter::log(std::string_view msg) {
 #endif
     msg = "Warning: Log message is empty.\r\n"; // Default message
   }
-  const char *keywords[] = {"Warning",        "Error",         "Fail",
-                            "Critical",       "Overflow",      "Event",
-                            "Hardware Fault", "Program Fault", "System Fault",
-                            "Supervisor"};
+  std::array<char, 256> logBuffer;
+  std::array<char, 64> dateRecord;
+  if (stamp(msg, logBuffer, dateRecord)) {
+    dispatch(dateRecord.data());
+  }
+  dispatch(logBuffer.data());
+}
 
-  bool needTimeStamp = false;
-  for (const auto &keyword : keywords) {
-    if (msg.find(keyword) != std::string_view::npos) {
-      needTimeStamp = true;
-      break;
-    }
+/** @brief Stamp a message into a record.
+ * Every record is stamped: "[HH:MM:SS.mmm] <msg>" (or .fffffff).
+ * @param msg Message text, cut to fit the record.
+ * @param logBuffer Receives the null-terminated record.
+ * @param dateRecord Receives the "Event: Date" record, with the same stamp,
+ *        when this is the first record of a new date.
+ * @return True if dateRecord was filled; it goes before the record.
+ */
+bool LogRouter::stamp(std::string_view msg, std::array<char, 256> &logBuffer,
+                      std::array<char, 64> &dateRecord) {
+  logBuffer[0] = '[';
+  std::uint32_t day = 0U;
+  BootClock &clock = BootClock::getInstance();
+  std::size_t n = 1U + ((stampSource.load() == Stamp::CYCLES)
+                            ? clock.formatTimeFine(&logBuffer[1], &day)
+                            : clock.formatTime(&logBuffer[1], &day));
+  logBuffer[n++] = ']';
+  logBuffer[n++] = ' ';
+  const bool newDay = stampDay.exchange(day) != day;
+  if (newDay) {
+    // First record of a new date: tell the reader which day the stamps are on
+    std::memcpy(dateRecord.data(), logBuffer.data(), n);
+    static constexpr std::string_view EVENT = "Event: Date ";
+    std::memcpy(&dateRecord[n], EVENT.data(), EVENT.size());
+    std::size_t m = n + EVENT.size();
+    m += Calendar::formatDate(day, &dateRecord[m]);
+    const std::string_view tail = clock.isSet()
+                                      ? std::string_view("\r\n")
+                                      : std::string_view(" (not set)\r\n");
+    std::memcpy(&dateRecord[m], tail.data(), tail.size());
+    dateRecord[m + tail.size()] = '\0';
   }
+  const std::size_t len = std::min(msg.size(), logBuffer.size() - 1U - n);
+  std::memcpy(&logBuffer[n], msg.data(), len);
+  logBuffer[n + len] = '\0';
+  return newDay;
+}
 
-  std::array<char, 256> logBuffer;
-  if (needTimeStamp) {
-    std::string_view timeStamp =
-        BootClock::getInstance().getCurrentTimeString();
-    snprintf(logBuffer.data(), logBuffer.size(), "[%s] %s", timeStamp.data(),
-             msg.data());
-  } else {
-    snprintf(logBuffer.data(), logBuffer.size(), "%s", msg.data());
+/** @brief Store a stamped record.
+ * Keeps the persistent copy, then either holds the record in the flight
+ * recorder ring or routes it to the enabled sink.
+ * @param record Null-terminated record.
+ */
+void LogRouter::dispatch(const char *record) {
+#ifdef FLASH_LOG
+  FlashLog::getInstance().log(record); // Persistent copy
+#endif
+
+  if (flightEnabled.load()) {
+    if (postRemaining.load() > 0U) {
+      postRemaining.fetch_sub(1U); // Post-trigger window: pass through
+    } else {
+      osMutexAcquire(flightMutexId, osWaitForever);
+      flight_push(record); // Steady state: memcpy into the ring
+      osMutexRelease(flightMutexId);
+      if (LogScanner::levelOf(record) >= LogLevel::ERROR) {
+        trigger(Trigger::ERROR_RECORD);
+      }
+      return;
+    }
   }
+  route(record);
+}
 
+/** @brief Send a finished record to the enabled sink.
+ * @param msg Null-terminated record.
+ */
+void LogRouter::route(std::string_view msg) {
   Logger *logger = nullptr; // Pointer to the selected logger
   // Determine which logger to use based on enabled flags
   if (fsLoggingEnabled) {
 #if defined(FS_LOG) && !defined(DEBUG)
     logger = static_cast<Logger *>(&FsLog::getInstance());
+#endif
+  } else if (rawLoggingEnabled) {
+#ifdef RAW_LOG
+    logger = static_cast<Logger *>(&RawLog::getInstance());
 #endif
   } else if (usbLoggingEnabled) {
     logger = static_cast<Logger *>(&UsbLogger::getInstance());
@@ -133,7 +329,7 @@ void LogRouter::log(std::string_view msg) {
     return; // No logging enabled
   }
   if (logger != nullptr) {
-    logger->log(logBuffer.data()); // Route log message
+    logger->log(msg); // Route log message
   }
 }
 
@@ -182,8 +378,162 @@ void LogRouter::log(std::string_view msg, std::string_view str,
   log(logBuffer.data());
 }
 
+/** @brief Log a record to every persistent backend.
+ * Used for boot-time records (e.g. the crash dump of the previous run) that
+ * must be stored even before logging is enabled by a command. Falls back to
+ * the USB queue if no persistent backend is built in.
+ * @param msg The message string to log (buffer of at least 64 bytes).
+ */
+void LogRouter::logPersistent(std::string_view msg) {
+  bool stored = false;
+#if defined(FS_LOG) && !defined(DEBUG)
+  FsLog::getInstance().log(msg);
+  stored = true;
+#endif
+#ifdef FLASH_LOG
+  FlashLog::getInstance().log(msg);
+  stored = true;
+#endif
+  if (!stored) {
+    UsbLogger::getInstance().log(msg);
+  }
+}
+
+/** @brief Enable or disable flight recorder mode.
+ * While enabled, records only go into a RAM ring; a trigger sends the ring
+ * (pre-trigger window) and the following records (post-trigger window) to
+ * the sinks.
+ * @param enable True to record into the ring, false to route directly.
+ */
+void LogRouter::enableFlightRecorder(bool enable) {
+  if (!flight_mutex()) {
+    return; // Flight recorder unavailable
+  }
+  if (enable && flightThreadId == nullptr) {
+    flightThreadId = osThreadNew(flightThreadWrapper, this, &flightThreadAttr);
+    if (flightThreadId == nullptr) {
+#if defined(DEBUG) && !defined(FS_LOG)
+      printf("Failed to create flight recorder thread: %s, %d\r\n", __FILE__,
+             __LINE__);
+#elif RUN_TIME
+      log("Program Fault: Failed to create flight recorder thread\r\n");
+#endif
+    }
+  }
+  osMutexAcquire(flightMutexId, osWaitForever);
+  flight_tail = flight_head; // Start with an empty ring
+  postRemaining = 0U;
+  flightEnabled = enable;
+  osMutexRelease(flightMutexId);
+}
+
+/** @brief Check whether flight recorder mode is on.
+ * @return True if records are held in the ring.
+ */
+bool LogRouter::isFlightRecorderEnabled() const { return flightEnabled.load(); }
+
+/** @brief Configure the flight recorder windows.
+ * @param preBytes Bytes of history kept before a trigger (256-2048).
+ * @param postRecords Records passed through after a trigger (0-100).
+ * @return False if a value is out of range.
+ */
+bool LogRouter::setFlightWindow(uint32_t preBytes, uint32_t postRecords) {
+  if (preBytes < FLIGHT_PRE_MIN || preBytes > FLIGHT_RING_SIZE ||
+      postRecords > FLIGHT_POST_MAX || !flight_mutex()) {
+    return false;
+  }
+  osMutexAcquire(flightMutexId, osWaitForever);
+  flight_pre = preBytes;
+  flight_tail = flight_head; // Window changed: start over
+  flightPostRecords = postRecords;
+  osMutexRelease(flightMutexId);
+  return true;
+}
+
+/** @brief Request a flush of the flight recorder ring.
+ * Posts the trigger to the flight recorder thread and returns at once, so
+ * it is safe from any thread, including one that just logged an Error.
+ * Without that thread the ring is drained on the caller's stack.
+ * @param source What caused the trigger.
+ */
+void LogRouter::trigger(Trigger source) {
+  if (!flightEnabled.load()) {
+    return;
+  }
+  if (flightThreadId == nullptr) {
+    drain(source);
+    return;
+  }
+  pendingTriggers.fetch_or(1U << static_cast<uint8_t>(source));
+  osThreadFlagsSet(flightThreadId, FLIGHT_TRIGGER_FLAG);
+}
+
+/** @brief Static wrapper to call flightThread from C-style function pointer.
+ * @param argument Pointer to the LogRouter instance.
+ */
+void LogRouter::flightThreadWrapper(void *argument) {
+  static_cast<LogRouter *>(argument)->flightThread();
+}
+
+/** @brief Flight recorder thread.
+ * Drains the ring once for every trigger source posted since it last ran.
+ */
+void LogRouter::flightThread() {
+  for (;;) {
+    osThreadFlagsWait(FLIGHT_TRIGGER_FLAG, osFlagsWaitAny, osWaitForever);
+    uint32_t pending = pendingTriggers.exchange(0U);
+    for (uint8_t i = 0U; pending != 0U; i++, pending >>= 1U) {
+      if ((pending & 1U) != 0U && flightEnabled.load()) {
+        drain(static_cast<Trigger>(i));
+      }
+    }
+  }
+}
+
+/** @brief Flush the flight recorder ring.
+ * Sends the recorded history to the enabled sink (or the persistent
+ * backends if none is enabled) and opens the post-trigger window.
+ * @param source What caused the trigger.
+ */
+void LogRouter::drain(Trigger source) {
+  static constexpr std::array<const char *, 4> names = {
+      "error", "supervisor", "command", "button"};
+  const bool sink = fsLoggingEnabled || rawLoggingEnabled || usbLoggingEnabled;
+  auto out = [&](std::string_view msg) {
+    if (sink) {
+      route(msg);
+    } else {
+      logPersistent(msg);
+    }
+  };
+  std::array<char, 64> event;
+  std::array<char, 64> dateRecord;
+  std::array<char, 256> line;
+  snprintf(event.data(), event.size(),
+           "Event: Flight recorder triggered by %s\r\n",
+           names[static_cast<uint8_t>(source)]);
+  if (stamp(event.data(), line, dateRecord)) {
+    out(dateRecord.data());
+  }
+  out(line.data());
+  for (;;) {
+    osMutexAcquire(flightMutexId, osWaitForever);
+    uint32_t n = flight_pop(line.data(), line.size());
+    osMutexRelease(flightMutexId);
+    if (n == 0U) {
+      break;
+    }
+    out(line.data()); // One record at a time; logging goes on meanwhile
+  }
+  postRemaining = flightPostRecords;
+}
+
 /** @brief Replay filesystem logs to USB.
+ * Posts a request to the replay worker and returns immediately.
+ * @param filter Lines to keep (default: all).
  */
-void LogRouter::replayFsLogsToUsb() { FsLog::getInstance().replayLogsToUsb(); }
+void LogRouter::replayFsLogsToUsb(const LogFilter &filter) {
+  LogReplay::getInstance().request(LogReplay::Source::COMMAND, filter);
+}
 
 /** @} */ // end of Logger
\ No newline at end of file
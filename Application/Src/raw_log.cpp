@@ -0,0 +1,250 @@
+/**
+ * @file    raw_log.cpp
+ * @brief   Log backend on a raw RAM partition, without a file system.
+ * @author  Mitul Goti
+ * @version 1.0
+ * @date    2025-10-03
+ * @ingroup Logger
+ * @{
+ * @details
+ * This module keeps routed log messages in a RawStore ring in no-init CCM
+ * RAM. Each message is one CRC-checked record; there is no directory, FAT
+ * or cluster chain to update.
+ */
+
+/* Raw Logger
+ ---
+ # 📝 Overview
+ FsLog pays for a FAT volume on every record: fopen, directory entry and
+ FAT updates, cluster allocation. When the log is only appended and
+ replayed, RawLog does the same job with a record header and a copy into a
+ 16 KB page ring. `rawLog on` routes the log stream to it, `rawLog out`
+ replays it over USB through the replay worker.
+
+ # ⚙️ Features
+ - log() appends one record under a mutex: at most one 512-byte page erase
+   (memset), a 12-byte page header, the record header and the payload.
+ - The slowest append is measured and shown by `rawLog status`.
+ - Oldest pages are overwritten when the ring is full.
+ - The ring lives in ".bss.noinit.raw" (CCM), so a warm reset remounts it
+   and the log from before the reset is kept; a cold boot formats it.
+ - Replay with the FsLog contract: FsReplayControl for progress, cancel,
+   throttle and the line filter; same status codes.
+
+ # 📋 Usage
+ Call `RawLog::getInstance().init()` once at start-up (RAW_LOG builds).
+ `rawLog on` selects it as the log sink, `rawLog out [filter]` replays it.
+
+ # 🔧 Implementation Details
+ The ring is a RamFlashPort of 32 pages of 512 bytes. Messages longer than
+ a page can take are truncated. The replay reads one record at a time under
+ the mutex and packs whole records into 256-byte USB chunks, so logging is
+ never blocked for more than one record copy. If the writer laps the
+ replay, the replay continues at the oldest page.
+ */
+
+#include "raw_log.h"
+#include "cmsis_os2.h"
+#include "raw_store.h"
+#include "usb_logger.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+/**
+ * @brief   Anonymous namespace for internal linkage.
+ * @details Contains the RAM region, the store and the replay buffers.
+ */
+namespace {
+uint32_t raw_region[RawLog::RAW_PAGES * RawLog::RAW_PAGE_SIZE / 4U]
+    __attribute__((section(".bss.noinit.raw"))); /*!< Not zeroed at reset */
+RamFlashPort raw_port(raw_region, RawLog::RAW_PAGES,
+                      RawLog::RAW_PAGE_SIZE); /*!< Region as pages */
+RawStore raw_store(raw_port);                 /*!< Record ring */
+std::array<char, RawLog::RAW_PAGE_SIZE> record_buf; /*!< One record */
+std::array<char, FsLog::FS_DATA_PACKET_SIZE + 1U>
+    chunk_buf; /*!< Records packed for one USB transfer */
+
+constexpr osMutexAttr_t rawMutexAttr = {
+    .name = "RawLogMutex",          /*!< Name for debugging */
+    .attr_bits = osMutexPrioInherit /*!< Priority inheritance */
+};
+} // namespace
+
+/**
+ * @brief   Constructor (private for singleton pattern).
+ */
+RawLog::RawLog() {}
+
+/**
+ * @brief   Get the singleton instance of RawLog.
+ * @return  Reference to RawLog instance.
+ */
+RawLog &RawLog::getInstance() {
+  static RawLog instance;
+  return instance;
+}
+
+/**
+ * @brief   Mount the ring (format it after a cold boot) and create the
+ *          mutex.
+ * @return  RAW_LOG_OK or an error code.
+ */
+RawLog::RawLogStatus RawLog::init() {
+  RawStore::RawStatus status = raw_store.mount();
+  if (status < RawStore::RAW_OK) {
+    UsbLogger::getInstance().log("Error: Raw log mount failed.\r\n");
+    return RAW_LOG_MOUNT_ERROR;
+  }
+  mutexId = osMutexNew(&rawMutexAttr);
+  if (mutexId == nullptr) {
+    UsbLogger::getInstance().log(
+        "Error: Raw log mutex can not be created.\r\n");
+    return RAW_LOG_RTOS_ERROR;
+  }
+  return RAW_LOG_OK;
+}
+
+/**
+ * @brief   Append a message as one record.
+ * @param   msg Message (truncated to the largest record).
+ */
+void RawLog::log(std::string_view msg) {
+  if (mutexId == nullptr || msg.empty()) {
+    return;
+  }
+  const std::uint32_t len = std::min<std::uint32_t>(
+      static_cast<std::uint32_t>(msg.size()), raw_store.maxRecord());
+  osMutexAcquire(mutexId, osWaitForever);
+  const std::uint32_t t0 = osKernelGetSysTimerCount();
+  raw_store.append(msg.data(), len);
+  const std::uint32_t dt = osKernelGetSysTimerCount() - t0;
+  worstTicks = std::max(worstTicks, dt);
+  osMutexRelease(mutexId);
+}
+
+/**
+ * @brief   Replay all records to USB.
+ * @details
+ *  - Reads records from the oldest one until it catches up with the writer.
+ *  - Packs whole records into USB chunks; the optional filter drops lines
+ *    before they use USB bandwidth.
+ *  - Stops between chunks if cancellation is requested and applies the
+ *    configured throttle delay.
+ * @param   ctrl Optional progress/cancel block (may be nullptr).
+ * @return  FS_TO_USB_OK, FS_TO_USB_CANCELLED or FS_TO_USB_INIT_ERROR.
+ */
+FsLog::FsLogStatus RawLog::replayLogsToUsb(FsReplayControl *ctrl) {
+  if (mutexId == nullptr) {
+    return FsLog::FS_TO_USB_INIT_ERROR;
+  }
+  auto cancelled = [ctrl]() {
+    return (ctrl != nullptr) && ctrl->cancel.load();
+  };
+  const LogScanner *scanner = (ctrl != nullptr) ? ctrl->scanner : nullptr;
+
+  osMutexAcquire(mutexId, osWaitForever);
+  RawStore::Cursor cursor = raw_store.oldest();
+  const std::uint32_t used = raw_store.usedBytes();
+  osMutexRelease(mutexId);
+  if (ctrl != nullptr) {
+    ctrl->sent.store(0U);
+    ctrl->matched.store(0U);
+    ctrl->total.store(used);
+  }
+  if (used == 0U) {
+    UsbLogger::getInstance().usbXferChunk(
+        "Info: No logs in the raw log to replay.\r\n");
+    return FsLog::FS_TO_USB_OK;
+  }
+  UsbLogger::getInstance().usbXferChunk(
+      "Reply: Replaying logs from raw log to USB...\r\n");
+  osDelay(10); /* Small delay to ensure USB is ready */
+
+  /* Send the packed records; false if cancelled while USB was busy */
+  auto flush = [&](std::uint32_t n, std::uint32_t done) {
+    std::uint32_t len = (scanner != nullptr)
+                            ? static_cast<std::uint32_t>(
+                                  scanner->compact(chunk_buf.data(), n))
+                            : n;
+    while (len > 0U && UsbLogger::getInstance().usbXferChunk(std::string_view(
+                           chunk_buf.data(), len)) == USB_XFER_ERROR) {
+      if (cancelled()) {
+        return false;
+      }
+      osDelay(10); /* Wait and retry if USB transfer fails */
+    }
+    if (ctrl != nullptr) {
+      ctrl->sent.fetch_add(done);
+      ctrl->matched.fetch_add(len);
+      if (len > 0U && ctrl->throttleMs.load() > 0U) {
+        osDelay(ctrl->throttleMs.load()); /* Yield USB bandwidth */
+      }
+    }
+    return true;
+  };
+
+  std::uint32_t packed = 0U;  /* Bytes in chunk_buf */
+  std::uint32_t done = 0U;    /* Ring bytes behind them */
+  std::uint32_t damaged = 0U; /* Records failing their CRC */
+  for (;;) {
+    if (cancelled()) {
+      return FsLog::FS_TO_USB_CANCELLED;
+    }
+    osMutexAcquire(mutexId, osWaitForever);
+    std::int32_t m =
+        raw_store.read(cursor, record_buf.data(), record_buf.size());
+    osMutexRelease(mutexId);
+    if (m == RawStore::READ_CRC_ERROR) {
+      damaged++;
+      continue;
+    }
+    const std::uint32_t len = std::min<std::uint32_t>(
+        static_cast<std::uint32_t>(m), FsLog::FS_DATA_PACKET_SIZE);
+    if (packed > 0U && (m == RawStore::READ_END ||
+                        packed + len > FsLog::FS_DATA_PACKET_SIZE)) {
+      if (!flush(packed, done)) {
+        return FsLog::FS_TO_USB_CANCELLED;
+      }
+      packed = 0U;
+      done = 0U;
+    }
+    if (m == RawStore::READ_END) {
+      break;
+    }
+    std::memcpy(chunk_buf.data() + packed, record_buf.data(), len);
+    packed += len;
+    done += RawStore::RECORD_HEADER_SIZE + ((m + 3U) & ~3U);
+  }
+  if (damaged > 0U) {
+    std::array<char, 64> msg;
+    std::snprintf(msg.data(), msg.size(),
+                  "Error: %u damaged raw log records skipped.\r\n",
+                  static_cast<unsigned>(damaged));
+    UsbLogger::getInstance().log(msg.data());
+  }
+  return FsLog::FS_TO_USB_OK;
+}
+
+/**
+ * @brief   Fill a status snapshot.
+ * @param   stats Destination.
+ */
+void RawLog::getStats(Stats &stats) {
+  if (mutexId == nullptr) {
+    stats = Stats{};
+    return;
+  }
+  osMutexAcquire(mutexId, osWaitForever);
+  stats.used = raw_store.usedBytes();
+  stats.capacity = raw_store.capacity();
+  stats.pages = raw_store.headSeq();
+  const std::uint64_t ticks = worstTicks;
+  osMutexRelease(mutexId);
+  stats.worstUs =
+      static_cast<std::uint32_t>(ticks * 1000000U / osKernelGetSysTimerFreq());
+}
+
+/** @} */ // end of Logger
@@ -0,0 +1,420 @@
+/**
+ * @file    raw_store.cpp
+ * @brief   Circular append-only record log on a raw partition (no FAT).
+ * @author  Mitul Goti
+ * @version 1.0
+ * @date    2025-10-03
+ * @ingroup Logger
+ * @{
+ * @details
+ * Implements RawStore: CRC-checked records in a strict page ring, a mount
+ * that binary-searches the page headers for the head, and RamFlashPort for
+ * RAM regions. Used by RawLog on the target; builds on a host as well.
+ */
+
+/* Raw Store
+ ---
+ # 📝 Overview
+ For append-and-replay logging a FAT volume is pure overhead: every record
+ updates the directory entry and the FAT besides the data. RawStore writes
+ the records straight into a partition: one header per page and one per
+ record, nothing else.
+
+ # ⚙️ Features
+ - Append is a record header write plus a copy of the payload. Crossing
+   into the next page adds one page erase and a 12-byte page header. On a
+   RAM region that bounds every append to about one page of memory traffic.
+ - CRC-32 per record; a torn record fails its CRC and is skipped on read.
+ - Strict circular order: page (head + 1) is always the next one, the
+   oldest page is overwritten.
+ - Mount reads O(log pages) page headers to find the head, then walks the
+   record headers of the head page only.
+
+ # 📋 Usage
+ ```
+ RamFlashPort port(region, 32U, 512U);
+ RawStore store(port);
+ store.mount();
+ store.append(msg, len);
+ RawStore::Cursor c = store.oldest();
+ while ((n = store.read(c, buf, sizeof(buf))) != RawStore::READ_END) { ... }
+ ```
+
+ # 🔧 Implementation Details
+ Page header words: magic, sequence number, ~(magic ^ sequence). Pages are
+ opened in index order with the next sequence number, so along the page
+ index the headers read s0, s0 + 1, ... up to the head and older (or
+ invalid) headers after it. "Page i holds s0 + i" is true for a prefix of
+ the pages, which is what the binary search looks for. The prefix starts at
+ the first page with a valid header, normally page 0: if power fails while
+ the ring wraps, page 0 is erased but has no header yet, and the run of
+ the previous lap on pages 1.. still leads to the head. The oldest live page
+ is the first page after the head whose sequence number continues the ring
+ backwards; normally the page right behind the head.
+
+ Records: {uint16 length, uint16 marker, uint32 crc} + payload padded to a
+ word, as in FlashStore. A damaged record header seals the rest of its
+ page.
+
+ format() erases every page once, so a later mount can never mistake
+ pages of an earlier ring for live ones.
+
+ # ⚠️ Limitations
+ - Not thread safe; the owner serializes calls.
+ - No wear leveling: on NOR flash every sector is erased once per lap.
+ */
+
+#include "raw_store.h"
+#include "flash_store.h"
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @brief   Anonymous namespace for internal linkage.
+ * @details Contains the on-partition layout constants.
+ */
+namespace {
+constexpr std::uint32_t PAGE_MAGIC = 0x47504C52U;  /*!< "RLPG" */
+constexpr std::uint16_t RECORD_MARKER = 0xA55AU;   /*!< Valid record header */
+constexpr std::uint32_t ERASED_WORD = 0xFFFFFFFFU; /*!< Erased word */
+
+/** @brief Record header */
+struct RecordHeader {
+  std::uint16_t length; /*!< Payload length in bytes */
+  std::uint16_t marker; /*!< RECORD_MARKER */
+  std::uint32_t crc;    /*!< CRC-32 of the payload */
+};
+static_assert(sizeof(RecordHeader) == RawStore::RECORD_HEADER_SIZE,
+              "Record header layout");
+
+/**
+ * @brief   Space taken by a record.
+ * @param   len Payload length.
+ * @return  Header plus word-padded payload.
+ */
+constexpr std::uint32_t recordSize(std::uint32_t len) {
+  return RawStore::RECORD_HEADER_SIZE + ((len + 3U) & ~3U);
+}
+} // namespace
+
+/**
+ * @brief   Bind the store to a partition.
+ * @param   port Partition (must outlive the store).
+ */
+RawStore::RawStore(FlashPort &port) : port(port) {}
+
+/**
+ * @brief   Mount the store.
+ * @details Binary search for the last page of the run s0, s0 + 1, ... that
+ *          starts at the first page with a valid header (page 0 unless a
+ *          wrap was torn), then a walk of the head page's record headers.
+ *          Starts a new ring only if no page has a valid header.
+ * @return  RAW_OK, RAW_FORMATTED for a new ring, or an error.
+ */
+RawStore::RawStatus RawStore::mount() {
+  mounted = false;
+  pages = port.sectorCount();
+  const std::uint32_t size = port.sectorSize();
+  if (pages < 2U || (size & 3U) != 0U ||
+      size <= PAGE_HEADER_SIZE + RECORD_HEADER_SIZE) {
+    return RAW_GEOMETRY_ERROR;
+  }
+
+  std::uint32_t p0 = 0U;
+  std::uint32_t s0 = 0U;
+  while (!pageSeq(p0, s0)) {
+    if (++p0 == pages) {
+      return format(); /* Blank or foreign partition */
+    }
+  }
+  std::uint32_t lo = p0;
+  std::uint32_t hi = pages - 1U;
+  while (lo < hi) {
+    const std::uint32_t mid = (lo + hi + 1U) / 2U;
+    std::uint32_t s = 0U;
+    if (pageSeq(mid, s) && s == s0 + (mid - p0)) {
+      lo = mid;
+    } else {
+      hi = mid - 1U;
+    }
+  }
+  head = lo;
+  seq = s0 + (lo - p0);
+
+  /* Oldest live page: the first one after the head that continues the ring
+     backwards (k = 1 once the ring has wrapped, page 0 before that) */
+  live = 1U;
+  for (std::uint32_t k = 1U; k < pages; k++) {
+    std::uint32_t s = 0U;
+    if (seq + k > pages && pageSeq((head + k) % pages, s) &&
+        s == seq + k - pages) {
+      live = pages - k + 1U;
+      break;
+    }
+  }
+  end = scanEnd(head);
+  mounted = true;
+  return RAW_OK;
+}
+
+/**
+ * @brief   Erase the partition and start a new ring at page 0.
+ * @return  RAW_FORMATTED or an error.
+ */
+RawStore::RawStatus RawStore::format() {
+  mounted = false;
+  pages = port.sectorCount();
+  if (pages < 2U) {
+    return RAW_GEOMETRY_ERROR;
+  }
+  for (std::uint32_t p = 1U; p < pages; p++) {
+    if (!port.erase(p)) {
+      return RAW_PORT_ERROR;
+    }
+  }
+  RawStatus status = open(0U, 1U);
+  live = 1U;
+  mounted = (status == RAW_OK);
+  return mounted ? RAW_FORMATTED : status;
+}
+
+/**
+ * @brief   Append one record.
+ * @details Worst case: one page erase, the page header, the record header
+ *          and the payload. Nothing else is read or written.
+ * @param   data Payload.
+ * @param   len  Payload length (empty payloads are ignored).
+ * @return  RAW_OK or an error.
+ */
+RawStore::RawStatus RawStore::append(const void *data, std::uint32_t len) {
+  if (!mounted) {
+    return RAW_NOT_MOUNTED;
+  }
+  if (len == 0U) {
+    return RAW_OK;
+  }
+  if (len > maxRecord()) {
+    return RAW_TOO_LARGE;
+  }
+  const std::uint32_t need = recordSize(len);
+  if (end + need > port.sectorSize()) {
+    RawStatus status = open((head + 1U) % pages, seq + 1U);
+    if (status != RAW_OK) {
+      return status;
+    }
+    if (live < pages) {
+      live++; /* Otherwise the oldest page was just overwritten */
+    }
+  }
+
+  const std::uint32_t off = end;
+  /* Advance first: a failed program must never be programmed over again */
+  end = off + need;
+
+  const RecordHeader hdr = {static_cast<std::uint16_t>(len), RECORD_MARKER,
+                            FlashStore::crc32(data, len)};
+  const std::uint8_t *src = static_cast<const std::uint8_t *>(data);
+  const std::uint32_t body = len & ~3U;
+  bool ok = port.program(head, off, &hdr, sizeof(hdr));
+  if (ok && body > 0U) {
+    ok = port.program(head, off + sizeof(hdr), src, body);
+  }
+  if (ok && (len & 3U) != 0U) {
+    std::uint32_t tail = ERASED_WORD;
+    std::memcpy(&tail, src + body, len & 3U);
+    ok = port.program(head, off + sizeof(hdr) + body, &tail, sizeof(tail));
+  }
+  return ok ? RAW_OK : RAW_PORT_ERROR;
+}
+
+/**
+ * @brief   Cursor at the oldest record in the ring.
+ * @return  Cursor for read().
+ */
+RawStore::Cursor RawStore::oldest() const {
+  return {seq + 1U - live, PAGE_HEADER_SIZE};
+}
+
+/**
+ * @brief   Read the record at a cursor.
+ * @details Advances the cursor past the record. If the cursor's page was
+ *          overwritten meanwhile, reading resumes at the oldest page. A
+ *          cursor at the end stays valid and picks up records appended
+ *          later.
+ * @param   cursor Read position (updated).
+ * @param   buf    Destination for the payload.
+ * @param   size   Size of buf.
+ * @return  Payload length, READ_END, or READ_CRC_ERROR for a skipped record
+ *          (damaged, or larger than buf).
+ */
+std::int32_t RawStore::read(Cursor &cursor, void *buf, std::uint32_t size) {
+  if (!mounted) {
+    return READ_END;
+  }
+  for (;;) {
+    const std::uint32_t age = seq - cursor.seq;
+    if (age >= live) {
+      /* Page overwritten: continue with the oldest one */
+      const Cursor first = oldest();
+      if (static_cast<std::int32_t>(first.seq - cursor.seq) <= 0) {
+        return READ_END; /* Cursor from another ring */
+      }
+      cursor = first;
+      continue;
+    }
+    const std::uint32_t page = (head + pages - age) % pages;
+    const std::uint32_t pageEnd = (age == 0U) ? end : port.sectorSize();
+    if (cursor.offset + RECORD_HEADER_SIZE <= pageEnd) {
+      RecordHeader hdr;
+      if (!port.read(page, cursor.offset, &hdr, sizeof(hdr))) {
+        return READ_END;
+      }
+      const std::uint32_t off = cursor.offset;
+      const std::uint32_t need = recordSize(hdr.length);
+      if (hdr.marker != RECORD_MARKER || off + need > pageEnd) {
+        cursor.offset = pageEnd; /* End of page, or sealed */
+        continue;
+      }
+      cursor.offset = off + need;
+      if (hdr.length > size ||
+          !port.read(page, off + sizeof(hdr), buf, hdr.length) ||
+          FlashStore::crc32(buf, hdr.length) != hdr.crc) {
+        return READ_CRC_ERROR;
+      }
+      return hdr.length;
+    }
+    if (age == 0U) {
+      return READ_END; /* Caught up with the writer */
+    }
+    cursor = {cursor.seq + 1U, PAGE_HEADER_SIZE};
+  }
+}
+
+/**
+ * @brief   Largest record append() accepts.
+ * @return  Page size minus page and record headers.
+ */
+std::uint32_t RawStore::maxRecord() const {
+  return port.sectorSize() - PAGE_HEADER_SIZE - RECORD_HEADER_SIZE;
+}
+
+/**
+ * @brief   Capacity of the ring.
+ * @return  Bytes in all pages, excluding page headers.
+ */
+std::uint32_t RawStore::capacity() const {
+  return pages * (port.sectorSize() - PAGE_HEADER_SIZE);
+}
+
+/**
+ * @brief   Bytes currently written.
+ * @return  Bytes in the live pages, including record headers.
+ */
+std::uint32_t RawStore::usedBytes() const {
+  if (!mounted) {
+    return 0U;
+  }
+  return (live - 1U) * (port.sectorSize() - PAGE_HEADER_SIZE) + end -
+         PAGE_HEADER_SIZE;
+}
+
+/**
+ * @brief   Read and check a page header.
+ * @param   page    Page index.
+ * @param   pageSeq Sequence number if the header is valid.
+ * @return  true for a valid header.
+ */
+bool RawStore::pageSeq(std::uint32_t page, std::uint32_t &pageSeq) {
+  std::uint32_t hdr[3];
+  if (!port.read(page, 0U, hdr, sizeof(hdr)) || hdr[0] != PAGE_MAGIC ||
+      hdr[2] != ~(PAGE_MAGIC ^ hdr[1])) {
+    return false;
+  }
+  pageSeq = hdr[1];
+  return true;
+}
+
+/**
+ * @brief   Erase a page, stamp its header and make it the head.
+ * @param   page    Page index.
+ * @param   pageSeq Sequence number for the page.
+ * @return  RAW_OK or RAW_PORT_ERROR.
+ */
+RawStore::RawStatus RawStore::open(std::uint32_t page,
+                                   std::uint32_t pageSeq) {
+  const std::uint32_t hdr[3] = {PAGE_MAGIC, pageSeq,
+                                ~(PAGE_MAGIC ^ pageSeq)};
+  if (!port.erase(page) || !port.program(page, 0U, hdr, sizeof(hdr))) {
+    return RAW_PORT_ERROR;
+  }
+  head = page;
+  seq = pageSeq;
+  end = PAGE_HEADER_SIZE;
+  return RAW_OK;
+}
+
+/**
+ * @brief   Find the end of the written area of a page.
+ * @details Hops from record header to record header; payloads are not read.
+ * @param   page Page index.
+ * @return  Offset of the first erased record header (or page size if the
+ *          page is full or sealed by a damaged header).
+ */
+std::uint32_t RawStore::scanEnd(std::uint32_t page) {
+  const std::uint32_t size = port.sectorSize();
+  std::uint32_t off = PAGE_HEADER_SIZE;
+  while (off + RECORD_HEADER_SIZE <= size) {
+    RecordHeader hdr;
+    if (!port.read(page, off, &hdr, sizeof(hdr))) {
+      return size;
+    }
+    if (hdr.length == 0xFFFFU && hdr.marker == 0xFFFFU) {
+      return off; /* Erased: end of written area */
+    }
+    if (hdr.marker != RECORD_MARKER || off + recordSize(hdr.length) > size) {
+      return size; /* Damaged header: seal the page */
+    }
+    off += recordSize(hdr.length);
+  }
+  return size;
+}
+
+/**
+ * @brief   Copy bytes out of a RAM page.
+ * @return  false if the range is outside the region.
+ */
+bool RamFlashPort::read(std::uint32_t sector, std::uint32_t offset, void *buf,
+                        std::uint32_t len) {
+  if (sector >= count || offset + len > size) {
+    return false;
+  }
+  std::memcpy(buf, base + sector * size + offset, len);
+  return true;
+}
+
+/**
+ * @brief   Copy bytes into a RAM page.
+ * @return  false if the range is outside the region.
+ */
+bool RamFlashPort::program(std::uint32_t sector, std::uint32_t offset,
+                           const void *data, std::uint32_t len) {
+  if (sector >= count || offset + len > size) {
+    return false;
+  }
+  std::memcpy(base + sector * size + offset, data, len);
+  return true;
+}
+
+/**
+ * @brief   Fill a RAM page with the erased pattern.
+ * @return  false if the page is outside the region.
+ */
+bool RamFlashPort::erase(std::uint32_t sector) {
+  if (sector >= count) {
+    return false;
+  }
+  std::memset(base + sector * size, 0xFF, size);
+  return true;
+}
+
+/** @} */ // end of Logger
@@ -0,0 +1,235 @@
+/**
+ * @file rtc_port.cpp
+ * @brief STM32F4 RTC access for the boot clock
+ * @author Mitul Goti
+ * @version 1.0
+ * @date 2025-10-06
+ * @ingroup boot_clock
+ * @details
+ * Implements Stm32RtcPort directly on the RTC, PWR and RCC registers. The
+ * CubeMX configuration does not enable the HAL RTC module, and the few
+ * register steps below are all the boot clock needs.
+ */
+
+/* STM32 RTC Port
+ ---
+ # 📝 Overview
+ The RTC sits in the backup domain: once started it keeps its calendar
+ across resets and, with a battery on VBAT, across power loss. BootClock
+ reads it once at start-up and writes it on `set clock`.
+
+ # ⚙️ Features
+ - Starts the RTC on the 32.768 kHz LSE crystal; boards without one (the
+   F4 Discovery leaves X3 unfitted) fall back to the ~32 kHz LSI.
+ - 24-hour BCD calendar with sub-second readout from RTC_SSR.
+ - Reports "not set" until the calendar was written once (INITS).
+
+ # 🔧 Implementation Details
+ init() only configures the clock source and prescalers when the backup
+ domain is not running yet (RTCEN clear), so a reset does not disturb the
+ calendar. The LSI is not in the backup domain and stops on every reset;
+ it is switched back on when it is the selected source.
+
+ read() takes SSR, TR and DR in this order: reading SSR or TR locks the
+ shadow registers until DR is read, so the three values belong together.
+ write() stops the calendar in init mode, loads TR and DR and restarts it;
+ the sub-second counter restarts at zero, so the milliseconds of the set
+ time are dropped.
+
+ # ⚠️ Limitations
+ - The hardware stores a two-digit year: 2000..2099 only.
+ - On the LSI the RTC may drift by several percent. The boot clock only
+   uses it for the time across a reset; while running it counts the
+   crystal-driven kernel tick.
+ */
+
+#include "rtc_port.h"
+#include "cmsis_os2.h"
+#include "stm32f4xx.h" // IWYU pragma: keep
+#include <cstdint>
+
+/**
+ * @brief   Anonymous namespace for internal linkage.
+ * @details Contains the register constants and BCD helpers.
+ */
+namespace {
+constexpr std::uint32_t LSE_STARTUP_MS = 500U;   ///< Crystal start-up limit
+constexpr std::uint32_t LSI_STARTUP_MS = 10U;    ///< LSI start-up limit
+constexpr std::uint32_t INIT_TIMEOUT = 100000U;  ///< Polls for INITF/RSF
+constexpr std::uint32_t ASYNC_PRESCALER = 127U;  ///< PREDIV_A: 256 Hz
+constexpr std::uint32_t SYNC_LSE = 255U;         ///< PREDIV_S on 32768 Hz
+constexpr std::uint32_t SYNC_LSI = 249U;         ///< PREDIV_S on 32000 Hz
+constexpr std::uint32_t WPR_KEY1 = 0xCAU;        ///< Write protection key 1
+constexpr std::uint32_t WPR_KEY2 = 0x53U;        ///< Write protection key 2
+constexpr std::uint32_t WPR_LOCK = 0xFFU;        ///< Any other value locks
+
+/**
+ * @brief   Decode a two-digit BCD field.
+ */
+inline std::uint32_t from_bcd(std::uint32_t bcd) {
+  return (bcd >> 4) * 10U + (bcd & 0x0FU);
+}
+
+/**
+ * @brief   Encode a value 0..99 as two BCD digits.
+ */
+inline std::uint32_t to_bcd(std::uint32_t value) {
+  return ((value / 10U) << 4) | (value % 10U);
+}
+
+/**
+ * @brief   Poll RCC until a ready flag is set.
+ * @return  True if the flag came up within timeoutMs.
+ */
+bool wait_ready(volatile std::uint32_t &reg, std::uint32_t flag,
+                std::uint32_t timeoutMs) {
+  for (std::uint32_t ms = 0U; (reg & flag) == 0U; ms++) {
+    if (ms >= timeoutMs) {
+      return false;
+    }
+    osDelay(1U);
+  }
+  return true;
+}
+
+/**
+ * @brief   Clear RSF and wait for the shadow registers to resynchronize.
+ * @details Called with the write protection removed.
+ * @return  True if RSF came up.
+ */
+bool resync_shadow() {
+  RTC->ISR = ~(RTC_ISR_RSF | RTC_ISR_INIT) & RTC->ISR; /* rc_w0 bit */
+  for (std::uint32_t i = 0U; (RTC->ISR & RTC_ISR_RSF) == 0U; i++) {
+    if (i >= INIT_TIMEOUT) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+/** @brief Start the RTC clock.
+ * Enables backup domain access. If the RTC is not running yet, selects LSE
+ * (or LSI if the crystal does not start) and sets 1 Hz prescalers.
+ * @return True if the RTC is clocked.
+ */
+bool Stm32RtcPort::init() {
+  RCC->APB1ENR |= RCC_APB1ENR_PWREN;
+  (void)RCC->APB1ENR; /* Let the clock enable take effect */
+  PWR->CR |= PWR_CR_DBP;
+
+  if ((RCC->BDCR & RCC_BDCR_RTCEN) == 0U) {
+    RCC->BDCR |= RCC_BDCR_BDRST; /* RTCSEL can only be set once per reset */
+    RCC->BDCR &= ~RCC_BDCR_BDRST;
+    RCC->BDCR |= RCC_BDCR_LSEON;
+    if (wait_ready(RCC->BDCR, RCC_BDCR_LSERDY, LSE_STARTUP_MS)) {
+      RCC->BDCR |= RCC_BDCR_RTCSEL_0;
+      syncPrescaler = SYNC_LSE;
+    } else {
+      RCC->BDCR &= ~RCC_BDCR_LSEON;
+      RCC->CSR |= RCC_CSR_LSION;
+      if (!wait_ready(RCC->CSR, RCC_CSR_LSIRDY, LSI_STARTUP_MS)) {
+        return false;
+      }
+      RCC->BDCR |= RCC_BDCR_RTCSEL_1;
+      syncPrescaler = SYNC_LSI;
+    }
+    RCC->BDCR |= RCC_BDCR_RTCEN;
+    if (!enterInit()) {
+      return false;
+    }
+    RTC->PRER = syncPrescaler; /* Two writes, as the reference manual asks */
+    RTC->PRER = syncPrescaler | (ASYNC_PRESCALER << 16);
+    RTC->CR &= ~RTC_CR_FMT; /* 24-hour format */
+    exitInit();
+  } else {
+    if ((RCC->BDCR & RCC_BDCR_RTCSEL) == RCC_BDCR_RTCSEL_1) {
+      RCC->CSR |= RCC_CSR_LSION; /* LSI is stopped by every reset */
+      if (!wait_ready(RCC->CSR, RCC_CSR_LSIRDY, LSI_STARTUP_MS)) {
+        return false;
+      }
+    }
+    syncPrescaler = RTC->PRER & RTC_PRER_PREDIV_S;
+    RTC->WPR = WPR_KEY1;
+    RTC->WPR = WPR_KEY2;
+    const bool synced = resync_shadow(); /* Required after a reset */
+    RTC->WPR = WPR_LOCK;
+    if (!synced) {
+      return false;
+    }
+  }
+  running = true;
+  return true;
+}
+
+/** @brief Read the calendar.
+ * @param dt Destination.
+ * @return False if the RTC is not running or was never set.
+ */
+bool Stm32RtcPort::read(DateTime &dt) {
+  if (!running || (RTC->ISR & RTC_ISR_INITS) == 0U) {
+    return false;
+  }
+  const std::uint32_t ssr = RTC->SSR & RTC_SSR_SS;
+  const std::uint32_t tr = RTC->TR; /* Locks DR until it is read */
+  const std::uint32_t dr = RTC->DR;
+  dt.year = static_cast<std::uint16_t>(2000U + from_bcd((dr >> 16) & 0xFFU));
+  dt.month = static_cast<std::uint8_t>(from_bcd((dr >> 8) & 0x1FU));
+  dt.day = static_cast<std::uint8_t>(from_bcd(dr & 0x3FU));
+  dt.hour = static_cast<std::uint8_t>(from_bcd((tr >> 16) & 0x3FU));
+  dt.minute = static_cast<std::uint8_t>(from_bcd((tr >> 8) & 0x7FU));
+  dt.second = static_cast<std::uint8_t>(from_bcd(tr & 0x7FU));
+  /* SS counts down from PREDIV_S once per second */
+  const std::uint32_t elapsed = (ssr <= syncPrescaler) ? syncPrescaler - ssr
+                                                       : 0U;
+  dt.millis =
+      static_cast<std::uint16_t>(elapsed * 1000U / (syncPrescaler + 1U));
+  return Calendar::valid(dt);
+}
+
+/** @brief Set the calendar.
+ * @param dt Date and time, year 2000..2099 (milliseconds are dropped).
+ * @return False if the RTC is not running, dt is out of range or the
+ *         calendar did not enter init mode.
+ */
+bool Stm32RtcPort::write(const DateTime &dt) {
+  if (!running || !Calendar::valid(dt) || dt.year < 2000U ||
+      dt.year > 2099U) {
+    return false;
+  }
+  const std::uint32_t days = Calendar::daysFromCivil(dt.year, dt.month, dt.day);
+  const std::uint32_t weekday = (days + 3U) % 7U + 1U; /* 1 = Monday */
+  if (!enterInit()) {
+    return false;
+  }
+  RTC->TR = (to_bcd(dt.hour) << 16) | (to_bcd(dt.minute) << 8) |
+            to_bcd(dt.second);
+  RTC->DR = (to_bcd(dt.year - 2000U) << 16) | (weekday << 13) |
+            (to_bcd(dt.month) << 8) | to_bcd(dt.day);
+  exitInit();
+  return true;
+}
+
+/** @brief Remove the write protection and stop the calendar.
+ * @return True once the calendar is in init mode (INITF).
+ */
+bool Stm32RtcPort::enterInit() {
+  RTC->WPR = WPR_KEY1;
+  RTC->WPR = WPR_KEY2;
+  RTC->ISR |= RTC_ISR_INIT;
+  for (std::uint32_t i = 0U; (RTC->ISR & RTC_ISR_INITF) == 0U; i++) {
+    if (i >= INIT_TIMEOUT) {
+      RTC->WPR = WPR_LOCK;
+      return false;
+    }
+  }
+  return true;
+}
+
+/** @brief Restart the calendar and restore the write protection.
+ */
+void Stm32RtcPort::exitInit() {
+  RTC->ISR &= ~RTC_ISR_INIT;
+  resync_shadow(); /* Next read() must not see the old shadow values */
+  RTC->WPR = WPR_LOCK;
+}
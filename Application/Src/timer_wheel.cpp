@@ -0,0 +1,169 @@
+/**
+ * @file timer_wheel.cpp
+ * @brief Hashed timer wheel for millisecond timers
+ * @author Mitul Goti
+ * @version 1.0
+ * @date 2025-10-09
+ * @ingroup led_thread
+ * @details
+ * This file implements TimerWheel: slot lists, expiry processing and the
+ * next-expiry search the LED scheduler sleeps on.
+ */
+
+/* Timer Wheel
+ ---
+ # 📝 Overview
+ The LED scheduler drives all indicator channels from one thread. Each
+ channel is a timer in this wheel; the thread sleeps until the earliest
+ expiry, fires what is due and sleeps again.
+
+ # ⚙️ Features
+ - 64 slots of one tick each, up to 32 timers, about 0.5 KB in total.
+ - O(1) arm and cancel, expiry work proportional to the slots passed.
+ - Timers of any length: a timer several turns ahead stays in its slot
+   until its tick is reached.
+ - Late processing is safe: timers that are overdue fire on the next
+   advance(), a gap of more than one turn is covered by a single sweep.
+
+ # 🔧 Implementation Details
+ A timer for tick t lives in slot t % 64. advance(now) walks the slots from
+ the last processed tick up to now (at most all 64) and fires each timer
+ that is due by now; timers due in a later turn stay linked. Each timer
+ keeps the index of the slot it is linked into (an overdue timer is filed
+ under the cursor slot, not that of its expiry), so unlinking never
+ searches. Fired timers are unlinked before the handler runs, so the
+ handler may re-arm them.
+ After a handler the slot is walked again from its head, because it may
+ have cancelled the timer the walk would continue with.
+
+ untilNext() searches forward from the next tick. A timer found k slots
+ ahead is due in k ticks or in k plus whole turns, so the search can stop
+ as soon as it has passed the best delay found so far.
+ */
+
+#include "timer_wheel.h"
+#include <cstdint>
+
+/**
+ * @brief   Anonymous namespace for internal linkage.
+ * @details Contains the slot mask.
+ */
+namespace {
+constexpr std::uint32_t SLOT_MASK = TimerWheel::SLOTS - 1U; ///< Tick to slot
+static_assert((TimerWheel::SLOTS & SLOT_MASK) == 0U, "SLOTS: power of two");
+static_assert(TimerWheel::SLOTS <= 256U, "SLOTS: 8-bit slot index");
+} // namespace
+
+/** @brief Cancel all timers and start at a tick.
+ * @param now First tick advance() will process.
+ */
+void TimerWheel::reset(std::uint32_t now) {
+  heads.fill(NONE);
+  timers.fill(Timer{});
+  cursor = now;
+  ready = true;
+}
+
+/** @brief Remove a timer from its slot list.
+ * @param id Armed timer.
+ */
+void TimerWheel::unlink(std::uint16_t id) {
+  Timer &t = timers[id];
+  if (t.prev != NONE) {
+    timers[t.prev].next = t.next;
+  } else {
+    heads[t.slot] = t.next; // Head of its slot
+  }
+  if (t.next != NONE) {
+    timers[t.next].prev = t.prev;
+  }
+  t.next = NONE;
+  t.prev = NONE;
+  t.armed = false;
+}
+
+/** @brief Arm a timer.
+ * @param id Timer id (< MAX_TIMERS); re-arming moves it.
+ * @param expiry Tick to fire at.
+ */
+void TimerWheel::arm(std::uint16_t id, std::uint32_t expiry) {
+  if (!ready) {
+    reset(expiry);
+  }
+  if (timers[id].armed) {
+    unlink(id);
+  }
+  // Overdue: file it under the next tick to process, keep the real expiry
+  const bool late = static_cast<std::int32_t>(expiry - cursor) < 0;
+  const std::uint32_t slot = (late ? cursor : expiry) & SLOT_MASK;
+  std::uint16_t &head = heads[slot];
+  Timer &t = timers[id];
+  t.expiry = expiry;
+  t.slot = static_cast<std::uint8_t>(slot);
+  t.prev = NONE;
+  t.next = head;
+  t.armed = true;
+  if (head != NONE) {
+    timers[head].prev = id;
+  }
+  head = id;
+}
+
+/** @brief Stop a timer.
+ * @param id Timer id; nothing happens if it is not armed.
+ */
+void TimerWheel::cancel(std::uint16_t id) {
+  if (timers[id].armed) {
+    unlink(id);
+  }
+}
+
+/** @brief Fire every timer due by now.
+ * Walks the slots from the last processed tick to now (one full sweep if
+ * more than a turn has passed).
+ * @param now Current tick.
+ * @param fire Handler for each expired timer.
+ * @param context Passed to the handler.
+ */
+void TimerWheel::advance(std::uint32_t now, FireHandler fire, void *context) {
+  if (!ready || static_cast<std::int32_t>(now - cursor) < 0) {
+    return; // Already processed
+  }
+  const std::uint32_t span = now - cursor + 1U;
+  const std::uint32_t visits = (span < SLOTS) ? span : SLOTS;
+  const std::uint32_t first = cursor;
+  cursor = now + 1U; // Timers re-armed into the past fire next time
+  for (std::uint32_t k = 0U; k < visits; k++) {
+    const std::uint32_t slot = (first + k) & SLOT_MASK;
+    std::uint16_t id = heads[slot];
+    while (id != NONE) {
+      if (static_cast<std::int32_t>(timers[id].expiry - now) > 0) {
+        id = timers[id].next; // A later turn
+        continue;
+      }
+      unlink(id);
+      fire(context, id);
+      id = heads[slot]; // The handler may have changed this slot
+    }
+  }
+}
+
+/** @brief Delay until the next expiry.
+ * @param limit Largest value returned (nothing armed, or armed later).
+ * @return Ticks after the next tick to process; 0 if a timer is due then
+ *         or overdue.
+ */
+std::uint32_t TimerWheel::untilNext(std::uint32_t limit) const {
+  std::uint32_t best = limit;
+  for (std::uint32_t k = 0U; k < SLOTS && k < best; k++) {
+    for (std::uint16_t id = heads[(cursor + k) & SLOT_MASK]; id != NONE;
+         id = timers[id].next) {
+      const std::int32_t delay =
+          static_cast<std::int32_t>(timers[id].expiry - cursor);
+      const std::uint32_t ticks =
+          (delay < 0) ? 0U : static_cast<std::uint32_t>(delay);
+      best = (ticks < best) ? ticks : best;
+    }
+  }
+  return best;
+}
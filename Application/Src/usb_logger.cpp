@@ -46,12 +46,40 @@ following commands:
 | Command         | Description |
 |-----------------|------------------------------------------------------------------|
 | 'set on time'   | Set LED ON time in milliseconds (valid range: 100–2000). |
-| 'fsLog out'     | Replay file system logs to USB. |
+| 'fsLog out'     | Replay file system logs to USB (background worker). |
+| 'fsLog out <filter>' | Replay matching lines only (severity/time/keyword). |
+| 'fsLog stop'    | Cancel a running replay. |
+| 'fsLog status'  | Show replay progress and FS free space. |
+| 'fsLog throttle <ms>' | Delay between replay chunks (0-1000 ms). |
+| 'fsLog follow on/off' | Stream new file system records live ("tail -f"). |
+| 'fsLog get [pos]' | Acknowledged replay in binary chunks, resumable. |
+| 'fsLog ack <seq>' | Host received all replay chunks below seq. |
 | 'fsLog on'      | Enable file system logging (disables USB logging). |
 | 'fsLog off'     | Disable file system logging. |
+| 'rawLog on/off' | Log to the FAT-free RAM record ring (RawLog). |
+| 'rawLog out <filter>' | Replay the raw log (background worker). |
+| 'rawLog status' | Show raw log usage and worst append time. |
+| 'flashLog out' | Replay the persistent flash log to USB. |
+| 'flashLog status' | Show flash log usage and sector wear. |
+| 'fs dump [offset]' | Stream the raw R0: image in CRC-checked blocks. |
+| 'fs bench'     | Benchmark R0: formats (FS_BENCH builds, erases the log). |
+| 'flight on/off' | Hold records in the RAM flight recorder. |
+| 'flight window <pre> <post>' | Bytes kept before, records after a trigger. |
+| 'flight dump'  | Trigger the flight recorder now. |
 | 'log on'       | Enable USB logging (disables file system logging). |
 | 'log off'      | Disable USB logging. |
-| 'set clock'    | Prompt to set clock time in hh:mm:ss format. |
+| 'set clock [t]' | t: hh:mm:ss or YYYY-MM-DDThh:mm:ss (prompt if omitted). |
+| 'sync <t1> [t4]' | Time sync exchange with the host (Tools/clock_sync). |
+| 'sync status'  | Show the host time sync estimate. |
+| 'stamp tick/cycles' | Record stamps to the ms, or to 100 ns (cycle counter). |
+| 'led policy rr/free/pattern/hw' | LED scheduler: in turn, blinking, patterns, or TIM4. |
+| 'led level <led/all> <0-255>' | LED brightness (LED_PWM builds). |
+| 'led <led> [on] [off]' | Show or set an LED's own on/off time in ms (0: default). |
+| 'led <led> duty <1-99> [period]' | Set an LED's on/off time as a duty cycle. |
+| 'led jitter <led/all> [reset]' | LED edge errors vs. ideal time, histogram. |
+| 'led pattern <led/all> <name>' | Built-in pattern (blink, sos, breathe, ...). |
+| 'led pattern <led/all> = <text>' | Pattern text, e.g. "3[on 150 off 150] 900". |
+| 'input'        | Button gesture counts, lost edges, worst latency. |
 | 'help'         | Show this help message. |
 
 - **Example:** Sending `500` sets the LED ON time to 500 ms.
@@ -63,10 +91,27 @@ message being logged over USB.
 #include "usb_logger.h"
 #include "EventRecorder.h"
 #include "boot_clock.h"
+#include "calendar.h"
+#include "clock_sync.h"
 #include "cmsis_os2.h"
+#include "crash_dump.h"
+#include "input.h"
 #include "led_thread.h"
 #include "log_router.h"
 #include "logger.h"
+#ifdef FLASH_LOG
+#include "flash_log.h"
+#endif
+#ifdef LED_SCHEDULER
+#include "led.h"
+#include "led_scheduler.h"
+#endif
+#ifdef FS_LOG
+#include "log_replay.h"
+#endif
+#ifdef RAW_LOG
+#include "raw_log.h"
+#endif
 #include "stdio.h" // For printf
 #include "usbd_cdc_if.h"
 #include "usbd_def.h"
@@ -75,6 +120,7 @@ message being logged over USB.
 #include <cstring>
 #include <functional>
 #include <map>
+#include <string>
 #include <string_view>
 
 /** Anonymous namespace for internal linkage
@@ -85,16 +131,54 @@ constexpr uint32_t LOG_MSG_SIZE = 64;     /*!< Size of each log message */
 constexpr uint32_t LOG_QUEUE_LENGTH = 32; /*!< Number of messages in queue */
 osMessageQueueId_t msgQueueId = nullptr;  /*!< Message queue for log strings */
 osEventFlagsId_t usbXferFlag = nullptr;   /*!< Event flags for USB transfer */
+osMutexId_t usbXferMutex = nullptr;       /*!< Serializes CDC transfers */
+
+/**
+ * @brief   Mutex attributes for USB transfers.
+ * @details Logger, replay and follow threads all send chunks; one transfer is
+ *          in flight at a time so completion flags are not mixed up.
+ */
+constexpr osMutexAttr_t usbXferMutexAttr = {
+    .name = "UsbXferMutex",         /*!< Name for debugging */
+    .attr_bits = osMutexPrioInherit /*!< Priority inheritance */
+};
 
 constexpr char helpMsg[] =
     "Commands:\r\n"
     "  set on time: Set LED ON time (100-2000 ms)\r\n"
-    "  fsLog out: Replay file system logs to USB\r\n"
+    "  fsLog out [filter]: Replay file system logs to USB\r\n"
+    "    filter: info|event|warn|err|crit, since/until hh:mm:ss, find word\r\n"
+    "  fsLog stop: Cancel running log replay\r\n"
+    "  fsLog status: Show log replay progress\r\n"
+    "  fsLog throttle <ms>: Delay between replay chunks\r\n"
+    "  fsLog follow on|off: Stream new file system logs live\r\n"
+    "  fsLog get [pos]: Acknowledged replay (resumes)\r\n"
+    "  fsLog ack <seq>: Chunks below seq received\r\n"
     "  fsLog on : Enable file system logging\r\n"
     "  fsLog off: Disable file system logging\r\n"
+    "  rawLog on|off: Log to the raw RAM ring\r\n"
+    "  rawLog out [filter]: Replay the raw RAM ring\r\n"
+    "  rawLog status: Raw log usage, worst append\r\n"
+    "  flashLog out: Replay persistent flash log\r\n"
+    "  flashLog status: Flash log usage and wear\r\n"
+    "  fs dump [offset]: Raw R0: image, binary blocks\r\n"
+    "  fs bench: Format benchmark (erases R0:)\r\n"
+    "  flight on|off: RAM flight recorder mode\r\n"
+    "  flight window <pre> <post>: Bytes before, records after\r\n"
+    "  flight dump: Trigger the flight recorder\r\n"
     "  log on   : Enable USB logging\r\n"
     "  log off  : Disable USB logging\r\n"
-    "  set clock: Set clock time (24-hour format)\r\n"
+    "  set clock [t]: hh:mm:ss or YYYY-MM-DDThh:mm:ss\r\n"
+    "  sync <t1> [t4]: Host time sync exchange (us)\r\n"
+    "  sync status: Offset, delay and skew estimate\r\n"
+    "  stamp tick|cycles: Stamps to the ms or 100 ns\r\n"
+    "  led policy rr|free|pattern|hw: In turn, blinking, patterns, TIM4\r\n"
+    "  led level <led|all> <0-255>: LED brightness (PWM)\r\n"
+    "  led <led> [on] [off]: Show or set an LED's on/off time (ms)\r\n"
+    "  led <led> duty <1-99> [period]: LED on/off time as duty cycle\r\n"
+    "  led jitter <led|all> [reset]: LED edge error histograms\r\n"
+    "  led pattern <led|all> <name>|= <text>: Set an LED pattern\r\n"
+    "  input    : Button gestures, lost edges, latency\r\n"
     "  help     : Show this help message\r\n"; /*!< Help message */
 
 using CommandHandler =
@@ -111,13 +195,133 @@ void handleSetOnTime(std::string_view args) {
 }
 
 /** @brief Handle 'fsLog out' command
- * @param args Command arguments (not used)
+ * @param args Optional filter, e.g. "err since 12:00:00" or "find LED"
  */
 void handleFsLogOut(std::string_view args) {
-  UNUSED(args);
 #ifdef FS_LOG
+  LogFilter filter;
+  if (!filter.parse(args)) {
+    UsbLogger::getInstance().usbXferChunk(
+        "Reply: Filter: [info|event|warn|err|crit] [since hh:mm:ss] "
+        "[until hh:mm:ss] [find word]\r\n");
+    return;
+  }
   // Calling LogRouter to replay file system logs to USB
-  LogRouter::getInstance().replayFsLogsToUsb();
+  LogRouter::getInstance().replayFsLogsToUsb(filter);
+#else
+  UNUSED(args);
+#endif
+}
+
+/** @brief Handle 'fsLog stop' command
+ * @param args Command arguments (not used)
+ */
+void handleFsLogStop(std::string_view args) {
+  UNUSED(args);
+#ifdef FS_LOG
+  // Cancelling running and pending replays
+  LogReplay::getInstance().cancel();
+  UsbLogger::getInstance().usbXferChunk("Reply: Log replay cancelled.\r\n");
+#endif
+}
+
+/** @brief Handle 'fsLog status' command
+ * @param args Command arguments (not used)
+ */
+void handleFsLogStatus(std::string_view args) {
+  UNUSED(args);
+#ifdef FS_LOG
+  std::array<char, 80> reply;
+  std::uint32_t sent = 0;
+  std::uint32_t total = 0;
+  LogReplay::getInstance().getProgress(sent, total);
+  snprintf(reply.data(), reply.size(),
+           "Reply: Replay %s %u/%u bytes, FS free %u bytes.\r\n",
+           LogReplay::getInstance().isBusy() ? "running" : "idle",
+           static_cast<unsigned>(sent), static_cast<unsigned>(total),
+           static_cast<unsigned>(FsLog::getInstance().fsFreeBytes()));
+  UsbLogger::getInstance().usbXferChunk(reply.data());
+#endif
+}
+
+/** @brief Handle 'fsLog throttle' command
+ * @param args Delay between replay chunks in milliseconds
+ */
+void handleFsLogThrottle(std::string_view args) {
+#ifdef FS_LOG
+  std::uint32_t ms = 0;
+  if (sscanf(args.data(), "%u", &ms) != 1) {
+    UsbLogger::getInstance().usbXferChunk(
+        "Reply: Usage: fsLog throttle <0-1000 ms>\r\n");
+    return;
+  }
+  LogReplay::getInstance().setThrottle(ms);
+  LogRouter::getInstance().log("Event: Replay throttle %d ms\r\n",
+                               LogReplay::getInstance().getThrottle());
+#else
+  UNUSED(args);
+#endif
+}
+
+/** @brief Handle 'fsLog follow' command
+ * @param args "on" to stream new records live, "off" to stop
+ */
+void handleFsLogFollow(std::string_view args) {
+#ifdef FS_LOG
+  if (args == "on" || args == "off") {
+    LogReplay::getInstance().follow(args == "on");
+    UsbLogger::getInstance().usbXferChunk(args == "on"
+                                              ? "Reply: Follow mode on.\r\n"
+                                              : "Reply: Follow mode off.\r\n");
+  } else {
+    UsbLogger::getInstance().usbXferChunk(
+        "Reply: Usage: fsLog follow on|off\r\n");
+  }
+#else
+  UNUSED(args);
+#endif
+}
+
+/** @brief Handle 'fsLog get' command
+ * @param args Optional reader position; without it the replay resumes
+ * behind the last acknowledged chunk
+ */
+void handleFsLogGet(std::string_view args) {
+#ifdef FS_LOG
+  std::uint32_t position = 0;
+  char *end = nullptr;
+  if (!args.empty()) {
+    position = strtoul(args.data(), &end, 0); // Decimal or 0x hex
+  }
+  if (!args.empty() && (end == args.data() || *end != '\0')) {
+    UsbLogger::getInstance().usbXferChunk(
+        "Reply: Usage: fsLog get [pos]\r\n");
+    return;
+  }
+  if (LogReplay::getInstance().requestWindow(args.empty(), position) !=
+      LogReplay::REPLAY_OK) {
+    UsbLogger::getInstance().usbXferChunk("Reply: Replay not available.\r\n");
+  }
+#else
+  UNUSED(args);
+#endif
+}
+
+/** @brief Handle 'fsLog ack' command
+ * @param args Sequence number of the first chunk not received; no reply,
+ * so acknowledgements do not interleave with the chunks
+ */
+void handleFsLogAck(std::string_view args) {
+#ifdef FS_LOG
+  char *end = nullptr;
+  if (!args.empty()) {
+    std::uint32_t seq = strtoul(args.data(), &end, 10);
+    if (end != args.data() && *end == '\0') {
+      LogReplay::getInstance().ack(seq);
+    }
+  }
+#else
+  UNUSED(args);
 #endif
 }
 
@@ -129,6 +333,7 @@ void handleFsLogOn(std::string_view args) {
 #ifdef FS_LOG
   // Calling LogRouter to enable file system logging
   LogRouter::getInstance().enableFsLogging(true);
+  LogRouter::getInstance().enableRawLogging(false);
   LogRouter::getInstance().enableUsbLogging(false);
 #endif
 }
@@ -144,6 +349,180 @@ void handleFsLogOff(std::string_view args) {
 #endif
 }
 
+/** @brief Handle 'rawLog on' command
+ * @param args Command arguments (not used)
+ */
+void handleRawLogOn(std::string_view args) {
+  UNUSED(args);
+#ifdef RAW_LOG
+  // Calling LogRouter to log to the raw RAM ring only
+  LogRouter::getInstance().enableRawLogging(true);
+  LogRouter::getInstance().enableFsLogging(false);
+  LogRouter::getInstance().enableUsbLogging(false);
+#endif
+}
+
+/** @brief Handle 'rawLog off' command
+ * @param args Command arguments (not used)
+ */
+void handleRawLogOff(std::string_view args) {
+  UNUSED(args);
+  LogRouter::getInstance().enableRawLogging(false);
+}
+
+/** @brief Handle 'rawLog out' command
+ * @param args Optional filter, same syntax as 'fsLog out'
+ */
+void handleRawLogOut(std::string_view args) {
+#if defined(RAW_LOG) && defined(FS_LOG)
+  LogFilter filter;
+  if (!filter.parse(args)) {
+    UsbLogger::getInstance().usbXferChunk(
+        "Reply: Filter: [info|event|warn|err|crit] [since hh:mm:ss] "
+        "[until hh:mm:ss] [find word]\r\n");
+    return;
+  }
+  if (LogReplay::getInstance().requestRaw(filter) != LogReplay::REPLAY_OK) {
+    UsbLogger::getInstance().usbXferChunk(
+        "Reply: Raw log replay not available.\r\n");
+  }
+#else
+  UNUSED(args);
+#endif
+}
+
+/** @brief Handle 'rawLog status' command
+ * @param args Command arguments (not used)
+ */
+void handleRawLogStatus(std::string_view args) {
+  UNUSED(args);
+#ifdef RAW_LOG
+  std::array<char, 96> reply;
+  RawLog::Stats stats;
+  RawLog::getInstance().getStats(stats);
+  snprintf(reply.data(), reply.size(),
+           "Reply: Raw %u/%u bytes, %u pages written, worst append %u us.\r\n",
+           static_cast<unsigned>(stats.used),
+           static_cast<unsigned>(stats.capacity),
+           static_cast<unsigned>(stats.pages),
+           static_cast<unsigned>(stats.worstUs));
+  UsbLogger::getInstance().usbXferChunk(reply.data());
+#endif
+}
+
+/** @brief Handle 'flashLog out' command
+ * @param args Command arguments (not used)
+ */
+void handleFlashLogOut(std::string_view args) {
+  UNUSED(args);
+#ifdef FLASH_LOG
+  if (FlashLog::getInstance().replayToUsb() != FlashLog::FLASH_LOG_OK) {
+    UsbLogger::getInstance().usbXferChunk(
+        "Reply: Flash log not available.\r\n");
+  }
+#endif
+}
+
+/** @brief Handle 'flashLog status' command
+ * @param args Command arguments (not used)
+ */
+void handleFlashLogStatus(std::string_view args) {
+  UNUSED(args);
+#ifdef FLASH_LOG
+  std::array<char, 96> reply;
+  FlashLog::Stats stats;
+  FlashLog::getInstance().getStats(stats);
+  snprintf(reply.data(), reply.size(),
+           "Reply: Flash %u/%u bytes, erases %u-%u, dropped %u.\r\n",
+           static_cast<unsigned>(stats.used),
+           static_cast<unsigned>(stats.capacity),
+           static_cast<unsigned>(stats.minErase),
+           static_cast<unsigned>(stats.maxErase),
+           static_cast<unsigned>(stats.dropped));
+  UsbLogger::getInstance().usbXferChunk(reply.data());
+#endif
+}
+
+/** @brief Handle 'fs dump' command
+ * @param args Optional image offset to resume from (decimal or 0x hex)
+ */
+void handleFsDump(std::string_view args) {
+#ifdef FS_LOG
+  std::uint32_t offset = 0;
+  char *end = nullptr;
+  if (!args.empty()) {
+    offset = strtoul(args.data(), &end, 0); // Decimal or 0x hex
+  }
+  if (!args.empty() && (end == args.data() || *end != '\0')) {
+    UsbLogger::getInstance().usbXferChunk(
+        "Reply: Usage: fs dump [offset]\r\n");
+    return;
+  }
+  if (LogReplay::getInstance().requestDump(offset) != LogReplay::REPLAY_OK) {
+    UsbLogger::getInstance().usbXferChunk("Reply: Dump not available.\r\n");
+  }
+#else
+  UNUSED(args);
+#endif
+}
+
+/** @brief Handle 'fs bench' command
+ * @param args Unused
+ */
+void handleFsBench(std::string_view args) {
+  UNUSED(args);
+#if defined(FS_LOG) && defined(FS_BENCH)
+  if (LogReplay::getInstance().requestBench() != LogReplay::REPLAY_OK) {
+    UsbLogger::getInstance().usbXferChunk("Reply: Bench not available.\r\n");
+  }
+#else
+  UsbLogger::getInstance().usbXferChunk(
+      "Reply: Bench not built (FS_BENCH).\r\n");
+#endif
+}
+
+/** @brief Handle 'flight' on/off command
+ * @param args "on" to hold records in the RAM ring, "off" to route directly
+ */
+void handleFlight(std::string_view args) {
+  if (args == "on" || args == "off") {
+    LogRouter::getInstance().enableFlightRecorder(args == "on");
+    UsbLogger::getInstance().usbXferChunk(
+        LogRouter::getInstance().isFlightRecorderEnabled()
+            ? "Reply: Flight recorder on.\r\n"
+            : "Reply: Flight recorder off.\r\n");
+  } else {
+    UsbLogger::getInstance().usbXferChunk("Reply: Usage: flight on|off\r\n");
+  }
+}
+
+/** @brief Handle 'flight window' command
+ * @param args "<pre bytes 256-2048> <post records 0-100>"
+ */
+void handleFlightWindow(std::string_view args) {
+  std::uint32_t pre = 0;
+  std::uint32_t post = 0;
+  if (sscanf(args.data(), "%u %u", &pre, &post) != 2 ||
+      !LogRouter::getInstance().setFlightWindow(pre, post)) {
+    UsbLogger::getInstance().usbXferChunk(
+        "Reply: Usage: flight window <256-2048> <0-100>\r\n");
+    return;
+  }
+  UsbLogger::getInstance().usbXferChunk("Reply: Flight window set.\r\n");
+}
+
+/** @brief Handle 'flight dump' command
+ * @param args Command arguments (not used)
+ */
+void handleFlightDump(std::string_view args) {
+  UNUSED(args);
+  if (!LogRouter::getInstance().isFlightRecorderEnabled()) {
+    UsbLogger::getInstance().usbXferChunk("Reply: Flight recorder off.\r\n");
+    return;
+  }
+  LogRouter::getInstance().trigger(LogRouter::Trigger::COMMAND);
+}
+
 /** @brief Handle 'log on' command
  * @param args Command arguments (not used)
  */
@@ -152,6 +531,7 @@ void handleLogOn(std::string_view args) {
   // Calling LogRouter for enabling USB logging using MemoryPool
   LogRouter::getInstance().enableUsbLogging(true);
   LogRouter::getInstance().enableFsLogging(false);
+  LogRouter::getInstance().enableRawLogging(false);
 
   LogRouter::getInstance().log(
       "Info: Max Log storage capacity is 32 messages.\r\n");
@@ -166,14 +546,444 @@ void handleLogOff(std::string_view args) {
   LogRouter::getInstance().enableUsbLogging(false);
 }
 
+/** @brief Set the boot clock and report the result
+ * @param text "hh:mm:ss" or "YYYY-MM-DD[T ]hh:mm:ss"
+ */
+void applyClock(std::string_view text) {
+  UsbLogger &usb = UsbLogger::getInstance();
+  BootClock::SetRTCStatus result = BootClock::getInstance().setRTC(text);
+  if (result == BootClock::SetRTCStatus::SUCCESS) {
+    usb.usbXferChunk("Reply: Clock time set successfully\r\n");
+#ifdef RUN_TIME
+    std::array<char, Calendar::ISO_STRING_SIZE> iso;
+    BootClock::getInstance().formatIso(iso.data());
+    LogRouter::getInstance().log("Event: Clock set to %s\r\n", iso.data());
+#endif
+  } else if (result == BootClock::SetRTCStatus::INVALID_RX_FORMAT) {
+    usb.usbXferChunk("Reply: Invalid clock format received. Use hh:mm:ss "
+                     "or YYYY-MM-DDThh:mm:ss.\r\n");
+  } else if (result == BootClock::SetRTCStatus::INVALID_VALUE) {
+    usb.usbXferChunk("Reply: Invalid clock value received.\r\n");
+  }
+}
+
 /** @brief Handle 'set clock' command
- * @param args Command arguments (not used)
+ * @param args Optional date/time; without it the next line is taken
  */
 void handleSetClock(std::string_view args) {
-  UNUSED(args);
+  if (!args.empty()) {
+    applyClock(args);
+    return;
+  }
   // Replying with prompt to set clock time
   UsbLogger::getInstance().usbXferChunk(
-      "Reply: Set clock time (hh:mm:ss):\r\n");
+      "Reply: Set clock (hh:mm:ss or YYYY-MM-DDThh:mm:ss):\r\n");
+}
+
+/** @brief Handle 'sync' command
+ * @param args "<t1> [<t4>]": host Unix time in microseconds when this
+ * command was sent, and when the reply to the previous one arrived
+ * @details Replies "Sync: <t1> <error us> <delay us> <skew ppb>" right
+ * after taking the send time t3; the host matches replies by t1.
+ */
+void handleSync(std::string_view args) {
+  const std::uint64_t t2 = BootClock::getInstance().nowUs(); // Receive time
+  char *end = nullptr;
+  const std::uint64_t t1 = strtoull(args.data(), &end, 10);
+  if (args.empty() || end == args.data() || (*end != '\0' && *end != ' ')) {
+    UsbLogger::getInstance().usbXferChunk(
+        "Reply: Usage: sync <t1> [t4] (host Unix us)\r\n");
+    return;
+  }
+  ClockSync &sync = ClockSync::getInstance();
+  if (*end == ' ') {
+    const char *t4Text = end + 1;
+    const std::uint64_t t4 = strtoull(t4Text, &end, 10);
+    if (end != t4Text && *end == '\0') {
+      sync.complete(t4); // Previous exchange: estimate and steer
+    }
+  }
+  const ClockSync::Stats &stats = sync.getStats();
+  std::array<char, 96> reply;
+  snprintf(reply.data(), reply.size(), "Sync: %llu %lld %lu %ld\r\n",
+           static_cast<unsigned long long>(t1),
+           static_cast<long long>(stats.errorUs),
+           static_cast<unsigned long>(stats.delayUs),
+           static_cast<long>(stats.skewPpb));
+  sync.begin(t1, t2, BootClock::getInstance().nowUs()); // t3: send time
+  UsbLogger::getInstance().usbXferChunk(reply.data());
+}
+
+/** @brief Handle 'sync status' command
+ * @param args Command arguments (not used)
+ */
+void handleSyncStatus(std::string_view args) {
+  UNUSED(args);
+  const ClockSync::Stats &stats = ClockSync::getInstance().getStats();
+  std::array<char, 160> reply;
+  snprintf(reply.data(), reply.size(),
+           "Reply: Sync %lu samples, %lu rejected, %lu steps, last error "
+           "%lld us, delay %lu us, skew %ld ppb\r\n",
+           static_cast<unsigned long>(stats.samples),
+           static_cast<unsigned long>(stats.rejected),
+           static_cast<unsigned long>(stats.steps),
+           static_cast<long long>(stats.errorUs),
+           static_cast<unsigned long>(stats.delayUs),
+           static_cast<long>(stats.skewPpb));
+  UsbLogger::getInstance().usbXferChunk(reply.data());
+}
+
+/** @brief Handle 'stamp' command
+ * @param args "tick" for ms stamps, "cycles" for cycle counter stamps
+ */
+void handleStamp(std::string_view args) {
+  LogRouter &router = LogRouter::getInstance();
+  if (args == "tick" || args == "cycles") {
+    const bool ok = router.setStamp((args == "cycles")
+                                        ? LogRouter::Stamp::CYCLES
+                                        : LogRouter::Stamp::TICK);
+    UsbLogger::getInstance().usbXferChunk(
+        !ok ? "Reply: No cycle counter (CYCLE_STAMP builds only).\r\n"
+        : (router.getStamp() == LogRouter::Stamp::CYCLES)
+            ? "Reply: Stamps from the cycle counter.\r\n"
+            : "Reply: Stamps from the kernel tick.\r\n");
+  } else {
+    UsbLogger::getInstance().usbXferChunk(
+        "Reply: Usage: stamp tick|cycles\r\n");
+  }
+}
+
+/** @brief Handle 'led policy' command
+ * @param args "rr" for one LED at a time, "free" for independent blinking,
+ *             "pattern" for the LEDs' pattern programs, "hw" for TIM4
+ */
+void handleLedPolicy(std::string_view args) {
+#ifdef LED_SCHEDULER
+  if (args == "rr") {
+    LedScheduler::getInstance().setPolicy(LedScheduler::Policy::ROUND_ROBIN);
+    UsbLogger::getInstance().usbXferChunk("Reply: LEDs in turn.\r\n");
+  } else if (args == "free") {
+    LedScheduler::getInstance().setPolicy(LedScheduler::Policy::FREE_RUNNING);
+    UsbLogger::getInstance().usbXferChunk("Reply: LEDs blinking freely.\r\n");
+  } else if (args == "pattern") {
+    LedScheduler::getInstance().setPolicy(LedScheduler::Policy::PATTERN);
+    UsbLogger::getInstance().usbXferChunk("Reply: LEDs run patterns.\r\n");
+  } else if (args == "hw") {
+    const bool pwm = Led::getInstance().getPwm() != nullptr;
+    if (pwm) {
+      LedScheduler::getInstance().setPolicy(LedScheduler::Policy::HARDWARE);
+    }
+    UsbLogger::getInstance().usbXferChunk(
+        pwm ? "Reply: TIM4 blinks the LEDs.\r\n"
+            : "Reply: No LED PWM (LED_PWM builds only).\r\n");
+  } else {
+    UsbLogger::getInstance().usbXferChunk(
+        "Reply: Usage: led policy rr|free|pattern|hw\r\n");
+  }
+#else
+  UNUSED(args);
+  UsbLogger::getInstance().usbXferChunk(
+      "Reply: LED scheduler not built (LED_SCHEDULER).\r\n");
+#endif
+}
+
+/** @brief Handle 'led pattern' command
+ * @param args "<led|all> <name>" for a built-in pattern or
+ *             "<led|all> = <text>" for pattern text
+ */
+void handleLedPattern(std::string_view args) {
+#ifdef LED_SCHEDULER
+  const std::size_t split = args.find(' ');
+  const std::string_view led = args.substr(0, split);
+  std::string_view spec =
+      (split == std::string_view::npos) ? std::string_view{}
+                                        : args.substr(split + 1U);
+  while (!spec.empty() && spec.front() == ' ') {
+    spec.remove_prefix(1);
+  }
+  std::size_t column = 0U;
+  std::array<char, 96> reply;
+  switch (LedScheduler::getInstance().setPattern(led, spec, &column)) {
+  case LedScheduler::PATTERN_OK:
+    snprintf(reply.data(), reply.size(), "Reply: Pattern set.\r\n");
+    break;
+  case LedScheduler::PATTERN_NO_LED:
+    snprintf(reply.data(), reply.size(),
+             "Reply: Usage: led pattern <led|all> <name>|= <text>\r\n");
+    break;
+  case LedScheduler::PATTERN_UNKNOWN: {
+    std::size_t count = 0U;
+    const LedPattern::Builtin *const table = LedPattern::builtins(count);
+    int len = snprintf(reply.data(), reply.size(), "Reply: Patterns:");
+    for (std::size_t i = 0U; i < count && len > 0 &&
+                             static_cast<std::size_t>(len) < reply.size();
+         i++) {
+      len += snprintf(reply.data() + len, reply.size() - len, " %s",
+                      table[i].name);
+    }
+    if (len > 0 && static_cast<std::size_t>(len) + 3U <= reply.size()) {
+      snprintf(reply.data() + len, reply.size() - len, "\r\n");
+    }
+    break;
+  }
+  case LedScheduler::PATTERN_SYNTAX:
+    snprintf(reply.data(), reply.size(),
+             "Reply: Pattern error at column %u.\r\n",
+             static_cast<unsigned>(column));
+    break;
+  default:
+    snprintf(reply.data(), reply.size(), "Reply: LED scheduler busy.\r\n");
+    break;
+  }
+  UsbLogger::getInstance().usbXferChunk(reply.data());
+#else
+  UNUSED(args);
+  UsbLogger::getInstance().usbXferChunk(
+      "Reply: LED scheduler not built (LED_SCHEDULER).\r\n");
+#endif
+}
+
+/** @brief Handle 'led level' command
+ * @param args "<led|all> <0-255>"
+ */
+void handleLedLevel(std::string_view args) {
+#ifdef LED_SCHEDULER
+  const std::size_t split = args.find(' ');
+  const std::string_view led = args.substr(0, split);
+  unsigned int level = 0U;
+  const bool valid =
+      split != std::string_view::npos &&
+      sscanf(args.data() + split + 1U, "%u", &level) == 1 &&
+      level <= 255U;
+  if (!valid) {
+    UsbLogger::getInstance().usbXferChunk(
+        "Reply: Usage: led level <led|all> <0-255>\r\n");
+  } else if (!LedScheduler::getInstance().setLevel(
+                 led, static_cast<std::uint8_t>(level))) {
+    UsbLogger::getInstance().usbXferChunk(
+        "Reply: No PWM for that LED (LED_PWM builds only).\r\n");
+  } else {
+    UsbLogger::getInstance().usbXferChunk("Reply: Level set.\r\n");
+  }
+#else
+  UNUSED(args);
+  UsbLogger::getInstance().usbXferChunk(
+      "Reply: LED scheduler not built (LED_SCHEDULER).\r\n");
+#endif
+}
+
+/** @brief Handle 'led' command (per-LED timing)
+ * @param args "<led>" to show, "<led> <on> [off]" or
+ *             "<led> duty <percent> [period]" to set the LED's times
+ */
+void handleLed(std::string_view args) {
+  const std::size_t split = args.find(' ');
+  const std::string name(args.substr(0, split));
+#ifdef LED_SCHEDULER
+  LedTiming *const timing = LedScheduler::getInstance().timing(name);
+#else
+  LedThread *const thread = LedThread::find(name);
+  LedTiming *const timing = (thread != nullptr) ? &thread->getTiming()
+                                                : nullptr;
+#endif
+  if (timing == nullptr) {
+    UsbLogger::getInstance().usbXferChunk(
+        "Reply: Usage: led <led> [on] [off] | led <led> duty <1-99> "
+        "[period]\r\n");
+    return;
+  }
+  LedTiming::Times times = timing->get();
+  const uint32_t onMs = (times.onMs != 0U) ? times.onMs
+                                           : LedThread::getOnTime();
+  const char *const rest =
+      (split == std::string_view::npos) ? "" : args.data() + split + 1U;
+  unsigned int a = 0U;
+  unsigned int b = 0U;
+  bool valid = true;
+  if (std::strncmp(rest, "duty", 4U) == 0) {
+    b = onMs + ((times.offMs != 0U) ? times.offMs : onMs); // Period
+    const int n = sscanf(rest, "duty %u %u", &a, &b);
+    valid = n >= 1 && a >= 1U && a <= 99U && b * a >= 100U &&
+            b <= 2U * LED_TIME_MAX;
+    const uint32_t on = b * a / 100U;
+    valid = valid && on <= LED_TIME_MAX && b - on <= LED_TIME_MAX;
+    if (valid) {
+      times.onMs = static_cast<uint16_t>(on);
+      times.offMs = static_cast<uint16_t>(b - on);
+    }
+  } else if (*rest != '\0') {
+    const int n = sscanf(rest, "%u %u", &a, &b);
+    valid = n >= 1 && a <= LED_TIME_MAX && (n < 2 || b <= LED_TIME_MAX);
+    if (valid) {
+      times.onMs = static_cast<uint16_t>(a);
+      times.offMs = (n < 2) ? times.offMs : static_cast<uint16_t>(b);
+    }
+  }
+  if (!valid) {
+    UsbLogger::getInstance().usbXferChunk(
+        "Reply: Usage: led <led> [0-65535] [0-65535] | led <led> duty "
+        "<1-99> [period]\r\n");
+    return;
+  }
+  if (*rest != '\0') {
+    timing->set(times); // One store; the LED picks it up next cycle
+  }
+  const uint32_t on = (times.onMs != 0U) ? times.onMs : LedThread::getOnTime();
+  std::array<char, 80> text;
+  if (times.offMs == 0U) {
+    snprintf(text.data(), text.size(), "LED %s on %lu ms%s, off default",
+             name.c_str(), static_cast<unsigned long>(on),
+             (times.onMs == 0U) ? " (shared)" : "");
+  } else {
+    snprintf(text.data(), text.size(),
+             "LED %s on %lu ms%s, off %u ms, duty %lu %%", name.c_str(),
+             static_cast<unsigned long>(on),
+             (times.onMs == 0U) ? " (shared)" : "", times.offMs,
+             static_cast<unsigned long>(on * 100U / (on + times.offMs)));
+  }
+  if (*rest != '\0') {
+    LogRouter::getInstance().log("Event: %s\r\n", text.data());
+  }
+  std::array<char, 96> reply;
+  snprintf(reply.data(), reply.size(), "Reply: %s.\r\n", text.data());
+  UsbLogger::getInstance().usbXferChunk(reply.data());
+#ifdef LED_SCHEDULER
+  // Round-robin hands over after the on-time, patterns time their own waits
+  if (*rest != '\0' && times.offMs != 0U &&
+      LedScheduler::getInstance().getPolicy() !=
+          LedScheduler::Policy::FREE_RUNNING) {
+    UsbLogger::getInstance().usbXferChunk(
+        "Reply: Warning: Off time only applies with 'led policy free'.\r\n");
+  }
+#endif
+}
+
+/** @brief Send one LED edge histogram, nonzero buckets only
+ * @param led LED name
+ * @param edge "on" or "off"
+ * @param hist Histogram to send
+ */
+void sendJitter(const char *led, const char *edge,
+                const JitterHistogram &hist) {
+  std::array<char, 256> line;
+  const int size = static_cast<int>(line.size());
+  int n = snprintf(line.data(), line.size(), "Reply: %s %s:", led, edge);
+  for (uint32_t i = 0U; i < JitterHistogram::BUCKETS && n < size - 32; i++) {
+    const unsigned long count = hist.bucket(i);
+    const unsigned long limit = JitterHistogram::bucketLimitUs(i);
+    if (count == 0U) {
+      continue;
+    }
+    if (i == 0U) {
+      n += snprintf(line.data() + n, size - n, " early %lu", count);
+    } else if (limit == 0U) {
+      n += snprintf(line.data() + n, size - n, " >=%lu us %lu",
+                    static_cast<unsigned long>(
+                        JitterHistogram::bucketLimitUs(i - 1U)),
+                    count);
+    } else {
+      n += snprintf(line.data() + n, size - n, " <%lu us %lu", limit, count);
+    }
+  }
+  snprintf(line.data() + n, size - n, "\r\n");
+  UsbLogger::getInstance().usbXferChunk(line.data());
+}
+
+/** @brief Send the edge counts, bounds and slips, then both histograms
+ * @param led LED name
+ * @param on On edge histogram
+ * @param off Off edge histogram
+ * @param slips Schedule restarts
+ */
+void sendJitterReport(const char *led, const JitterHistogram &on,
+                      const JitterHistogram &off, uint32_t slips) {
+  std::array<char, 160> reply;
+  snprintf(reply.data(), reply.size(),
+           "Reply: LED %s: %lu on edges %ld..%ld us, %lu off edges "
+           "%ld..%ld us, %lu slips\r\n",
+           led, static_cast<unsigned long>(on.count()),
+           static_cast<long>((on.count() != 0U) ? on.earliest() : 0),
+           static_cast<long>((on.count() != 0U) ? on.latest() : 0),
+           static_cast<unsigned long>(off.count()),
+           static_cast<long>((off.count() != 0U) ? off.earliest() : 0),
+           static_cast<long>((off.count() != 0U) ? off.latest() : 0),
+           static_cast<unsigned long>(slips));
+  UsbLogger::getInstance().usbXferChunk(reply.data());
+  sendJitter(led, "on", on);
+  sendJitter(led, "off", off);
+}
+
+/** @brief Handle 'led jitter' command
+ * @param args "<led|all>" to show, "<led|all> reset" to clear the edge
+ *             error histograms of the LED threads (of the LED scheduler's
+ *             channels in LED_SCHEDULER builds)
+ */
+void handleLedJitter(std::string_view args) {
+  const std::size_t split = args.find(' ');
+  const std::string_view name = args.substr(0, split);
+  const bool reset =
+      split != std::string_view::npos && args.substr(split + 1U) == "reset";
+  if (name.empty() || (split != std::string_view::npos && !reset)) {
+    UsbLogger::getInstance().usbXferChunk(
+        "Reply: Usage: led jitter <led|all> [reset]\r\n");
+    return;
+  }
+#ifdef LED_SCHEDULER
+  LedScheduler &leds = LedScheduler::getInstance();
+  bool found = false;
+  for (uint32_t id = 0U; id < leds.channelCount(); id++) {
+    if (name != "all" && name != leds.getName(id)) {
+      continue;
+    }
+    found = true;
+    if (reset) {
+      leds.resetJitter(id);
+      continue;
+    }
+    sendJitterReport(leds.getName(id), leds.getOnJitter(id),
+                     leds.getOffJitter(id), leds.getSlips(id));
+  }
+#else
+  bool found = false;
+  uint32_t i = 0U;
+  while (LedThread *led = LedThread::get(i++)) {
+    if (name != "all" && name != led->getName()) {
+      continue;
+    }
+    found = true;
+    if (reset) {
+      led->resetJitter();
+      continue;
+    }
+    sendJitterReport(led->getName(), led->getOnJitter(), led->getOffJitter(),
+                     led->getSlips());
+  }
+#endif
+  if (!found) {
+    UsbLogger::getInstance().usbXferChunk("Reply: No such LED.\r\n");
+  } else if (reset) {
+    UsbLogger::getInstance().usbXferChunk(
+        "Reply: LED jitter histograms cleared.\r\n");
+  }
+}
+
+/** @brief Handle 'input' command
+ * @param args Command arguments (not used)
+ */
+void handleInput(std::string_view args) {
+  UNUSED(args);
+  using Gesture = InputDispatcher::Gesture;
+  const InputDispatcher &input = InputDispatcher::getInstance();
+  std::array<char, 160> reply;
+  snprintf(reply.data(), reply.size(),
+           "Reply: Button %lu short, %lu long, %lu double, %lu edges lost, "
+           "worst latency %lu ms\r\n",
+           static_cast<unsigned long>(input.getCount(Gesture::SHORT)),
+           static_cast<unsigned long>(input.getCount(Gesture::LONG)),
+           static_cast<unsigned long>(input.getCount(Gesture::DOUBLE)),
+           static_cast<unsigned long>(input.getDropped()),
+           static_cast<unsigned long>(input.getWorstLatency()));
+  UsbLogger::getInstance().usbXferChunk(reply.data());
 }
 
 /** @brief Handle 'help' command
@@ -187,12 +997,69 @@ void handleHelp(std::string_view args) {
 
 // Map of command strings to their corresponding handler functions
 const std::map<std::string, CommandHandler> commandMap = {
-    {"set on time", handleSetOnTime}, {"fsLog out", handleFsLogOut},
-    {"fsLog on", handleFsLogOn},      {"fsLog off", handleFsLogOff},
-    {"log on", handleLogOn},          {"log off", handleLogOff},
-    {"set clock", handleSetClock},    {"help", handleHelp},
+    {"set on time", handleSetOnTime},
+    {"fsLog out", handleFsLogOut},
+    {"fsLog on", handleFsLogOn},
+    {"fsLog off", handleFsLogOff},
+    {"fsLog stop", handleFsLogStop},
+    {"fsLog status", handleFsLogStatus},
+    {"fsLog throttle", handleFsLogThrottle},
+    {"fsLog follow", handleFsLogFollow},
+    {"fsLog get", handleFsLogGet},
+    {"fsLog ack", handleFsLogAck},
+    {"rawLog on", handleRawLogOn},
+    {"rawLog off", handleRawLogOff},
+    {"rawLog out", handleRawLogOut},
+    {"rawLog status", handleRawLogStatus},
+    {"flashLog out", handleFlashLogOut},
+    {"flashLog status", handleFlashLogStatus},
+    {"fs dump", handleFsDump},
+    {"fs bench", handleFsBench},
+    {"flight", handleFlight},
+    {"flight window", handleFlightWindow},
+    {"flight dump", handleFlightDump},
+    {"log on", handleLogOn},
+    {"log off", handleLogOff},
+    {"set clock", handleSetClock},
+    {"sync", handleSync},
+    {"sync status", handleSyncStatus},
+    {"stamp", handleStamp},
+    {"led policy", handleLedPolicy},
+    {"led pattern", handleLedPattern},
+    {"led level", handleLedLevel},
+    {"led jitter", handleLedJitter},
+    {"led", handleLed},
+    {"input", handleInput},
+    {"help", handleHelp},
 };
 
+/** @brief Look up a command, allowing trailing arguments.
+ * @param line Received command line ("<command>" or "<command> <args>")
+ * @param args Set to the argument part of the line (empty if none)
+ * @return Iterator to the matching entry or commandMap.end()
+ */
+auto findCommand(std::string_view line, std::string_view &args) {
+  args = {};
+  auto it = commandMap.find(std::string(line));
+  if (it != commandMap.end()) {
+    return it;
+  }
+  // Longest command that is followed by a space wins
+  auto best = commandMap.end();
+  for (auto cmd = commandMap.begin(); cmd != commandMap.end(); ++cmd) {
+    const std::string &key = cmd->first;
+    if (line.size() > key.size() && line[key.size()] == ' ' &&
+        line.compare(0, key.size(), key) == 0 &&
+        (best == commandMap.end() || key.size() > best->first.size())) {
+      best = cmd;
+    }
+  }
+  if (best != commandMap.end()) {
+    args = line.substr(best->first.size() + 1);
+  }
+  return best;
+}
+
 uint64_t log_queue_mem[LOG_QUEUE_LENGTH * LOG_MSG_SIZE / 8]
     __attribute__((aligned(64))); /*!< Memory buffer for message queue */
 uint64_t log_queue_cb[32]
@@ -266,6 +1133,14 @@ void UsbLogger::init() {
 #ifdef DEBUG
     printf("Failed to create USB transfer event flags: %s, %d\r\n", __FILE__,
            __LINE__);
+#endif
+    return;
+  }
+  usbXferMutex = osMutexNew(&usbXferMutexAttr);
+  if (usbXferMutex == nullptr) {
+#ifdef DEBUG
+    printf("Failed to create USB transfer mutex: %s, %d\r\n", __FILE__,
+           __LINE__);
 #endif
     return;
   }
@@ -314,6 +1189,21 @@ void UsbLogger::log(std::string_view msg) {
   }
 }
 
+/**
+ * @brief Move queued, unsent messages into the crash dump.
+ * @details Fault context only: non-blocking queue reads, no locks.
+ */
+void UsbLogger::crashDrain() {
+  char msg[LOG_MSG_SIZE];
+  if (msgQueueId == nullptr) {
+    return;
+  }
+  while (osMessageQueueGet(msgQueueId, msg, nullptr, 0) == osOK) {
+    CrashDump::getInstance().capture(
+        std::string_view(msg, strnlen(msg, LOG_MSG_SIZE)));
+  }
+}
+
 /**
  * @brief Start a USB transfer of a message chunk.
  * @param msg Pointer to the message buffer.
@@ -323,9 +1213,13 @@ void UsbLogger::log(std::string_view msg) {
  *   - Initiates a USB CDC transfer in a separate thread.
  *   - Waits for the transfer complete event flag.
  *   - Retries if the USB is busy.
+ *   - Holds the transfer mutex so concurrent senders do not interleave.
  */
 UsbLogger::UsbXferStatus UsbLogger::usbXfer(std::string_view msg,
                                             std::uint32_t len) {
+  if (usbXferMutex != nullptr) {
+    osMutexAcquire(usbXferMutex, osWaitForever);
+  }
   // Start USB transfer in a separate thread
   while (CDC_Transmit_FS(const_cast<uint8_t *>(
                              reinterpret_cast<const uint8_t *>(msg.data())),
@@ -333,7 +1227,11 @@ UsbLogger::UsbXferStatus UsbLogger::usbXfer(std::string_view msg,
     osDelay(10); // Wait and retry if USB is busy
   }
   // Wait for transfer complete event
-  if (osEventFlagsWait(usbXferFlag, 1U, osFlagsWaitAny, 10U) != 1U) {
+  uint32_t flags = osEventFlagsWait(usbXferFlag, 1U, osFlagsWaitAny, 10U);
+  if (usbXferMutex != nullptr) {
+    osMutexRelease(usbXferMutex);
+  }
+  if (flags != 1U) {
 #ifdef DEBUG
     printf("Failed: USB transfer: %s, %d\r\n", __FILE__, __LINE__);
 #endif
@@ -390,7 +1288,7 @@ void UsbLogger::loggerThread() {
  *   - Logs actions and errors using the LogRouter.
  */
 void UsbLogger::loggerCommand(void) {
-  std::array<char, 16> rxBuf; // Buffer for receiving commands
+  std::array<char, 64> rxBuf{}; // One full-speed packet (64 bytes)
   uint32_t rxLen = 4;
 
   /* Helper lambda to check if a string represents a valid integer */
@@ -406,10 +1304,11 @@ void UsbLogger::loggerCommand(void) {
   // Check for received command from USB CDC
   if (USBD_Interface_fops_FS.Receive(reinterpret_cast<uint8_t *>(rxBuf.data()),
                                      &rxLen) == USBD_OK) {
-    auto command = std::string(rxBuf.data());
-    auto it = commandMap.find(command);
+    rxBuf.back() = '\0'; // Ensure null termination
+    std::string_view args;
+    auto it = findCommand(rxBuf.data(), args);
     if (it != commandMap.end()) {
-      it->second(rxBuf.data()); // Call the corresponding command handler
+      it->second(args); // Call the corresponding command handler
     } else if (isInteger(rxBuf.data())) {
       uint32_t temp = 0;
       sscanf(rxBuf.data(), "%u", &temp); // Parse received command as integer
@@ -429,18 +1328,10 @@ void UsbLogger::loggerCommand(void) {
         printf("Invalid ON Time received: %s, %d\r\n", __FILE__, __LINE__);
 #endif
       }
-    } else if (strnlen(rxBuf.data(), rxBuf.size()) == 8 && rxBuf.at(2) == ':' &&
-               rxBuf.at(5) == ':') {
-      // Handle 'set clock' command with time format hh:mm:ss
-      BootClock::SetRTCStatus result =
-          BootClock::getInstance().setRTC(rxBuf.data());
-      if (result == BootClock::SetRTCStatus::SUCCESS) {
-        usbXferChunk("Reply: Clock time set successfully\r\n");
-      } else if (result == BootClock::SetRTCStatus::INVALID_RX_FORMAT) {
-        usbXferChunk("Reply: Invalid clock format received. Use hh:mm:ss.\r\n");
-      } else if (result == BootClock::SetRTCStatus::INVALID_VALUE) {
-        usbXferChunk("Reply: Invalid clock value received.\r\n");
-      }
+    } else if ((rxBuf.at(2) == ':' && rxBuf.at(5) == ':') ||
+               (rxBuf.at(4) == '-' && rxBuf.at(7) == '-')) {
+      // Reply to 'set clock': hh:mm:ss or YYYY-MM-DDThh:mm:ss
+      applyClock(rxBuf.data());
     } else {
       // Find the actual length of received data (up to first null terminator)
       size_t actualLen = strnlen(rxBuf.data(), rxBuf.size());
@@ -468,7 +1359,7 @@ UsbLogger::UsbXferStatus UsbLogger::usbXferChunk(std::string_view msg) {
   uint32_t len = msg.length();
   if (len > 0) {
     // Transmit a chunk of data over USB CDC
-    if (usbXfer(msg.data(), len) != 0) {
+    if (usbXfer(msg, len) != 0) { // Binary safe: no strlen()
       return USB_XFER_ERROR; // Transfer failed
     } else {
       return USB_XFER_SUCCESS; // Transfer succeeded
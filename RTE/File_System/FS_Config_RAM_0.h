@@ -27,7 +27,11 @@
 //     <s>Section Name
 //     <i>Define the name of the section for the file system buffer.
 //     <i>Linker script shall have this section defined.
-#define RAM0_SECTION            ".filesystem.ram0"
+#ifdef FS_LOG_WARM_RESET
+#define RAM0_SECTION            ".bss.noinit.ram0"
+#else
+#define RAM0_SECTION            ".bss.ram0"
+#endif
 
 //   </e>
 
@@ -23,6 +23,7 @@
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "ARM_Fault.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -84,7 +85,7 @@ void NMI_Handler(void) {
  */
 void HardFault_Handler(void) {
   /* USER CODE BEGIN HardFault_IRQn 0 */
-
+  ARM_FaultSave(); /* Save fault record, crash dump, reset (crash_dump.cpp) */
   /* USER CODE END HardFault_IRQn 0 */
   while (1) {
     /* USER CODE BEGIN W1_HardFault_IRQn 0 */
@@ -97,7 +98,7 @@ void HardFault_Handler(void) {
  */
 void MemManage_Handler(void) {
   /* USER CODE BEGIN MemoryManagement_IRQn 0 */
-
+  ARM_FaultSave(); /* Save fault record, crash dump, reset (crash_dump.cpp) */
   /* USER CODE END MemoryManagement_IRQn 0 */
   while (1) {
     /* USER CODE BEGIN W1_MemoryManagement_IRQn 0 */
@@ -110,7 +111,7 @@ void MemManage_Handler(void) {
  */
 void BusFault_Handler(void) {
   /* USER CODE BEGIN BusFault_IRQn 0 */
-
+  ARM_FaultSave(); /* Save fault record, crash dump, reset (crash_dump.cpp) */
   /* USER CODE END BusFault_IRQn 0 */
   while (1) {
     /* USER CODE BEGIN W1_BusFault_IRQn 0 */
@@ -123,7 +124,7 @@ void BusFault_Handler(void) {
  */
 void UsageFault_Handler(void) {
   /* USER CODE BEGIN UsageFault_IRQn 0 */
-
+  ARM_FaultSave(); /* Save fault record, crash dump, reset (crash_dump.cpp) */
   /* USER CODE END UsageFault_IRQn 0 */
   while (1) {
     /* USER CODE BEGIN W1_UsageFault_IRQn 0 */
@@ -0,0 +1,154 @@
+/**
+ * @file    clocksync.cpp
+ * @brief   Host tool: keep the device clock on the host clock.
+ * @author  Mitul Goti
+ * @version 1.0
+ * @date    2025-10-07
+ * @ingroup boot_clock
+ * @{
+ * @details
+ * Build and run on Linux:
+ * ```
+ * g++ -std=c++17 -O2 Tools/clock_sync/clocksync.cpp -o clocksync
+ * ./clocksync /dev/ttyACM0            # one exchange every 16 s, forever
+ * ./clocksync /dev/ttyACM0 4 100      # every 4 s, 100 exchanges
+ * ```
+ * Sends `sync <t1> <t4>` with CLOCK_REALTIME in microseconds: t1 is the
+ * send time of this request, t4 the arrival time of the previous reply.
+ * Prints one line per reply: the device's last correction, round-trip
+ * delay and skew estimate. Run NTP/PTP on the host for a good reference.
+ * Other text the firmware sends goes to stderr.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <poll.h>
+#include <string>
+#include <termios.h>
+#include <unistd.h>
+
+namespace {
+constexpr int REPLY_TIMEOUT_MS = 1000; /*!< Wait for "Sync:" */
+
+/**
+ * @brief   Host time in Unix microseconds.
+ */
+std::uint64_t nowUs() {
+  timespec ts;
+  clock_gettime(CLOCK_REALTIME, &ts);
+  return static_cast<std::uint64_t>(ts.tv_sec) * 1000000U +
+         static_cast<std::uint64_t>(ts.tv_nsec) / 1000U;
+}
+
+/**
+ * @brief   Open a CDC tty in raw mode.
+ * @return  File descriptor or -1.
+ */
+int openTty(const char *path) {
+  int fd = open(path, O_RDWR | O_NOCTTY);
+  if (fd < 0) {
+    return -1;
+  }
+  termios tio;
+  if (tcgetattr(fd, &tio) == 0) {
+    cfmakeraw(&tio);
+    tcsetattr(fd, TCSANOW, &tio);
+  }
+  tcflush(fd, TCIOFLUSH);
+  return fd;
+}
+
+/**
+ * @brief   Wait for the reply to the request sent at t1.
+ * @param   fd   tty.
+ * @param   t1   Send time of the request.
+ * @param   line Receives the reply line.
+ * @return  Host time when the reply arrived, 0 on timeout.
+ */
+std::uint64_t awaitReply(int fd, std::uint64_t t1, std::string &line) {
+  static std::string pending; /* Bytes after the last full line */
+  const std::uint64_t deadline = nowUs() + REPLY_TIMEOUT_MS * 1000U;
+  char buf[512];
+  pollfd p = {fd, POLLIN, 0};
+  for (;;) {
+    const std::uint64_t now = nowUs();
+    if (now >= deadline ||
+        poll(&p, 1, static_cast<int>((deadline - now) / 1000U) + 1) <= 0) {
+      return 0U;
+    }
+    const ssize_t len = read(fd, buf, sizeof(buf));
+    const std::uint64_t arrived = nowUs(); /* t4 candidate */
+    if (len <= 0) {
+      return 0U;
+    }
+    pending.append(buf, static_cast<std::size_t>(len));
+    std::size_t nl;
+    while ((nl = pending.find('\n')) != std::string::npos) {
+      line = pending.substr(0, nl + 1U);
+      pending.erase(0, nl + 1U);
+      unsigned long long echo = 0U;
+      if (std::sscanf(line.c_str(), "Sync: %llu", &echo) == 1 && echo == t1) {
+        return arrived;
+      }
+      std::fputs(line.c_str(), stderr);
+    }
+  }
+}
+} // namespace
+
+/**
+ * @brief   Entry point, see the file header for usage.
+ */
+int main(int argc, char **argv) {
+  if (argc < 2) {
+    std::fprintf(stderr, "usage: clocksync <tty> [interval s] [count]\n");
+    return 2;
+  }
+  const unsigned interval = (argc > 2) ? std::atoi(argv[2]) : 16U;
+  const long count = (argc > 3) ? std::atol(argv[3]) : -1;
+  int fd = openTty(argv[1]);
+  if (fd < 0) {
+    std::perror(argv[1]);
+    return 1;
+  }
+  std::uint64_t t4 = 0U; /* Arrival of the previous reply, 0 if none */
+  std::printf("%-20s %12s %10s %10s\n", "host time (us)", "error us",
+              "delay us", "skew ppb");
+  for (long n = 0; count < 0 || n < count; n++) {
+    char cmd[64];
+    const std::uint64_t t1 = nowUs();
+    int len = (t4 != 0U)
+                  ? std::snprintf(cmd, sizeof(cmd), "sync %llu %llu",
+                                  static_cast<unsigned long long>(t1),
+                                  static_cast<unsigned long long>(t4))
+                  : std::snprintf(cmd, sizeof(cmd), "sync %llu",
+                                  static_cast<unsigned long long>(t1));
+    if (write(fd, cmd, len) != len) { /* One packet, no line ending */
+      std::perror("write");
+      return 1;
+    }
+    std::string line;
+    t4 = awaitReply(fd, t1, line);
+    long long error = 0;
+    unsigned long delay = 0U;
+    long skew = 0;
+    unsigned long long echo = 0U;
+    if (t4 == 0U) {
+      std::fprintf(stderr, "clocksync: no reply\n");
+    } else if (std::sscanf(line.c_str(), "Sync: %llu %lld %lu %ld", &echo,
+                           &error, &delay, &skew) == 4) {
+      std::printf("%-20llu %12lld %10lu %10ld\n",
+                  static_cast<unsigned long long>(t1), error, delay, skew);
+      std::fflush(stdout);
+    }
+    sleep(interval);
+  }
+  close(fd);
+  return 0;
+}
+
+/** @} */ // end of boot_clock
@@ -0,0 +1,107 @@
+/**
+ * @file    cycle_check.cpp
+ * @brief   Host self-check of the CycleClock wrap tracking.
+ * @author  Mitul Goti
+ * @version 1.0
+ * @date    2025-10-08
+ * @ingroup boot_clock
+ * @{
+ * @details
+ * Built and run with the other host checks by `make -C Tools check`, or
+ * alone from the repository root:
+ * ```
+ * make -C Tools cycle_check
+ * Tools/build/cycle_check
+ * ```
+ * Runs the counter through many wraps, first from one thread, then with
+ * reader threads racing a writer that advances the counter and reads it
+ * once per step (as the 1 s tracking timer does on the target).
+ */
+
+#include "cycle_clock.h"
+#include "cycle_sim.h"
+#include "host_check.h"
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+constexpr std::uint64_t HALF_WRAP = 1ULL << 31; /*!< Tracking limit */
+constexpr int READERS = 4;                      /*!< Racing reader threads */
+} // namespace
+
+int main() {
+  int failures = 0;
+
+  /* 1. One thread, random steps below half a wrap, start near a wrap */
+  {
+    SimCycleCounter counter;
+    counter.advance(0xFFFFF000U);
+    CycleClock clock;
+    clock.attach(&counter);
+    std::mt19937_64 rng(1);
+    for (int i = 0; i < 1000000; i++) {
+      counter.advance(rng() % HALF_WRAP);
+      if (clock.cycles() != counter.total()) {
+        std::printf("FAIL: step %d: %llu, expected %llu\n", i,
+                    static_cast<unsigned long long>(clock.cycles()),
+                    static_cast<unsigned long long>(counter.total()));
+        failures++;
+        break;
+      }
+    }
+    std::printf("single: %llu wraps\n",
+                static_cast<unsigned long long>(counter.total() >> 32));
+  }
+
+  /* 2. Readers race the writer's compare-and-swap */
+  {
+    SimCycleCounter counter;
+    CycleClock clock;
+    clock.attach(&counter);
+    std::atomic_bool done = false;
+    std::atomic_int bad = 0;
+    std::vector<std::thread> readers;
+    for (int r = 0; r < READERS; r++) {
+      readers.emplace_back([&]() {
+        std::uint64_t last = 0U;
+        while (!done.load()) {
+          const std::uint64_t before = counter.total();
+          const std::uint64_t now = clock.cycles();
+          const std::uint64_t after = counter.total();
+          if (now < before || now > after || now < last) {
+            bad++;
+          }
+          last = now;
+        }
+      });
+    }
+    for (int i = 0; i < 2000000; i++) {
+      counter.advance(1U << 24); /* 256 steps per wrap */
+      clock.cycles();
+    }
+    done = true;
+    for (std::thread &t : readers) {
+      t.join();
+    }
+    failures += expect(bad.load() == 0, "racing reads out of range");
+    std::printf("racing: %llu wraps, %d readers, %d bad reads\n",
+                static_cast<unsigned long long>(counter.total() >> 32),
+                READERS, bad.load());
+  }
+
+  /* 3. Without a counter */
+  {
+    CycleClock clock;
+    failures += expect(!clock.attached() && clock.cycles() == 0U &&
+                           clock.frequency() == 0U,
+                       "detached clock counts");
+  }
+
+  return summary(failures);
+}
+
+/** @} */ // end of boot_clock
@@ -0,0 +1,49 @@
+/**
+ * @file    cycle_sim.h
+ * @brief   Host stand-in for the DWT cycle counter behind CycleCounter.
+ * @author  Mitul Goti
+ * @version 1.0
+ * @date    2025-10-08
+ * @ingroup boot_clock
+ * @{
+ * @details
+ *   SimCycleCounter implements CycleCounter on a 64-bit count that the test
+ *   advances by hand (from any thread). read() returns the low 32 bits, so
+ *   it wraps like CYCCNT.
+ */
+
+#ifndef CYCLE_SIM_H
+#define CYCLE_SIM_H
+
+#include <atomic>
+#include <cstdint>
+#include <cycle_counter.h>
+
+/**
+ * @class   SimCycleCounter
+ * @brief   CycleCounter on a simulated free-running count.
+ */
+class SimCycleCounter : public CycleCounter {
+public:
+  /** @param hz Simulated core clock */
+  explicit SimCycleCounter(std::uint32_t hz = 168000000U) : hz(hz) {}
+
+  std::uint32_t read() override {
+    return static_cast<std::uint32_t>(count.load());
+  }
+
+  std::uint32_t frequency() const override { return hz; }
+
+  /** @brief Let cycles pass */
+  void advance(std::uint64_t cycles) { count.fetch_add(cycles); }
+
+  /** @brief Cycles since the simulated reset, not wrapped */
+  std::uint64_t total() const { return count.load(); }
+
+private:
+  std::atomic_uint64_t count = 0U; /*!< Full count, CYCCNT is the low half */
+  std::uint32_t hz;                /*!< Counts per second */
+};
+
+#endif    // CYCLE_SIM_H
+/** @} */ // end of boot_clock
@@ -0,0 +1,194 @@
+/**
+ * @file    flash_bench.cpp
+ * @brief   Host benchmark and self-check of FlashStore on the simulator.
+ * @author  Mitul Goti
+ * @version 1.0
+ * @date    2025-09-24
+ * @ingroup Logger
+ * @{
+ * @details
+ * Built and run with the other host checks by `make -C Tools check`, or
+ * alone from the repository root:
+ * ```
+ * make -C Tools flash_bench
+ * Tools/build/flash_bench [image] [pages]
+ * ```
+ * Uses the target geometry (3 x 128 KB). Fills 256-byte pages the way
+ * FlashLog does, then remounts, verifies every record and simulates a power
+ * cut in the middle of a record.
+ */
+
+#include "flash_sim.h"
+#include "flash_store.h"
+#include "host_check.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace {
+constexpr std::uint32_t SECTORS = 3U;          /*!< As Stm32FlashPort */
+constexpr std::uint32_t SECTOR_SIZE = 0x20000; /*!< As Stm32FlashPort */
+constexpr std::uint32_t PAGE_SIZE = 256U;      /*!< As FlashLog */
+
+/**
+ * @brief   Fill a page with log lines "[hh:mm:ss.mmm] Info: page n line k".
+ * @param   page Destination page.
+ * @param   n    Page number (recorded in every line).
+ * @return  Bytes used.
+ */
+std::uint32_t fillPage(char *page, std::uint32_t n) {
+  std::uint32_t len = 0U;
+  for (std::uint32_t k = 0;; k++) {
+    char line[64];
+    int m = std::snprintf(line, sizeof(line),
+                          "[%02u:%02u:%02u.%03u] Info: page %u line %u\r\n",
+                          (n / 3600000U) % 24U, (n / 60000U) % 60U,
+                          (n / 1000U) % 60U, n % 1000U, n, k);
+    if (len + m > PAGE_SIZE) {
+      return len;
+    }
+    std::memcpy(page + len, line, m);
+    len += m;
+  }
+}
+
+/**
+ * @brief   Page number recorded in a page.
+ * @return  Page number, or UINT32_MAX if the text is not a page.
+ */
+std::uint32_t pageNumber(const char *page, std::int32_t len) {
+  unsigned n = 0;
+  std::string text(page, static_cast<std::size_t>(len));
+  return (std::sscanf(text.c_str(), "[%*2u:%*2u:%*2u.%*3u] Info: page %u", &n) ==
+          1)
+             ? n
+             : UINT32_MAX;
+}
+
+/**
+ * @brief   Read the whole ring, checking that page numbers increase by one.
+ * @return  Number of records read, or -1 on an ordering error (not checked
+ *          across a skipped record).
+ */
+long verify(FlashStore &store, std::uint32_t &last, std::uint32_t &bad) {
+  char buf[PAGE_SIZE];
+  long records = 0;
+  std::uint32_t prev = UINT32_MAX;
+  bad = 0U;
+  FlashStore::Cursor cursor = store.oldest();
+  for (;;) {
+    std::int32_t n = store.read(cursor, buf, sizeof(buf));
+    if (n == FlashStore::READ_END) {
+      break;
+    }
+    if (n < 0) {
+      bad++;
+      prev = UINT32_MAX; /* A skipped record may leave a gap */
+      continue;
+    }
+    std::uint32_t page = pageNumber(buf, n);
+    if (prev != UINT32_MAX && page != prev + 1U) {
+      std::printf("  order error: page %u after %u\n", page, prev);
+      return -1;
+    }
+    prev = page;
+    records++;
+  }
+  last = prev;
+  return records;
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  const char *path = (argc > 1) ? argv[1] : "flash_sim.img";
+  const std::uint32_t pages =
+      (argc > 2) ? static_cast<std::uint32_t>(std::atoi(argv[2])) : 5000U;
+  std::remove(path);
+  int failures = 0;
+  char page[PAGE_SIZE];
+
+  /* 1. Append throughput */
+  {
+    FileFlashPort port(path, SECTORS, SECTOR_SIZE);
+    if (!port.isOpen()) {
+      std::printf("cannot open %s\n", path);
+      return 1;
+    }
+    FlashStore store(port);
+    std::printf("mount (empty): %d\n", store.mount());
+    port.resetStats();
+    std::uint64_t bytes = 0U;
+    auto t0 = std::chrono::steady_clock::now();
+    for (std::uint32_t n = 0; n < pages; n++) {
+      std::uint32_t len = fillPage(page, n);
+      if (store.append(page, len) != FlashStore::FLASH_OK ||
+          (store.needsPrepare() && store.prepare() != FlashStore::FLASH_OK)) {
+        std::printf("append failed at page %u\n", n);
+        return 1;
+      }
+      bytes += len;
+    }
+    double hostUs = std::chrono::duration<double, std::micro>(
+                        std::chrono::steady_clock::now() - t0)
+                        .count();
+    const FileFlashPort::Stats &s = port.stats();
+    std::printf("append: %u pages, %llu bytes, %.2f us/page host, "
+                "%.0f us/page target program, %llu erases (%.2f s)\n",
+                pages, static_cast<unsigned long long>(bytes), hostUs / pages,
+                (s.programWords * FileFlashPort::WORD_PROGRAM_US) / pages,
+                static_cast<unsigned long long>(s.erases),
+                s.erases * FileFlashPort::SECTOR_ERASE_US / 1e6);
+    std::uint32_t minErase = 0U;
+    std::uint32_t maxErase = 0U;
+    store.eraseCounts(minErase, maxErase);
+    std::printf("wear: erase counts %u..%u, used %u of %u bytes\n", minErase,
+                maxErase, store.usedBytes(), store.capacity());
+    failures += expect(maxErase - minErase <= 1U, "uneven wear");
+  }
+
+  /* 2. Remount (headers only) and verify */
+  {
+    FileFlashPort port(path, SECTORS, SECTOR_SIZE);
+    FlashStore store(port);
+    auto t0 = std::chrono::steady_clock::now();
+    int status = store.mount();
+    double mountUs = std::chrono::duration<double, std::micro>(
+                         std::chrono::steady_clock::now() - t0)
+                         .count();
+    std::printf("remount: %d, %.1f us host, %llu bytes read\n", status,
+                mountUs,
+                static_cast<unsigned long long>(port.stats().readBytes));
+    std::uint32_t last = 0U;
+    std::uint32_t bad = 0U;
+    long records = verify(store, last, bad);
+    std::printf("verify: %ld records, last page %u, %u bad\n", records, last,
+                bad);
+    failures += expect(records > 0 && last == pages - 1U && bad == 0U,
+                       "records lost or damaged");
+
+    /* 3. Power cut in the middle of a record */
+    port.cutPowerAfter(FlashStore::RECORD_HEADER_SIZE / 4U + 10U);
+    std::uint32_t len = fillPage(page, pages);
+    std::printf("power cut append: %d\n", store.append(page, len));
+  }
+  {
+    FileFlashPort port(path, SECTORS, SECTOR_SIZE);
+    FlashStore store(port);
+    std::printf("remount after cut: %d\n", store.mount());
+    std::uint32_t len = fillPage(page, pages + 1U);
+    store.append(page, len);
+    std::uint32_t last = 0U;
+    std::uint32_t bad = 0U;
+    long records = verify(store, last, bad);
+    std::printf("verify: %ld records, last page %u, %u bad\n", records, last,
+                bad);
+    /* Only the torn record is lost */
+    failures += expect(bad == 1U && last == pages + 1U,
+                       "torn record not detected");
+  }
+  return summary(failures);
+}
+
+/** @} */ // end of Logger
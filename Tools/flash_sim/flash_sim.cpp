@@ -0,0 +1,113 @@
+/**
+ * @file    flash_sim.cpp
+ * @brief   File-backed NOR flash simulator for host builds of FlashStore.
+ * @author  Mitul Goti
+ * @version 1.0
+ * @date    2025-09-24
+ * @ingroup Logger
+ * @{
+ * @details
+ * The image is loaded into memory on construction and written back on
+ * destruction, so a second run (or a second FileFlashPort on the same path)
+ * sees what a reset target would see.
+ */
+
+#include "flash_sim.h"
+#include <cstring>
+
+/**
+ * @brief   Open an image file, creating an erased one if needed.
+ * @param   path  Image file path.
+ * @param   count Number of sectors.
+ * @param   size  Bytes per sector.
+ */
+FileFlashPort::FileFlashPort(const char *path, std::uint32_t count,
+                             std::uint32_t size)
+    : count(count), size(size),
+      image(static_cast<std::size_t>(count) * size, 0xFFU), erases(count, 0U) {
+  file = std::fopen(path, "r+b");
+  if (file != nullptr) {
+    if (std::fread(image.data(), 1, image.size(), file) != image.size()) {
+      std::fprintf(stderr, "flash_sim: short image %s, padding erased\n", path);
+    }
+  } else {
+    file = std::fopen(path, "w+b");
+  }
+}
+
+/**
+ * @brief   Write the image back and close the file.
+ */
+FileFlashPort::~FileFlashPort() {
+  if (file != nullptr) {
+    std::fseek(file, 0, SEEK_SET);
+    std::fwrite(image.data(), 1, image.size(), file);
+    std::fclose(file);
+  }
+}
+
+/**
+ * @brief   Read from the image.
+ * @return  true on success.
+ */
+bool FileFlashPort::read(std::uint32_t sector, std::uint32_t offset, void *buf,
+                         std::uint32_t len) {
+  if (sector >= count || offset + len > size) {
+    return false;
+  }
+  std::memcpy(buf, &image[static_cast<std::size_t>(sector) * size + offset],
+              len);
+  counters.readBytes += len;
+  return true;
+}
+
+/**
+ * @brief   Program words: bits can only go from 1 to 0.
+ * @return  true on success, false on bad arguments or after a power cut.
+ */
+bool FileFlashPort::program(std::uint32_t sector, std::uint32_t offset,
+                            const void *data, std::uint32_t len) {
+  if (sector >= count || offset + len > size || ((offset | len) & 3U) != 0U) {
+    return false;
+  }
+  const std::uint8_t *src = static_cast<const std::uint8_t *>(data);
+  std::uint8_t *dst = &image[static_cast<std::size_t>(sector) * size + offset];
+  for (std::uint32_t i = 0; i < len; i += 4U) {
+    if (powerBudget == 0U) {
+      return false; /* Power lost: remaining words stay erased */
+    }
+    powerBudget--;
+    for (std::uint32_t b = 0; b < 4U; b++) {
+      dst[i + b] &= src[i + b];
+    }
+    counters.programWords++;
+    counters.busyUs += WORD_PROGRAM_US;
+  }
+  return true;
+}
+
+/**
+ * @brief   Erase a sector to 0xFF.
+ * @return  true on success, false on bad arguments or after a power cut.
+ */
+bool FileFlashPort::erase(std::uint32_t sector) {
+  if (sector >= count || powerBudget == 0U) {
+    return false;
+  }
+  std::memset(&image[static_cast<std::size_t>(sector) * size], 0xFF, size);
+  erases[sector]++;
+  counters.erases++;
+  counters.busyUs += SECTOR_ERASE_US;
+  return true;
+}
+
+/**
+ * @brief   Erases performed on a sector by this instance.
+ * @param   sector Sector index.
+ * @return  Erase count since construction.
+ */
+std::uint32_t FileFlashPort::eraseCount(std::uint32_t sector) const {
+  return (sector < count) ? erases[sector] : 0U;
+}
+
+/** @} */ // end of Logger
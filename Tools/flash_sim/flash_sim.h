@@ -0,0 +1,71 @@
+/**
+ * @file    flash_sim.h
+ * @brief   File-backed NOR flash simulator for host builds of FlashStore.
+ * @author  Mitul Goti
+ * @version 1.0
+ * @date    2025-09-24
+ * @ingroup Logger
+ * @{
+ * @details
+ *   FileFlashPort implements FlashPort on an image file with NOR semantics:
+ *   program can only clear bits, erase sets a sector to 0xFF. It counts
+ *   operations, estimates the time they would take on an STM32F407 and can
+ *   cut power after a given number of programmed words.
+ */
+
+#ifndef FLASH_SIM_H
+#define FLASH_SIM_H
+
+#include <cstdint>
+#include <cstdio>
+#include <flash_port.h>
+#include <vector>
+
+/**
+ * @class   FileFlashPort
+ * @brief   FlashPort backed by an image file.
+ */
+class FileFlashPort : public FlashPort {
+public:
+  static constexpr double WORD_PROGRAM_US = 16.0; /*!< F407 typ. per word */
+  static constexpr double SECTOR_ERASE_US = 1000000.0; /*!< 128 KB typ. */
+
+  /** @brief Operation counters and estimated target time */
+  struct Stats {
+    std::uint64_t readBytes = 0U;   /*!< Bytes read */
+    std::uint64_t programWords = 0U; /*!< Words programmed */
+    std::uint64_t erases = 0U;      /*!< Sector erases */
+    double busyUs = 0.0;            /*!< Estimated program/erase time */
+  };
+
+  /** @brief Open (or create erased) an image of count x size bytes */
+  FileFlashPort(const char *path, std::uint32_t count, std::uint32_t size);
+  ~FileFlashPort() override; /*!< Write back and close the image */
+
+  std::uint32_t sectorCount() const override { return count; }
+  std::uint32_t sectorSize() const override { return size; }
+  bool read(std::uint32_t sector, std::uint32_t offset, void *buf,
+            std::uint32_t len) override;
+  bool program(std::uint32_t sector, std::uint32_t offset, const void *data,
+               std::uint32_t len) override;
+  bool erase(std::uint32_t sector) override;
+
+  /** @brief Fail every program/erase after n more programmed words */
+  void cutPowerAfter(std::uint64_t words) { powerBudget = words; }
+  std::uint32_t eraseCount(std::uint32_t sector) const; /*!< Per sector */
+  const Stats &stats() const { return counters; }       /*!< Counters */
+  void resetStats() { counters = Stats{}; }             /*!< Clear counters */
+  bool isOpen() const { return file != nullptr; }       /*!< Image usable */
+
+private:
+  std::FILE *file = nullptr;              /*!< Image file */
+  std::uint32_t count;                    /*!< Sectors */
+  std::uint32_t size;                     /*!< Bytes per sector */
+  std::vector<std::uint8_t> image;        /*!< Image contents */
+  std::vector<std::uint32_t> erases;      /*!< Erases per sector */
+  std::uint64_t powerBudget = UINT64_MAX; /*!< Words left before cut */
+  Stats counters;                         /*!< Operation counters */
+};
+
+#endif    // FLASH_SIM_H
+/** @} */ // end of Logger
@@ -0,0 +1,158 @@
+/**
+ * @file    raw_check.cpp
+ * @brief   Host self-check of RawStore wrap, remount and torn pages.
+ * @author  Mitul Goti
+ * @version 1.0
+ * @date    2025-10-16
+ * @ingroup Logger
+ * @{
+ * @details
+ * Built and run with the other host checks by `make -C Tools check`, or
+ * alone from the repository root:
+ * ```
+ * make -C Tools raw_check
+ * Tools/build/raw_check [image]
+ * ```
+ * Fills a small ring for several laps and remounts it, then cuts power
+ * while a page is opened (erased, header half programmed): once at the
+ * wrap to page 0 and once in the middle of the ring. Every remount must
+ * keep all records in order and continue appending behind the last one.
+ */
+
+#include "flash_sim.h"
+#include "host_check.h"
+#include "raw_store.h"
+#include <cstdint>
+#include <cstdio>
+
+namespace {
+constexpr std::uint32_t PAGES = 8U;       /*!< Pages in the ring */
+constexpr std::uint32_t PAGE_SIZE = 512U; /*!< Bytes per page */
+constexpr std::uint32_t RECORD_LEN = 20U; /*!< "record 00000000000\r\n" */
+/** Records that fill one page: (512 - 12) / (8 + 20) */
+constexpr std::uint32_t PER_PAGE =
+    (PAGE_SIZE - RawStore::PAGE_HEADER_SIZE) /
+    (RawStore::RECORD_HEADER_SIZE + RECORD_LEN);
+
+/** @brief Append record number n. */
+RawStore::RawStatus appendRecord(RawStore &store, std::uint32_t n) {
+  char text[RECORD_LEN + 1U];
+  std::snprintf(text, sizeof(text), "record %011u\r\n", n);
+  return store.append(text, RECORD_LEN);
+}
+
+/** @brief Result of reading the whole ring */
+struct Scan {
+  std::uint32_t records = 0U; /*!< Records read */
+  std::uint32_t first = 0U;   /*!< Number of the oldest record */
+  std::uint32_t last = 0U;    /*!< Number of the newest record */
+  std::uint32_t bad = 0U;     /*!< CRC errors and out-of-order records */
+};
+
+/** @brief Read every record from the oldest one. */
+Scan scan(RawStore &store) {
+  Scan s;
+  RawStore::Cursor c = store.oldest();
+  char buf[64];
+  std::int32_t n;
+  while ((n = store.read(c, buf, sizeof(buf) - 1U)) != RawStore::READ_END) {
+    unsigned number = 0U;
+    buf[n > 0 ? n : 0] = '\0';
+    if (n < 0 || std::sscanf(buf, "record %u", &number) != 1 ||
+        (s.records > 0U && number != s.last + 1U)) {
+      s.bad++;
+      continue;
+    }
+    s.first = (s.records == 0U) ? number : s.first;
+    s.last = number;
+    s.records++;
+  }
+  return s;
+}
+
+/**
+ * @brief   Cut power while the next page is opened, then remount.
+ * @details Appends until the head is the page before target and full, then
+ *          lets the next append erase target and program one header word.
+ * @param   path   Image file.
+ * @param   target Page whose opening is torn.
+ * @param   next   Number of the next record to append (updated).
+ * @return  Failures.
+ */
+int tornOpen(const char *path, std::uint32_t target, std::uint32_t &next) {
+  int failures = 0;
+  {
+    FileFlashPort port(path, PAGES, PAGE_SIZE);
+    RawStore store(port);
+    failures += expect(store.mount() == RawStore::RAW_OK, "mount before cut");
+    const std::uint32_t before = (target + PAGES - 1U) % PAGES;
+    /* The head page is (seq - 1) % PAGES; its first record opened it */
+    while ((store.headSeq() - 1U) % PAGES != before) {
+      appendRecord(store, next++);
+    }
+    for (std::uint32_t i = 1U; i < PER_PAGE; i++) {
+      appendRecord(store, next++);
+    }
+    port.cutPowerAfter(1U); /* Erase works, the header is torn */
+    failures += expect(appendRecord(store, next) == RawStore::RAW_PORT_ERROR,
+                       "append across the cut fails");
+  }
+  FileFlashPort port(path, PAGES, PAGE_SIZE);
+  RawStore store(port);
+  failures += expect(store.mount() == RawStore::RAW_OK,
+                     "remount after a torn page keeps the ring");
+  Scan s = scan(store);
+  failures += expect(s.bad == 0U && s.last == next - 1U,
+                     "records up to the cut survive in order");
+  failures += expect(s.records >= (PAGES - 2U) * PER_PAGE,
+                     "only the torn page is lost");
+  failures += expect(appendRecord(store, next++) == RawStore::RAW_OK &&
+                         (store.headSeq() - 1U) % PAGES == target,
+                     "next append reopens the torn page");
+  s = scan(store);
+  failures += expect(s.bad == 0U && s.last == next - 1U,
+                     "append continues behind the last record");
+  return failures;
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  const char *path = (argc > 1) ? argv[1] : "raw_sim.img";
+  std::remove(path);
+  int failures = 0;
+  std::uint32_t next = 0U;
+
+  /* 1. Blank partition, several laps, remount */
+  {
+    FileFlashPort port(path, PAGES, PAGE_SIZE);
+    if (!port.isOpen()) {
+      std::printf("cannot open %s\n", path);
+      return 1;
+    }
+    RawStore store(port);
+    failures += expect(store.mount() == RawStore::RAW_FORMATTED,
+                       "blank partition is formatted");
+    while (store.headSeq() < 3U * PAGES + 3U) {
+      appendRecord(store, next++);
+    }
+  }
+  {
+    FileFlashPort port(path, PAGES, PAGE_SIZE);
+    RawStore store(port);
+    failures += expect(store.mount() == RawStore::RAW_OK, "remount");
+    failures += expect(store.headSeq() == 3U * PAGES + 3U, "head found");
+    const Scan s = scan(store);
+    failures += expect(s.bad == 0U && s.last == next - 1U,
+                       "records in order up to the last");
+    failures += expect(s.records > (PAGES - 1U) * PER_PAGE,
+                       "a full ring is kept after the wrap");
+  }
+
+  /* 2. Torn header at the wrap to page 0, then in the middle */
+  failures += tornOpen(path, 0U, next);
+  failures += tornOpen(path, 5U, next);
+
+  return summary(failures);
+}
+
+/** @} */ // end of Logger
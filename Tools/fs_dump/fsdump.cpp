@@ -0,0 +1,320 @@
+/**
+ * @file    fsdump.cpp
+ * @brief   Host tool: fetch the raw R0: volume image with `fs dump`.
+ * @author  Mitul Goti
+ * @version 1.0
+ * @date    2025-09-30
+ * @ingroup Logger
+ * @{
+ * @details
+ * Build and run on Linux from the repository root:
+ * ```
+ * g++ -std=c++17 -O2 -IApplication/Inc Tools/fs_dump/fsdump.cpp \
+ *     Application/Src/flash_store.cpp -o fsdump
+ * ./fsdump /dev/ttyACM0 r0.img [offset]   # live, resumes on its own
+ * ./fsdump --capture dump.bin r0.img      # parse a captured stream
+ * sudo mount -o loop,ro r0.img /mnt       # FAT volume as formatted by fformat
+ * ```
+ * Blocks are checked against their CRC-32; missing or damaged blocks are
+ * requested again from the first missing offset. With an offset, bytes
+ * before it are taken from the existing image file (resume across runs).
+ * Log text the firmware sends between blocks is copied to stderr.
+ */
+
+#include "flash_store.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <string>
+#include <termios.h>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+constexpr std::uint32_t DUMP_MAGIC = 0x42445346U; /*!< FsLog::FS_DUMP_MAGIC */
+constexpr std::uint32_t HEADER_SIZE = 16U; /*!< FsLog::DumpBlockHeader */
+constexpr std::uint32_t MAX_BLOCK = 4096U; /*!< Sanity limit for a block */
+constexpr int IDLE_MS = 2000;              /*!< Silence that ends a round */
+constexpr int ROUNDS = 8;                  /*!< Requests before giving up */
+
+/**
+ * @class   DumpParser
+ * @brief   Splits the CDC byte stream into dump blocks and text lines.
+ */
+class DumpParser {
+public:
+  std::vector<std::uint8_t> image; /*!< Assembled image */
+  std::vector<bool> have;          /*!< Per byte: received and checked */
+  bool ended = false;              /*!< Trailer seen */
+  std::uint32_t imageCrc = 0U;     /*!< CRC-32 reported in the trailer */
+  std::uint32_t writes = 0U;       /*!< FS writes during the dump */
+  std::uint32_t badBlocks = 0U;    /*!< Blocks with a CRC mismatch */
+
+  /** @brief Feed received bytes */
+  void feed(const std::uint8_t *data, std::size_t len) {
+    buf.insert(buf.end(), data, data + len);
+    for (;;) {
+      std::size_t magic = findMagic();
+      std::size_t nl = 0U;
+      while (nl < magic && buf[nl] != '\n') {
+        nl++;
+      }
+      if (nl < magic) {
+        textLine(std::string(buf.begin(), buf.begin() + nl + 1U));
+        buf.erase(buf.begin(), buf.begin() + nl + 1U);
+        continue;
+      }
+      if (magic == buf.size()) {
+        return; /* Partial text line: wait for more */
+      }
+      if (magic > 0U) {
+        textLine(std::string(buf.begin(), buf.begin() + magic));
+        buf.erase(buf.begin(), buf.begin() + magic);
+      }
+      if (buf.size() < HEADER_SIZE) {
+        return;
+      }
+      const std::uint32_t offset = u32(4U);
+      const std::uint32_t length = u32(8U);
+      if (length == 0U || length > MAX_BLOCK) {
+        buf.erase(buf.begin()); /* Not a header after all */
+        continue;
+      }
+      if (buf.size() < HEADER_SIZE + length) {
+        return;
+      }
+      const std::uint8_t *data = buf.data() + HEADER_SIZE;
+      if (FlashStore::crc32(data, length) != u32(12U) ||
+          (!image.empty() && offset + length > image.size())) {
+        badBlocks++; /* Dropped, fetched again by the next round */
+        buf.erase(buf.begin(), buf.begin() + HEADER_SIZE + length);
+        continue;
+      }
+      if (image.size() < offset + length) {
+        resize(offset + length);
+      }
+      std::memcpy(&image[offset], data, length);
+      std::fill(have.begin() + offset, have.begin() + offset + length, true);
+      buf.erase(buf.begin(), buf.begin() + HEADER_SIZE + length);
+    }
+  }
+
+  /** @brief Resize the image, keeping what was received */
+  void resize(std::size_t size) {
+    image.resize(size, 0U);
+    have.resize(size, false);
+  }
+
+  /** @brief First offset not received yet, image size if complete */
+  std::uint32_t firstMissing() const {
+    std::size_t i = 0U;
+    while (i < have.size() && have[i]) {
+      i++;
+    }
+    return static_cast<std::uint32_t>(i);
+  }
+
+private:
+  std::vector<std::uint8_t> buf; /*!< Unparsed bytes */
+
+  std::uint32_t u32(std::size_t i) const {
+    return buf[i] | (buf[i + 1U] << 8) | (buf[i + 2U] << 16) |
+           (static_cast<std::uint32_t>(buf[i + 3U]) << 24);
+  }
+
+  std::size_t findMagic() const {
+    for (std::size_t i = 0; i + 4U <= buf.size(); i++) {
+      if (u32(i) == DUMP_MAGIC) {
+        return i;
+      }
+    }
+    /* Hold back a tail that may be the start of a magic */
+    static const char head[] = "FSDB";
+    std::size_t keep = std::min<std::size_t>(buf.size(), 3U);
+    while (keep > 0U &&
+           std::memcmp(buf.data() + buf.size() - keep, head, keep) != 0) {
+      keep--;
+    }
+    return buf.size() - keep;
+  }
+
+  void textLine(const std::string &line) {
+    unsigned size = 0U;
+    unsigned from = 0U;
+    unsigned block = 0U;
+    unsigned crc = 0U;
+    unsigned n = 0U;
+    if (std::sscanf(line.c_str(),
+                    "Reply: Dump R0: %u bytes from %u, %u-byte blocks.", &size,
+                    &from, &block) == 3) {
+      if (image.size() != size) {
+        resize(size);
+      }
+    } else if (std::sscanf(line.c_str(),
+                           "Reply: Dump end, image crc 0x%X, %u writes",
+                           &crc, &n) == 2) {
+      ended = true;
+      imageCrc = crc;
+      writes = n;
+    }
+    std::fputs(line.c_str(), stderr);
+  }
+};
+
+/**
+ * @brief   Open a CDC tty in raw mode.
+ * @return  File descriptor or -1.
+ */
+int openTty(const char *path) {
+  int fd = open(path, O_RDWR | O_NOCTTY);
+  if (fd < 0) {
+    std::perror(path);
+    return -1;
+  }
+  termios tio;
+  if (tcgetattr(fd, &tio) == 0) {
+    cfmakeraw(&tio);
+    tcsetattr(fd, TCSANOW, &tio);
+  }
+  tcflush(fd, TCIOFLUSH);
+  return fd;
+}
+
+/**
+ * @brief   Request a dump from offset and read until the trailer or silence.
+ */
+void dumpRound(int fd, DumpParser &parser, std::uint32_t offset) {
+  char cmd[32];
+  int n = std::snprintf(cmd, sizeof(cmd), "fs dump %u", offset);
+  if (write(fd, cmd, n) != n) { /* One packet, no line ending */
+    std::perror("write");
+    return;
+  }
+  parser.ended = false;
+  std::uint8_t buf[4096];
+  pollfd p = {fd, POLLIN, 0};
+  while (!parser.ended && poll(&p, 1, IDLE_MS) > 0) {
+    ssize_t r = read(fd, buf, sizeof(buf));
+    if (r <= 0) {
+      break;
+    }
+    parser.feed(buf, static_cast<std::size_t>(r));
+  }
+}
+
+/**
+ * @brief   Write the image file.
+ */
+bool writeImage(const char *path, const std::vector<std::uint8_t> &image) {
+  FILE *f = std::fopen(path, "wb");
+  if (f == nullptr ||
+      std::fwrite(image.data(), 1, image.size(), f) != image.size()) {
+    std::perror(path);
+    if (f != nullptr) {
+      std::fclose(f);
+    }
+    return false;
+  }
+  std::fclose(f);
+  return true;
+}
+
+/**
+ * @brief   Report completeness and CRC of the assembled image.
+ * @return  Process exit code.
+ */
+int finish(const DumpParser &parser, const char *path) {
+  const std::uint32_t missing = parser.firstMissing();
+  if (parser.image.empty() || missing < parser.image.size()) {
+    std::fprintf(stderr, "fsdump: incomplete image, first gap at %u\n",
+                 static_cast<unsigned>(missing));
+    return 1;
+  }
+  const std::uint32_t crc =
+      FlashStore::crc32(parser.image.data(), parser.image.size());
+  const bool match = parser.ended && crc == parser.imageCrc;
+  std::fprintf(stderr, "fsdump: %zu bytes, crc 0x%08X %s, %u bad blocks\n",
+               parser.image.size(), static_cast<unsigned>(crc),
+               match ? "matches the device"
+                     : "differs from the device (volume changed)",
+               static_cast<unsigned>(parser.badBlocks));
+  if (!writeImage(path, parser.image)) {
+    return 1;
+  }
+  return match ? 0 : 3;
+}
+} // namespace
+
+/**
+ * @brief   Entry point, see the file header for usage.
+ */
+int main(int argc, char **argv) {
+  DumpParser parser;
+  if (argc >= 4 && std::strcmp(argv[1], "--capture") == 0) {
+    FILE *f = std::fopen(argv[2], "rb");
+    if (f == nullptr) {
+      std::perror(argv[2]);
+      return 1;
+    }
+    std::uint8_t buf[4096];
+    std::size_t n;
+    while ((n = std::fread(buf, 1, sizeof(buf), f)) > 0) {
+      parser.feed(buf, n);
+    }
+    std::fclose(f);
+    return finish(parser, argv[3]);
+  }
+  if (argc < 3) {
+    std::fprintf(stderr, "usage: fsdump <tty> <image> [offset] | "
+                         "--capture <stream> <image>\n");
+    return 2;
+  }
+
+  std::uint32_t offset = (argc >= 4) ? std::strtoul(argv[3], nullptr, 0) : 0U;
+  if (offset > 0U) {
+    /* Resume: bytes before offset come from the previous image */
+    FILE *f = std::fopen(argv[2], "rb");
+    std::uint8_t buf[4096];
+    std::size_t n;
+    std::uint32_t pos = 0U;
+    while (f != nullptr && pos < offset &&
+           (n = std::fread(buf, 1, sizeof(buf), f)) > 0) {
+      n = std::min<std::size_t>(n, offset - pos);
+      parser.resize(pos + n);
+      std::memcpy(&parser.image[pos], buf, n);
+      std::fill(parser.have.begin() + pos, parser.have.end(), true);
+      pos += n;
+    }
+    if (f != nullptr) {
+      std::fclose(f);
+    }
+    offset = pos; /* Whatever the old image did not have is fetched */
+  }
+
+  int fd = openTty(argv[1]);
+  if (fd < 0) {
+    return 1;
+  }
+  for (int round = 0; round < ROUNDS; round++) {
+    dumpRound(fd, parser, offset);
+    offset = parser.firstMissing();
+    if (!parser.image.empty() && offset >= parser.image.size()) {
+      if (parser.writes == 0U || round + 1 == ROUNDS) {
+        break;
+      }
+      /* Volume written meanwhile: fetch a quiet copy */
+      std::fprintf(stderr, "fsdump: %u writes during dump, again\n",
+                   static_cast<unsigned>(parser.writes));
+      std::fill(parser.have.begin(), parser.have.end(), false);
+      offset = 0U;
+    }
+  }
+  close(fd);
+  return finish(parser, argv[2]);
+}
+
+/** @} */ // end of Logger
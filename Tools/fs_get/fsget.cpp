@@ -0,0 +1,292 @@
+/**
+ * @file    fsget.cpp
+ * @brief   Host tool: fetch the FS log with the acknowledged replay.
+ * @author  Mitul Goti
+ * @version 1.0
+ * @date    2025-10-01
+ * @ingroup Logger
+ * @{
+ * @details
+ * Build and run on Linux from the repository root:
+ * ```
+ * g++ -std=c++17 -O2 -IApplication/Inc Tools/fs_get/fsget.cpp \
+ *     Application/Src/flash_store.cpp -o fsget
+ * ./fsget /dev/ttyACM0 log.txt          # fetch, or continue an earlier run
+ * ./fsget /dev/ttyACM0 log.txt restart  # fetch from the start of the file
+ * ```
+ * Runs `fsLog get <pos>` and acknowledges every in-order chunk with a valid
+ * CRC (`fsLog ack <seq>`). Text is appended to the output file and the
+ * position after it is saved in `<output>.pos`, so a run that was cut off
+ * (cable pulled, device reset, hub reset) continues where the host stopped
+ * receiving. The tty is reopened when it disappears. Other text the
+ * firmware sends goes to stderr.
+ */
+
+#include "flash_store.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <string>
+#include <termios.h>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+constexpr std::uint32_t CHUNK_MAGIC = 0x43525346U; /*!< FS_CHUNK_MAGIC */
+constexpr std::uint32_t HEADER_SIZE = 20U; /*!< FsLog::ReplayChunkHeader */
+constexpr std::uint32_t MAX_CHUNK = 1024U; /*!< Sanity limit for a chunk */
+constexpr std::uint32_t ACK_EVERY = 4U;    /*!< Chunks per acknowledgement */
+constexpr int POLL_MS = 100;               /*!< Idle time before an ack */
+constexpr int SILENT_MS = 10000;           /*!< Silence that ends a session */
+constexpr int SESSIONS = 20;               /*!< Reconnects before giving up */
+
+/**
+ * @class   Session
+ * @brief   Receives one `fsLog get` run: chunks, acks and text lines.
+ */
+class Session {
+public:
+  Session(int fd, FILE *out, const std::string &posPath, std::uint32_t pos)
+      : pos(pos), fd(fd), out(out), posPath(posPath) {}
+
+  std::uint32_t pos;   /*!< Position after the last text written */
+  bool synced = false; /*!< Device reported the whole file sent */
+  bool ended = false;  /*!< Device ended the session (synced or paused) */
+
+  /** @brief Feed received bytes */
+  void feed(const std::uint8_t *data, std::size_t len) {
+    buf.insert(buf.end(), data, data + len);
+    for (;;) {
+      std::size_t magic = findMagic();
+      std::size_t nl = 0U;
+      while (nl < magic && buf[nl] != '\n') {
+        nl++;
+      }
+      if (nl < magic) {
+        textLine(std::string(buf.begin(), buf.begin() + nl + 1U));
+        buf.erase(buf.begin(), buf.begin() + nl + 1U);
+        continue;
+      }
+      if (magic == buf.size()) {
+        return; /* Partial text line: wait for more */
+      }
+      if (magic > 0U) {
+        textLine(std::string(buf.begin(), buf.begin() + magic));
+        buf.erase(buf.begin(), buf.begin() + magic);
+      }
+      if (buf.size() < HEADER_SIZE) {
+        return;
+      }
+      const std::uint32_t length = u32(12U);
+      if (length == 0U || length > MAX_CHUNK) {
+        buf.erase(buf.begin()); /* Not a header after all */
+        continue;
+      }
+      if (buf.size() < HEADER_SIZE + length) {
+        return;
+      }
+      chunk(u32(4U), u32(8U), buf.data() + HEADER_SIZE, length, u32(16U));
+      buf.erase(buf.begin(), buf.begin() + HEADER_SIZE + length);
+    }
+  }
+
+  /** @brief Acknowledge what arrived since the last ack */
+  void idle() {
+    if (started && acked != expect) {
+      ack();
+    }
+  }
+
+private:
+  int fd;                        /*!< tty */
+  FILE *out;                     /*!< Output text file */
+  std::string posPath;           /*!< Position file */
+  std::vector<std::uint8_t> buf; /*!< Unparsed bytes */
+  bool started = false;          /*!< Start line seen */
+  std::uint32_t expect = 0U;     /*!< Next sequence number wanted */
+  std::uint32_t acked = 0U;      /*!< Last sequence number acknowledged */
+
+  std::uint32_t u32(std::size_t i) const {
+    return buf[i] | (buf[i + 1U] << 8) | (buf[i + 2U] << 16) |
+           (static_cast<std::uint32_t>(buf[i + 3U]) << 24);
+  }
+
+  std::size_t findMagic() const {
+    for (std::size_t i = 0; i + 4U <= buf.size(); i++) {
+      if (u32(i) == CHUNK_MAGIC) {
+        return i;
+      }
+    }
+    /* Hold back a tail that may be the start of a magic */
+    static const char head[] = "FSRC";
+    std::size_t keep = std::min<std::size_t>(buf.size(), 3U);
+    while (keep > 0U &&
+           std::memcmp(buf.data() + buf.size() - keep, head, keep) != 0) {
+      keep--;
+    }
+    return buf.size() - keep;
+  }
+
+  void chunk(std::uint32_t seq, std::uint32_t next, const std::uint8_t *data,
+             std::uint32_t len, std::uint32_t crc) {
+    if (!started || seq != expect || FlashStore::crc32(data, len) != crc) {
+      if (started && seq != expect) {
+        ack(); /* Gap or repeat: tell the device where we are */
+      }
+      return; /* The device resends after its timeout */
+    }
+    std::fwrite(data, 1, len, out);
+    std::fflush(out);
+    pos = next;
+    savePos();
+    expect++;
+    if (expect - acked >= ACK_EVERY) {
+      ack();
+    }
+  }
+
+  void ack() {
+    char cmd[32];
+    int n = std::snprintf(cmd, sizeof(cmd), "fsLog ack %u", expect);
+    if (write(fd, cmd, n) == n) { /* One packet, no line ending */
+      acked = expect;
+    }
+  }
+
+  void savePos() {
+    FILE *f = std::fopen(posPath.c_str(), "w");
+    if (f != nullptr) {
+      std::fprintf(f, "0x%X\n", pos);
+      std::fclose(f);
+    }
+  }
+
+  void textLine(const std::string &line) {
+    unsigned window = 0U;
+    unsigned from = 0U;
+    unsigned seq = 0U;
+    unsigned end = 0U;
+    if (std::sscanf(line.c_str(), "Reply: Replay window %u from 0x%X, seq %u",
+                    &window, &from, &seq) == 3) {
+      started = true;
+      expect = seq;
+      acked = seq;
+    } else if (std::sscanf(line.c_str(), "Reply: Replay synced to 0x%X",
+                           &end) == 1) {
+      synced = true;
+      ended = true;
+    } else if (std::strncmp(line.c_str(), "Reply: Replay paused", 20) == 0 ||
+               std::strncmp(line.c_str(), "Reply: Replay stopped", 21) == 0) {
+      ended = true;
+    }
+    std::fputs(line.c_str(), stderr);
+  }
+};
+
+/**
+ * @brief   Open a CDC tty in raw mode.
+ * @return  File descriptor or -1.
+ */
+int openTty(const char *path) {
+  int fd = open(path, O_RDWR | O_NOCTTY);
+  if (fd < 0) {
+    return -1;
+  }
+  termios tio;
+  if (tcgetattr(fd, &tio) == 0) {
+    cfmakeraw(&tio);
+    tcsetattr(fd, TCSANOW, &tio);
+  }
+  tcflush(fd, TCIOFLUSH);
+  return fd;
+}
+
+/**
+ * @brief   Read the saved position of an earlier run.
+ * @return  Position, 0 if there is none.
+ */
+std::uint32_t loadPos(const std::string &path) {
+  FILE *f = std::fopen(path.c_str(), "r");
+  char line[16] = "";
+  if (f != nullptr) {
+    if (std::fgets(line, sizeof(line), f) == nullptr) {
+      line[0] = '\0';
+    }
+    std::fclose(f);
+  }
+  return std::strtoul(line, nullptr, 0);
+}
+} // namespace
+
+/**
+ * @brief   Entry point, see the file header for usage.
+ */
+int main(int argc, char **argv) {
+  if (argc < 3) {
+    std::fprintf(stderr, "usage: fsget <tty> <output> [restart]\n");
+    return 2;
+  }
+  const std::string posPath = std::string(argv[2]) + ".pos";
+  const bool restart = argc >= 4 && std::strcmp(argv[3], "restart") == 0;
+  std::uint32_t pos = restart ? 0U : loadPos(posPath);
+  FILE *out = std::fopen(argv[2], (pos == 0U) ? "wb" : "ab");
+  if (out == nullptr) {
+    std::perror(argv[2]);
+    return 1;
+  }
+
+  for (int session = 0; session < SESSIONS; session++) {
+    int fd = openTty(argv[1]);
+    if (fd < 0) {
+      sleep(1); /* Unplugged or re-enumerating */
+      continue;
+    }
+    char cmd[32];
+    int n = std::snprintf(cmd, sizeof(cmd), "fsLog get 0x%X", pos);
+    if (write(fd, cmd, n) != n) {
+      close(fd);
+      continue;
+    }
+    Session s(fd, out, posPath, pos);
+    std::uint8_t buf[4096];
+    pollfd p = {fd, POLLIN, 0};
+    int silent = 0;
+    while (!s.ended && silent < SILENT_MS) {
+      int r = poll(&p, 1, POLL_MS);
+      if (r < 0 || (r > 0 && (p.revents & (POLLERR | POLLHUP)) != 0)) {
+        break; /* tty gone */
+      }
+      if (r == 0) {
+        s.idle();
+        silent += POLL_MS;
+        continue;
+      }
+      ssize_t len = read(fd, buf, sizeof(buf));
+      if (len <= 0) {
+        break;
+      }
+      silent = 0;
+      s.feed(buf, static_cast<std::size_t>(len));
+    }
+    s.idle();
+    close(fd);
+    pos = s.pos;
+    if (s.synced) {
+      std::fclose(out);
+      std::fprintf(stderr, "fsget: synced, position 0x%X\n", pos);
+      return 0;
+    }
+    std::fprintf(stderr, "fsget: interrupted at 0x%X, reconnecting\n", pos);
+    sleep(1);
+  }
+  std::fclose(out);
+  std::fprintf(stderr, "fsget: giving up at 0x%X, run again to resume\n",
+               pos);
+  return 1;
+}
+
+/** @} */ // end of Logger
@@ -0,0 +1,131 @@
+/**
+ * @file    gpio_check.cpp
+ * @brief   Host self-check of GpioPin, GpioGroup and GpioBatch.
+ * @author  Mitul Goti
+ * @version 1.0
+ * @date    2025-10-12
+ * @ingroup led
+ * @{
+ * @details
+ * Built and run with the other host checks by `make -C Tools check`, or
+ * alone from the repository root:
+ * ```
+ * make -C Tools gpio_check
+ * Tools/build/gpio_check
+ * ```
+ * Builds the pin templates and GpioBatch against a mock register file
+ * that counts BSRR stores, and checks the port and bit resolution, the
+ * output latch after every operation, that group and batch updates take
+ * one store per port, and that pins outside an update keep their state.
+ */
+
+#include "gpio_pin.h"
+#include "host_check.h"
+#include "stm32f4xx.h"
+#include <cstdint>
+#include <cstdio>
+
+GPIO_TypeDef mockGpio[9];
+
+namespace {
+using Green = GpioPin<60U>;  /*!< PD12 */
+using Orange = GpioPin<61U>; /*!< PD13 */
+using Red = GpioPin<62U>;    /*!< PD14 */
+using Blue = GpioPin<63U>;   /*!< PD15 */
+using Button = GpioPin<0U>;  /*!< PA0 */
+using BoardLeds = GpioGroup<Green, Orange, Red, Blue>;
+
+/* Resolved at compile time */
+static_assert(Green::PORT == 3U && Green::MASK == (1U << 12), "PD12");
+static_assert(GpioPin<143U>::PORT == 8U && GpioPin<143U>::MASK == 0x8000U,
+              "PI15");
+static_assert(BoardLeds::PORT == 3U && BoardLeds::MASK == 0xF000U, "group");
+/* Does not compile, as intended:
+ *   GpioPin<144U>                       no such port
+ *   GpioGroup<Green, Button>            two ports
+ *   GpioGroup<Green, Green>             pin listed twice
+ */
+
+/** @brief BSRR stores to GPIOD since the last call. */
+std::uint32_t storesD() {
+  static std::uint32_t seen = 0U;
+  const std::uint32_t n = GPIOD->BSRR.stores - seen;
+  seen = GPIOD->BSRR.stores;
+  return n;
+}
+} // namespace
+
+int main() {
+  int failures = 0;
+  GPIOD->ODR = 0x0A5AU; /* Other PD pins must survive every LED update */
+
+  /* 1. Single pins */
+  Green::set();
+  failures += expect(GPIOD->ODR == 0x1A5AU && storesD() == 1U, "set");
+  Blue::write(true);
+  Green::clear();
+  failures += expect(GPIOD->ODR == 0x8A5AU && storesD() == 2U, "clear");
+  Blue::toggle();
+  Red::toggle();
+  failures += expect(GPIOD->ODR == 0x4A5AU && storesD() == 2U, "toggle");
+  failures += expect(Red::isSet() && !Blue::isSet(), "latch");
+  GPIOA->IDR = 1U;
+  failures += expect(Button::read() && GPIOA->BSRR.stores == 0U, "input");
+
+  /* 2. Group: every LED in one store, in group bit order */
+  BoardLeds::write(0b0101U); /* Green and red on */
+  failures += expect(GPIOD->ODR == 0x5A5AU && storesD() == 1U,
+                     "group write");
+  failures += expect(GPIOD->BSRR.last == 0xA0005000U, "set and reset bits");
+  failures += expect(BoardLeds::isSet() == 0b0101U, "group latch");
+  BoardLeds::toggle();
+  failures += expect(GPIOD->ODR == 0xAA5AU && storesD() == 1U,
+                     "group toggle");
+  BoardLeds::set();
+  failures += expect(GPIOD->ODR == 0xFA5AU && storesD() == 1U, "group set");
+  BoardLeds::clear();
+  failures += expect(GPIOD->ODR == 0x0A5AU && storesD() == 1U,
+                     "group clear");
+  GPIOD->IDR = 0x8000U;
+  failures += expect(BoardLeds::read() == 0b1000U, "group input");
+
+  /* 3. Run-time batch: one store per port, latest change of a pin wins */
+  GpioBatch batch;
+  failures += expect(batch.empty() && gpioPort(3U) == GPIOD &&
+                         gpioPort(9U) == nullptr,
+                     "run-time port lookup");
+  failures += expect(!batch.write(144U, true), "pin beyond GPIOI");
+  batch.write(60U, true);
+  batch.write(61U, true);
+  batch.write(61U, false); /* Replaces the earlier change */
+  batch.write(63U, true);
+  batch.write(1U, true); /* PA1 */
+  failures += expect(GPIOD->ODR == 0x0A5AU && storesD() == 0U,
+                     "nothing before commit");
+  const std::uint32_t storesA = GPIOA->BSRR.stores;
+  batch.commit();
+  failures += expect(GPIOD->ODR == 0x9A5AU && storesD() == 1U,
+                     "batch, one store on GPIOD");
+  failures += expect(GPIOD->BSRR.last == 0x20009000U, "batch bits");
+  failures += expect(GPIOA->ODR == 0x0002U &&
+                         GPIOA->BSRR.stores == storesA + 1U,
+                     "batch, one store on GPIOA");
+  failures += expect(batch.empty(), "batch cleared");
+  batch.commit();
+  failures += expect(storesD() == 0U, "empty commit stores nothing");
+
+  /* 4. One pin by number, as Led drives it */
+  failures += expect(gpioWrite(62U, true) && GPIOD->ODR == 0xDA5AU &&
+                         storesD() == 1U && GPIOD->BSRR.last == 0x4000U,
+                     "gpioWrite high, one store");
+  failures += expect(gpioIsSet(62U) && !gpioIsSet(61U), "gpioIsSet");
+  failures += expect(gpioWrite(63U, false) && GPIOD->ODR == 0x5A5AU &&
+                         GPIOD->BSRR.last == 0x80000000U,
+                     "gpioWrite low");
+  failures += expect(!gpioWrite(144U, true) && !gpioIsSet(144U),
+                     "gpioWrite beyond GPIOI");
+
+  return summary(failures);
+}
+
+/** @} */ // end of led
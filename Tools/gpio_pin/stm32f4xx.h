@@ -0,0 +1,61 @@
+/**
+ * @file    stm32f4xx.h
+ * @brief   Mock GPIO register file for building gpio_pin on the host.
+ * @author  Mitul Goti
+ * @version 1.0
+ * @date    2025-10-12
+ * @ingroup led
+ * @{
+ * @details
+ *   Stands in for the device header when gpio_pin.h and gpio_pin.cpp are
+ *   built for Tools/gpio_pin. GPIOA..GPIOI are plain structs in RAM with
+ *   the RM0090 register layout, except BSRR: a store to it applies the
+ *   set/reset semantics to ODR (set wins) and is counted, so the check can
+ *   see how many stores an operation took.
+ */
+
+#ifndef MOCK_STM32F4XX_H
+#define MOCK_STM32F4XX_H
+
+#include <cstdint>
+
+/** Write-only bit set/reset register acting on ODR */
+class MockBsrr {
+public:
+  explicit MockBsrr(volatile uint32_t *odr) : odr(odr) {}
+  MockBsrr &operator=(uint32_t value) {
+    *odr = (*odr & ~(value >> 16)) | (value & 0xFFFFU);
+    last = value;
+    stores++;
+    return *this;
+  }
+  uint32_t last = 0U;   ///< Value of the latest store
+  uint32_t stores = 0U; ///< Stores so far
+
+private:
+  volatile uint32_t *odr;
+};
+
+/** GPIO port register block (RM0090 8.4) */
+struct GPIO_TypeDef {
+  volatile uint32_t MODER = 0U, OTYPER = 0U, OSPEEDR = 0U, PUPDR = 0U,
+                    IDR = 0U, ODR = 0U;
+  MockBsrr BSRR{&ODR};
+  volatile uint32_t LCKR = 0U;
+  volatile uint32_t AFR[2] = {0U, 0U};
+};
+
+extern GPIO_TypeDef mockGpio[9]; ///< GPIOA..GPIOI, defined by the test
+
+#define GPIOA (&mockGpio[0])
+#define GPIOB (&mockGpio[1])
+#define GPIOC (&mockGpio[2])
+#define GPIOD (&mockGpio[3])
+#define GPIOE (&mockGpio[4])
+#define GPIOF (&mockGpio[5])
+#define GPIOG (&mockGpio[6])
+#define GPIOH (&mockGpio[7])
+#define GPIOI (&mockGpio[8])
+
+#endif // MOCK_STM32F4XX_H
+/** @} */ // end of led
@@ -0,0 +1,53 @@
+/**
+ * @file    host_check.h
+ * @brief   Helpers shared by the host self-checks under Tools/.
+ * @author  Mitul Goti
+ * @version 1.0
+ * @date    2025-10-17
+ * @{
+ * @details
+ *   Every host check is a small program that builds the firmware module it
+ *   tests with the host compiler (and a mock header where the module needs
+ *   one), prints one "FAIL: ..." line per failed check and ends with
+ *   "PASS" or "FAIL" and a non-zero exit status. Build and run all of them
+ *   from the repository root:
+ *   ```
+ *   make -C Tools check
+ *   ```
+ *   or one of them with `make -C Tools <name>` (binaries go to
+ *   Tools/build/). Tools/Makefile holds the sources and include paths of
+ *   each check.
+ */
+
+#ifndef HOST_CHECK_H
+#define HOST_CHECK_H
+
+#include <cstdio>
+
+/**
+ * @brief   Print a failed check.
+ * @param   ok   Result of the check.
+ * @param   what Description printed on failure.
+ * @return  1 if the check failed, 0 otherwise (to add to a failure count).
+ */
+inline int expect(bool ok, const char *what) {
+  if (!ok) {
+    std::printf("FAIL: %s\n", what);
+    return 1;
+  }
+  return 0;
+}
+
+/**
+ * @brief   Print the verdict of a check program.
+ * @param   failures Failed checks.
+ * @return  Exit status for main().
+ */
+inline int summary(int failures) {
+  std::printf("%s (%d failures)\n", failures == 0 ? "PASS" : "FAIL",
+              failures);
+  return failures == 0 ? 0 : 1;
+}
+
+#endif    // HOST_CHECK_H
+/** @} */
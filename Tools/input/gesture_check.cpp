@@ -0,0 +1,179 @@
+/**
+ * @file    gesture_check.cpp
+ * @brief   Host self-check of the ButtonGesture debounce and gestures.
+ * @author  Mitul Goti
+ * @version 1.0
+ * @date    2025-10-14
+ * @ingroup input
+ * @{
+ * @details
+ * Built and run with the other host checks by `make -C Tools check`, or
+ * alone from the repository root:
+ * ```
+ * make -C Tools gesture_check
+ * Tools/build/gesture_check
+ * ```
+ * Feeds scripted edge sequences with their ticks to the state machine and
+ * checks the gestures it reports and their ticks: bounce, taps shorter
+ * than the debounce window, short, double and long presses, a click
+ * followed by a long press, a caller that handles deadlines late, and
+ * ticks that wrap.
+ */
+
+#include "button_gesture.h"
+#include "host_check.h"
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace {
+using Gesture = ButtonGesture::Gesture;
+
+/** @brief One reported gesture */
+struct Seen {
+  Gesture g;
+  std::uint32_t tick;
+  bool operator==(const Seen &o) const { return g == o.g && tick == o.tick; }
+};
+
+std::vector<Seen> seen; /*!< Gestures since the last take() */
+
+void record(void *context, Gesture g, std::uint32_t tick) {
+  static_cast<void>(context);
+  seen.push_back({g, tick});
+}
+
+/** @brief Gestures reported since the last call. */
+std::vector<Seen> take() {
+  std::vector<Seen> out;
+  out.swap(seen);
+  return out;
+}
+
+ButtonGesture button;
+
+void edge(bool level, std::uint32_t tick) {
+  button.edge(level, tick, record, nullptr);
+}
+
+void expire(std::uint32_t now) { button.expire(now, record, nullptr); }
+
+using S = std::vector<Seen>;
+constexpr Gesture PRESS = Gesture::PRESS;
+constexpr Gesture RELEASE = Gesture::RELEASE;
+constexpr Gesture SHORT = Gesture::SHORT;
+constexpr Gesture LONG = Gesture::LONG;
+constexpr Gesture DOUBLE = Gesture::DOUBLE;
+} // namespace
+
+int main() {
+  int failures = 0;
+  std::uint32_t ticks = 0U;
+
+  /* 1. Short press: PRESS at once, SHORT when the double gap ends */
+  button.reset();
+  failures += expect(!button.untilNext(0U, ticks), "idle: no deadline");
+  edge(true, 100U);
+  failures += expect(take() == S{{PRESS, 100U}}, "press at its edge");
+  failures += expect(button.untilNext(105U, ticks) && ticks == 15U,
+                     "debounce deadline first");
+  edge(false, 250U);
+  expire(549U);
+  failures += expect(take() == S{{RELEASE, 250U}}, "release, no SHORT yet");
+  expire(550U);
+  failures += expect(take() == S{{SHORT, 550U}}, "short press");
+  failures += expect(!button.untilNext(550U, ticks), "nothing left");
+
+  /* 2. Bounce within the window is ignored */
+  edge(true, 1000U);
+  edge(false, 1002U);
+  edge(true, 1005U);
+  edge(false, 1011U);
+  edge(true, 1013U);
+  expire(1020U);
+  failures += expect(take() == S{{PRESS, 1000U}} && button.isPressed(),
+                     "one press for a bouncing contact");
+  edge(false, 1200U);
+  edge(true, 1203U);
+  edge(false, 1206U);
+  expire(1500U);
+  failures += expect(take() == S{{RELEASE, 1200U}, {SHORT, 1500U}},
+                     "one release for a bouncing contact");
+
+  /* 3. Tap shorter than the window: release found when it closes */
+  edge(true, 2000U);
+  edge(false, 2008U);
+  expire(2019U);
+  failures += expect(take() == S{{PRESS, 2000U}}, "tap, window open");
+  expire(2020U);
+  failures += expect(take() == S{{RELEASE, 2020U}}, "tap released");
+  expire(2320U);
+  failures += expect(take() == S{{SHORT, 2320U}}, "tap is a short press");
+
+  /* 4. Double press */
+  edge(true, 3000U);
+  edge(false, 3100U);
+  edge(true, 3250U);
+  edge(false, 3350U);
+  expire(4000U);
+  failures += expect(take() == S{{PRESS, 3000U},
+                                 {RELEASE, 3100U},
+                                 {PRESS, 3250U},
+                                 {RELEASE, 3350U},
+                                 {DOUBLE, 3350U}},
+                     "double press, no SHORT");
+
+  /* 5. Long press: reported while held, release adds nothing */
+  edge(true, 5000U);
+  expire(5799U);
+  failures += expect(take() == S{{PRESS, 5000U}}, "not long yet");
+  expire(5800U);
+  failures += expect(take() == S{{LONG, 5800U}}, "long press while held");
+  edge(false, 6500U);
+  expire(7000U);
+  failures += expect(take() == S{{RELEASE, 6500U}}, "long press released");
+
+  /* 6. Click, then a second press held long */
+  edge(true, 8000U);
+  edge(false, 8100U);
+  edge(true, 8200U);
+  expire(9000U);
+  failures += expect(take() == S{{PRESS, 8000U},
+                                 {RELEASE, 8100U},
+                                 {PRESS, 8200U},
+                                 {SHORT, 9000U},
+                                 {LONG, 9000U}},
+                     "click, then long press");
+  edge(false, 9100U);
+  expire(9500U);
+  failures += expect(take() == S{{RELEASE, 9100U}}, "no double after long");
+
+  /* 7. Late caller: deadlines before an edge are handled first */
+  edge(true, 10000U);
+  edge(false, 10100U);
+  edge(true, 10500U); /* No expire() since 10100 */
+  failures += expect(take() == S{{PRESS, 10000U},
+                                 {RELEASE, 10100U},
+                                 {SHORT, 10400U},
+                                 {PRESS, 10500U}},
+                     "gap handled before the late edge");
+  edge(false, 10600U);
+  expire(11000U);
+  take();
+
+  /* 8. Ticks that wrap */
+  const std::uint32_t t = 0xFFFFFF00U;
+  edge(true, t);
+  edge(false, t + 100U);
+  failures += expect(button.untilNext(t + 100U, ticks) && ticks == 20U,
+                     "deadline across the wrap");
+  expire(t + 399U);
+  failures += expect(take() == S{{PRESS, t}, {RELEASE, t + 100U}},
+                     "no SHORT before the wrapped gap");
+  expire(t + 400U);
+  failures += expect(take() == S{{SHORT, t + 400U}}, "short across the wrap");
+
+  return summary(failures);
+}
+
+/** @} */ // end of input
@@ -0,0 +1,93 @@
+/**
+ * @file    jitter_check.cpp
+ * @brief   Host self-check of the JitterHistogram buckets and conversion.
+ * @author  Mitul Goti
+ * @version 1.0
+ * @date    2025-10-15
+ * @ingroup led_thread
+ * @{
+ * @details
+ * Built and run with the other host checks by `make -C Tools check`, or
+ * alone from the repository root:
+ * ```
+ * make -C Tools jitter_check
+ * Tools/build/jitter_check
+ * ```
+ * Checks the bucket of errors at every bucket boundary, the counts and
+ * extremes after recording, reset, and the conversion of system timer
+ * readings to microseconds across the 32-bit wrap at 168 MHz.
+ */
+
+#include "host_check.h"
+#include "jitter_histogram.h"
+#include <cstdint>
+#include <cstdio>
+
+namespace {
+constexpr std::uint32_t COUNTS_PER_US = 168U;       /*!< 168 MHz */
+constexpr std::uint32_t COUNTS_PER_TICK = 168000U;  /*!< 1 kHz tick */
+} // namespace
+
+int main() {
+  int failures = 0;
+
+  /* 1. Buckets: early, < 1 us, then powers of two up to >= 8192 us */
+  failures += expect(JitterHistogram::bucketOf(-1) == 0U, "early");
+  failures += expect(JitterHistogram::bucketOf(0) == 1U, "0 us");
+  failures += expect(JitterHistogram::bucketOf(1) == 2U, "1 us");
+  for (std::uint32_t i = 2U; i < JitterHistogram::BUCKETS - 1U; i++) {
+    const std::uint32_t limit = JitterHistogram::bucketLimitUs(i);
+    failures += expect(JitterHistogram::bucketOf(
+                           static_cast<std::int32_t>(limit - 1U)) == i,
+                       "last error of a bucket");
+    failures += expect(JitterHistogram::bucketOf(
+                           static_cast<std::int32_t>(limit)) == i + 1U,
+                       "first error of the next bucket");
+  }
+  failures += expect(JitterHistogram::bucketLimitUs(1U) == 1U &&
+                         JitterHistogram::bucketLimitUs(14U) == 8192U &&
+                         JitterHistogram::bucketLimitUs(15U) == 0U,
+                     "bucket limits");
+  failures += expect(JitterHistogram::bucketOf(INT32_MAX) ==
+                         JitterHistogram::BUCKETS - 1U,
+                     "huge error in the last bucket");
+
+  /* 2. Recording */
+  JitterHistogram hist;
+  failures += expect(hist.count() == 0U, "empty");
+  const std::int32_t errors[] = {3, 5, 5, 40, 0, 9000, -2};
+  for (std::int32_t e : errors) {
+    hist.record(e);
+  }
+  failures += expect(hist.count() == 7U, "count");
+  failures += expect(hist.bucket(0U) == 1U && hist.bucket(1U) == 1U &&
+                         hist.bucket(3U) == 1U && hist.bucket(4U) == 2U &&
+                         hist.bucket(7U) == 1U && hist.bucket(15U) == 1U,
+                     "bucket counts");
+  failures += expect(hist.earliest() == -2 && hist.latest() == 9000,
+                     "extremes");
+  hist.reset();
+  failures += expect(hist.count() == 0U && hist.earliest() == INT32_MAX &&
+                         hist.latest() == INT32_MIN,
+                     "reset");
+
+  /* 3. System timer readings to us, across the wrap */
+  const std::uint32_t tick = 25565U; /* Tick * 168000 wraps past 2^32 */
+  const std::uint32_t ideal = tick * COUNTS_PER_TICK;
+  failures += expect(JitterHistogram::errorUs(ideal + 17U * COUNTS_PER_US,
+                                              ideal, COUNTS_PER_US) == 17,
+                     "17 us late");
+  failures += expect(JitterHistogram::errorUs(ideal - 3U * COUNTS_PER_US,
+                                              ideal, COUNTS_PER_US) == -3,
+                     "3 us early");
+  const std::uint32_t nearWrap = 0xFFFFFF00U;
+  failures += expect(JitterHistogram::errorUs(nearWrap + 0x200U, nearWrap,
+                                              COUNTS_PER_US) == 3,
+                     "late across the wrap");
+  failures += expect(JitterHistogram::errorUs(100U, 0U, 0U) == 100,
+                     "0 counts per us taken as 1");
+
+  return summary(failures);
+}
+
+/** @} */ // end of led_thread
@@ -0,0 +1,181 @@
+/**
+ * @file    pattern_check.cpp
+ * @brief   Host self-check of the LedPattern compiler and interpreter.
+ * @author  Mitul Goti
+ * @version 1.0
+ * @date    2025-10-10
+ * @ingroup led_thread
+ * @{
+ * @details
+ * Built and run with the other host checks by `make -C Tools check`, or
+ * alone from the repository root:
+ * ```
+ * make -C Tools pattern_check
+ * Tools/build/pattern_check [pattern text]
+ * ```
+ * Checks the encoding and error columns of the compiler (partly at compile
+ * time), runs every built-in pattern for one cycle and checks its length
+ * and on-time, and checks halt and the runaway guard. With an argument it
+ * compiles that text and prints its bytecode and first cycle instead.
+ */
+
+#include "host_check.h"
+#include "led_pattern.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+namespace {
+constexpr std::uint32_t SHARED_MS = 500U; /*!< Shared on-time for 't' */
+
+/* Compiled at build time, like the firmware's built-in table */
+constexpr auto NESTED = LedPattern::compile<16>("2[on 2[300 tog]] 1000");
+static_assert(NESTED.ok() && NESTED.size == 14U, "nested loops");
+static_assert(NESTED.bytes[0] == LedPattern::OP_LOOP && NESTED.bytes[1] == 2U,
+              "loop count");
+static_assert(NESTED.bytes[11] == LedPattern::OP_WAIT16 &&
+                  NESTED.bytes[12] == 0xE8U && NESTED.bytes[13] == 0x03U,
+              "16-bit wait");
+static_assert(LedPattern::compile<8>("on off").error == 7U, "no wait");
+static_assert(LedPattern::compile<8>("on blah 5").error == 4U, "bad word");
+static_assert(LedPattern::compile<8>("3[on 5").error == 7U, "open loop");
+static_assert(LedPattern::compile<8>("on 5]").error == 5U, "stray ]");
+static_assert(LedPattern::compile<8>("256[on 5]").error == 1U, "count");
+static_assert(LedPattern::compile<8>("on 65536").error == 4U, "wait range");
+static_assert(LedPattern::compile<8>("[[[on 5]]]").error == 3U, "depth");
+static_assert(LedPattern::compile<3>("on 5 off 5").error == 6U, "overflow");
+static_assert(LedPattern::compile<8>("on halt").ok(), "halt, no wait");
+
+/** One cycle of a program: total time, time lit, number of steps */
+struct Cycle {
+  std::uint32_t totalMs = 0U;
+  std::uint32_t litMs = 0U;
+  std::uint32_t steps = 0U;
+  std::uint32_t end = 0U; /*!< HALT, RUNAWAY or 0 (wrapped to the start) */
+};
+
+/** @brief Run a program until it first returns to its start. */
+Cycle runCycle(const std::uint8_t *code, std::size_t size, bool print) {
+  Cycle c;
+  LedPattern::State s;
+  do {
+    const std::uint32_t ms = LedPattern::step(code, size, s, SHARED_MS);
+    if (ms == LedPattern::HALT || ms == LedPattern::RUNAWAY) {
+      c.end = ms;
+      break;
+    }
+    if (print) {
+      std::printf("  %5u ms %s %u ms\n", c.totalMs, s.lit ? "on " : "off",
+                  ms);
+    }
+    c.totalMs += ms;
+    c.litMs += s.lit ? ms : 0U;
+    c.steps++;
+  } while (!(s.pc >= size && s.depth == 0U) && c.steps < 100000U);
+  return c;
+}
+
+/** @brief Print one cycle and compare it with the expected times. */
+int checkCycle(const char *name, const Cycle &c, std::uint32_t total,
+               std::uint32_t lit) {
+  std::printf("%-10s %5u ms, lit %4u ms, %4u steps (expected %u, %u)\n",
+              name, c.totalMs, c.litMs, c.steps, total, lit);
+  return expect(c.totalMs == total && c.litMs == lit && c.end == 0U, name);
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  if (argc > 1) {
+    const auto code = LedPattern::compile<64>(argv[1]);
+    if (!code.ok()) {
+      std::printf("error at column %u\n", code.error);
+      return 1;
+    }
+    std::printf("%u bytes:", code.size);
+    for (std::size_t i = 0U; i < code.size; i++) {
+      std::printf(" %02x", code.bytes[i]);
+    }
+    std::printf("\n");
+    const Cycle c = runCycle(code.bytes.data(), code.size, true);
+    std::printf("cycle %u ms, lit %u ms%s\n", c.totalMs, c.litMs,
+                c.end == LedPattern::HALT      ? ", halted"
+                : c.end == LedPattern::RUNAWAY ? ", runaway"
+                                               : "");
+    return 0;
+  }
+
+  int failures = 0;
+
+  /* 1. Built-in patterns: length and on-time of one cycle */
+  struct Expected {
+    const char *name;
+    std::uint32_t total;
+    std::uint32_t lit;
+  };
+  const Expected expected[] = {
+      {"blink", 2U * SHARED_MS, SHARED_MS},
+      {"heartbeat", 1000U, 160U},
+      {"sos", 4500U, 2250U},
+      {"strobe", 100U, 20U},
+      {"alert", 1480U, 240U},
+      {"breathe", 17U * 60U + 300U, 6U * (2U * 36U + 9U)}, /* Duty 1..9..1 */
+  };
+  std::size_t count = 0U;
+  const LedPattern::Builtin *table = LedPattern::builtins(count);
+  failures += expect(count == sizeof(expected) / sizeof(expected[0]),
+                     "built-in pattern count");
+  for (const Expected &e : expected) {
+    const LedPattern::Builtin *b = LedPattern::find(e.name);
+    if (expect(b != nullptr, e.name) != 0) {
+      failures++;
+      continue;
+    }
+    failures += checkCycle(e.name, runCycle(b->code, b->size, false),
+                           e.total, e.lit);
+  }
+  failures +=
+      expect(LedPattern::find("nope") == nullptr && table != nullptr, "lookup");
+
+  /* 2. Nested loops: 2 x (on, 2 x (300 ms, toggle)), 1000 ms */
+  failures += checkCycle("nested",
+                         runCycle(NESTED.bytes.data(), NESTED.size, false),
+                         2U * 600U + 1000U, 2U * 300U + 1000U);
+
+  /* 3. Halt keeps the LED state and stays halted */
+  {
+    constexpr auto code = LedPattern::compile<8>("on 100 halt");
+    LedPattern::State s;
+    const std::uint32_t first =
+        LedPattern::step(code.bytes.data(), code.size, s, SHARED_MS);
+    const std::uint32_t second =
+        LedPattern::step(code.bytes.data(), code.size, s, SHARED_MS);
+    const std::uint32_t third =
+        LedPattern::step(code.bytes.data(), code.size, s, SHARED_MS);
+    failures += expect(first == 100U && second == LedPattern::HALT &&
+                           third == LedPattern::HALT && s.lit,
+                       "halt");
+  }
+
+  /* 4. A forever loop without a wait trips the runaway guard */
+  {
+    constexpr auto code = LedPattern::compile<8>("100 [tog]");
+    LedPattern::State s;
+    LedPattern::step(code.bytes.data(), code.size, s, SHARED_MS);
+    failures += expect(LedPattern::step(code.bytes.data(), code.size, s,
+                                        SHARED_MS) == LedPattern::RUNAWAY,
+                       "runaway not detected");
+  }
+
+  /* 5. Truncated bytecode halts instead of reading past the end */
+  {
+    const std::uint8_t bad[] = {LedPattern::OP_ON, LedPattern::OP_WAIT16, 5U};
+    LedPattern::State s;
+    failures += expect(LedPattern::step(bad, sizeof(bad), s, SHARED_MS) ==
+                           LedPattern::HALT,
+                       "truncated code");
+  }
+
+  return summary(failures);
+}
+
+/** @} */ // end of led_thread
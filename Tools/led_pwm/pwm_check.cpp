@@ -0,0 +1,184 @@
+/**
+ * @file    pwm_check.cpp
+ * @brief   Host self-check of the LedPwm TIM4 driver on a mock register file.
+ * @author  Mitul Goti
+ * @version 1.0
+ * @date    2025-10-11
+ * @ingroup led
+ * @{
+ * @details
+ * Built and run with the other host checks by `make -C Tools check`, or
+ * alone from the repository root:
+ * ```
+ * make -C Tools pwm_check
+ * Tools/build/pwm_check
+ * ```
+ * The driver source is built unchanged; Tools/led_pwm/stm32f4xx.h puts its
+ * registers in RAM. The check evaluates the output compare logic of TIM4
+ * over one counter period (the waveform the pins show) and checks the
+ * clock, pin and timebase setup, the brightness levels and the hardware
+ * blink phases.
+ */
+
+#include "host_check.h"
+#include "led_pwm.h"
+#include "stm32f4xx.h"
+#include <cstdint>
+#include <cstdio>
+
+TIM_TypeDef mockTim4;
+GPIO_TypeDef mockGpioD;
+RCC_TypeDef mockRcc;
+uint32_t SystemCoreClock = 168000000U;
+
+namespace {
+constexpr std::uint32_t PPRE1_DIV4 = 5U; /*!< Discovery clock tree: APB1/4 */
+
+/** @brief Output level of a channel at a counter value (RM0090 18.3.9). */
+bool pinHigh(std::uint32_t ch, std::uint32_t cnt) {
+  const std::uint32_t ccmr = (ch < 2U) ? mockTim4.CCMR1 : mockTim4.CCMR2;
+  const std::uint32_t mode = (ccmr >> ((ch % 2U) * 8U + 4U)) & 7U;
+  const std::uint32_t ccr = (&mockTim4.CCR1)[ch];
+  if ((mockTim4.CCER & (1U << (ch * 4U))) == 0U) {
+    return false;
+  }
+  if (mode == 6U) {
+    return cnt < ccr;
+  }
+  if (mode == 7U) {
+    return cnt >= ccr;
+  }
+  return mode == 5U; /* Forced active */
+}
+
+/** @brief Counter ticks per period a channel is high. */
+std::uint32_t highTicks(std::uint32_t ch) {
+  std::uint32_t n = 0U;
+  for (std::uint32_t cnt = 0U; cnt <= mockTim4.ARR; cnt++) {
+    n += pinHigh(ch, cnt) ? 1U : 0U;
+  }
+  return n;
+}
+
+/** @brief First counter value a channel is high, ARR + 1 if never. */
+std::uint32_t firstHigh(std::uint32_t ch) {
+  std::uint32_t cnt = 0U;
+  while (cnt <= mockTim4.ARR && !pinHigh(ch, cnt)) {
+    cnt++;
+  }
+  return cnt;
+}
+} // namespace
+
+int main() {
+  int failures = 0;
+
+  /* 1. Set-up: clocks, pins, 1 kHz timebase, all dark */
+  mockRcc.CFGR = PPRE1_DIV4 << RCC_CFGR_PPRE1_Pos;
+  mockGpioD.MODER = 0x55000055U; /* PD12..15 and PD0..3 outputs */
+  mockGpioD.AFR[1] = 0x0000FFFFU;
+  LedPwm pwm;
+  std::uint32_t ch = 0U;
+  failures += expect(!pwm.channel(60U, ch), "channel before init");
+  failures += expect(pwm.init(), "init");
+  failures += expect((mockRcc.AHB1ENR & RCC_AHB1ENR_GPIODEN) != 0U &&
+                         (mockRcc.APB1ENR & RCC_APB1ENR_TIM4EN) != 0U,
+                     "clocks");
+  failures += expect(mockGpioD.MODER == 0xAA000055U, "MODER AF for PD12..15");
+  failures += expect(mockGpioD.AFR[1] == 0x2222FFFFU, "AFR AF2 for PD12..15");
+  failures += expect(mockTim4.PSC == 83U && mockTim4.ARR == 999U,
+                     "1 kHz x 1000 steps from 84 MHz");
+  failures += expect((mockTim4.CR1 & (TIM_CR1_CEN | TIM_CR1_ARPE)) ==
+                         (TIM_CR1_CEN | TIM_CR1_ARPE),
+                     "counter running, ARR preloaded");
+  failures += expect(mockTim4.EGR == TIM_EGR_UG, "update event");
+  failures += expect(mockTim4.CCER == (TIM_CCER_CC1E | TIM_CCER_CC2E |
+                                       TIM_CCER_CC3E | TIM_CCER_CC4E),
+                     "outputs enabled");
+  failures += expect((mockTim4.CCMR1 & 0x0808U) == 0x0808U &&
+                         (mockTim4.CCMR2 & 0x0808U) == 0x0808U,
+                     "compare preload");
+  for (std::uint32_t c = 0U; c < LedPwm::CHANNELS; c++) {
+    failures += expect(highTicks(c) == 0U, "dark after init");
+  }
+
+  /* 2. Pin numbers to channels */
+  failures += expect(!pwm.channel(59U, ch), "pin 59");
+  failures += expect(!pwm.channel(64U, ch), "pin 64");
+  failures += expect(pwm.channel(62U, ch) && ch == 2U, "pin 62 = CH3");
+
+  /* 3. Dim mode: on, off, toggle, levels (square law) */
+  pwm.on(0U);
+  failures += expect(highTicks(0U) == 1000U, "full on");
+  pwm.setLevel(0U, 128U);
+  failures += expect(highTicks(0U) == 252U, "level 128 = 25.2 %");
+  pwm.setLevel(0U, 16U);
+  failures += expect(highTicks(0U) == 4U, "level 16 = 0.4 %");
+  pwm.toggle(0U);
+  failures += expect(highTicks(0U) == 0U && !pwm.isOn(0U), "toggle off");
+  pwm.setLevel(0U, 255U);
+  failures += expect(highTicks(0U) == 0U, "level while off stays dark");
+  pwm.toggle(0U);
+  failures += expect(highTicks(0U) == 1000U, "toggle on");
+  pwm.on(3U);
+  pwm.off(3U);
+  failures += expect(highTicks(3U) == 0U && highTicks(0U) == 1000U,
+                     "channels independent");
+
+  /* 4. Blink mode: 1 s period, phases, clipping */
+  failures += expect(!pwm.blink(0U), "period 0");
+  failures += expect(!pwm.blink(LedPwm::BLINK_PERIOD_MAX_MS + 1U),
+                     "period above ARR range");
+  failures += expect(pwm.blink(LedPwm::BLINK_PERIOD_MAX_MS) &&
+                         mockTim4.ARR == 65529U,
+                     "longest period");
+  failures += expect(pwm.blink(1000U) && mockTim4.PSC == 8399U &&
+                         mockTim4.ARR == 9999U,
+                     "0.1 ms ticks, 1 s period");
+  failures += expect(pwm.getMode() == LedPwm::Mode::BLINK &&
+                         highTicks(0U) == 0U,
+                     "blink mode starts dark");
+  pwm.setBlink(0U, 500U, false);
+  pwm.setBlink(1U, 500U, true);
+  pwm.setBlink(2U, 2000U, true);
+  pwm.setBlink(3U, 100U, true);
+  failures += expect(highTicks(0U) == 5000U && firstHigh(0U) == 0U,
+                     "early half");
+  failures += expect(highTicks(1U) == 5000U && firstHigh(1U) == 5000U,
+                     "late half");
+  bool alternate = true;
+  for (std::uint32_t cnt = 0U; cnt <= mockTim4.ARR; cnt++) {
+    alternate = alternate && (pinHigh(0U, cnt) != pinHigh(1U, cnt));
+  }
+  failures += expect(alternate, "CH1 and CH2 alternate");
+  failures += expect(highTicks(2U) == 10000U, "on-time clipped to period");
+  failures += expect(highTicks(3U) == 1000U && firstHigh(3U) == 9000U,
+                     "late 100 ms");
+  pwm.off(0U); /* Recorded only, the timer owns the pin */
+  failures += expect(highTicks(0U) == 5000U, "off() ignored in blink mode");
+
+  /* 5. Back to dim mode with the recorded states */
+  pwm.on(2U);
+  pwm.dim();
+  failures += expect(mockTim4.PSC == 83U && mockTim4.ARR == 999U,
+                     "dim timebase restored");
+  failures += expect(highTicks(0U) == 0U && highTicks(1U) == 0U &&
+                         highTicks(2U) == 1000U && highTicks(3U) == 0U,
+                     "dim states restored");
+  failures += expect(!pwm.setBlink(0U, 100U, false), "setBlink in dim mode");
+
+  /* 6. Timer clock follows the APB1 prescaler */
+  const struct {
+    std::uint32_t ppre1;
+    std::uint32_t psc;
+  } clocks[] = {{0U, 167U}, {4U, 167U}, {5U, 83U}, {7U, 20U}};
+  for (const auto &c : clocks) {
+    mockRcc.CFGR = c.ppre1 << RCC_CFGR_PPRE1_Pos;
+    pwm.dim();
+    failures += expect(mockTim4.PSC == c.psc, "APB1 prescaler");
+  }
+
+  return summary(failures);
+}
+
+/** @} */ // end of led
@@ -0,0 +1,61 @@
+/**
+ * @file    stm32f4xx.h
+ * @brief   Mock register file for building LedPwm on the host.
+ * @author  Mitul Goti
+ * @version 1.0
+ * @date    2025-10-11
+ * @ingroup led
+ * @{
+ * @details
+ *   Stands in for the device header when Application/Src/led_pwm.cpp is
+ *   built for Tools/led_pwm: the same type, register and bit names, backed
+ *   by plain structs in RAM. The register layouts follow RM0090 for the
+ *   registers the driver uses; RCC keeps only those registers. Hardware
+ *   side effects (preload transfer on update, counting) are modelled in
+ *   pwm_check.cpp, not here.
+ */
+
+#ifndef MOCK_STM32F4XX_H
+#define MOCK_STM32F4XX_H
+
+#include <cstdint>
+
+/** TIM2..TIM5 register block (RM0090 18.4) */
+typedef struct {
+  volatile uint32_t CR1, CR2, SMCR, DIER, SR, EGR, CCMR1, CCMR2, CCER, CNT,
+      PSC, ARR, RCR, CCR1, CCR2, CCR3, CCR4, BDTR, DCR, DMAR, OR;
+} TIM_TypeDef;
+
+/** GPIO port register block (RM0090 8.4) */
+typedef struct {
+  volatile uint32_t MODER, OTYPER, OSPEEDR, PUPDR, IDR, ODR, BSRR, LCKR,
+      AFR[2];
+} GPIO_TypeDef;
+
+/** RCC registers used by the driver */
+typedef struct {
+  volatile uint32_t CFGR, AHB1ENR, APB1ENR;
+} RCC_TypeDef;
+
+extern TIM_TypeDef mockTim4;   ///< Defined by the test
+extern GPIO_TypeDef mockGpioD; ///< Defined by the test
+extern RCC_TypeDef mockRcc;    ///< Defined by the test
+
+#define TIM4 (&mockTim4)
+#define GPIOD (&mockGpioD)
+#define RCC (&mockRcc)
+
+#define TIM_CR1_CEN (1U << 0)
+#define TIM_CR1_ARPE (1U << 7)
+#define TIM_EGR_UG (1U << 0)
+#define TIM_CCER_CC1E (1U << 0)
+#define TIM_CCER_CC2E (1U << 4)
+#define TIM_CCER_CC3E (1U << 8)
+#define TIM_CCER_CC4E (1U << 12)
+#define RCC_CFGR_PPRE1_Pos (10U)
+#define RCC_CFGR_PPRE1 (7U << RCC_CFGR_PPRE1_Pos)
+#define RCC_AHB1ENR_GPIODEN (1U << 3)
+#define RCC_APB1ENR_TIM4EN (1U << 2)
+
+#endif // MOCK_STM32F4XX_H
+/** @} */ // end of led
@@ -0,0 +1,37 @@
+/**
+ * @file    cmsis_os2.h
+ * @brief   Minimal CMSIS-RTOS2 declarations for building led_thread.h on
+ *          the host.
+ * @author  Mitul Goti
+ * @version 1.0
+ * @date    2025-10-13
+ * @ingroup led_thread
+ * @{
+ * @details
+ *   Only the types led_thread.h names; no RTOS function is called by the
+ *   LedTiming and on-time code under test.
+ */
+
+#ifndef MOCK_CMSIS_OS2_H
+#define MOCK_CMSIS_OS2_H
+
+#include <cstdint>
+
+typedef void *osThreadId_t;
+typedef void *osSemaphoreId_t;
+typedef void *osEventFlagsId_t;
+typedef enum { osPriorityNormal = 24 } osPriority_t;
+typedef struct {
+  const char *name;
+  uint32_t attr_bits;
+  void *cb_mem;
+  uint32_t cb_size;
+  void *stack_mem;
+  uint32_t stack_size;
+  osPriority_t priority;
+  uint32_t tz_module;
+  uint32_t reserved;
+} osThreadAttr_t;
+
+#endif // MOCK_CMSIS_OS2_H
+/** @} */ // end of led_thread
@@ -0,0 +1,99 @@
+/**
+ * @file    timing_check.cpp
+ * @brief   Host self-check of LedTiming snapshots and on-time clamping.
+ * @author  Mitul Goti
+ * @version 1.0
+ * @date    2025-10-13
+ * @ingroup led_thread
+ * @{
+ * @details
+ * Built and run with the other host checks by `make -C Tools check`, or
+ * alone from the repository root:
+ * ```
+ * make -C Tools timing_check
+ * Tools/build/timing_check
+ * ```
+ * A writer thread publishes on/off pairs that carry a check relation while
+ * a reader thread takes snapshots as fast as it can; every snapshot must
+ * be one whole pair. Then the clamping of the shared on-time is checked at
+ * both limits.
+ */
+
+#include "host_check.h"
+#include "led_thread.h"
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+
+std::atomic<uint32_t> LedThread::onTime{500U};
+
+namespace {
+constexpr uint32_t WRITES = 5000000U; /*!< Pairs the writer publishes */
+
+/** @brief Off time belonging to an on time in the test pairs. */
+uint16_t pairOf(uint16_t on) { return static_cast<uint16_t>(~on * 7U); }
+} // namespace
+
+int main() {
+  int failures = 0;
+
+  /* 1. Snapshots are always one whole update */
+  LedTiming timing;
+  timing.set({0U, pairOf(0U)});
+  std::atomic<bool> done{false};
+  std::atomic<uint32_t> reads{0U};
+  uint32_t torn = 0U;
+  uint32_t changes = 0U;
+  std::thread reader([&]() {
+    uint16_t last = 0U;
+    while (!done.load(std::memory_order_relaxed)) {
+      const LedTiming::Times t = timing.get();
+      torn += (t.offMs != pairOf(t.onMs)) ? 1U : 0U;
+      changes += (t.onMs != last) ? 1U : 0U;
+      last = t.onMs;
+      reads.fetch_add(1U, std::memory_order_relaxed);
+    }
+  });
+  while (reads.load() == 0U) {
+    std::this_thread::yield(); /* Overlap the writes with the reads */
+  }
+  for (uint32_t i = 1U; i <= WRITES; i++) {
+    const uint16_t on = static_cast<uint16_t>(i);
+    timing.set({on, pairOf(on)});
+    if (i % 4096U == 0U) {
+      std::this_thread::yield(); /* Let the reader in on one core too */
+    }
+  }
+  done.store(true);
+  reader.join();
+  std::printf("%u snapshots, %u changes seen, %u torn\n", reads.load(),
+              changes, torn);
+  failures += expect(torn == 0U, "torn snapshot");
+  failures += expect(changes > 0U, "reader saw no update");
+
+  /* 2. Shared on-time stays within its limits */
+  LedThread::setOnTime(LED_ON_TIME_MIN + 30U);
+  LedThread::decreaseOnTime(100U);
+  failures += expect(LedThread::getOnTime() == LED_ON_TIME_MIN,
+                     "decrease clamps to the minimum, no wrap");
+  LedThread::decreaseOnTime(0xFFFFFFFFU);
+  failures += expect(LedThread::getOnTime() == LED_ON_TIME_MIN,
+                     "huge decrease");
+  LedThread::setOnTime(LED_ON_TIME_MAX - 30U);
+  LedThread::increaseOnTime(100U);
+  failures += expect(LedThread::getOnTime() == LED_ON_TIME_MAX,
+                     "increase clamps to the maximum");
+  LedThread::setOnTime(500U);
+  LedThread::increaseOnTime(0xFFFFFFFFU);
+  failures += expect(LedThread::getOnTime() == LED_ON_TIME_MAX,
+                     "increase does not overflow");
+  LedThread::setOnTime(500U);
+  LedThread::increaseOnTime(250U);
+  LedThread::decreaseOnTime(150U);
+  failures += expect(LedThread::getOnTime() == 600U, "in range");
+
+  return summary(failures);
+}
+
+/** @} */ // end of led_thread
@@ -0,0 +1,230 @@
+/**
+ * @file    lzlog.cpp
+ * @brief   Host tool for compressed FS log files (FS_LOG_COMPRESS).
+ * @author  Mitul Goti
+ * @version 1.0
+ * @date    2025-09-28
+ * @ingroup Logger
+ * @{
+ * @details
+ * Build and run on Linux from the repository root:
+ * ```
+ * g++ -std=c++17 -O2 -IApplication/Inc Tools/log_codec/lzlog.cpp \
+ *     Application/Src/log_codec.cpp Application/Src/flash_store.cpp -o lzlog
+ * ./lzlog d log.lzb [log.txt]   # decompress a log file
+ * ./lzlog c log.txt log.lzb     # compress text the way FsLog does
+ * ./lzlog bench [log.txt]       # ratio and file writes (synthetic log
+ *                               # if no file is given)
+ * ```
+ * Damaged frames are skipped: the decoder searches the next valid frame.
+ */
+
+#include "log_codec.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+/**
+ * @brief   Read a whole file.
+ * @param   path File name.
+ * @param   data Contents.
+ * @return  true on success.
+ */
+bool readFile(const char *path, std::vector<std::uint8_t> &data) {
+  FILE *f = std::fopen(path, "rb");
+  if (f == nullptr) {
+    std::perror(path);
+    return false;
+  }
+  std::uint8_t buf[4096];
+  std::size_t n;
+  while ((n = std::fread(buf, 1, sizeof(buf), f)) > 0) {
+    data.insert(data.end(), buf, buf + n);
+  }
+  std::fclose(f);
+  return true;
+}
+
+/**
+ * @brief   Pack text into frames like FsLog: whole lines, up to BLOCK_SIZE.
+ * @param   text   Log text.
+ * @param   out    Frames.
+ * @param   frames Number of frames (file writes on the target).
+ */
+void pack(const std::vector<std::uint8_t> &text,
+          std::vector<std::uint8_t> &out, std::size_t &frames) {
+  std::uint16_t table[LogCodec::HASH_SIZE];
+  std::uint8_t frame[LogCodec::FRAME_MAX_SIZE];
+  std::string block;
+  frames = 0U;
+  auto flush = [&]() {
+    if (!block.empty()) {
+      std::uint32_t n = LogCodec::encodeFrame(
+          block.data(), static_cast<std::uint32_t>(block.size()), frame,
+          table);
+      out.insert(out.end(), frame, frame + n);
+      frames++;
+      block.clear();
+    }
+  };
+  std::size_t start = 0U;
+  while (start < text.size()) {
+    std::size_t end = start;
+    while (end < text.size() && text[end] != '\n') {
+      end++;
+    }
+    end = (end < text.size()) ? end + 1U : end;
+    /* Lines longer than a block are split */
+    end = std::min<std::size_t>(end, start + LogCodec::BLOCK_SIZE);
+    if (block.size() + (end - start) > LogCodec::BLOCK_SIZE) {
+      flush();
+    }
+    block.append(text.begin() + start, text.begin() + end);
+    start = end;
+  }
+  flush();
+}
+
+/**
+ * @brief   Decode all frames, skipping damaged bytes.
+ * @param   in      File contents.
+ * @param   out     Text.
+ * @param   skipped Damaged bytes skipped.
+ */
+void unpack(const std::vector<std::uint8_t> &in, std::string &out,
+            std::size_t &skipped) {
+  char raw[LogCodec::BLOCK_SIZE];
+  std::size_t pos = 0U;
+  skipped = 0U;
+  while (pos + LogCodec::FRAME_HEADER_SIZE <= in.size()) {
+    LogCodec::FrameHeader hdr;
+    std::int32_t n = -1;
+    if (LogCodec::readHeader(&in[pos], hdr) &&
+        pos + LogCodec::FRAME_HEADER_SIZE + hdr.packedLen <= in.size()) {
+      n = LogCodec::decodeFrame(&in[pos], raw, sizeof(raw));
+    }
+    if (n < 0) {
+      pos++; /* Resynchronize on the next frame header */
+      skipped++;
+      continue;
+    }
+    out.append(raw, n);
+    pos += LogCodec::FRAME_HEADER_SIZE + hdr.packedLen;
+  }
+  skipped += in.size() - pos;
+}
+
+/**
+ * @brief   Synthetic log resembling the firmware output.
+ * @param   seconds Simulated run time.
+ * @return  Log text.
+ */
+std::vector<std::uint8_t> syntheticLog(unsigned seconds) {
+  std::string text;
+  char line[96];
+  for (unsigned s = 0; s < seconds; s++) {
+    const char *leds[] = {"Green", "Orange", "Red", "Blue"};
+    for (unsigned l = 0; l < 4U; l++) {
+      std::snprintf(line, sizeof(line),
+                    "[%02u:%02u:%02u.%03u] Event: %s LED toggled %u\r\n",
+                    s / 3600U, (s / 60U) % 60U, s % 60U, (l * 137U) % 1000U,
+                    leds[l], s * (l + 1U));
+      text += line;
+    }
+    std::snprintf(line, sizeof(line),
+                  "[%02u:%02u:%02u.%03u] Supervisor: Heartbeat %u\r\n",
+                  s / 3600U, (s / 60U) % 60U, s % 60U, 999U, s % 256U);
+    text += line;
+  }
+  return std::vector<std::uint8_t>(text.begin(), text.end());
+}
+
+/**
+ * @brief   Write a buffer to a file.
+ * @return  true on success.
+ */
+bool writeFile(const char *path, const void *data, std::size_t len) {
+  FILE *f = std::fopen(path, "wb");
+  if (f == nullptr || std::fwrite(data, 1, len, f) != len) {
+    std::perror(path);
+    if (f != nullptr) {
+      std::fclose(f);
+    }
+    return false;
+  }
+  std::fclose(f);
+  return true;
+}
+} // namespace
+
+/**
+ * @brief   Entry point, see the file header for usage.
+ */
+int main(int argc, char **argv) {
+  if (argc >= 3 && std::strcmp(argv[1], "d") == 0) {
+    std::vector<std::uint8_t> in;
+    std::string text;
+    std::size_t skipped;
+    if (!readFile(argv[2], in)) {
+      return 1;
+    }
+    unpack(in, text, skipped);
+    if (skipped > 0U) {
+      std::fprintf(stderr, "%zu damaged bytes skipped\n", skipped);
+    }
+    if (argc >= 4) {
+      return writeFile(argv[3], text.data(), text.size()) ? 0 : 1;
+    }
+    std::fwrite(text.data(), 1, text.size(), stdout);
+    return 0;
+  }
+  if (argc >= 4 && std::strcmp(argv[1], "c") == 0) {
+    std::vector<std::uint8_t> in;
+    std::vector<std::uint8_t> out;
+    std::size_t frames;
+    if (!readFile(argv[2], in)) {
+      return 1;
+    }
+    pack(in, out, frames);
+    return writeFile(argv[3], out.data(), out.size()) ? 0 : 1;
+  }
+  if (argc >= 2 && std::strcmp(argv[1], "bench") == 0) {
+    std::vector<std::uint8_t> in;
+    if (argc >= 3) {
+      if (!readFile(argv[2], in)) {
+        return 1;
+      }
+    } else {
+      in = syntheticLog(3600U);
+    }
+    std::size_t lines = 0U;
+    for (std::uint8_t c : in) {
+      lines += (c == '\n') ? 1U : 0U;
+    }
+    std::vector<std::uint8_t> out;
+    std::size_t frames;
+    pack(in, out, frames);
+    std::string back;
+    std::size_t skipped;
+    unpack(out, back, skipped);
+    const bool same = back.size() == in.size() &&
+                      std::memcmp(back.data(), in.data(), in.size()) == 0;
+    std::printf("text %zu bytes, %zu lines\n", in.size(), lines);
+    std::printf("packed %zu bytes in %zu frames, ratio %.2f\n", out.size(),
+                frames, out.size() ? double(in.size()) / out.size() : 0.0);
+    std::printf("file writes per KB of text: %.2f (uncompressed: %.2f)\n",
+                in.size() ? frames * 1024.0 / in.size() : 0.0,
+                in.size() ? lines * 1024.0 / in.size() : 0.0);
+    std::printf("round trip %s\n", same ? "ok" : "FAILED");
+    return same ? 0 : 1;
+  }
+  std::fprintf(stderr, "usage: lzlog d <in.lzb> [out.txt] | "
+                       "c <in.txt> <out.lzb> | bench [in.txt]\n");
+  return 2;
+}
+
+/** @} */ // end of Logger
@@ -0,0 +1,120 @@
+/**
+ * @file    rtc_check.cpp
+ * @brief   Host self-check of Calendar and the RtcPort contract.
+ * @author  Mitul Goti
+ * @version 1.0
+ * @date    2025-10-06
+ * @ingroup boot_clock
+ * @{
+ * @details
+ * Built and run with the other host checks by `make -C Tools check`, or
+ * alone from the repository root:
+ * ```
+ * make -C Tools rtc_check
+ * Tools/build/rtc_check
+ * ```
+ * Compares every day from 1970 to 2199 with the host C library, checks
+ * the "set clock" parser and round-trips times through SimRtcPort the way
+ * BootClock uses it across a reset.
+ */
+
+#include "calendar.h"
+#include "host_check.h"
+#include "rtc_sim.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+namespace {
+/**
+ * @brief   Parse text and compare the result with an ISO string.
+ * @param   text     Input for Calendar::parse().
+ * @param   expected Expected kind of result.
+ * @param   iso      Expected time after parsing (nullptr: don't care).
+ * @return  Failed checks.
+ */
+int checkParse(const char *text, Calendar::Parsed expected,
+               const char *iso) {
+  DateTime dt = Calendar::fromUnixMs(Calendar::MS_PER_DAY * 20000U);
+  const Calendar::Parsed parsed = Calendar::parse(text, dt);
+  int failures = expect(parsed == expected, text);
+  if (iso != nullptr && parsed != Calendar::Parsed::NONE) {
+    char buf[Calendar::ISO_STRING_SIZE];
+    Calendar::formatIso(Calendar::toUnixMs(dt), buf);
+    if (std::strcmp(buf, iso) != 0) {
+      std::printf("FAIL: %s -> %s, expected %s\n", text, buf, iso);
+      failures++;
+    }
+  }
+  return failures;
+}
+} // namespace
+
+int main() {
+  int failures = 0;
+
+  /* 1. Day numbers and ISO text against gmtime() */
+  const std::uint32_t lastDay = Calendar::daysFromCivil(2199U, 12U, 31U);
+  for (std::uint32_t day = 0U; day <= lastDay; day++) {
+    const std::uint64_t ms = day * Calendar::MS_PER_DAY + 45296789U;
+    const std::time_t t = static_cast<std::time_t>(ms / 1000U);
+    std::tm tm{};
+    gmtime_r(&t, &tm);
+    char expected[80];
+    std::snprintf(expected, sizeof(expected),
+                  "%04d-%02d-%02dT%02d:%02d:%02d.789", tm.tm_year + 1900,
+                  tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min,
+                  tm.tm_sec);
+    char buf[Calendar::ISO_STRING_SIZE];
+    Calendar::formatIso(ms, buf);
+    const DateTime dt = Calendar::fromUnixMs(ms);
+    if (std::strcmp(buf, expected) != 0 || !Calendar::valid(dt) ||
+        Calendar::toUnixMs(dt) != ms) {
+      std::printf("FAIL: day %u: %s, expected %s\n", day, buf, expected);
+      return 1;
+    }
+  }
+  std::printf("calendar: %u days checked\n", lastDay + 1U);
+
+  /* 2. Parser */
+  failures += checkParse("12:34:56", Calendar::Parsed::TIME,
+                         "2024-10-04T12:34:56.000");
+  failures += checkParse("12:34:56\r\n", Calendar::Parsed::TIME, nullptr);
+  failures += checkParse("2026-10-17T08:09:10", Calendar::Parsed::DATE_TIME,
+                         "2026-10-17T08:09:10.000");
+  failures += checkParse("2026-10-17 08:09:10.250Z",
+                         Calendar::Parsed::DATE_TIME,
+                         "2026-10-17T08:09:10.250");
+  failures += checkParse("2026-10-17", Calendar::Parsed::NONE, nullptr);
+  failures += checkParse("2026-10-17T8:09:10", Calendar::Parsed::NONE, nullptr);
+  failures += checkParse("12:34:56 x", Calendar::Parsed::NONE, nullptr);
+  failures += checkParse("12:34", Calendar::Parsed::NONE, nullptr);
+  DateTime bad;
+  Calendar::parse("2025-02-29T00:00:00", bad);
+  failures += expect(!Calendar::valid(bad), "2025-02-29 accepted");
+  Calendar::parse("2024-02-29T23:59:59", bad);
+  failures += expect(Calendar::valid(bad), "2024-02-29 refused");
+  Calendar::parse("24:00:00", bad);
+  failures += expect(!Calendar::valid(bad), "24:00:00 accepted");
+
+  /* 3. RTC contract: set, reset, read back */
+  SimRtcPort rtc;
+  DateTime dt;
+  failures += expect(!rtc.read(dt), "fresh RTC reads as set");
+  Calendar::parse("1999-12-31T23:59:59", dt);
+  failures += expect(!rtc.write(dt), "RTC took year 1999");
+  Calendar::parse("2026-10-17T23:59:58.600", dt);
+  failures += expect(rtc.write(dt), "RTC write failed");
+  rtc.advance(1500U); /* Board reset in the meantime */
+  failures += expect(rtc.read(dt), "RTC lost its time");
+  char buf[Calendar::ISO_STRING_SIZE];
+  Calendar::formatIso(Calendar::toUnixMs(dt), buf);
+  failures += expect(std::strcmp(buf, "2026-10-17T23:59:59.500") == 0, buf);
+  rtc.powerLoss();
+  failures += expect(!rtc.read(dt), "RTC kept its time without power");
+
+  return summary(failures);
+}
+
+/** @} */ // end of boot_clock
@@ -0,0 +1,58 @@
+/**
+ * @file    rtc_sim.h
+ * @brief   Host stand-in for the STM32 RTC behind RtcPort.
+ * @author  Mitul Goti
+ * @version 1.0
+ * @date    2025-10-06
+ * @ingroup boot_clock
+ * @{
+ * @details
+ *   SimRtcPort implements RtcPort on a millisecond counter that the test
+ *   advances by hand. It mirrors the limits of Stm32RtcPort: the calendar
+ *   reads as "not set" until written once, years outside 2000..2099 are
+ *   refused and the milliseconds of a write are dropped.
+ */
+
+#ifndef RTC_SIM_H
+#define RTC_SIM_H
+
+#include <calendar.h>
+#include <cstdint>
+#include <rtc_port.h>
+
+/**
+ * @class   SimRtcPort
+ * @brief   RtcPort on a simulated free-running counter.
+ */
+class SimRtcPort : public RtcPort {
+public:
+  bool read(DateTime &dt) override {
+    if (!set) {
+      return false;
+    }
+    dt = Calendar::fromUnixMs(unixMs);
+    return true;
+  }
+
+  bool write(const DateTime &dt) override {
+    if (!Calendar::valid(dt) || dt.year < 2000U || dt.year > 2099U) {
+      return false;
+    }
+    unixMs = Calendar::toUnixMs(dt) - dt.millis; /* SSR restarts at 0 */
+    set = true;
+    return true;
+  }
+
+  /** @brief Let time pass (e.g. while the board is reset or off) */
+  void advance(std::uint64_t ms) { unixMs += ms; }
+
+  /** @brief Lose the backup domain (no battery on VBAT) */
+  void powerLoss() { set = false; }
+
+private:
+  std::uint64_t unixMs = 0U; /*!< Calendar time held by the "RTC" */
+  bool set = false;          /*!< Calendar written once (INITS) */
+};
+
+#endif    // RTC_SIM_H
+/** @} */ // end of boot_clock